@@ -0,0 +1,41 @@
+#include <zeo/zeo_bv.h>
+
+#define FRAME 200
+#define N     1000
+
+int main(void)
+{
+  zVec3D *v;
+  zCH3DInc chi;
+  zPH3D ch;
+  clock_t t1, t2, t3;
+  register int i, k;
+
+  if( !( v = zAlloc( zVec3D, FRAME*N ) ) ) return EXIT_FAILURE;
+  zRandInit();
+  for( i=0; i<FRAME*N; i++ )
+    zVec3DCreatePolar( &v[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  /* rebuild the convex hull every frame */
+  t1 = clock();
+  for( k=1; k<=FRAME; k++ ){
+    zCH3D( &ch, v, k*N );
+    zPH3DDestroy( &ch );
+  }
+  /* incrementally extend the convex hull */
+  t2 = clock();
+  zCH3DIncInit( &chi );
+  for( k=0; k<FRAME; k++ ){
+    zCH3DIncAdd( &chi, &v[k*N], N );
+    zCH3DInc2PH3D( &chi, &ch );
+    zPH3DDestroy( &ch );
+  }
+  t3 = clock();
+  zCH3DInc2PH3D( &chi, &ch );
+  printf( "%d vertices, %d faces\n", zPH3DVertNum(&ch), zPH3DFaceNum(&ch) );
+  printf( "rebuild:     %ld\n", t2 - t1 );
+  printf( "incremental: %ld\n", t3 - t2 );
+  zPH3DDestroy( &ch );
+  zCH3DIncDestroy( &chi );
+  zFree( v );
+  return 0;
+}
@@ -0,0 +1,39 @@
+#define _POSIX_C_SOURCE 199309L
+#include <zeo/zeo_bv.h>
+#include <time.h>
+
+#define N 2000000
+
+double elapsed(struct timespec *t1, struct timespec *t2)
+{
+  return ( t2->tv_sec - t1->tv_sec ) * 1.0e3 + ( t2->tv_nsec - t1->tv_nsec ) * 1.0e-6;
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D *v;
+  zPH3D ch;
+  struct timespec t1, t2;
+  int nthread;
+  register int i;
+
+  nthread = argc > 1 ? atoi( argv[1] ) : 4;
+  if( !( v = zAlloc( zVec3D, N ) ) ) return EXIT_FAILURE;
+  zRandInit();
+  for( i=0; i<N; i++ )
+    zVec3DCreatePolar( &v[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+
+  clock_gettime( CLOCK_MONOTONIC, &t1 );
+  zCH3D( &ch, v, N );
+  clock_gettime( CLOCK_MONOTONIC, &t2 );
+  printf( "zCH3D:         %d vertices, %d faces, %g ms\n", zPH3DVertNum(&ch), zPH3DFaceNum(&ch), elapsed( &t1, &t2 ) );
+  zPH3DDestroy( &ch );
+
+  clock_gettime( CLOCK_MONOTONIC, &t1 );
+  zCH3DParallel( &ch, v, N, nthread );
+  clock_gettime( CLOCK_MONOTONIC, &t2 );
+  printf( "zCH3DParallel: %d vertices, %d faces, %g ms (%d threads)\n", zPH3DVertNum(&ch), zPH3DFaceNum(&ch), elapsed( &t1, &t2 ), nthread );
+  zPH3DDestroy( &ch );
+  zFree( v );
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include <zeo/zeo.h>
+
+#define T 100
+#define MARGIN 0.005
+
+typedef struct{
+  int count;
+} count_t;
+
+bool count_pair(int id1, int id2, void *priv)
+{
+  ((count_t *)priv)->count++;
+  return true;
+}
+
+void box_rand(zAABox3D *box)
+{
+  double x, y, z, r;
+
+  x = zRandF(-1,1); y = zRandF(-1,1); z = zRandF(-1,1);
+  r = zRandF(0.01,0.03);
+  zAABox3DCreate( box, x-r, y-r, z-r, x+r, y+r, z+r );
+}
+
+int main(int argc, char *argv[])
+{
+  zAABBTree tree;
+  zAABox3D *box;
+  zVec3D v;
+  int *leaf, n, count_bf = 0, reinserted = 0;
+  count_t c = { 0 };
+  clock_t t1, t2;
+  long t_bf = 0, t_tree = 0;
+  register int i, j, k;
+
+  n = argc > 1 ? atoi( argv[1] ) : 2000;
+  zRandInit();
+  box = zAlloc( zAABox3D, n );
+  leaf = zAlloc( int, n );
+  zAABBTreeInit( &tree, MARGIN );
+  for( i=0; i<n; i++ ){
+    box_rand( &box[i] );
+    leaf[i] = zAABBTreeInsert( &tree, &box[i], NULL );
+  }
+  for( k=0; k<T; k++ ){
+    t1 = clock();
+    for( i=0; i<n; i++ ){
+      if( zRandI(0,99) == 0 ){ /* an object leaves and another enters */
+        zAABBTreeRemove( &tree, leaf[i] );
+        box_rand( &box[i] );
+        leaf[i] = zAABBTreeInsert( &tree, &box[i], NULL );
+        continue;
+      }
+      zVec3DCreate( &v, zRandF(-0.002,0.002), zRandF(-0.002,0.002), zRandF(-0.002,0.002) );
+      zVec3DAddDRC( &box[i].min, &v );
+      zVec3DAddDRC( &box[i].max, &v );
+      if( zAABBTreeMove( &tree, leaf[i], &box[i], &v ) ) reinserted++;
+    }
+    zAABBTreeQueryTree( &tree, &tree, count_pair, &c );
+    t2 = clock();
+    t_tree += t2 - t1;
+    /* brute-force check of all pairs */
+    t1 = clock();
+    for( i=0; i<n; i++ )
+      for( j=i+1; j<n; j++ )
+        if( zColChkAABox3D( &box[i], &box[j] ) ) count_bf++;
+    t2 = clock();
+    t_bf += t2 - t1;
+  }
+  printf( "%d boxes, %d cycles, tree height %d\n", n, T, zAABBTreeHeight(&tree) );
+  printf( "brute-force: %ld clocks, %d pairs\n", t_bf, count_bf );
+  printf( "AABB tree:   %ld clocks, %d pairs of fattened boxes (%d reinsertions)\n", t_tree, c.count, reinserted );
+  zAABBTreeDestroy( &tree );
+  zFree( box );
+  zFree( leaf );
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <zeo/zeo.h>
+
+#define T 1000
+
+int main(int argc, char *argv[])
+{
+  zPH3D ph;
+  zPH3DBVH bvh;
+  zVec3D *loop, center, axis, p, cp, dir, *org, *rdir;
+  clock_t t1, t2;
+  long t_bf = 0, t_bvh = 0;
+  int n, nthread;
+  double d_bf = 0, d_bvh = 0, t, *rt;
+  int *face;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : 500;
+  nthread = argc > 2 ? atoi( argv[2] ) : 4;
+  zRandInit();
+  loop = zAlloc( zVec3D, n );
+  for( i=0; i<n; i++ )
+    zVec3DCreate( &loop[i], 1+0.3*cos(zPIx2*i/n), 0, 0.3*sin(zPIx2*i/n) );
+  zVec3DZero( &center );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( &ph, loop, n, n, &center, &axis );
+  printf( "%d faces\n", zPH3DFaceNum(&ph) );
+  t1 = clock();
+  zPH3DBVHCreate( &bvh, &ph, nthread );
+  t2 = clock();
+  printf( "build: %ld clocks (CPU time of %d threads), %d nodes, depth %d\n", (long)( t2 - t1 ), nthread, zPH3DBVHNodeNum(&bvh), zPH3DBVHDepth(&bvh) );
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(-1,1) );
+    if( i < T/100 ){ /* linear scan is too slow to be repeated */
+      t1 = clock();
+      d_bf += zPH3DClosest( &ph, &p, &cp );
+      t2 = clock();
+      t_bf += t2 - t1;
+    }
+    t1 = clock();
+    d_bvh += zPH3DBVHClosest( &bvh, &p, &cp, NULL );
+    t2 = clock();
+    t_bvh += t2 - t1;
+  }
+  printf( "closest (linear scan): %g clocks/query\n", (double)t_bf / ( T/100 ) );
+  printf( "closest (BVH):         %g clocks/query\n", (double)t_bvh / T );
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(-1,1) );
+    zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zPH3DBVHRayCast( &bvh, &p, &dir, HUGE_VAL, &t );
+  }
+  t2 = clock();
+  printf( "ray cast (BVH):        %g clocks/query\n", (double)( t2 - t1 ) / T );
+  /* coherent rays from a point */
+  org = zAlloc( zVec3D, T );
+  rdir = zAlloc( zVec3D, T );
+  rt = zAlloc( double, T );
+  face = zAlloc( int, T );
+  zVec3DCreate( &p, 0, -3, 0.5 );
+  for( i=0; i<T; i++ ){
+    zVec3DCopy( &p, &org[i] );
+    zVec3DCreate( &rdir[i], 2.0*( i%40 )/40 - 1, 1, 0.5*( i/40 )/( T/40 ) - 0.5 );
+  }
+  t1 = clock();
+  for( i=0; i<T; i++ )
+    face[i] = zPH3DBVHRayCast( &bvh, &org[i], &rdir[i], HUGE_VAL, &rt[i] );
+  t2 = clock();
+  printf( "coherent rays (BVH):   %g clocks/ray\n", (double)( t2 - t1 ) / T );
+  zFree( org );
+  zFree( rdir );
+  zFree( rt );
+  zFree( face );
+  /* refit against rebuild after a deformation */
+  for( i=0; i<zPH3DVertNum(&ph); i++ )
+    zPH3DVert(&ph,i)->e[zZ] *= 1.5;
+  t1 = clock();
+  zPH3DBVHRefit( &bvh );
+  t2 = clock();
+  printf( "refit: %ld clocks, cost ratio %g\n", (long)( t2 - t1 ), zPH3DBVHCostRatio(&bvh) );
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &ph );
+  zFree( loop );
+  return 0;
+}
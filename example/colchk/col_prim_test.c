@@ -0,0 +1,67 @@
+#include <zeo/zeo.h>
+
+#define N 100
+#define T 100
+
+void shape_rand(zShape3D *s, int type)
+{
+  zVec3D c, ax, ay, az;
+  zMat3D att;
+
+  zVec3DCreate( &c, zRandF(-1.5,1.5), zRandF(-1.5,1.5), zRandF(-1.5,1.5) );
+  zVec3DCreate( &ax, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DFromAA( &att, &ax );
+  zMat3DCol( &att, zX, &ax );
+  zMat3DCol( &att, zY, &ay );
+  zMat3DCol( &att, zZ, &az );
+  if( type == 0 )
+    zShape3DSphereCreate( s, &c, zRandF(0.1,0.8), 0 );
+  else
+    zShape3DBoxCreate( s, &c, &ax, &ay, &az, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1) );
+}
+
+void bench(char *name, int type1, int type2)
+{
+  zShape3D s1[N], s2[N];
+  zVec3D c1, c2;
+  clock_t t1, t2, t3, t4;
+  double d = 0, e = 0;
+  int n1 = 0, n2 = 0;
+  register int i, j;
+
+  for( i=0; i<N; i++ ){
+    shape_rand( &s1[i], type1 );
+    shape_rand( &s2[i], type2 );
+  }
+  t1 = clock();
+  for( j=0; j<T; j++ )
+    for( i=0; i<N; i++ )
+      d += zShape3DDist( &s1[i], &s2[i] );
+  t2 = clock();
+  for( j=0; j<T; j++ )
+    for( i=0; i<N; i++ )
+      e += zGJKShape( &s1[i], NULL, &s2[i], NULL, &c1, &c2 ) ? 0 : zVec3DDist( &c1, &c2 );
+  t3 = clock();
+  for( j=0; j<T; j++ )
+    for( i=0; i<N; i++ )
+      if( zColChkShape3D( &s1[i], &s2[i] ) ) n1++;
+  t4 = clock();
+  for( i=0; i<N; i++ )
+    if( zGJKShape( &s1[i], NULL, &s2[i], NULL, &c1, &c2 ) ) n2++;
+  printf( "%s: zShape3DDist %g / zGJKShape %g clocks/query (sum of distances %g vs %g)\n", name,
+    (double)( t2 - t1 ) / ( N*T ), (double)( t3 - t2 ) / ( N*T ), d / T, e / T );
+  printf( "  zColChkShape3D %g clocks/query (%d vs %d intersections)\n", (double)( t4 - t3 ) / ( N*T ), n1 / T, n2 );
+  for( i=0; i<N; i++ ){
+    zShape3DDestroy( &s1[i] );
+    zShape3DDestroy( &s2[i] );
+  }
+}
+
+int main(void)
+{
+  zRandInit();
+  bench( "sphere-sphere", 0, 0 );
+  bench( "sphere-box   ", 0, 1 );
+  bench( "box-box      ", 1, 1 );
+  return 0;
+}
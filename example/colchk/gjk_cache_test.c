@@ -0,0 +1,75 @@
+#include <zeo/zeo_col.h>
+
+#define T 1000
+
+void vec_create_rand(zVec3D p[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i++ )
+    zVec3DCreatePolar( &p[i], 1, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+}
+
+/* a pose at the i'th control cycle */
+void frame_at(zFrame3D *f, int i)
+{
+  zVec3D aa;
+
+  zVec3DCreate( zFrame3DPos(f), 2.2*cos(zPIx2*i/T), 2.2*sin(zPIx2*i/T), 0.1*sin(2*zPIx2*i/T) );
+  zVec3DCreate( &aa, 0, 0, zPIx2*i/T );
+  zMat3DFromAA( zFrame3DAtt(f), &aa );
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D *p1, *p2, c1, c2;
+  zPH3D ch1, ch2;
+  zPH3DAdj adj1, adj2;
+  zConvex3D cv1, cv2;
+  zGJKCache cache;
+  zFrame3D f1, f2;
+  clock_t t1, t2, t3;
+  int n, iter_cold = 0, iter_warm = 0;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : 2000;
+  p1 = zAlloc( zVec3D, n );
+  p2 = zAlloc( zVec3D, n );
+  zRandInit();
+  vec_create_rand( p1, n );
+  vec_create_rand( p2, n );
+  zCH3DAdj( &ch1, &adj1, p1, n );
+  zCH3DAdj( &ch2, &adj2, p2, n );
+  zConvex3DPH3D( &cv1, &ch1, &adj1 );
+  zConvex3DPH3D( &cv2, &ch2, &adj2 );
+  zFrame3DIdent( &f1 );
+  zConvex3DSetFrame( &cv1, &f1 );
+  zConvex3DSetFrame( &cv2, &f2 );
+
+  t1 = clock();
+  for( i=0; i<T; i++ ){ /* cold start at every cycle */
+    frame_at( &f2, i );
+    zGJKCacheCreate( &cache, &cv1, &cv2 );
+    zGJKCacheCheck( &cache, &c1, &c2 );
+    iter_cold += zGJKCacheIterNum(&cache);
+  }
+  t2 = clock();
+  zGJKCacheCreate( &cache, &cv1, &cv2 );
+  for( i=0; i<T; i++ ){ /* warm start from the previous cycle */
+    frame_at( &f2, i );
+    zGJKCacheCheck( &cache, &c1, &c2 );
+    iter_warm += zGJKCacheIterNum(&cache);
+  }
+  t3 = clock();
+  zGJKCacheDestroy( &cache );
+  printf( "%d vertices, %d cycles\n", zPH3DVertNum(&ch1), T );
+  printf( "cold: %ld clocks, %g iterations/query\n", t2 - t1, (double)iter_cold/T );
+  printf( "warm: %ld clocks, %g iterations/query\n", t3 - t2, (double)iter_warm/T );
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zPH3DAdjDestroy( &adj1 );
+  zPH3DAdjDestroy( &adj2 );
+  zFree( p1 );
+  zFree( p2 );
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <zeo/zeo_col.h>
+
+#define T 400
+
+void vec_create_rand(zVec3D p[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i++ )
+    zVec3DCreatePolar( &p[i], 1, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D *p1, *p2, c1, c2;
+  zPH3D ch1, ch2;
+  zPH3DAdj adj1, adj2;
+  zConvex3D cv1, cv2, cs1, cs2;
+  zFrame3D f1, f2;
+  clock_t t1, t2, t3;
+  int n;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : 2000;
+  p1 = zAlloc( zVec3D, n );
+  p2 = zAlloc( zVec3D, n );
+  zRandInit();
+  vec_create_rand( p1, n );
+  vec_create_rand( p2, n );
+  zCH3DAdj( &ch1, &adj1, p1, n );
+  zCH3DAdj( &ch2, &adj2, p2, n );
+  zConvex3DPH3D( &cs1, &ch1, NULL );
+  zConvex3DPH3D( &cs2, &ch2, NULL );
+  zConvex3DPH3D( &cv1, &ch1, &adj1 );
+  zConvex3DPH3D( &cv2, &ch2, &adj2 );
+  zConvex3DSetFrame( &cs1, &f1 ); zConvex3DSetFrame( &cs2, &f2 );
+  zConvex3DSetFrame( &cv1, &f1 ); zConvex3DSetFrame( &cv2, &f2 );
+  zFrame3DIdent( &f1 );
+  zFrame3DIdent( &f2 );
+
+  t1 = clock();
+  for( i=0; i<T; i++ ){ /* linear scan */
+    zVec3DCreate( zFrame3DPos(&f2), 2.5*cos(zPIx2*i/T), 2.5*sin(zPIx2*i/T), 0.1 );
+    zGJKConvex( &cs1, &cs2, &c1, &c2 );
+    zMPRConvex( &cs1, &cs2 );
+  }
+  t2 = clock();
+  for( i=0; i<T; i++ ){ /* hill-climbing */
+    zVec3DCreate( zFrame3DPos(&f2), 2.5*cos(zPIx2*i/T), 2.5*sin(zPIx2*i/T), 0.1 );
+    zGJKConvex( &cv1, &cv2, &c1, &c2 );
+    zMPRConvex( &cv1, &cv2 );
+  }
+  t3 = clock();
+  printf( "%d vertices\n", zPH3DVertNum(&ch1) );
+  printf( "linear scan:   %ld\n", t2 - t1 );
+  printf( "hill-climbing: %ld\n", t3 - t2 );
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zPH3DAdjDestroy( &adj1 );
+  zPH3DAdjDestroy( &adj2 );
+  zFree( p1 );
+  zFree( p2 );
+  return 0;
+}
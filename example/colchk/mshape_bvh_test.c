@@ -0,0 +1,65 @@
+#include <zeo/zeo.h>
+
+#define T 10000
+
+int main(int argc, char *argv[])
+{
+  zMShape3D ms;
+  zMShape3DBVH mb;
+  zVec3D c1, c2, p, cp;
+  clock_t t1, t2;
+  int n, count = 0;
+  double d = 0, err = 0;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : 300;
+  zRandInit();
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, n );
+  for( i=0; i<n; i++ ){
+    zVec3DCreate( &c1, zRandF(-5,5), zRandF(-5,5), zRandF(0,2) );
+    zVec3DCreate( &c2, zRandF(-0.3,0.3), zRandF(-0.3,0.3), zRandF(0,1) );
+    zVec3DAddDRC( &c2, &c1 );
+    switch( i % 3 ){
+    case 0: /* a polyhedral link */
+      zShape3DCylCreate( zMShape3DShape(&ms,i), &c1, &c2, zRandF(0.05,0.2), 32 );
+      zShape3DToPH( zMShape3DShape(&ms,i) );
+      break;
+    case 1:
+      zShape3DBoxCreateAlign( zMShape3DShape(&ms,i), &c1, zRandF(0.1,0.5), zRandF(0.1,0.5), zRandF(0.1,0.5) );
+      break;
+    default:
+      zShape3DCylCreate( zMShape3DShape(&ms,i), &c1, &c2, zRandF(0.05,0.2), 16 );
+    }
+  }
+  zMShape3DBVHInit( &mb, &ms );
+
+  t1 = clock();
+  zMShape3DBVHBuild( &mb );
+  t2 = clock();
+  printf( "build (%d shapes): %ld clocks\n", n, (long)( t2 - t1 ) );
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-6,6), zRandF(-6,6), zRandF(-1,3) );
+    d += zMShape3DClosest( &ms, &p, &cp );
+  }
+  t2 = clock();
+  printf( "zMShape3DClosest:    %g clocks/query\n", (double)( t2 - t1 ) / T );
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-6,6), zRandF(-6,6), zRandF(-1,3) );
+    d += zMShape3DBVHClosest( &mb, &p, &cp, NULL );
+  }
+  t2 = clock();
+  printf( "zMShape3DBVHClosest: %g clocks/query\n", (double)( t2 - t1 ) / T );
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-6,6), zRandF(-6,6), zRandF(-1,3) );
+    err = zMax( err, fabs( zMShape3DBVHClosest( &mb, &p, &cp, NULL ) - zMShape3DClosest( &ms, &p, &cp ) ) );
+    if( zMShape3DBVHPointIsInside( &mb, &p, true ) != zMShape3DPointIsInside( &ms, &p, true ) ) count++;
+  }
+  printf( "maximum error = %g, mismatches of inside test = %d\n", err, count );
+
+  zMShape3DBVHDestroy( &mb );
+  zMShape3DDestroy( &ms );
+  return d == 0 ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+#include <zeo/zeo.h>
+
+#define T 1000
+
+/* a thin torus, for which axis-aligned boxes fit poorly. */
+zPH3D *torus_create(zPH3D *ph, int n)
+{
+  zVec3D *loop, center, axis;
+  register int i;
+
+  loop = zAlloc( zVec3D, 8 );
+  for( i=0; i<8; i++ )
+    zVec3DCreate( &loop[i], 1+0.02*cos(zPIx2*i/8), 0, 0.02*sin(zPIx2*i/8) );
+  zVec3DZero( &center );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( ph, loop, 8, n, &center, &axis );
+  zFree( loop );
+  return ph;
+}
+
+int main(int argc, char *argv[])
+{
+  zPH3D ph1, ph2, ph1x, ph2x;
+  zPH3DOBBTree tree1, tree2;
+  zPH3DBVH bvh1, bvh2;
+  zFrame3D *f1, *f2;
+  clock_t t1, t2;
+  int n, hit_obb = 0, hit_bvh = 0;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : 1000;
+  zRandInit();
+  torus_create( &ph1, n );
+  torus_create( &ph2, n );
+  printf( "%d faces x 2\n", zPH3DFaceNum(&ph1) );
+  t1 = clock();
+  zPH3DOBBTreeCreate( &tree1, &ph1 );
+  zPH3DOBBTreeCreate( &tree2, &ph2 );
+  t2 = clock();
+  printf( "build (OBB tree): %ld clocks, depth %d\n", (long)( t2 - t1 ), zPH3DOBBTreeDepth(&tree1) );
+  zPH3DClone( &ph1, &ph1x );
+  zPH3DClone( &ph2, &ph2x );
+  zPH3DBVHCreate( &bvh1, &ph1x, 1 );
+  zPH3DBVHCreate( &bvh2, &ph2x, 1 );
+  f1 = zAlloc( zFrame3D, T );
+  f2 = zAlloc( zFrame3D, T );
+  for( i=0; i<T; i++ ){
+    zFrame3DFromZYX( &f1[i], zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-zPI,zPI), zRandF(-zPI_2,zPI_2), zRandF(-zPI,zPI) );
+    zFrame3DFromZYX( &f2[i], zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-zPI,zPI), zRandF(-zPI_2,zPI_2), zRandF(-zPI,zPI) );
+  }
+  t1 = clock();
+  for( i=0; i<T; i++ )
+    if( zPH3DOBBTreeColChk( &tree1, &f1[i], &tree2, &f2[i], NULL, NULL ) ) hit_obb++;
+  t2 = clock();
+  printf( "OBB tree:       %g clocks/query (%d hits)\n", (double)( t2 - t1 ) / T, hit_obb );
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zPH3DBVHXform( &bvh1, &ph1, &f1[i] );
+    zPH3DBVHXform( &bvh2, &ph2, &f2[i] );
+    if( zPH3DBVHColChk( &bvh1, &bvh2, NULL, NULL ) ) hit_bvh++;
+  }
+  t2 = clock();
+  printf( "AABB BVH+refit: %g clocks/query (%d hits)\n", (double)( t2 - t1 ) / T, hit_bvh );
+  zFree( f1 );
+  zFree( f2 );
+  zPH3DBVHDestroy( &bvh1 );
+  zPH3DBVHDestroy( &bvh2 );
+  zPH3DOBBTreeDestroy( &tree1 );
+  zPH3DOBBTreeDestroy( &tree2 );
+  zPH3DDestroy( &ph1 );
+  zPH3DDestroy( &ph2 );
+  zPH3DDestroy( &ph1x );
+  zPH3DDestroy( &ph2x );
+  return 0;
+}
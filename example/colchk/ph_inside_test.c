@@ -0,0 +1,56 @@
+#include <zeo/zeo.h>
+
+#define N 100000
+
+int main(int argc, char *argv[])
+{
+  zPH3D torus;
+  zPH3DBVH bvh;
+  zVec3D loop[64], center, axis, *p;
+  bool *inside;
+  clock_t t1, t2;
+  int div, nthread, count = 0, err = 0;
+  double e;
+  register int i;
+
+  div = argc > 1 ? atoi( argv[1] ) : 256;
+  nthread = argc > 2 ? atoi( argv[2] ) : 4;
+  zRandInit();
+  for( i=0; i<64; i++ )
+    zVec3DCreate( &loop[i], 1.0+0.3*cos(zPIx2*i/64), 0, 0.3*sin(zPIx2*i/64) );
+  zVec3DZero( &center );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( &torus, loop, 64, div, &center, &axis );
+  zPH3DBVHCreate( &bvh, &torus, nthread );
+  p = zAlloc( zVec3D, N );
+  inside = zAlloc( bool, N );
+  for( i=0; i<N; i++ )
+    zVec3DCreate( &p[i], zRandF(-1.5,1.5), zRandF(-1.5,1.5), zRandF(-0.5,0.5) );
+
+  t1 = clock();
+  for( i=0; i<N/100; i++ )
+    if( zPH3DPointIsInside( &torus, &p[i], true ) ) count++;
+  t2 = clock();
+  printf( "zPH3DPointIsInside (%d faces, convex only): %g clocks/point, %d inside\n", zPH3DFaceNum(&torus), (double)( t2 - t1 ) / ( N/100 ), count );
+  t1 = clock();
+  for( count=0, i=0; i<N; i++ )
+    if( zPH3DBVHPointIsInside( &bvh, &p[i], true ) ) count++;
+  t2 = clock();
+  printf( "zPH3DBVHPointIsInside: %g clocks/point, %d inside\n", (double)( t2 - t1 ) / N, count );
+  t1 = clock();
+  count = zPH3DBVHPointIsInsideBatch( &bvh, p, N, true, inside, nthread );
+  t2 = clock();
+  printf( "zPH3DBVHPointIsInsideBatch: %g clocks/point (CPU time of %d threads), %d inside\n", (double)( t2 - t1 ) / N, nthread, count );
+  /* against the exact torus, except for points close to the surface */
+  for( i=0; i<N; i++ ){
+    e = sqrt( zSqr( sqrt( zSqr(p[i].c.x) + zSqr(p[i].c.y) ) - 1.0 ) + zSqr(p[i].c.z) ) - 0.3;
+    if( fabs( e ) > 0.01 && inside[i] != ( e < 0 ) ) err++;
+  }
+  printf( "misjudged points: %d\n", err );
+
+  zFree( p );
+  zFree( inside );
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &torus );
+  return 0;
+}
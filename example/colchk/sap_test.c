@@ -0,0 +1,72 @@
+#include <zeo/zeo.h>
+
+#define T 100
+
+/* random spheres in a unit cube. */
+void mshape_create_rand(zMShape3D *ms, int n)
+{
+  zVec3D c;
+  register int i;
+
+  zMShape3DInit( ms );
+  zArrayAlloc( &ms->shape, zShape3D, n );
+  for( i=0; i<n; i++ ){
+    zVec3DCreate( &c, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zShape3DSphereCreate( zMShape3DShape(ms,i), &c, zRandF(0.01,0.03), 0 );
+  }
+}
+
+/* move spheres a little. */
+void mshape_move(zMShape3D *ms)
+{
+  zVec3D v;
+  register int i;
+
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    zVec3DCreate( &v, zRandF(-0.002,0.002), zRandF(-0.002,0.002), zRandF(-0.002,0.002) );
+    zVec3DAddDRC( zSphere3DCenter(zShape3DSphere(zMShape3DShape(ms,i))), &v );
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  zMShape3D ms;
+  zAABox3D *box;
+  zSAP sap;
+  clock_t t1, t2;
+  long t_bf = 0, t_sap = 0;
+  int n, count_bf = 0, count_sap = 0, changed = 0;
+  register int i, j, k;
+
+  n = argc > 1 ? atoi( argv[1] ) : 2000;
+  zRandInit();
+  mshape_create_rand( &ms, n );
+  box = zAlloc( zAABox3D, n );
+  zSAPCreateMShape3D( &sap, &ms );
+  for( k=0; k<T; k++ ){
+    mshape_move( &ms );
+    /* brute-force check of all pairs */
+    t1 = clock();
+    for( i=0; i<n; i++ )
+      zShape3DToAABox3D( zMShape3DShape(&ms,i), &box[i] );
+    for( i=0; i<n; i++ )
+      for( j=i+1; j<n; j++ )
+        if( zColChkAABox3D( &box[i], &box[j] ) ) count_bf++;
+    t2 = clock();
+    t_bf += t2 - t1;
+    /* incremental sweep-and-prune */
+    t1 = clock();
+    zSAPUpdateMShape3D( &sap, &ms );
+    t2 = clock();
+    t_sap += t2 - t1;
+    count_sap += zSAPPairNum(&sap);
+    changed += zSAPAddedNum(&sap) + zSAPRemovedNum(&sap);
+  }
+  printf( "%d shapes, %d cycles\n", n, T );
+  printf( "brute-force:    %ld clocks, %d pairs\n", t_bf, count_bf );
+  printf( "sweep-and-prune: %ld clocks, %d pairs (%d changes)\n", t_sap, count_sap, changed );
+  zSAPDestroy( &sap );
+  zFree( box );
+  zMShape3DDestroy( &ms );
+  return 0;
+}
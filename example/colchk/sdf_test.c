@@ -0,0 +1,65 @@
+#include <zeo/zeo.h>
+
+#define T 100000
+
+int main(int argc, char *argv[])
+{
+  zMShape3D ms;
+  zSDF3D dense, sparse;
+  zVec3D c1, c2, p, cp, g;
+  clock_t t1, t2;
+  int n, nthread;
+  double d = 0;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : 100;
+  nthread = argc > 2 ? atoi( argv[2] ) : 4;
+  zRandInit();
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, n );
+  for( i=0; i<n; i++ ){
+    zVec3DCreate( &c1, zRandF(-2,2), zRandF(-2,2), zRandF(0,1) );
+    zVec3DCreate( &c2, zRandF(-0.2,0.2), zRandF(-0.2,0.2), zRandF(0,1) );
+    zVec3DAddDRC( &c2, &c1 );
+    if( i % 2 == 0 )
+      zShape3DCylCreate( zMShape3DShape(&ms,i), &c1, &c2, zRandF(0.05,0.2), 16 );
+    else
+      zShape3DBoxCreateAlign( zMShape3DShape(&ms,i), &c1, zRandF(0.1,0.5), zRandF(0.1,0.5), zRandF(0.1,0.5) );
+  }
+  t1 = clock();
+  zSDF3DCreateMShape( &dense, &ms, 0.05, 0.5, ZEO_SDF3D_DENSE, nthread );
+  t2 = clock();
+  printf( "dense:  %ld clocks (CPU time of %d threads), %d x %d x %d grid, %d blocks\n", (long)( t2 - t1 ), nthread,
+    zSDF3DSize(&dense,zX), zSDF3DSize(&dense,zY), zSDF3DSize(&dense,zZ), zSDF3DBlockNum(&dense) );
+  t1 = clock();
+  zSDF3DCreateMShape( &sparse, &ms, 0.05, 0.5, 0.2, nthread );
+  t2 = clock();
+  printf( "sparse: %ld clocks (CPU time of %d threads), %d blocks\n", (long)( t2 - t1 ), nthread, zSDF3DBlockNum(&sparse) );
+
+  t1 = clock();
+  for( i=0; i<T/100; i++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(0,1) );
+    d += zMShape3DClosest( &ms, &p, &cp );
+  }
+  t2 = clock();
+  printf( "zMShape3DClosest: %g clocks/query\n", (double)( t2 - t1 ) / ( T/100 ) );
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(0,1) );
+    d += zSDF3DGrad( &dense, &p, &g );
+  }
+  t2 = clock();
+  printf( "zSDF3DGrad (dense):  %g clocks/query\n", (double)( t2 - t1 ) / T );
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(0,1) );
+    d += zSDF3DGrad( &sparse, &p, &g );
+  }
+  t2 = clock();
+  printf( "zSDF3DGrad (sparse): %g clocks/query\n", (double)( t2 - t1 ) / T );
+
+  zSDF3DDestroy( &dense );
+  zSDF3DDestroy( &sparse );
+  zMShape3DDestroy( &ms );
+  return d == 0 ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#include <zeo/zeo_ep.h>
+
+#define N 100000
+
+int main(void)
+{
+  zEP *ep1, *ep2, *ep, *epv, tmp;
+  zMat3D *m;
+  zVec3D *av;
+  double *t, err, maxerr = 0;
+  clock_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+  register int i;
+
+  zRandInit();
+  ep1 = zAlloc( zEP, N );
+  ep2 = zAlloc( zEP, N );
+  ep  = zAlloc( zEP, N );
+  epv = zAlloc( zEP, N );
+  m   = zAlloc( zMat3D, N );
+  av  = zAlloc( zVec3D, N );
+  t   = zAlloc( double, N );
+  if( !ep1 || !ep2 || !ep || !epv || !m || !av || !t ) goto TERMINATE;
+  for( i=0; i<N; i++ ){
+    zEPCreate( &ep1[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zEPCreate( &ep2[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zEPCreate( &epv[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    t[i] = zRandF(0,1);
+  }
+
+  t0 = clock();
+  for( i=0; i<N; i++ ){
+    zEPCopy( &ep2[i], &tmp );
+    zEPInterDiv( &ep1[i], &tmp, t[i], &ep[i] );
+  }
+  t1 = clock();
+  zEPInterDivArray( ep1, ep2, t, N, ep );
+  t2 = clock();
+  zEPInterDivNLArray( ep1, ep2, t, N, ep );
+  t3 = clock();
+  for( i=0; i<N; i++ )
+    zMat3DFromEP( &m[i], &ep1[i] );
+  t4 = clock();
+  zMat3DFromEPArray( m, ep1, N );
+  t5 = clock();
+  for( i=0; i<N; i++ )
+    zMat3DToEP( &m[i], &ep[i] );
+  t6 = clock();
+  zMat3DToEPArray( m, ep, N );
+  t7 = clock();
+  for( i=0; i<N; i++ )
+    zEPVel2AngVel( &epv[i], &ep1[i], &av[i] );
+  t8 = clock();
+  zEPVel2AngVelArray( epv, ep1, av, N );
+  t9 = clock();
+
+  /* check consistency between SLERP and NLERP */
+  zEPInterDivArray( ep1, ep2, t, N, ep );
+  zEPInterDivNLArray( ep1, ep2, t, N, epv );
+  for( i=0; i<N; i++ ){
+    err = fabs( zEPInnerProd( &ep[i], &epv[i] ) );
+    if( 1 - err > maxerr ) maxerr = 1 - err;
+  }
+
+  printf( "+++ c.time (scalar / array) +++\n" );
+  printf( "SLERP:          %ld / %ld\n", t1 - t0, t2 - t1 );
+  printf( "NLERP:          - / %ld\n", t3 - t2 );
+  printf( "zMat3DFromEP:   %ld / %ld\n", t4 - t3, t5 - t4 );
+  printf( "zMat3DToEP:     %ld / %ld\n", t6 - t5, t7 - t6 );
+  printf( "zEPVel2AngVel:  %ld / %ld\n", t8 - t7, t9 - t8 );
+  printf( "max. deviation of NLERP from SLERP (1-cos): %g\n", maxerr );
+
+ TERMINATE:
+  zFree( ep1 );
+  zFree( ep2 );
+  zFree( ep );
+  zFree( epv );
+  zFree( m );
+  zFree( av );
+  zFree( t );
+  return 0;
+}
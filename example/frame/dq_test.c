@@ -0,0 +1,41 @@
+#include <zeo/zeo.h>
+
+#define N 1000000
+
+int main(void)
+{
+  zFrame3D f1, f2, f, fdq;
+  zDQ dq1, dq2, dq;
+  zVec6D err;
+  clock_t t1, t2, t3;
+  register int i;
+
+  zRandInit();
+  zFrame3DFromZYX( &f1, zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-zPI,zPI), 0.5*zRandF(-zPI,zPI), zRandF(-zPI,zPI) );
+  zFrame3DIdent( &f2 );
+  zDQFromFrame3D( &dq1, &f1 );
+  zDQIdent( &dq2 );
+
+  /* chain of N transformations */
+  zFrame3DCopy( &f2, &f );
+  t1 = clock();
+  for( i=0; i<N; i++ ){
+    zFrame3DCascade( &f1, &f, &f2 );
+    zFrame3DCopy( &f2, &f );
+  }
+  t2 = clock();
+  zDQCopy( &dq2, &dq );
+  for( i=0; i<N; i++ )
+    zDQCascade( &dq1, &dq, &dq );
+  t3 = clock();
+  zDQNormalize( &dq );
+
+  printf( "+++ c.time +++\n" );
+  printf( "zFrame3DCascade: %ld\n", t2 - t1 );
+  printf( "zDQCascade:      %ld\n", t3 - t2 );
+  printf( "+++ error +++\n" );
+  zFrame3DError( &f, zDQToFrame3D( &dq, &fdq ), &err );
+  zVec6DPrint( &err );
+  printf( "orthonormality of frame: %g\n", zMat3DDet( zFrame3DAtt(&f) ) - 1 );
+  return 0;
+}
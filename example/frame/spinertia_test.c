@@ -0,0 +1,75 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+#define T 1000
+
+/* spatial transformation matrix equivalent to zXform6DLin() */
+zMat6D *frame2mat6d(zFrame3D *f, zMat6D *m)
+{
+  zMat3D op;
+
+  zMat3DT( zFrame3DAtt(f), &m->c.ll );
+  zMat3DZero( &m->c.la );
+  zVec3DOuterProd2Mat3D( zFrame3DPos(f), &op );
+  zMulMat3DTMat3D( zFrame3DAtt(f), &op, &m->c.al );
+  zMat3DRevDRC( &m->c.al );
+  zMat3DT( zFrame3DAtt(f), &m->c.aa );
+  return m;
+}
+
+int main(void)
+{
+  zFrame3D f[N];
+  zSpInertia si[N], sic[N];
+  zMat6D x[N], mi[N], mtmp, mic;
+  zVec6D v[N], vc[N], fc[N];
+  zVec3D aa, com;
+  zMat3D inertia;
+  clock_t t1, t2, t3, t4, t5, t6, t7;
+  register int i, k;
+
+  zRandInit();
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zMat3DFromAA( zFrame3DAtt(&f[i]), &aa );
+    zVec3DCreate( zFrame3DPos(&f[i]), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec6DCreate( &v[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec3DCreate( &com, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zMat3DCreate( &inertia, zRandF(0.1,1), 0, 0, 0, zRandF(0.1,1), 0, 0, 0, zRandF(0.1,1) );
+    zSpInertiaCreate( &si[i], zRandF(0.1,10), &com, &inertia );
+    frame2mat6d( &f[i], &x[i] );
+    zSpInertiaToMat6D( &si[i], &mi[i] );
+  }
+
+  t1 = clock();
+  for( k=0; k<T; k++ )
+    for( i=0; i<N; i++ ) zMulMat6DVec6D( &x[i], &v[i], &vc[i] );
+  t2 = clock();
+  for( k=0; k<T; k++ )
+    zXform6DLinArray( f, v, N, vc );
+  t3 = clock();
+  for( k=0; k<T; k++ )
+    for( i=0; i<N; i++ ) zMulMat6DVec6D( &mi[i], &v[i], &fc[i] );
+  t4 = clock();
+  for( k=0; k<T; k++ )
+    zMulSpInertiaVec6DArray( si, v, N, fc );
+  t5 = clock();
+  for( k=0; k<T; k++ )
+    for( i=0; i<N; i++ ){
+      zMulMat6DMat6D( &mi[i], &x[i], &mtmp );
+      zMulMat6DTMat6D( &x[i], &mtmp, &mic );
+    }
+  t6 = clock();
+  for( k=0; k<T; k++ )
+    zSpInertiaXformArray( si, f, N, sic );
+  t7 = clock();
+
+  printf( "+++ c.time +++\n" );
+  printf( "dense X v:         %ld\n", t2 - t1 );
+  printf( "zXform6DLinArray:  %ld\n", t3 - t2 );
+  printf( "dense I v:         %ld\n", t4 - t3 );
+  printf( "zMulSpInertiaVec6DArray: %ld\n", t5 - t4 );
+  printf( "dense X^T I X:     %ld\n", t6 - t5 );
+  printf( "zSpInertiaXformArray:    %ld\n", t7 - t6 );
+  return 0;
+}
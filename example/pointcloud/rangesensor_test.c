@@ -0,0 +1,71 @@
+#include <zeo/zeo.h>
+
+#define T 100
+
+int main(int argc, char *argv[])
+{
+  zMShape3D ms;
+  zRangeScene scene;
+  zRangeSensor camera, lidar;
+  zFrame3D pose;
+  zVec3D center, c1, c2;
+  clock_t t1, t2;
+  int nthread, count = 0;
+  register int i;
+
+  nthread = argc > 1 ? atoi( argv[1] ) : 4;
+  zRandInit();
+  /* a polyhedral cone, a box, a sphere and a cylinder on the floor */
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, 5 );
+  zVec3DCreate( &c1, 3, 0, 0 );
+  zVec3DCreate( &c2, 3, 0, 1.5 );
+  zShape3DConeCreate( zMShape3DShape(&ms,0), &c1, &c2, 0.8, 64 );
+  zShape3DToPH( zMShape3DShape(&ms,0) );
+  zVec3DCreate( &center, 0, 0, -0.05 );
+  zShape3DBoxCreateAlign( zMShape3DShape(&ms,1), &center, 20, 20, 0.1 );
+  zShape3DToPH( zMShape3DShape(&ms,1) );
+  zVec3DCreate( &center, 0, 3, 0.5 );
+  zShape3DSphereCreate( zMShape3DShape(&ms,2), &center, 0.5, 0 );
+  zVec3DCreate( &c1, -3, 0, 0 );
+  zVec3DCreate( &c2, -3, 0, 2 );
+  zShape3DCylCreate( zMShape3DShape(&ms,3), &c1, &c2, 0.4, 0 );
+  zVec3DCreate( &center, 0, -3, 0.5 );
+  zShape3DBoxCreateAlign( zMShape3DShape(&ms,4), &center, 1, 1, 1 );
+
+  t1 = clock();
+  zRangeSceneCreate( &scene, &ms, nthread );
+  t2 = clock();
+  printf( "scene: %ld clocks\n", (long)( t2 - t1 ) );
+  zRangeSensorCreateCamera( &camera, 320, 240, 300, 300, 159.5, 119.5, 0.1, 10 );
+  zRangeSensorCreateLiDAR( &lidar, 16, zDeg2Rad(-15), zDeg2Rad(15), 1800, 0.1, 100 );
+  zFrame3DIdent( &pose );
+  zVec3DCreate( zFrame3DPos(&pose), 0, 0, 1 );
+
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zFrame3DPos(&pose)->c.x = zRandF(-0.5,0.5);
+    count += zRangeSensorScan( &lidar, &scene, &pose, nthread );
+  }
+  t2 = clock();
+  printf( "LiDAR (%d rays): %g clocks/scan (CPU time of %d threads), %g points/scan\n", zRangeSensorRayNum(&lidar), (double)( t2 - t1 ) / T, nthread, (double)count / T );
+  zRangeSensorWritePCDFile( &lidar, &pose, "lidar" );
+
+  /* a camera looking at the cone */
+  zMat3DCreate( zFrame3DAtt(&pose), 0, 0, 1, -1, 0, 0, 0, -1, 0 );
+  count = 0;
+  t1 = clock();
+  for( i=0; i<T; i++ ){
+    zFrame3DPos(&pose)->c.y = zRandF(-0.5,0.5);
+    count += zRangeSensorScan( &camera, &scene, &pose, nthread );
+  }
+  t2 = clock();
+  printf( "camera (%d rays): %g clocks/scan (CPU time of %d threads), %g points/scan\n", zRangeSensorRayNum(&camera), (double)( t2 - t1 ) / T, nthread, (double)count / T );
+  zRangeSensorWritePCDFile( &camera, &pose, "camera" );
+
+  zRangeSensorDestroy( &camera );
+  zRangeSensorDestroy( &lidar );
+  zRangeSceneDestroy( &scene );
+  zMShape3DDestroy( &ms );
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include <zeo/zeo.h>
+
+#define N 100000
+
+int main(void)
+{
+  zEllips3D el;
+  zVec3D center, ax, ay, az, *p, *cp;
+  double *d, err = 0;
+  clock_t t1, t2;
+  register int i;
+
+  zRandInit();
+  zVec3DCreate( &center, 0.1, 0.2, 0.3 );
+  zVec3DCreate( &ax, 1, 0, 0 );
+  zVec3DCreate( &ay, 0,-1.0/sqrt(2), 1.0/sqrt(2) );
+  zVec3DOuterProd( &ax, &ay, &az );
+  zEllips3DCreate( &el, &center, &ax, &ay, &az, 0.15, 0.4, 0.05, 0 );
+  p = zAlloc( zVec3D, N );
+  cp = zAlloc( zVec3D, N );
+  d = zAlloc( double, N );
+  for( i=0; i<N; i++ )
+    zVec3DCreate( &p[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+
+  t1 = clock();
+  for( i=0; i<N; i++ )
+    d[i] = zEllips3DClosest( &el, &p[i], &cp[i] );
+  t2 = clock();
+  printf( "zEllips3DClosest:      %g clocks/point\n", (double)( t2 - t1 ) / N );
+  t1 = clock();
+  zEllips3DClosestBatch( &el, p, N, cp, d );
+  t2 = clock();
+  printf( "zEllips3DClosestBatch: %g clocks/point\n", (double)( t2 - t1 ) / N );
+  for( i=0; i<N; i++ )
+    err = zMax( err, fabs( zEllips3DPointDist( &el, &p[i] ) - d[i] ) );
+  printf( "maximum difference = %g\n", err );
+
+  zFree( p );
+  zFree( cp );
+  zFree( d );
+  return 0;
+}
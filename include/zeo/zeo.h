@@ -6,8 +6,10 @@
  - color and optics computations
  - 2D/3D vectors and matrices
  - 6D spatial vectors and matrices
+ - compact spatial inertia
  - 3D frame and coordinate transportation
  - Euler parameter (unit quaternion)
+ - dual quaternion
  - 3D shape elements (plane, edge and triangle)
  - 3D shape primitives (box, sphere, cylinder, cone, ellipsoid,
    elliptic cylinder, polyhedron)
@@ -16,7 +18,9 @@
  - NURBS curve / surface
  - trianglation of non-convex
  - bounding volume (AABB, OBB, boundin ball, convex-hull)
- - collision checking (GJK, Muller-Preparata)
+ - collision checking (GJK, Muller-Preparata, narrow phase between primitives)
+ - simulation of range sensors (depth camera, LiDAR)
+ - signed distance field
  - principal component analysis of point cloud
  - B-Rep (boundary representation) and boolean operations
  - elevation map
@@ -26,10 +30,14 @@
 #define __ZEO_H__
 
 #include <zeo/zeo_mat6d.h>
+#include <zeo/zeo_dq.h>
+#include <zeo/zeo_spinertia.h>
 #include <zeo/zeo_pointcloud.h>
 #include <zeo/zeo_mshape.h>
 #include <zeo/zeo_bv.h>
 #include <zeo/zeo_col.h>
+#include <zeo/zeo_rangesensor.h>
+#include <zeo/zeo_sdf.h>
 #include <zeo/zeo_map.h>
 
 #endif /* __ZEO_H__ */
@@ -37,6 +37,16 @@ __EXPORT bool zAABox3DPointIsInside(zAABox3D *box, zVec3D *p, bool rim);
 /*! \brief compute volume of an axis-aligned box. */
 __EXPORT double zAABox3DVolume(zAABox3D *box);
 
+/*! \brief compute surface area of an axis-aligned box. */
+__EXPORT double zAABox3DArea(zAABox3D *box);
+
+/*! \brief squared distance from a point to an axis-aligned box (zero if the point is inside). */
+__EXPORT double zAABox3DPointSqrDist(zAABox3D *box, zVec3D *p);
+
+/*! \brief check if a ray \a org + t \a dir (0 <= t <= \a tmax) hits an axis-aligned box.
+ * The parameter t at which the ray enters the box is stored in \a t unless it is the null pointer. */
+__EXPORT bool zAABox3DRayHit(zAABox3D *box, zVec3D *org, zVec3D *dir, double tmax, double *t);
+
 /*! \brief print an axis-aligned box out to a file. */
 __EXPORT void zAABox3DDataFPrint(FILE *fp, zAABox3D *box);
 
@@ -46,6 +56,11 @@ __EXPORT zBox3D *zAABox3DToBox3D(zAABox3D *aab, zBox3D *box);
 /*! \brief compute an axis-aligned box of a 3D box. */
 __EXPORT zAABox3D *zBox3DToAABox3D(zBox3D *box, zAABox3D *aabox);
 
+/*! \brief compute an axis-aligned box of a shape by its support map.
+ * If the shape has no support point, e.g. an empty NURBS surface, \a aabox is
+ * initialized by zAABox3DInit() and the null pointer is returned. */
+__EXPORT zAABox3D *zShape3DToAABox3D(zShape3D *shape, zAABox3D *aabox);
+
 /* ********************************************************** */
 /* AABB - axis-aligned bounding box
  * ********************************************************** */
@@ -11,6 +11,16 @@
 
 __BEGIN_DECLS
 
+/*! \struct zCH3DInc
+ * \brief incremental convex hull of points.
+ *
+ * The working space of quickhull is kept internally, and is not
+ * supposed to be accessed directly.
+ */
+typedef struct{
+  struct _zQH *qh;
+} zCH3DInc;
+
 /* ********************************************************** */
 /* convex hull
  * ********************************************************** */
@@ -24,19 +34,105 @@ __BEGIN_DECLS
  * of points is given as a vector list \a pl.
  *
  * The algorithm is according to quickhull by C. Barber,
- * D. Dobkin and H. Huhdanpaa(1996).
+ * D. Dobkin and H. Huhdanpaa(1996). Points are referred by
+ * indices of a flat array, the outside point set of each facet is
+ * a span of a shared index buffer, and facets are allocated from
+ * an arena which is freed at once.
  * \notes
- * In the cource of computation, \a pl is partially destroyed
- * but not freed by zCH3DPL().
+ * zCH3DPL() copies points in \a pl to an array, so that \a pl is
+ * not modified.
  * \return
  * zCH3DPL() and zCH3D() return a pointer \a ch if succeeding
  * to compute the convex hull. If failing to allocate working
  * memory necessitated in computation, the null pointer is
+ * returned. If the given set is empty, the null pointer is also
  * returned.
  */
 __EXPORT zPH3D *zCH3D(zPH3D *ch, zVec3D p[], int num);
 __EXPORT zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *pl);
 
+/*! \brief convex hull of points with vertex adjacency.
+ *
+ * zCH3DAdj() computes convex hull of a set of points \a p in the
+ * same way with zCH3D(), and also creates the vertex adjacency of
+ * the hull \a adj from the contiguity of facets found in the course
+ * of computation. \a num is the number of points. The resulting
+ * polyhedron is put into \a ch.
+ *
+ * The adjacency enables hill-climbing on the hull vertices, e.g.
+ * to find a support point in sublinear time.
+ * \return
+ * zCH3DAdj() returns a pointer \a ch if succeeding. Otherwise, the
+ * null pointer is returned.
+ * \sa
+ * zCH3D, zPH3DAdjCreate
+ */
+__EXPORT zPH3D *zCH3DAdj(zPH3D *ch, zPH3DAdj *adj, zVec3D p[], int num);
+
+/*! \brief convex hull of points computed in parallel.
+ *
+ * zCH3DParallel() computes convex hull of a set of points \a p
+ * with \a nthread threads. \a num is the number of points. The
+ * result is put into \a ch.
+ *
+ * Points strictly inside of a polytope spanned by extreme points
+ * along 26 directions are discarded in parallel first. The rest
+ * of points are divided into partitions, convex hulls of which
+ * are computed concurrently by zCH3D(). The final convex hull is
+ * computed by zCH3D() from the vertices of the partial hulls.
+ * \notes
+ * The number of threads is reduced so that each thread processes
+ * at least 4096 points. If it is one, zCH3DParallel() is the same
+ * with zCH3D().
+ * \return
+ * zCH3DParallel() returns a pointer \a ch if succeeding to compute
+ * the convex hull. Otherwise, the null pointer is returned.
+ * \sa
+ * zCH3D
+ */
+__EXPORT zPH3D *zCH3DParallel(zPH3D *ch, zVec3D p[], int num, int nthread);
+
+/*! \brief incremental convex hull of points.
+ *
+ * zCH3DIncInit() initializes a persistent convex hull \a ch, which
+ * is empty at first.
+ *
+ * zCH3DIncAdd() adds \a num points \a p to \a ch. Points beyond the
+ * current hull are assigned to outside sets of visible facets, and
+ * only the visible facets and the horizon are updated. Points inside
+ * of the hull are discarded. Until four non-coplanar points are
+ * given, points are just stored.
+ * zCH3DIncAddPoint() adds a point \a p to \a ch.
+ *
+ * zCH3DInc2PH3D() converts \a ch to a polyhedron \a ph at any time.
+ * If all the given points are coplanar, a planar convex hull is
+ * created.
+ *
+ * zCH3DIncDestroy() destroys \a ch.
+ * \notes
+ * Vertices which are no longer on the hull and removed facets are
+ * occasionally garbage-collected, so that the memory consumption is
+ * proportional to the size of the hull rather than the number of
+ * points given in total.
+ * \return
+ * zCH3DIncInit() returns a pointer \a ch.
+ *
+ * zCH3DIncAdd() and zCH3DIncAddPoint() return the true value if
+ * succeeding. If failing to allocate internal memory, the false value
+ * is returned.
+ *
+ * zCH3DInc2PH3D() returns a pointer \a ph if succeeding. If \a ch
+ * is degenerate to a line or a point, or failing to allocate memory,
+ * the null pointer is returned.
+ * \sa
+ * zCH3D
+ */
+__EXPORT zCH3DInc *zCH3DIncInit(zCH3DInc *ch);
+__EXPORT bool zCH3DIncAdd(zCH3DInc *ch, zVec3D p[], int num);
+#define zCH3DIncAddPoint(ch,p) zCH3DIncAdd( ch, p, 1 )
+__EXPORT zPH3D *zCH3DInc2PH3D(zCH3DInc *ch, zPH3D *ph);
+__EXPORT void zCH3DIncDestroy(zCH3DInc *ch);
+
 __END_DECLS
 
 #endif /* __ZEO_BV_QHULL_H__ */
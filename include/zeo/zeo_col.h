@@ -7,6 +7,7 @@
 #ifndef __ZEO_COL_H__
 #define __ZEO_COL_H__
 
+#include <zeo/zeo_mshape.h>
 #include <zeo/zeo_bv.h>
 
 __BEGIN_DECLS
@@ -108,9 +109,16 @@ __EXPORT int zIntersectVecListPlane3D(zVec3DList *vl, zPlane3D *p, zVec3D ip[]);
 __END_DECLS
 
 #include <zeo/zeo_col_box.h> /* axis-aligned bounding box (AABB) and oriented bounding box (OBB) */
+#include <zeo/zeo_col_sap.h> /* sweep-and-prune */
+#include <zeo/zeo_col_aabbtree.h> /* dynamic AABB tree */
+#include <zeo/zeo_col_bvh.h> /* static bounding volume hierarchy of polyhedra */
+#include <zeo/zeo_col_obbtree.h> /* OBB tree of polyhedra */
 #include <zeo/zeo_col_minkowski.h> /* Minkowski sum */
+#include <zeo/zeo_col_convex.h> /* convex object with support map */
 #include <zeo/zeo_col_gjk.h> /* Gilbert-Johnson-Keerthi algorithm */
+#include <zeo/zeo_col_prim.h> /* narrow phase between primitive shapes */
 #include <zeo/zeo_col_mpr.h> /* Minkowski Portal Refinement algorithm */
+#include <zeo/zeo_col_contact.h> /* contact manifold */
 #include <zeo/zeo_col_ph.h>  /* polyhedra */
 
 #endif /* __ZEO_COL_H__ */
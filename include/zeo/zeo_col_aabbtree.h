@@ -0,0 +1,125 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_aabbtree - collision checking: dynamic AABB tree.
+ */
+
+#ifndef __ZEO_COL_AABBTREE_H__
+#define __ZEO_COL_AABBTREE_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zAABBTree
+ * dynamic bounding volume hierarchy of axis-aligned boxes
+ * ********************************************************** */
+
+typedef struct{
+  zAABox3D box;  /* fattened box of a leaf, or enclosing box of a branch */
+  int parent;    /* parent node, or the next vacant node */
+  int child[2];  /* child nodes (-1 for a leaf) */
+  int height;    /* height of the subtree (0 for a leaf, -1 for a vacant node) */
+  void *data;    /* user data of a leaf */
+} zAABBTreeNode;
+
+typedef struct{
+  zAABBTreeNode *node; /* node pool */
+  int size;            /* capacity of the pool */
+  int num;             /* number of nodes in use */
+  int root;            /* root node (-1 for an empty tree) */
+  int vacant;          /* head of the list of vacant nodes */
+  double margin;       /* margin to fatten boxes of leaves */
+} zAABBTree;
+
+#define zAABBTreeRoot(t)     (t)->root
+#define zAABBTreeBox(t,id)   ( &(t)->node[(id)].box )
+#define zAABBTreeData(t,id)  (t)->node[(id)].data
+#define zAABBTreeHeight(t)   ( (t)->root < 0 ? 0 : (t)->node[(t)->root].height )
+#define zAABBTreeIsLeaf(t,id) ( (t)->node[(id)].child[0] < 0 )
+
+/*! \brief initialize and destroy a dynamic AABB tree.
+ *
+ * zAABBTreeInit() initializes a dynamic AABB tree \a tree. \a margin
+ * is the margin by which boxes of leaves are fattened.
+ * zAABBTreeDestroy() destroys \a tree.
+ * \return
+ * zAABBTreeInit() returns a pointer \a tree.
+ * zAABBTreeDestroy() returns no value.
+ */
+__EXPORT zAABBTree *zAABBTreeInit(zAABBTree *tree, double margin);
+__EXPORT void zAABBTreeDestroy(zAABBTree *tree);
+
+/*! \brief insert, remove and move an object in a dynamic AABB tree.
+ *
+ * zAABBTreeInsert() inserts an object with an axis-aligned box \a box
+ * and user data \a data into a dynamic AABB tree \a tree. The box is
+ * fattened by the margin of \a tree, and stored in a leaf. The sibling
+ * of the leaf is chosen so as to minimize the increase of surface
+ * areas of ancestors, and the ancestors are rebalanced by rotations.
+ *
+ * zAABBTreeRemove() removes the leaf \a id from \a tree.
+ *
+ * zAABBTreeMove() moves the leaf \a id to a new box \a box. If \a box
+ * is still inside of the fattened box of the leaf, nothing is done.
+ * Otherwise, the leaf is reinserted with a box fattened by the margin
+ * and extended along the displacement \a disp, which is predicted for
+ * the next motion. The null pointer for \a disp means no prediction.
+ *
+ * Nodes are allocated from a pool which grows by doubling, and removed
+ * nodes are recycled.
+ * \return
+ * zAABBTreeInsert() returns the identifier of the leaf, which is valid
+ * until it is removed. If it fails to allocate memory, -1 is returned.
+ * zAABBTreeRemove() returns the false value if \a id is not a leaf.
+ * zAABBTreeMove() returns the true value if the leaf is reinserted,
+ * or the false value otherwise.
+ */
+__EXPORT int zAABBTreeInsert(zAABBTree *tree, zAABox3D *box, void *data);
+__EXPORT bool zAABBTreeRemove(zAABBTree *tree, int id);
+__EXPORT bool zAABBTreeMove(zAABBTree *tree, int id, zAABox3D *box, zVec3D *disp);
+
+/*! \brief queries on a dynamic AABB tree.
+ *
+ * zAABBTreeQuery() finds leaves of a dynamic AABB tree \a tree whose
+ * boxes overlap with an axis-aligned box \a box. For each of them,
+ * \a callback is called with the identifier of the leaf and a private
+ * data \a priv. The query is terminated when \a callback returns the
+ * false value.
+ *
+ * zAABBTreeRayCast() finds leaves whose boxes are hit by a ray from
+ * \a org along \a dir, namely, a segment \a org + t \a dir for 0 <= t
+ * <= \a tmax. For each of them, \a callback is called with the
+ * identifier of the leaf, the ray and the current upper bound of t.
+ * It is supposed to return the parameter t at which the ray hits the
+ * object in the leaf, or the given upper bound if it misses, so that
+ * the ray is clipped for the rest of traversal. Leaves whose boxes are
+ * entered just at the upper bound are still visited, so that \a callback
+ * can break ties, e.g. between objects which contain \a org and are hit
+ * at t = 0. Returning a negative value terminates the query.
+ *
+ * zAABBTreeClosest() finds the leaf which has the closest object from
+ * a point \a p. \a callback is supposed to return the distance from
+ * \a p to the object of a leaf, and is called only for leaves whose
+ * boxes are nearer than the closest object found so far. The distance
+ * is stored in \a dist unless it is the null pointer.
+ *
+ * zAABBTreeQueryTree() finds pairs of leaves of two trees \a tree1
+ * and \a tree2 whose boxes overlap with each other, and calls
+ * \a callback for each pair. If \a tree1 and \a tree2 are the same,
+ * each pair of different leaves is reported once. The query is
+ * terminated when \a callback returns the false value.
+ * \return
+ * zAABBTreeClosest() returns the identifier of the closest leaf, or -1
+ * if \a tree is empty.
+ * The others return no value.
+ */
+__EXPORT void zAABBTreeQuery(zAABBTree *tree, zAABox3D *box, bool (*callback)(int,void*), void *priv);
+__EXPORT void zAABBTreeRayCast(zAABBTree *tree, zVec3D *org, zVec3D *dir, double tmax, double (*callback)(int,zVec3D*,zVec3D*,double,void*), void *priv);
+__EXPORT int zAABBTreeClosest(zAABBTree *tree, zVec3D *p, double (*callback)(int,zVec3D*,void*), void *priv, double *dist);
+__EXPORT void zAABBTreeQueryTree(zAABBTree *tree1, zAABBTree *tree2, bool (*callback)(int,int,void*), void *priv);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_AABBTREE_H__ */
@@ -0,0 +1,290 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_bvh - collision checking: static bounding volume hierarchy of a polyhedron.
+ */
+
+#ifndef __ZEO_COL_BVH_H__
+#define __ZEO_COL_BVH_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zPH3DBVH
+ * static bounding volume hierarchy over triangles of a polyhedron
+ * ********************************************************** */
+
+#define ZEO_PH3D_BVH_LEAF_SIZE 4  /* maximum number of faces in a leaf */
+#define ZEO_PH3D_BVH_DEPTH_MAX 64 /* maximum depth of the hierarchy */
+#define ZEO_PH3D_BVH_REBUILD_RATIO 1.5 /* suggested ratio of costs to rebuild a refitted hierarchy */
+
+typedef struct{
+  zAABox3D box; /* bounding box */
+  int head;     /* the first face of a leaf, or the second child of a branch */
+  int num;      /* number of faces of a leaf (0 for a branch) */
+} zPH3DBVHNode;
+
+typedef struct{
+  zPH3D *ph;          /* polyhedron */
+  int *face;          /* face indices of \a ph arranged by leaves */
+  zPH3DBVHNode *node; /* nodes in depth-first order (the first child of a branch follows it) */
+  int nodenum;        /* number of nodes */
+  int depth;          /* depth of the hierarchy */
+  double cost0;       /* cost of the hierarchy estimated by the surface area heuristic when created */
+  double cost;        /* current cost of the hierarchy */
+} zPH3DBVH;
+
+#define zPH3DBVHNodeNum(b)       (b)->nodenum
+#define zPH3DBVHNode(b,i)        ( &(b)->node[(i)] )
+#define zPH3DBVHDepth(b)         (b)->depth
+#define zPH3DBVHIsLeaf(b,i)      ( (b)->node[(i)].num > 0 )
+#define zPH3DBVHLeafFace(b,i,j)  (b)->face[(b)->node[(i)].head+(j)]
+#define zPH3DBVHCostRatio(b)     ( (b)->cost / (b)->cost0 )
+
+/*! \brief create and destroy a static bounding volume hierarchy of a polyhedron.
+ *
+ * zPH3DBVHInit() initializes a bounding volume hierarchy \a bvh.
+ *
+ * zPH3DBVHCreate() creates a bounding volume hierarchy \a bvh of
+ * axis-aligned boxes over triangles of a polyhedron \a ph. Faces are
+ * split recursively by the surface area heuristic evaluated on 16 bins
+ * of centroids along each axis, until the estimated cost of a split
+ * exceeds that of a leaf with at most ZEO_PH3D_BVH_LEAF_SIZE faces.
+ * Subtrees with many faces are built concurrently by at most \a nthread
+ * threads. Nodes are stored in a flat array in depth-first order, and
+ * each leaf refers to a range of an array of face indices.
+ *
+ * \a bvh refers to \a ph, which has to be kept alive and unmoved while
+ * \a bvh is used.
+ *
+ * zPH3DBVHDestroy() destroys \a bvh. \a ph is not destroyed.
+ * \notes
+ * Subtrees deeper than a half of ZEO_PH3D_BVH_DEPTH_MAX are split at
+ * the median, so that the depth is bounded by ZEO_PH3D_BVH_DEPTH_MAX.
+ * \return
+ * zPH3DBVHInit() returns a pointer \a bvh.
+ * zPH3DBVHCreate() returns a pointer \a bvh if succeeding. If it fails
+ * to allocate memory or \a ph has no faces, the null pointer is returned.
+ * zPH3DBVHDestroy() returns no value.
+ */
+__EXPORT zPH3DBVH *zPH3DBVHInit(zPH3DBVH *bvh);
+__EXPORT zPH3DBVH *zPH3DBVHCreate(zPH3DBVH *bvh, zPH3D *ph, int nthread);
+__EXPORT void zPH3DBVHDestroy(zPH3DBVH *bvh);
+
+/*! \brief refit a bounding volume hierarchy of a polyhedron.
+ *
+ * zPH3DBVHRefit() recomputes boxes of nodes of a bounding volume
+ * hierarchy \a bvh from the current vertices of its polyhedron in a
+ * bottom-up order, keeping the topology. It is supposed to be called
+ * after vertices of the polyhedron are moved in place, e.g. by a
+ * non-rigid deformation. The cost is linear to the number of nodes.
+ * Normal vectors of faces are not updated, which has to be done by
+ * zTri3DCalcNorm() for each face if necessary.
+ *
+ * zPH3DBVHXform() transforms a polyhedron \a src by a frame \a f into
+ * the polyhedron of \a bvh by zPH3DXform(), and refits \a bvh. \a bvh
+ * has to be created for a polyhedron which has the same structure with
+ * \a src, e.g. a clone of \a src.
+ * zPH3DBVHXformInv() transforms \a src by the inverse of \a f in the
+ * same way.
+ *
+ * The cost of the hierarchy estimated by the surface area heuristic
+ * is updated in \a bvh, and zPH3DBVHCostRatio() returns its ratio to
+ * that of the hierarchy when created. Since boxes of a refitted
+ * hierarchy overlap more as the polyhedron deforms, the ratio grows,
+ * and the hierarchy should be created again when it exceeds a certain
+ * threshold (e.g. ZEO_PH3D_BVH_REBUILD_RATIO).
+ * \return
+ * zPH3DBVHRefit(), zPH3DBVHXform() and zPH3DBVHXformInv() return a
+ * pointer \a bvh.
+ * \sa
+ * zPH3DXform, zPH3DXformInv
+ */
+__EXPORT zPH3DBVH *zPH3DBVHRefit(zPH3DBVH *bvh);
+__EXPORT zPH3DBVH *zPH3DBVHXform(zPH3DBVH *bvh, zPH3D *src, zFrame3D *f);
+__EXPORT zPH3DBVH *zPH3DBVHXformInv(zPH3DBVH *bvh, zPH3D *src, zFrame3D *f);
+
+/*! \brief proximity queries on a bounding volume hierarchy of a polyhedron.
+ *
+ * zPH3DBVHClosest() finds the closest point on a polyhedron of a
+ * bounding volume hierarchy \a bvh to a point \a p, and puts it into
+ * \a cp. The index of the face on which the closest point lies is
+ * stored in \a face unless it is the null pointer.
+ *
+ * zPH3DBVHContigVert() finds the vertex of faces of \a bvh contiguous
+ * to \a p. The distance from \a p to the vertex is stored in \a d
+ * unless it is the null pointer.
+ *
+ * Nodes are visited nearer first, and those farther than the closest
+ * one found so far are pruned.
+ * \return
+ * zPH3DBVHClosest() returns the distance from \a p to \a cp.
+ * zPH3DBVHContigVert() returns a pointer to the found vertex.
+ * \sa
+ * zPH3DClosest, zPH3DContigVert
+ */
+__EXPORT double zPH3DBVHClosest(zPH3DBVH *bvh, zVec3D *p, zVec3D *cp, int *face);
+__EXPORT zVec3D *zPH3DBVHContigVert(zPH3DBVH *bvh, zVec3D *p, double *d);
+
+/*! \brief ray casting to a bounding volume hierarchy of a polyhedron.
+ *
+ * zPH3DBVHRayCast() finds the nearest intersection of a ray \a org +
+ * t \a dir (0 <= t <= \a tmax) and faces of a polyhedron of a bounding
+ * volume hierarchy \a bvh. The parameter t at the intersection is
+ * stored in \a t unless it is the null pointer. Both faces and their
+ * back sides are hit by the ray.
+ *
+ * zPH3DBVHRayAnyHit() checks if the ray hits any face of \a bvh. The
+ * query is terminated as soon as a face hit by the ray is found, which
+ * is not necessarily the nearest, and is cheaper than zPH3DBVHRayCast()
+ * for visibility checks.
+ * \return
+ * zPH3DBVHRayCast() returns the index of the face hit by the ray, or -1
+ * if the ray hits nothing.
+ * zPH3DBVHRayAnyHit() returns the index of a face hit by the ray, or -1
+ * if the ray hits nothing.
+ * \sa
+ * zTri3DRayHit, zAABox3DRayHit
+ */
+__EXPORT int zPH3DBVHRayCast(zPH3DBVH *bvh, zVec3D *org, zVec3D *dir, double tmax, double *t);
+__EXPORT int zPH3DBVHRayAnyHit(zPH3DBVH *bvh, zVec3D *org, zVec3D *dir, double tmax);
+
+/*! \brief overlap queries on bounding volume hierarchies of polyhedra.
+ *
+ * zPH3DBVHQueryAABox3D() finds faces of a polyhedron of a bounding
+ * volume hierarchy \a bvh which intersect with an axis-aligned box
+ * \a box, and calls \a callback with the index of each of them and a
+ * private data \a priv. The query is terminated when \a callback
+ * returns the false value.
+ *
+ * zPH3DBVHQueryPair() finds pairs of intersecting faces of polyhedra
+ * of two bounding volume hierarchies \a bvh1 and \a bvh2 by a
+ * simultaneous descent of the two, and calls \a callback with indices
+ * of faces of each pair. The query is terminated when \a callback
+ * returns the false value.
+ *
+ * zPH3DBVHColChk() checks if polyhedra of \a bvh1 and \a bvh2 intersect
+ * with each other on their surfaces. Indices of a pair of intersecting
+ * faces found first are stored in \a face1 and \a face2 unless they are
+ * the null pointers.
+ *
+ * Both polyhedra have to be represented in the same frame.
+ * \notes
+ * Interpenetration of polyhedra one of which is entirely inside of the
+ * other is not detected, since no faces intersect.
+ * \return
+ * zPH3DBVHColChk() returns the true value if the polyhedra intersect,
+ * or the false value otherwise.
+ * The others return no value.
+ */
+__EXPORT void zPH3DBVHQueryAABox3D(zPH3DBVH *bvh, zAABox3D *box, bool (*callback)(int,void*), void *priv);
+__EXPORT void zPH3DBVHQueryPair(zPH3DBVH *bvh1, zPH3DBVH *bvh2, bool (*callback)(int,int,void*), void *priv);
+__EXPORT bool zPH3DBVHColChk(zPH3DBVH *bvh1, zPH3DBVH *bvh2, int *face1, int *face2);
+
+/*! \brief check if points are inside of a polyhedron of a bounding volume hierarchy.
+ *
+ * zPH3DBVHPointIsInside() checks if a point \a p is inside of a closed
+ * polyhedron of a bounding volume hierarchy \a bvh, which is not
+ * necessarily convex. The winding number of the polyhedron around \a p
+ * is counted by signed crossings of a ray from \a p and faces found on
+ * \a bvh, and \a p is regarded as inside if it is not zero. If the ray
+ * passes an edge or a vertex, where a crossing could be counted twice
+ * or missed, it is cast again in another direction.
+ * A point within zTOL from the surface is regarded as inside if \a rim
+ * is the true value, and outside otherwise.
+ *
+ * zPH3DBVHPointIsInsideBatch() checks if \a n points \a p[i]
+ * (i=0,...,\a n-1) are inside of the polyhedron of \a bvh, and sets
+ * \a inside[i] for the result of each. Points are divided into chunks
+ * checked concurrently by at most \a nthread threads.
+ * \notes
+ * Normal vectors of faces have to point outward. The cost of a query is
+ * roughly logarithmic to the number of faces.
+ * \return
+ * zPH3DBVHPointIsInside() returns the true value if \a p is inside of
+ * the polyhedron, or the false value otherwise.
+ * zPH3DBVHPointIsInsideBatch() returns the number of points inside.
+ * \sa
+ * zPH3DPointIsInside
+ */
+__EXPORT bool zPH3DBVHPointIsInside(zPH3DBVH *bvh, zVec3D *p, bool rim);
+__EXPORT int zPH3DBVHPointIsInsideBatch(zPH3DBVH *bvh, zVec3D p[], int n, bool rim, bool inside[], int nthread);
+
+/* ********************************************************** */
+/* CLASS: zMShape3DBVH
+ * two-level bounding volume hierarchy of multiple shapes
+ * ********************************************************** */
+
+typedef struct{
+  zMShape3D *ms;  /* multiple shapes */
+  zAABBTree tree; /* top-level tree over shapes */
+  zPH3DBVH *bvh;  /* bottom-level hierarchies of polyhedral shapes */
+  bool built;     /* flag to check if the hierarchy is up to date */
+} zMShape3DBVH;
+
+#define zMShape3DBVHIsBuilt(b) (b)->built
+
+/*! \brief create and destroy a two-level bounding volume hierarchy of multiple shapes.
+ *
+ * zMShape3DBVHInit() initializes a two-level bounding volume hierarchy
+ * \a mb as a companion of multiple shapes \a ms. The hierarchy is not
+ * built until the first query on \a mb, so that it costs nothing for
+ * shapes which are never queried.
+ *
+ * zMShape3DBVHBuild() builds \a mb explicitly. The top level is a
+ * dynamic AABB tree over axis-aligned bounding boxes of shapes of
+ * \a ms, and the bottom level consists of static bounding volume
+ * hierarchies over triangles of polyhedral shapes. Primitive shapes
+ * are queried analytically at the bottom level.
+ *
+ * zMShape3DBVHReset() discards the hierarchy of \a mb, so that it is
+ * rebuilt at the next query. It has to be called after shapes of \a ms
+ * are moved, added or removed.
+ *
+ * zMShape3DBVHDestroy() destroys \a mb. \a ms is not destroyed.
+ * \return
+ * zMShape3DBVHInit() returns a pointer \a mb.
+ * zMShape3DBVHBuild() returns the true value if succeeding, or the
+ * false value if it fails to allocate memory.
+ * zMShape3DBVHReset() and zMShape3DBVHDestroy() return no value.
+ */
+__EXPORT zMShape3DBVH *zMShape3DBVHInit(zMShape3DBVH *mb, zMShape3D *ms);
+__EXPORT bool zMShape3DBVHBuild(zMShape3DBVH *mb);
+__EXPORT void zMShape3DBVHReset(zMShape3DBVH *mb);
+__EXPORT void zMShape3DBVHDestroy(zMShape3DBVH *mb);
+
+/*! \brief proximity queries on a two-level bounding volume hierarchy of multiple shapes.
+ *
+ * zMShape3DBVHClosest() finds the closest point on multiple shapes of
+ * a two-level bounding volume hierarchy \a mb to a point \a p, and puts
+ * it into \a cp. The index of the shape on which the closest point lies
+ * is stored in \a id unless it is the null pointer. Shapes and faces
+ * are visited nearer first, and those farther than the closest one
+ * found so far at either level are pruned, so that the cost is roughly
+ * logarithmic to the numbers of shapes and faces.
+ *
+ * zMShape3DBVHPointIsInside() checks if \a p is inside of any shape of
+ * \a mb. Only shapes whose bounding boxes contain \a p are checked, and
+ * polyhedral shapes are checked by zPH3DBVHPointIsInside(), so that
+ * non-convex ones are also correctly treated.
+ * If \a rim is the true value, points on the surface are regarded as
+ * inside.
+ *
+ * \a mb is built if it is not yet.
+ * \return
+ * zMShape3DBVHClosest() returns the distance from \a p to \a cp, which
+ * is the same with that returned by zMShape3DClosest(). If \a mb has no
+ * shapes, HUGE_VAL is returned and \a id is set for -1.
+ * zMShape3DBVHPointIsInside() returns the true value if \a p is inside,
+ * or the false value otherwise.
+ * \sa
+ * zMShape3DClosest, zMShape3DPointIsInside
+ */
+__EXPORT double zMShape3DBVHClosest(zMShape3DBVH *mb, zVec3D *p, zVec3D *cp, int *id);
+__EXPORT bool zMShape3DBVHPointIsInside(zMShape3DBVH *mb, zVec3D *p, bool rim);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_BVH_H__ */
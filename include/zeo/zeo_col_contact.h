@@ -0,0 +1,94 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_contact - collision checking: contact manifold.
+ */
+
+#ifndef __ZEO_COL_CONTACT_H__
+#define __ZEO_COL_CONTACT_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zContact3D
+ * contact point of a pair of objects
+ * ********************************************************** */
+
+typedef struct{
+  zVec3D p1, p2;   /* contact points on the surfaces of object 1 and 2 */
+  zVec3D lp1, lp2; /* the above points in the local frames of object 1 and 2 */
+  double depth;    /* penetration depth */
+  double impulse;  /* accumulated normal impulse kept for warm-starting */
+  int life;        /* number of frames for which the point persists */
+} zContact3D;
+
+/* ********************************************************** */
+/* CLASS: zContactManifold3D
+ * contact manifold of a pair of convex objects
+ * ********************************************************** */
+
+#define ZEO_CONTACT_MANIFOLD_SIZE 4
+#define ZEO_CONTACT_MANIFOLD_TOL  1.0e-3
+
+typedef struct{
+  int num;     /* number of contact points */
+  zContact3D cp[ZEO_CONTACT_MANIFOLD_SIZE];
+  zVec3D norm; /* contact normal directed from object 1 to object 2 */
+  double tol;  /* threshold to break a persistent contact point */
+} zContactManifold3D;
+
+#define zContactManifold3DNum(m)     (m)->num
+#define zContactManifold3DNorm(m)    ( &(m)->norm )
+#define zContactManifold3DCP(m,i)    ( &(m)->cp[(i)] )
+#define zContactManifold3DTol(m)     (m)->tol
+#define zContactManifold3DSetTol(m,t) ( (m)->tol = (t) )
+
+/*! \brief contact manifold of a pair of convex objects.
+ *
+ * zContactManifold3DInit() initializes a contact manifold \a m, namely,
+ * empties it and sets the breaking threshold for ZEO_CONTACT_MANIFOLD_TOL.
+ * The threshold is changed by zContactManifold3DSetTol().
+ *
+ * zContactManifold3DPH3D() computes the contact manifold of two convex
+ * polyhedra \a ph1 and \a ph2 located at frames \a f1 and \a f2,
+ * respectively. The null pointer for \a f1 or \a f2 means the identity
+ * frame. zContactManifold3DBox3D() does the same for two boxes \a box1
+ * and \a box2.
+ *
+ * The contact normal is found by the expanding polytope algorithm.
+ * The face most aligned with the normal is chosen from the faces of
+ * both objects as the reference face, and the face of the other object
+ * most anti-parallel to it as the incident face. Coplanar triangles
+ * of a polyhedron are merged into a polygonal face by the stored face
+ * normals. The incident face is clipped by the side planes of the
+ * reference face, and the points under the reference face are taken
+ * as contact points. If more than four points remain, four of them
+ * that span the largest area including the deepest one are kept.
+ *
+ * \a m is persistent over frames. Contact points already stored in
+ * \a m are re-evaluated at the current frames through their local
+ * coordinates, and are discarded if they separate or slide along the
+ * contact plane farther than the breaking threshold. A new point which
+ * is close to a surviving one inherits its accumulated impulse and
+ * life, so that a contact solver can be warm-started. Call
+ * zContactManifold3DInit() beforehand to compute a manifold from
+ * scratch.
+ * \notes
+ * The contact normal \a norm, depth \a d and contact points \a p1 and
+ * \a p2 of each contact satisfy \a p1 - \a p2 = \a d \a norm.
+ * \return
+ * zContactManifold3DInit() returns a pointer \a m.
+ * zContactManifold3DPH3D() and zContactManifold3DBox3D() return the
+ * number of contact points, which is zero if the objects are apart.
+ * \sa
+ * zEPAConvex
+ */
+__EXPORT zContactManifold3D *zContactManifold3DInit(zContactManifold3D *m);
+__EXPORT int zContactManifold3DPH3D(zContactManifold3D *m, zPH3D *ph1, zFrame3D *f1, zPH3D *ph2, zFrame3D *f2);
+__EXPORT int zContactManifold3DBox3D(zContactManifold3D *m, zBox3D *box1, zBox3D *box2);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_CONTACT_H__ */
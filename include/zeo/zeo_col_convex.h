@@ -0,0 +1,98 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_convex - collision checking: convex object with support map.
+ */
+
+#ifndef __ZEO_COL_CONVEX_H__
+#define __ZEO_COL_CONVEX_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zConvex3D
+ * convex object represented by a support map
+ * ********************************************************** */
+
+typedef struct _zConvex3D{
+  zVec3D *vert;      /* vertices of a polytope */
+  int vnum;          /* number of vertices */
+  zPH3DAdj *adj;     /* vertex adjacency of a polytope */
+  zShape3D *shape;   /* primitive shape */
+  int hint;          /* index of the last support vertex (-1 for a shape) */
+  int cache[8];      /* indices of the last support vertices for octants of directions */
+  zFrame3D *f;       /* frame of the object */
+  zVec3D center;     /* an interior point */
+  zVec3D *(*_support)(struct _zConvex3D*,zVec3D*,zVec3D*); /* support map */
+} zConvex3D;
+
+/*! \brief create a convex object.
+ *
+ * zConvex3DPoints() creates a convex object \a c as the convex hull
+ * of a set of points \a p. \a n is the number of points. The support
+ * map is computed by a linear scan of \a p.
+ *
+ * zConvex3DPH3D() creates a convex object \a c from a convex
+ * polyhedron \a ph. If the vertex adjacency \a adj of \a ph is given,
+ * the support map is computed by hill-climbing from the support
+ * vertex previously found for a direction in the same octant, which is
+ * cached in \a c for each of eight octants. Otherwise, it is
+ * computed by a linear scan of vertices. \a adj is created by
+ * zCH3DAdj() or zPH3DAdjCreate().
+ *
+ * zConvex3DShape() creates a convex object \a c from a shape \a shape.
+ * The support map is computed by zShape3DSupportMap(), namely, the
+ * analytic support function of each primitive, so that the shape is
+ * never tessellated. A non-convex polyhedron is dealt with as its
+ * convex hull.
+ *
+ * zConvex3DSetFrame() attaches a frame \a f to \a c. Then, points and
+ * the polyhedron given to \a c are regarded to be described in \a f,
+ * so that \a c can be moved without transforming the vertices.
+ * The null pointer for \a f means the identity frame.
+ *
+ * zConvex3DSupportMap() finds the support point of \a c with respect
+ * to a direction vector \a v, which is put into \a sp.
+ * \notes
+ * \a p, \a ph, \a adj, \a shape and \a f are not copied but referred by \a c,
+ * so that they have to be kept while \a c is used.
+ * \return
+ * zConvex3DPoints(), zConvex3DPH3D() and zConvex3DShape() return a
+ * pointer \a c. zConvex3DShape() returns the null pointer if \a shape
+ * has no support point, e.g. an empty polyhedron or NURBS surface.
+ * zConvex3DSupportMap() returns a pointer \a sp.
+ * \sa
+ * zPH3DAdjSupportMap, zVec3DSupportMap, zShape3DSupportMap
+ */
+__EXPORT zConvex3D *zConvex3DPoints(zConvex3D *c, zVec3D p[], int n);
+__EXPORT zConvex3D *zConvex3DPH3D(zConvex3D *c, zPH3D *ph, zPH3DAdj *adj);
+__EXPORT zConvex3D *zConvex3DShape(zConvex3D *c, zShape3D *shape);
+#define zConvex3DSetFrame(c,frame) ( (c)->f = (frame) )
+#define zConvex3DSupportMap(c,v,sp) (c)->_support( c, v, sp )
+
+/*! \brief center of a convex object.
+ *
+ * zConvex3DCenter() puts an interior point of a convex object \a c
+ * into \a center.
+ * \return
+ * zConvex3DCenter() returns a pointer \a center.
+ */
+__EXPORT zVec3D *zConvex3DCenter(zConvex3D *c, zVec3D *center);
+
+/*! \brief a vertex of a convex object.
+ *
+ * zConvex3DVert() puts the \a i'th vertex of a convex object \a c,
+ * which is transformed by the frame attached to \a c, into \a v.
+ * The index of the support vertex found last is stored in the member
+ * hint of \a c, which is available for \a i to recompute the point.
+ * \return
+ * zConvex3DVert() returns a pointer \a v. If \a c is not made of
+ * vertices or \a i is out of range, the null pointer is returned.
+ */
+__EXPORT zVec3D *zConvex3DVert(zConvex3D *c, int i, zVec3D *v);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_CONVEX_H__ */
@@ -32,6 +32,140 @@ __EXPORT bool zGJKPL(zVec3DList *pl1, zVec3DList *pl2, zVec3D *ca, zVec3D *cb);
 
 __EXPORT bool zGJKPoint(zVec3D pl[], int n, zVec3D *p, zVec3D *c);
 
+/*! \brief Gilbert-Johnson-Keerthi algorithm for convex objects.
+ *
+ * zGJKConvex() finds a pair of the closest points of two convex
+ * objects \a cv1 and \a cv2 in the same way with zGJK(). The pair
+ * of points found are stored in \a c1 and \a c2.
+ *
+ * zGJKDepthConvex() also finds the pair of points. If the objects
+ * intersect, it computes the penetration depth in the same way with
+ * zGJKDepth().
+ *
+ * Each object is represented by a support map. If it is created by
+ * zConvex3DPH3D() with the vertex adjacency, the support map is
+ * computed by hill-climbing from the vertex found in the previous
+ * query, so that the cost hardly depends on the number of vertices.
+ * Since the last support vertices are cached in \a cv1 and \a cv2,
+ * the following check of the same pair is warm-started.
+ * \return
+ * zGJKConvex() and zGJKDepthConvex() return the true value if the
+ * objects intersect. Otherwise, the false value is returned.
+ * \sa
+ * zConvex3DPH3D, zGJK, zGJKDepth
+ */
+__EXPORT bool zGJKConvex(zConvex3D *cv1, zConvex3D *cv2, zVec3D *c1, zVec3D *c2);
+__EXPORT bool zGJKDepthConvex(zConvex3D *cv1, zConvex3D *cv2, zVec3D *c1, zVec3D *c2);
+
+/* ********************************************************** */
+/* CLASS: zGJKCache
+ * cache of GJK algorithm for a pair of convex objects
+ * ********************************************************** */
+
+typedef struct{
+  zConvex3D *cv1, *cv2; /* a pair of convex objects */
+  int n;                /* number of vertices of the last simplex */
+  int i1[4], i2[4];     /* indices of vertices of the objects to form the simplex */
+  zVec3D v;             /* the last proximity vector (separating direction) */
+  int iter;             /* number of iterations in the last query */
+} zGJKCache;
+
+#define zGJKCacheIterNum(c) (c)->iter
+
+/*! \brief GJK algorithm with a cached simplex.
+ *
+ * zGJKCacheCreate() creates a cache \a cache for a pair of convex
+ * objects \a cv1 and \a cv2. It is persistent over queries of the
+ * same pair, e.g., at every control cycle.
+ *
+ * zGJKCacheDestroy() destroys \a cache. Since \a cache does not own
+ * any memory, it just unbinds the pair and discards the cache.
+ *
+ * zGJKCacheCheck() finds a pair of the closest points of the objects
+ * bound to \a cache, which are put into \a c1 and \a c2. The final
+ * simplex is stored in \a cache as indices of the vertices of the
+ * objects together with the proximity vector, and the next query is
+ * seeded from the simplex reconstructed from the vertices at the new
+ * poses of the objects. When the poses move slightly, the query mostly
+ * terminates within one or two iterations. If the objects are shapes,
+ * which are not made of vertices, the query is seeded from the support
+ * point along the cached proximity vector.
+ * zGJKCacheIterNum() is the number of iterations in the last query.
+ * \notes
+ * The vertices of the objects have to be kept while \a cache is used.
+ * Only the frames attached to \a cv1 and \a cv2 may be changed.
+ * \return
+ * zGJKCacheCreate() returns a pointer \a cache.
+ * zGJKCacheCheck() returns the true value if the objects intersect.
+ * Otherwise, the false value is returned.
+ * \sa
+ * zGJKConvex, zConvex3DSetFrame
+ */
+__EXPORT zGJKCache *zGJKCacheCreate(zGJKCache *cache, zConvex3D *cv1, zConvex3D *cv2);
+__EXPORT void zGJKCacheDestroy(zGJKCache *cache);
+__EXPORT bool zGJKCacheCheck(zGJKCache *cache, zVec3D *c1, zVec3D *c2);
+
+/*! \brief Gilbert-Johnson-Keerthi algorithm for shapes.
+ *
+ * zGJKShape() finds a pair of the closest points of two shapes \a s1
+ * and \a s2, which are put into \a c1 and \a c2, respectively.
+ * \a s1 and \a s2 are located at frames \a f1 and \a f2, respectively.
+ * The null pointer for \a f1 or \a f2 means that the shape is not moved.
+ * Each shape is accessed only through the analytic support function of
+ * the primitive, so that it is never converted to a polyhedron.
+ * A non-convex polyhedron is dealt with as its convex hull.
+ * \notes
+ * For a curved surface, the closest points are approached asymptotically.
+ * The iteration stops when the gap between the proximity and the support
+ * point falls below a tolerance relative to the distance, when the
+ * proximity stops approaching, or after Z_MAX_ITER_NUM support queries.
+ * \return
+ * zGJKShape() returns the true value if the shapes intersect, namely, the
+ * origin is enclosed by the simplex on the Minkowski difference.
+ * Otherwise, the false value is returned. An empty shape is regarded
+ * not to intersect with anything, in which case \a c1 and \a c2 are
+ * not modified.
+ * \sa
+ * zConvex3DShape, zShape3DSupportMap, zMPRShape
+ */
+__EXPORT bool zGJKShape(zShape3D *s1, zFrame3D *f1, zShape3D *s2, zFrame3D *f2, zVec3D *c1, zVec3D *c2);
+
+/*! \brief expanding polytope algorithm.
+ *
+ * zEPA() finds the penetration depth of convex hulls of two sets of
+ * points \a p1 and \a p2 by the expanding polytope algorithm (EPA).
+ * \a n1 and \a n2 are the numbers of points of \a p1 and \a p2,
+ * respectively.
+ * The polytope is initialized from the terminal simplex of GJK, and
+ * expanded towards the boundary of Minkowski difference of the two
+ * objects. The face closest to the origin is picked up from a binary
+ * heap of faces allocated in a pool. The expansion stops if the
+ * support point along the normal of the face is farther than the face
+ * by no more than \a tol, or if the number of iterations reaches \a iter.
+ * If zero or a negative value is given for \a tol, zTOL is applied.
+ * If zero is given for \a iter, Z_MAX_ITER_NUM is applied.
+ *
+ * The minimum translation vector is put into \a mtv. The witness
+ * points on the objects are put into \a c1 and \a c2, which satisfy
+ * \a c1 - \a c2 = \a mtv. Namely, the objects are separated by
+ * translating the second object by \a mtv, or the first object by
+ * -\a mtv. The penetration depth is the norm of \a mtv.
+ * If the objects do not intersect, \a mtv is the zero vector, and
+ * \a c1 and \a c2 are the closest points as zGJK() finds.
+ *
+ * zEPAConvex() and zEPAShape() do the same computation for convex
+ * objects \a cv1 and \a cv2 and shapes \a s1 and \a s2 at frames
+ * \a f1 and \a f2, respectively.
+ * \return
+ * zEPA(), zEPAConvex() and zEPAShape() return the true value if the
+ * objects intersect. Otherwise, the false value is returned.
+ * \sa
+ * zGJKDepth, zMPRDepth
+ */
+__EXPORT bool zEPA(zVec3D p1[], int n1, zVec3D p2[], int n2, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2);
+__EXPORT bool zEPAConvex(zConvex3D *cv1, zConvex3D *cv2, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2);
+__EXPORT bool zEPAShape(zShape3D *s1, zFrame3D *f1, zShape3D *s2, zFrame3D *f2, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2);
+
 __END_DECLS
 
 #endif /* __ZEO_COL_GJK_H__ */
@@ -34,6 +34,39 @@ __BEGIN_DECLS
 __EXPORT bool zMPR(zVec3D p1[], int n1, zVec3D p2[], int n2);
 __EXPORT bool zMPRDepth(zVec3D p1[], int n1, zVec3D p2[], int n2, double *depth, zVec3D *pos, zVec3D *dir);
 
+/*! \brief Minkowski Portal Refinement algorithm for convex objects.
+ *
+ * zMPRConvex() and zMPRDepthConvex() are the same with zMPR() and
+ * zMPRDepth(), respectively, except that each object is given as
+ * a convex object \a c1 and \a c2 represented by a support map.
+ * If they are created by zConvex3DPH3D() with the vertex adjacency,
+ * the support map is computed by hill-climbing warm-started from the
+ * vertex found in the previous query.
+ * \return
+ * zMPRConvex() and zMPRDepthConvex() return the true value if the
+ * objects are in collision. Otherwise, the false value is returned.
+ * \sa
+ * zConvex3DPH3D, zMPR, zMPRDepth
+ */
+__EXPORT bool zMPRConvex(zConvex3D *c1, zConvex3D *c2);
+__EXPORT bool zMPRDepthConvex(zConvex3D *c1, zConvex3D *c2, double *depth, zVec3D *pos, zVec3D *dir);
+
+/*! \brief Minkowski Portal Refinement algorithm for shapes.
+ *
+ * zMPRShape() and zMPRDepthShape() are the same with zMPR() and
+ * zMPRDepth(), respectively, except that they check two shapes \a s1
+ * and \a s2 located at frames \a f1 and \a f2. The null pointer for
+ * \a f1 or \a f2 means that the shape is not moved. The shapes are
+ * accessed through zShape3DSupportMap(), and never tessellated.
+ * \return
+ * zMPRShape() and zMPRDepthShape() return the true value if the shapes
+ * are in collision. Otherwise, the false value is returned.
+ * \sa
+ * zConvex3DShape, zGJKShape
+ */
+__EXPORT bool zMPRShape(zShape3D *s1, zFrame3D *f1, zShape3D *s2, zFrame3D *f2);
+__EXPORT bool zMPRDepthShape(zShape3D *s1, zFrame3D *f1, zShape3D *s2, zFrame3D *f2, double *depth, zVec3D *pos, zVec3D *dir);
+
 __END_DECLS
 
 #endif /* __ZEO_COL_MPR_H__ */
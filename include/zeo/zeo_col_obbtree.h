@@ -0,0 +1,109 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_obbtree - collision checking: OBB tree of a polyhedron.
+ */
+
+#ifndef __ZEO_COL_OBBTREE_H__
+#define __ZEO_COL_OBBTREE_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zPH3DOBBTree
+ * hierarchy of oriented bounding boxes over triangles of a polyhedron
+ * ********************************************************** */
+
+#define ZEO_PH3D_OBBTREE_DEPTH_MAX 64 /* maximum depth of the hierarchy */
+
+typedef struct{
+  zBox3D obb; /* oriented bounding box */
+  int head;   /* the face of a leaf, or the second child of a branch */
+  int num;    /* number of faces of a leaf (0 for a branch) */
+} zPH3DOBBTreeNode;
+
+typedef struct{
+  zPH3D *ph;              /* polyhedron */
+  int *face;              /* face indices of \a ph arranged by leaves */
+  zPH3DOBBTreeNode *node; /* nodes in depth-first order (the first child of a branch follows it) */
+  int nodenum;            /* number of nodes */
+  int depth;              /* depth of the hierarchy */
+} zPH3DOBBTree;
+
+#define zPH3DOBBTreeNodeNum(t)       (t)->nodenum
+#define zPH3DOBBTreeNode(t,i)        ( &(t)->node[(i)] )
+#define zPH3DOBBTreeDepth(t)         (t)->depth
+#define zPH3DOBBTreeIsLeaf(t,i)      ( (t)->node[(i)].num > 0 )
+#define zPH3DOBBTreeLeafFace(t,i,j)  (t)->face[(t)->node[(i)].head+(j)]
+
+/*! \brief create and destroy an OBB tree of a polyhedron.
+ *
+ * zPH3DOBBTreeInit() initializes an OBB tree \a tree.
+ *
+ * zPH3DOBBTreeCreate() creates a hierarchy of oriented bounding boxes
+ * \a tree over triangles of a polyhedron \a ph in the same way with
+ * RAPID. Axes of the box of each node are the principal axes of the
+ * area-weighted covariance of its triangles, and the triangles are
+ * split at their mean along the longest axis of the box, until each
+ * leaf has a single triangle. Boxes are slightly inflated so that
+ * coplanar triangles are checked conservatively.
+ *
+ * \a tree refers to \a ph, which has to be kept alive and unmoved while
+ * \a tree is used. Coordinates of \a ph are those in the frame of the
+ * polyhedron, which is posed in queries.
+ *
+ * zPH3DOBBTreeDestroy() destroys \a tree. \a ph is not destroyed.
+ * \notes
+ * Subtrees deeper than a half of ZEO_PH3D_OBBTREE_DEPTH_MAX, and those
+ * whose triangles lie on one side of the mean, are split at the median,
+ * so that the depth is bounded by ZEO_PH3D_OBBTREE_DEPTH_MAX.
+ * \return
+ * zPH3DOBBTreeInit() returns a pointer \a tree.
+ * zPH3DOBBTreeCreate() returns a pointer \a tree if succeeding. If it
+ * fails to allocate memory or \a ph has no faces, the null pointer is
+ * returned.
+ * zPH3DOBBTreeDestroy() returns no value.
+ * \sa
+ * zPH3DBVHCreate
+ */
+__EXPORT zPH3DOBBTree *zPH3DOBBTreeInit(zPH3DOBBTree *tree);
+__EXPORT zPH3DOBBTree *zPH3DOBBTreeCreate(zPH3DOBBTree *tree, zPH3D *ph);
+__EXPORT void zPH3DOBBTreeDestroy(zPH3DOBBTree *tree);
+
+/*! \brief overlap queries on OBB trees of posed polyhedra.
+ *
+ * zPH3DOBBTreeQueryPair() finds pairs of intersecting faces of two
+ * polyhedra of OBB trees \a tree1 and \a tree2 posed at frames \a f1
+ * and \a f2, respectively, and calls \a callback with indices of faces
+ * of each pair and a private data \a priv. The query is terminated when
+ * \a callback returns the false value. The two trees are descended
+ * simultaneously, where a pair of nodes is pruned if their boxes are
+ * separated along any of fifteen axes by zColChkBox3D(). The larger
+ * box is split first.
+ *
+ * zPH3DOBBTreeColChk() checks if the two posed polyhedra intersect
+ * with each other on their surfaces. Indices of a pair of intersecting
+ * faces found first are stored in \a face1 and \a face2 unless they are
+ * the null pointers.
+ *
+ * Only the relative pose of the two polyhedra matters, which is
+ * computed once for each query, so that neither the polyhedra nor the
+ * trees have to be transformed.
+ * \notes
+ * Interpenetration of polyhedra one of which is entirely inside of the
+ * other is not detected, since no faces intersect.
+ * \return
+ * zPH3DOBBTreeColChk() returns the true value if the polyhedra intersect,
+ * or the false value otherwise.
+ * zPH3DOBBTreeQueryPair() returns no value.
+ * \sa
+ * zPH3DBVHQueryPair, zPH3DBVHColChk
+ */
+__EXPORT void zPH3DOBBTreeQueryPair(zPH3DOBBTree *tree1, zFrame3D *f1, zPH3DOBBTree *tree2, zFrame3D *f2, bool (*callback)(int,int,void*), void *priv);
+__EXPORT bool zPH3DOBBTreeColChk(zPH3DOBBTree *tree1, zFrame3D *f1, zPH3DOBBTree *tree2, zFrame3D *f2, int *face1, int *face2);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_OBBTREE_H__ */
@@ -0,0 +1,68 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_prim - collision checking: narrow phase between primitive shapes.
+ */
+
+#ifndef __ZEO_COL_PRIM_H__
+#define __ZEO_COL_PRIM_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief closest points of edges and capsules.
+ *
+ * zEdge3DClosestPair() finds a pair of the closest points of two edges
+ * \a e1 and \a e2, and puts them into \a c1 and \a c2, respectively.
+ * Parallel and degenerated edges are also dealt with.
+ *
+ * zCapsule3DClosestPair() finds a pair of the closest points of two
+ * capsules, namely, sphere-swept edges. The capsules are swept from
+ * \a e1 and \a e2 by spheres with radii \a r1 and \a r2, respectively.
+ * If they intersect, a point in the intersection is put into both \a c1
+ * and \a c2.
+ * \return
+ * zEdge3DClosestPair() returns the distance between \a c1 and \a c2.
+ * zCapsule3DClosestPair() returns the true value if the capsules
+ * intersect, or the false value otherwise.
+ */
+__EXPORT double zEdge3DClosestPair(zEdge3D *e1, zEdge3D *e2, zVec3D *c1, zVec3D *c2);
+__EXPORT bool zCapsule3DClosestPair(zEdge3D *e1, double r1, zEdge3D *e2, double r2, zVec3D *c1, zVec3D *c2);
+
+/*! \brief narrow phase collision checking between primitive shapes.
+ *
+ * zColChkShape3D() checks if two shapes \a s1 and \a s2 intersect with
+ * each other.
+ *
+ * zShape3DClosestPair() finds a pair of the closest points of \a s1
+ * and \a s2, and puts them into \a c1 and \a c2, respectively. If the
+ * shapes intersect, a point in the intersection is put into both \a c1
+ * and \a c2.
+ *
+ * zShape3DDist() computes the distance between \a s1 and \a s2.
+ *
+ * The query is dispatched through a table indexed by the types of the
+ * shapes to a specialized routine, which is
+ *  - closed-form for sphere-sphere,
+ *  - the closest point of the other shape to the center for
+ *    sphere-box, sphere-cylinder and sphere-ellipsoid,
+ *  - the separating axis test on 15 axes for the intersection of
+ *    box-box, while the closest points of them are found by GJK.
+ * The other pairs are dealt with by zGJKShape(), which treats a
+ * polyhedron as its convex hull.
+ * \return
+ * zColChkShape3D() and zShape3DClosestPair() return the true value if
+ * the shapes intersect, or the false value otherwise.
+ * zShape3DDist() returns the distance between the shapes, which is
+ * zero if they intersect.
+ * \sa
+ * zGJKShape
+ */
+__EXPORT bool zColChkShape3D(zShape3D *s1, zShape3D *s2);
+__EXPORT bool zShape3DClosestPair(zShape3D *s1, zShape3D *s2, zVec3D *c1, zVec3D *c2);
+__EXPORT double zShape3DDist(zShape3D *s1, zShape3D *s2);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_PRIM_H__ */
@@ -0,0 +1,114 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_sap - collision checking: sweep-and-prune broad phase.
+ */
+
+#ifndef __ZEO_COL_SAP_H__
+#define __ZEO_COL_SAP_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zSAP
+ * incremental sweep-and-prune over axis-aligned boxes
+ * ********************************************************** */
+
+typedef struct{
+  double val; /* coordinate of the endpoint */
+  int data;   /* twice the identifier of a box, plus one for a maximum endpoint */
+} zSAPEndpoint;
+
+typedef struct{
+  int i, j; /* identifiers of boxes (i < j) */
+} zSAPPair;
+
+typedef struct{
+  int num, size;
+  zSAPPair *buf;
+} zSAPPairList;
+
+typedef struct{
+  int num, size;      /* number of box slots and capacity */
+  zAABox3D *box;      /* boxes */
+  bool *alive;        /* flags of boxes in use */
+  int *vacant, vnum;  /* stack of vacant identifiers */
+  int pending;        /* number of boxes added since the last update */
+  int epnum;          /* number of endpoints on each axis */
+  zSAPEndpoint *ep[3];/* sorted endpoints on each axis */
+  zSAPPairList pair;  /* overlapping pairs */
+  int *hash, hsize, hused; /* hash table of overlapping pairs */
+  zSAPPairList added;   /* pairs which began to overlap */
+  zSAPPairList removed; /* pairs which ceased to overlap */
+  bool flushed;       /* flag to clear the above lists */
+} zSAP;
+
+#define zSAPPairNum(s)     (s)->pair.num
+#define zSAPPair(s,k)      ( &(s)->pair.buf[(k)] )
+#define zSAPAddedNum(s)    (s)->added.num
+#define zSAPAdded(s,k)     ( &(s)->added.buf[(k)] )
+#define zSAPRemovedNum(s)  (s)->removed.num
+#define zSAPRemoved(s,k)   ( &(s)->removed.buf[(k)] )
+#define zSAPBox(s,id)      ( &(s)->box[(id)] )
+
+/*! \brief sweep-and-prune broad phase.
+ *
+ * zSAPInit() initializes a sweep-and-prune structure \a sap.
+ * zSAPDestroy() destroys \a sap.
+ *
+ * zSAPAdd() adds an axis-aligned box \a box to \a sap, which is
+ * copied. zSAPRemove() removes the box identified by \a id from \a sap.
+ * Pairs of the removed box are immediately reported as removed ones.
+ * zSAPMove() replaces the box identified by \a id with \a box.
+ *
+ * zSAPUpdate() updates the overlapping pairs of boxes in \a sap. The
+ * endpoints of boxes are kept sorted along x, y and z axes, and are
+ * re-sorted by insertion sort, which runs in nearly linear time when
+ * boxes move only a little between updates. A pair of boxes is
+ * examined only when their endpoints are swapped, so that pairs which
+ * began or ceased to overlap since the last update are found without
+ * checking all pairs. When many boxes are added at once, the endpoints
+ * are sorted from scratch instead.
+ *
+ * The overlapping pairs are accessed by zSAPPairNum() and zSAPPair().
+ * The pairs which began to overlap and those which ceased to overlap
+ * since the last update are accessed by zSAPAddedNum(), zSAPAdded(),
+ * zSAPRemovedNum() and zSAPRemoved(). They are net changes, i.e., a
+ * pair which ceased and began to overlap again, e.g., through an
+ * identifier reused by zSAPAdd(), is not reported. Identifiers in a
+ * pair are in ascending order.
+ *
+ * zSAPCreateMShape3D() creates \a sap for the shapes of multiple shapes
+ * \a ms, where the identifier of each box is the index of the shape.
+ * The axis-aligned box of each shape is computed by zShape3DToAABox3D().
+ * zSAPUpdateMShape3D() recomputes the boxes of shapes in \a ms, which
+ * are supposed to be moved, and updates \a sap.
+ * \notes
+ * Boxes touching each other are not regarded to overlap, in the same
+ * manner with zColChkAABox3D().
+ * \return
+ * zSAPInit() returns a pointer \a sap.
+ * zSAPAdd() returns the identifier of the added box, or -1 if it fails
+ * to allocate memory.
+ * zSAPRemove() and zSAPMove() return the false value if \a id is invalid.
+ * zSAPUpdate(), zSAPCreateMShape3D() and zSAPUpdateMShape3D() return
+ * the false value if they fail to allocate memory.
+ * Otherwise, the true value is returned.
+ * \sa
+ * zColChkAABox3D, zShape3DToAABox3D
+ */
+__EXPORT zSAP *zSAPInit(zSAP *sap);
+__EXPORT void zSAPDestroy(zSAP *sap);
+__EXPORT int zSAPAdd(zSAP *sap, zAABox3D *box);
+__EXPORT bool zSAPRemove(zSAP *sap, int id);
+__EXPORT bool zSAPMove(zSAP *sap, int id, zAABox3D *box);
+__EXPORT bool zSAPUpdate(zSAP *sap);
+
+__EXPORT bool zSAPCreateMShape3D(zSAP *sap, zMShape3D *ms);
+__EXPORT bool zSAPUpdateMShape3D(zSAP *sap, zMShape3D *ms);
+
+__END_DECLS
+
+#endif /* __ZEO_COL_SAP_H__ */
@@ -0,0 +1,157 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_dq - unit dual quaternion for rigid transformation.
+ */
+
+#ifndef __ZEO_DQ_H__
+#define __ZEO_DQ_H__
+
+#include <zeo/zeo_ep.h>
+#include <zeo/zeo_frame.h>
+
+__BEGIN_DECLS
+
+/*! \struct zDQ
+ * \brief unit dual quaternion.
+ *
+ * A rigid transformation which rotates a point by an Euler parameter
+ * r and then translates it by p is represented by a dual quaternion
+ * r + epsilon d, where d = 1/2 p r (p is regarded as a quaternion
+ * with the zero scalar part).
+ */
+typedef union{
+  struct{
+    zEP r; /*!< real part (rotation) */
+    zEP d; /*!< dual part (translation) */
+  } q;
+  double e[8];
+} zDQ;
+
+#define zDQReal(dq) ( &(dq)->q.r )
+#define zDQDual(dq) ( &(dq)->q.d )
+
+/*! \brief create, copy and convert a unit dual quaternion.
+ *
+ * zDQCreate() creates a unit dual quaternion \a dq which represents
+ * a rotation by an Euler parameter \a ep followed by a translation
+ * \a pos.
+ *
+ * zDQIdent() creates a dual quaternion for the identity transformation.
+ *
+ * zDQCopy() copies a dual quaternion \a src to \a dest.
+ *
+ * zDQPos() abstracts the translation vector of \a dq and puts it into
+ * \a pos.
+ *
+ * zDQFromFrame3D() converts a 3D frame \a f to the equivalent dual
+ * quaternion \a dq.
+ *
+ * zDQToFrame3D() converts a dual quaternion \a dq to the equivalent 3D
+ * frame \a f.
+ * \return
+ * zDQCreate(), zDQIdent() and zDQFromFrame3D() return a pointer \a dq.
+ * zDQPos() returns a pointer \a pos.
+ * zDQToFrame3D() returns a pointer \a f.
+ * zDQFromFrame3D() returns the null pointer if the attitude matrix of
+ * \a f is not orthonormal.
+ */
+__EXPORT zDQ *zDQCreate(zDQ *dq, zEP *ep, zVec3D *pos);
+__EXPORT zDQ *zDQIdent(zDQ *dq);
+#define zDQCopy(s,d)  zCopy( zDQ, (s), (d) )
+__EXPORT zVec3D *zDQPos(zDQ *dq, zVec3D *pos);
+__EXPORT zDQ *zDQFromFrame3D(zDQ *dq, zFrame3D *f);
+__EXPORT zFrame3D *zDQToFrame3D(zDQ *dq, zFrame3D *f);
+
+/*! \brief normalize a dual quaternion.
+ *
+ * zDQNormalize() directly normalizes a dual quaternion \a dq so that
+ * the real part is a unit quaternion and the dual part is orthogonal
+ * to the real part. Since a unit dual quaternion has only two
+ * constraints in contrast to the six of an attitude matrix, it is
+ * cheap to remove numerical drift from long cascades.
+ * \return
+ * zDQNormalize() returns a pointer \a dq, or the null pointer if the
+ * real part of \a dq is zero.
+ */
+__EXPORT zDQ *zDQNormalize(zDQ *dq);
+
+/*! \brief inverse and cascaded transformations of a dual quaternion.
+ *
+ * zDQInv() calculates the inverse transformation of a unit dual
+ * quaternion \a dq, which is the quaternion conjugate of \a dq.
+ * The result is put into \a dqi.
+ *
+ * zDQCascade() cascades a dual quaternion \a dq1 to the other \a dq2
+ * in the same manner with zFrame3DCascade(). Namely, suppose \a dq1 is
+ * the transformation from a frame S1 to another S0, and \a dq2 is that
+ * from S2 to S1, the result \a dq is the transformation from S2 to S0.
+ *
+ * zDQXform() calculates the transformation \a dq from \a dq1 to \a dq2
+ * in the same manner with zFrame3DXform(), namely, the cascade of the
+ * inverse of \a dq1 and \a dq2.
+ * \return
+ * zDQInv(), zDQCascade() and zDQXform() return a pointer to the result.
+ * \notes
+ * It is allowed to let the result point to the same address with the
+ * arguments.
+ */
+__EXPORT zDQ *zDQInv(zDQ *dq, zDQ *dqi);
+__EXPORT zDQ *zDQCascade(zDQ *dq1, zDQ *dq2, zDQ *dq);
+__EXPORT zDQ *zDQXform(zDQ *dq1, zDQ *dq2, zDQ *dq);
+
+/*! \brief transform coordinates of a 3D vector by a dual quaternion.
+ *
+ * zXform3DDQ() transforms a 3D vector \a v by a unit dual quaternion
+ * \a dq and puts the result into \a tv, in the same manner with
+ * zXform3D().
+ *
+ * zXform3DInvDQ() transforms \a v by the inverse of \a dq and puts the
+ * result into \a tv, in the same manner with zXform3DInv().
+ * \return
+ * zXform3DDQ() and zXform3DInvDQ() return a pointer \a tv.
+ */
+__EXPORT zVec3D *zXform3DDQ(zDQ *dq, zVec3D *v, zVec3D *tv);
+__EXPORT zVec3D *zXform3DInvDQ(zDQ *dq, zVec3D *v, zVec3D *tv);
+
+/*! \brief interpolation and blending of dual quaternions.
+ *
+ * zDQInterDiv() calculates the interior division of two unit dual
+ * quaternions \a dq1 and \a dq2 in accordance with the screw linear
+ * interpolation (ScLERP), namely, the transformation moves along the
+ * screw motion from \a dq1 to \a dq2 with a constant velocity. \a t is
+ * the dividing ratio, which is regularly chosen within the range from
+ * 0 to 1. When \a t is out of the range, it computes the outer
+ * division for extrapolation. The result is put into \a dq.
+ *
+ * zDQBlend() computes the dual quaternion linear blending (DLB proposed
+ * by L. Kavan et al., 2008) of \a n unit dual quaternions \a dq with
+ * weights \a w, namely, the normalized weighted sum of them. Each of
+ * \a dq is flipped to the same hemisphere with the first one. The
+ * result is put into \a dqb.
+ * \return
+ * zDQInterDiv() returns a pointer \a dq.
+ * zDQBlend() returns a pointer \a dqb, or the null pointer if the
+ * weighted sum degenerates.
+ * \sa
+ * zEPInterDiv
+ */
+__EXPORT zDQ *zDQInterDiv(zDQ *dq1, zDQ *dq2, double t, zDQ *dq);
+__EXPORT zDQ *zDQBlend(zDQ dq[], double w[], int n, zDQ *dqb);
+
+/*! \brief print a dual quaternion.
+ *
+ * zDQFPrint() prints a dual quaternion \a dq to the current position
+ * of a file \a fp in the following format.
+ *  r0 { r1, r2, r3 }
+ *  d0 { d1, d2, d3 }
+ * zDQPrint() prints \a dq out to the standard output.
+ * \return
+ * zDQFPrint() and zDQPrint() return no value.
+ */
+__EXPORT void zDQFPrint(FILE *fp, zDQ *dq);
+#define zDQPrint(dq) zDQFPrint( stdout, dq )
+
+__END_DECLS
+
+#endif /* __ZEO_DQ_H__ */
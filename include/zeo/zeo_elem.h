@@ -318,6 +318,19 @@ __EXPORT bool zTri3DPointIsInside(zTri3D *t, zVec3D *v, bool rim);
 __EXPORT double zTri3DLinScale(zTri3D *t, zVec3D *p, double *l0, double *l1, double *l2, zVec3D *cp);
 __EXPORT double zTri3DClosest(zTri3D *t, zVec3D *v, zVec3D *cp);
 
+/*! \brief intersection of a ray and a 3D triangle.
+ *
+ * zTri3DRayHit() checks if a ray \a org + t \a dir (0 <= t <= \a tmax)
+ * intersects with a triangle \a tri by Moller-Trumbore's algorithm.
+ * Both the front and back sides of \a tri are hit by the ray. The
+ * parameter t at the intersection is stored in \a t unless it is the
+ * null pointer.
+ * \return
+ * zTri3DRayHit() returns the true value if the ray hits \a tri, or
+ * the false value otherwise. A ray parallel to \a tri does not hit it.
+ */
+__EXPORT bool zTri3DRayHit(zTri3D *tri, zVec3D *org, zVec3D *dir, double tmax, double *t);
+
 /*! \brief volume, inertia, barycenter and circumcenter of cone.
  *
  * zTri3DConeVolume() calculates the volume of a cone which consists
@@ -65,6 +65,23 @@ __EXPORT bool zEPIsIdent(zEP *ep);
  */
 __EXPORT zVec3D *zEP2AA(zEP *ep, zVec3D *aa);
 __EXPORT zEP *zAA2EP(zVec3D *aa, zEP *ep);
+#define _zMat3DFromEP(m,ep) do{\
+  double __e00, __e11, __e22, __e33, __e12, __e23, __e31, __e01, __e02, __e03;\
+  __e00 = zSqr((ep)->e[0]);\
+  __e11 = zSqr((ep)->e[1]);\
+  __e22 = zSqr((ep)->e[2]);\
+  __e33 = zSqr((ep)->e[3]);\
+  __e12 = (ep)->e[1] * (ep)->e[2];\
+  __e23 = (ep)->e[2] * (ep)->e[3];\
+  __e31 = (ep)->e[3] * (ep)->e[1];\
+  __e01 = (ep)->e[0] * (ep)->e[1];\
+  __e02 = (ep)->e[0] * (ep)->e[2];\
+  __e03 = (ep)->e[0] * (ep)->e[3];\
+  _zMat3DCreate( m,\
+    __e00+__e11-__e22-__e33,       2*(__e12-__e03),       2*(__e31+__e02),\
+          2*(__e12+__e03), __e00-__e11+__e22-__e33,       2*(__e23-__e01),\
+          2*(__e31-__e02),       2*(__e23+__e01), __e00-__e11-__e22+__e33 );\
+} while(0)
 __EXPORT zMat3D *zMat3DFromEP(zMat3D *m, zEP *ep);
 __EXPORT zEP *zMat3DToEP(zMat3D *m, zEP *ep);
 
@@ -92,6 +109,14 @@ __EXPORT zVec3D *zEPRotVec3D(zEP *ep, zVec3D *v, zVec3D *rv);
  * zEPVel2AngVel() returns a pointer \a angvel.
  * zAngVel2EPVel() returns a pointer \a epvel.
  */
+#define _zEPVel2AngVel(epvel,ep,angvel) do{\
+  double __x, __y, __z;\
+  __zVec3DOuterProd( &(ep)->ex.v, &(epvel)->ex.v, __x, __y, __z );\
+  __x += (ep)->ex.w * (epvel)->ex.v.c.x - (epvel)->ex.w * (ep)->ex.v.c.x;\
+  __y += (ep)->ex.w * (epvel)->ex.v.c.y - (epvel)->ex.w * (ep)->ex.v.c.y;\
+  __z += (ep)->ex.w * (epvel)->ex.v.c.z - (epvel)->ex.w * (ep)->ex.v.c.z;\
+  _zVec3DCreate( angvel, 2*__x, 2*__y, 2*__z );\
+} while(0)
 __EXPORT zVec3D *zEPVel2AngVel(zEP *epvel, zEP *ep, zVec3D *angvel);
 __EXPORT zEP *zAngVel2EPVel(zVec3D *angvel, zEP *ep, zEP *epvel);
 
@@ -161,6 +186,23 @@ __EXPORT zEP *zEPCascade(zEP *e1, zEP *e2, zEP *e);
  */
 __EXPORT zEP *zEPInterDiv(zEP *ep1, zEP *ep2, double t, zEP *ep);
 
+/*! \brief normalized linear interpolation of Euler parameter.
+ *
+ * zEPInterDivNL() calculates the interior division of two Euler parameters
+ * \a ep1 and \a ep2 in accordance with the normalized linear interpolation
+ * (NLERP), namely, the linear interpolation of the four components followed
+ * by normalization. \a t is the dividing ratio. The result is put into \a ep.
+ *
+ * NLERP does not keep the angular velocity constant in contrast to SLERP,
+ * while it is much cheaper since no trigonometric functions are evaluated.
+ * It is a good approximation of SLERP when \a ep1 and \a ep2 are close.
+ * \return
+ * zEPInterDivNL() returns a pointer \a ep.
+ * \sa
+ * zEPInterDiv
+ */
+__EXPORT zEP *zEPInterDivNL(zEP *ep1, zEP *ep2, double t, zEP *ep);
+
 /*! \brief interior division of two attitude matrices for SLERP.
  *
  * zMat3DInterDiv() calculates the interior division of two 3x3 attitude
@@ -176,6 +218,47 @@ __EXPORT zEP *zEPInterDiv(zEP *ep1, zEP *ep2, double t, zEP *ep);
  */
 __EXPORT zMat3D *zMat3DInterDiv(zMat3D *m1, zMat3D *m2, double t, zMat3D *m);
 
+/*! \brief batch conversion and interpolation of Euler parameters.
+ *
+ * The following functions apply the corresponding scalar operations to
+ * arrays of Euler parameters, attitude matrices and 3D vectors of size
+ * \a n element by element, where the i-th output is computed only from
+ * the i-th inputs.
+ *
+ * zEPInterDivArray() and zEPInterDivNLArray() compute SLERP and NLERP of
+ * \a ep1[i] and \a ep2[i] with a dividing ratio \a t[i], respectively,
+ * and put the results into \a ep[i]. Unlike zEPInterDiv(), they do not
+ * modify \a ep2 to choose the shorter path.
+ *
+ * zMat3DFromEPArray() converts \a ep[i] to attitude matrices \a m[i].
+ *
+ * zMat3DToEPArray() converts attitude matrices \a m[i] to \a ep[i].
+ *
+ * zEPVel2AngVelArray() converts derivatives of Euler parameters \a epvel[i]
+ * at the attitudes \a ep[i] to angular velocities \a angvel[i].
+ * \notes
+ * The arrays are processed by blocks in a few passes. The arithmetic
+ * passes are straight-line loops with selects in place of branches, so
+ * that the compiler can vectorize them, where attitude matrices are
+ * transposed to a structure of arrays in a block. Only the square roots
+ * and the trigonometric functions in SLERP are evaluated in scalar
+ * loops, since they may set errno. It is allowed to let the output
+ * array point to the same address with one of the input arrays.
+ * \return
+ * zEPInterDivArray() and zEPInterDivNLArray() return a pointer \a ep.
+ * zMat3DFromEPArray() returns a pointer \a m.
+ * zMat3DToEPArray() returns a pointer \a ep, or the null pointer if one
+ * of \a m is not an attitude matrix.
+ * zEPVel2AngVelArray() returns a pointer \a angvel.
+ * \sa
+ * zEPInterDiv, zEPInterDivNL, zMat3DFromEP, zMat3DToEP, zEPVel2AngVel
+ */
+__EXPORT zEP *zEPInterDivArray(zEP ep1[], zEP ep2[], double t[], int n, zEP ep[]);
+__EXPORT zEP *zEPInterDivNLArray(zEP ep1[], zEP ep2[], double t[], int n, zEP ep[]);
+__EXPORT zMat3D *zMat3DFromEPArray(zMat3D m[], zEP ep[], int n);
+__EXPORT zEP *zMat3DToEPArray(zMat3D m[], zEP ep[], int n);
+__EXPORT zVec3D *zEPVel2AngVelArray(zEP epvel[], zEP ep[], zVec3D angvel[], int n);
+
 /*! \brief print Euler parameter.
  *
  * zEPFPrint() prints Euler parameter to the current position of
@@ -80,6 +80,13 @@
 
 #define ZEO_ERR_MAP_UNSPEC   "map type unspecified."
 
+#define ZEO_ERR_SAP_SIZMIS   "size mismatch of boxes and shapes"
+
+#define ZEO_ERR_PCD_SIZMIS   "number of points %d is not a multiple of width %d"
+#define ZEO_ERR_RANGESENSOR_INVSIZ "invalid resolution of a range sensor"
+
+#define ZEO_ERR_SDF_INVPITCH "non-positive pitch or band of a signed distance field"
+
 #define ZEO_ERR_FATAL        "fatal error! - please report to the author"
 
 /* warning messages */
@@ -108,4 +115,7 @@
 
 #define ZEO_WARN_MAPNET_EMPTY     "empty map net assigned."
 
+#define ZEO_WARN_SAP_INVALID_ID   "%d: invalid identifier of a box"
+#define ZEO_WARN_AABBTREE_INVALID_ID "%d: invalid identifier of a leaf"
+
 #endif /* __ZEO_ERRMSG_H__ */
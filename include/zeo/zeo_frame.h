@@ -110,9 +110,76 @@ __EXPORT zVec3D *zXform3DInv(zFrame3D *f, zVec3D *v, zVec3D *tv);
 #define zXform3DInvDRC(f,v) zXform3DInv(f,v,v)
 
 /*! \brief transform a 6D vector.
+ *
+ * A 3D frame \a f is also regarded as a compact representation of the
+ * spatial (6x6) transformation matrix with only 12 values. Suppose \a f
+ * is for the transformation from a frame S1 to S0.
+ *
+ * zXform6DLin() transforms a velocity-type 6D vector \a v at the
+ * original point of S0 with respect to S0 to that at the original point
+ * of S1 with respect to S1, namely:
+ *  vc_lin = R^T ( v_lin + v_ang x p )
+ *  vc_ang = R^T v_ang
+ * where R and p are the attitude matrix and the position vector of \a f.
+ *
+ * zXform6DAng() transforms a force-type 6D vector \a v which works at
+ * the original point of S1 with respect to S1 to that which works at the
+ * original point of S0 with respect to S0, namely:
+ *  vc_lin = R v_lin
+ *  vc_ang = R v_ang + p x R v_lin
+ * It is the transpose of the transformation by zXform6DLin().
+ *
+ * zXform6DLinInv() and zXform6DAngInv() are the inverse transformations
+ * of zXform6DLin() and zXform6DAng(), respectively.
+ *
+ * zXform6DLinArray(), zXform6DAngArray(), zXform6DLinInvArray() and
+ * zXform6DAngInvArray() transform each of \a n 6D vectors \a v[i] by
+ * \a f[i] in the same manners with the above, and put the results into
+ * \a vc[i].
+ *
+ * None of them builds the 6x6 matrix, which costs 36 multiplications
+ * per vector in addition to the matrix construction.
+ * \return
+ * Each function returns a pointer to the result.
+ * \notes
+ * It is allowed to let \a vc point to the same address with \a v.
  */
+#define _zXform6DLin(f,v,vc) do{\
+  zVec3D __tmp;\
+  _zVec3DOuterProd( zVec6DAng(v), zFrame3DPos(f), &__tmp );\
+  _zVec3DAddDRC( &__tmp, zVec6DLin(v) );\
+  _zMulMat3DTVec3D( zFrame3DAtt(f), zVec6DAng(v), zVec6DAng(vc) );\
+  _zMulMat3DTVec3D( zFrame3DAtt(f), &__tmp, zVec6DLin(vc) );\
+} while(0)
+#define _zXform6DAng(f,v,vc) do{\
+  zVec3D __tmp;\
+  _zMulMat3DVec3D( zFrame3DAtt(f), zVec6DLin(v), zVec6DLin(vc) );\
+  _zMulMat3DVec3D( zFrame3DAtt(f), zVec6DAng(v), zVec6DAng(vc) );\
+  _zVec3DOuterProd( zFrame3DPos(f), zVec6DLin(vc), &__tmp );\
+  _zVec3DAddDRC( zVec6DAng(vc), &__tmp );\
+} while(0)
+#define _zXform6DLinInv(f,v,vc) do{\
+  zVec3D __tmp;\
+  _zMulMat3DVec3D( zFrame3DAtt(f), zVec6DAng(v), zVec6DAng(vc) );\
+  _zMulMat3DVec3D( zFrame3DAtt(f), zVec6DLin(v), zVec6DLin(vc) );\
+  _zVec3DOuterProd( zFrame3DPos(f), zVec6DAng(vc), &__tmp );\
+  _zVec3DAddDRC( zVec6DLin(vc), &__tmp );\
+} while(0)
+#define _zXform6DAngInv(f,v,vc) do{\
+  zVec3D __tmp;\
+  _zVec3DOuterProd( zFrame3DPos(f), zVec6DLin(v), &__tmp );\
+  _zVec3DSub( zVec6DAng(v), &__tmp, &__tmp );\
+  _zMulMat3DTVec3D( zFrame3DAtt(f), zVec6DLin(v), zVec6DLin(vc) );\
+  _zMulMat3DTVec3D( zFrame3DAtt(f), &__tmp, zVec6DAng(vc) );\
+} while(0)
 __EXPORT zVec6D *zXform6DLin(zFrame3D *f, zVec6D *v, zVec6D *vc);
 __EXPORT zVec6D *zXform6DAng(zFrame3D *f, zVec6D *v, zVec6D *vc);
+__EXPORT zVec6D *zXform6DLinInv(zFrame3D *f, zVec6D *v, zVec6D *vc);
+__EXPORT zVec6D *zXform6DAngInv(zFrame3D *f, zVec6D *v, zVec6D *vc);
+__EXPORT zVec6D *zXform6DLinArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[]);
+__EXPORT zVec6D *zXform6DAngArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[]);
+__EXPORT zVec6D *zXform6DLinInvArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[]);
+__EXPORT zVec6D *zXform6DAngInvArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[]);
 
 /*! \brief twist a frame by a torsion vector
  *   (position offset & angle-axis rotation).
@@ -684,6 +684,38 @@ __EXPORT zVec3D *zMat3DDif(zMat3D *m, zMat3D *mnew, double dt, zVec3D *omega);
  */
 __EXPORT void zMat3DSymEig(zMat3D *m, double eval[], zVec3D evec[]);
 
+/*! \brief eigensystem of a symmetric 3x3 matrix by a closed-form method.
+ *
+ * zMat3DSymEigTrig() calculates eigenvalues and eigenvectors of a
+ * symmetric 3x3 matrix \a m in a closed form. The eigenvalues are
+ * given by the trigonometric solution of the characteristic cubic
+ * equation. The eigenvector for the eigenvalue farther from the other
+ * two is computed from cross products of rows of \a m minus the
+ * eigenvalue times the identity matrix, and the remaining two are
+ * computed by the 2x2 eigensystem in its orthogonal complement.
+ * If the spectrum is so degenerated that the eigenvector cannot be
+ * identified, it falls back to zMat3DSymEig().
+ * The eigenvalues are stored in \a eval in descending order, and the
+ * corresponding eigenvectors are stored in \a evec. The eigenvectors
+ * form a right-handed orthonormal basis.
+ *
+ * zMat3DSymEigTrigArray() computes the eigensystems of an array of
+ * \a n symmetric 3x3 matrices \a m by zMat3DSymEigTrig(). The
+ * eigenvalues and eigenvectors of \a m[i] are stored in \a eval[3*i],
+ * \a eval[3*i+1], \a eval[3*i+2] and \a evec[3*i], \a evec[3*i+1],
+ * \a evec[3*i+2], respectively.
+ * \return
+ * zMat3DSymEigTrig() and zMat3DSymEigTrigArray() return no value.
+ * \notes
+ * \a m must be symmetric. Otherwise, the correct result will not be expected.
+ * \a eval and \a evec of zMat3DSymEigTrigArray() must have 3 \a n
+ * elements at least.
+ * \sa
+ * zMat3DSymEig
+ */
+__EXPORT void zMat3DSymEigTrig(zMat3D *m, double eval[], zVec3D evec[]);
+__EXPORT void zMat3DSymEigTrigArray(zMat3D m[], int n, double eval[], zVec3D evec[]);
+
 /* ********************************************************** */
 /* I/O
  * ********************************************************** */
@@ -71,6 +71,18 @@ __EXPORT char *zDirStr(zDir dir);
  */
 __EXPORT zDir zDirRev(zDir dir);
 
+/*! \brief run a function concurrently over an array of arguments.
+ *
+ * zThreadRun() calls \a func for each of \a n arguments stored in an
+ * array \a arg, the size of each of which is \a size, and waits for
+ * all of them to finish. The last argument is processed in the current
+ * thread, and the others in new threads. If a thread cannot be created,
+ * the corresponding argument is processed in the current thread instead.
+ * \return
+ * zThreadRun() returns no value.
+ */
+__EXPORT void zThreadRun(void *(*func)(void*), void *arg, size_t size, int n);
+
 __END_DECLS
 
 #endif /* __ZEO_MISC_H__ */
@@ -74,6 +74,26 @@ __EXPORT zVec3D *zMShape3DContigVert(zMShape3D *ms, zVec3D *p, double *d);
 __EXPORT double zMShape3DClosest(zMShape3D *ms, zVec3D *p, zVec3D *cp);
 __EXPORT bool zMShape3DPointIsInside(zMShape3D *ms, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and multiple shapes.
+ *
+ * zMShape3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and multiple shapes \a ms. The parameter t at the
+ * intersection, the intersection point and the outward unit normal vector
+ * of the shape hit at the point are stored in \a t, \a hit and \a norm,
+ * respectively, unless they are the null pointers.
+ *
+ * zMShape3DRayAnyHit() checks if the ray hits any of \a ms. The query is
+ * terminated as soon as a shape hit by the ray is found, which is not
+ * necessarily the nearest.
+ * \return
+ * zMShape3DRayCast() and zMShape3DRayAnyHit() return the index of the
+ * shape hit by the ray, or -1 if the ray hits nothing.
+ * \sa
+ * zShape3DRayCast
+ */
+__EXPORT int zMShape3DRayCast(zMShape3D *ms, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *hit, zVec3D *norm);
+__EXPORT int zMShape3DRayAnyHit(zMShape3D *ms, zVec3D *org, zVec3D *dir, double tmax);
+
 __EXPORT zMShape3D *zMShape3DToPH(zMShape3D *ms);
 
 /*! \brief register a definition of tag-and-keys for multiple shapes to a ZTK format processor. */
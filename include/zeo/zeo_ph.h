@@ -108,11 +108,101 @@ __EXPORT zVec3D *zPH3DContigVert(zPH3D *ph, zVec3D *p, double *d);
  * of \a ph, or the false value otherwise.
  * \notes
  * zPH3DPointIsInside() assumes that \a ph has a convex volume.
+ * For a non-convex polyhedron, use zPH3DBVHPointIsInside() instead.
  */
 __EXPORT double zPH3DClosest(zPH3D *ph, zVec3D *p, zVec3D *cp);
 __EXPORT double zPH3DPointDist(zPH3D *ph, zVec3D *p);
 __EXPORT bool zPH3DPointIsInside(zPH3D *ph, zVec3D *v, bool rim);
 
+/*! \brief intersection of a ray and a 3D polyhedron.
+ *
+ * zPH3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and faces of a polyhedron \a ph by scanning all
+ * the faces. Both faces and their back sides are hit by the ray. The
+ * parameter t at the intersection is stored in \a t unless it is the
+ * null pointer.
+ * \return
+ * zPH3DRayCast() returns the index of the face hit by the ray, or -1 if
+ * the ray hits nothing.
+ * \sa
+ * zTri3DRayHit, zPH3DBVHRayCast
+ */
+__EXPORT int zPH3DRayCast(zPH3D *ph, zVec3D *org, zVec3D *dir, double tmax, double *t);
+
+/* ********************************************************** */
+/* CLASS: zPH3DAdj
+ * vertex adjacency of a 3D polyhedron in compressed sparse row form
+ * ********************************************************** */
+
+typedef struct{
+  int num;   /* number of vertices */
+  int *head; /* heads of neighbor lists (size num+1) */
+  int *idx;  /* indices of neighbor vertices */
+} zPH3DAdj;
+
+#define zPH3DAdjNeighborNum(adj,i) ( (adj)->head[(i)+1] - (adj)->head[i] )
+#define zPH3DAdjNeighbor(adj,i,j)  (adj)->idx[(adj)->head[i]+(j)]
+
+/*! \brief vertex adjacency of a 3D polyhedron.
+ *
+ * zPH3DAdjInit() initializes a vertex adjacency \a adj.
+ *
+ * zPH3DAdjAlloc() allocates memory of \a adj for \a vnum vertices
+ * and \a nnum neighbor indices in total.
+ *
+ * zPH3DAdjCreate() creates the vertex adjacency of a 3D polyhedron
+ * \a ph. Two vertices are adjacent to each other if they share an
+ * edge of a face. Indices of vertices are those in the vertex array
+ * of \a ph.
+ *
+ * zPH3DAdjDestroy() destroys \a adj.
+ *
+ * zPH3DAdjNeighborNum(adj,i) is the number of neighbors of the
+ * \a i th vertex, and zPH3DAdjNeighbor(adj,i,j) is the index of
+ * the \a j th neighbor of it.
+ * \return
+ * zPH3DAdjInit() returns a pointer \a adj.
+ * zPH3DAdjAlloc() and zPH3DAdjCreate() return a pointer \a adj if
+ * succeeding, or the null pointer if failing to allocate memory.
+ * zPH3DAdjDestroy() returns no value.
+ * \sa
+ * zCH3DAdj
+ */
+__EXPORT zPH3DAdj *zPH3DAdjInit(zPH3DAdj *adj);
+__EXPORT zPH3DAdj *zPH3DAdjAlloc(zPH3DAdj *adj, int vnum, int nnum);
+__EXPORT zPH3DAdj *zPH3DAdjCreate(zPH3DAdj *adj, zPH3D *ph);
+__EXPORT void zPH3DAdjDestroy(zPH3DAdj *adj);
+
+/*! \brief support map of a convex polyhedron by hill-climbing.
+ *
+ * zPH3DAdjSupportMap() finds the support point of a convex polytope
+ * with respect to a direction vector \a v. \a vert is the array of
+ * vertices of the polytope, and \a adj is the vertex adjacency of it.
+ * It starts from the vertex indicated by \a hint, and climbs to the
+ * neighbor which most increases the inner product with \a v until no
+ * neighbor increases it. The index of the support point found is put
+ * back into \a hint, so that the following query in a close direction
+ * terminates in a few steps.
+ * If \a hint points an invalid index, the search starts from the
+ * first vertex.
+ * \notes
+ * If the climb stops at a vertex some of whose neighbors are below it,
+ * edges around the vertex span a cone which contains the polytope, so
+ * that the vertex is the support point. If all neighbors of the vertex
+ * are level with it, the vertex may
+ * lie inside of a face perpendicular to \a v, e.g. on a triangulated
+ * face of a mesh, so that all vertices are scanned instead. Hence, the
+ * inner product of the result with \a v is always the maximum as that
+ * of zVec3DSupportMap(), although a different one may be chosen from
+ * vertices on the same level.
+ * \return
+ * zPH3DAdjSupportMap() returns a pointer to the support point.
+ * If \a adj is empty, the null pointer is returned.
+ * \sa
+ * zVec3DSupportMap, zCH3DAdj
+ */
+__EXPORT zVec3D *zPH3DAdjSupportMap(zPH3DAdj *adj, zVec3D vert[], zVec3D *v, int *hint);
+
 /*! \brief volume, barycenter and inertia of a 3D polyhedron.
  *
  * zPH3DVolume() calculates the volume of a polyhedron \a ph.
@@ -25,6 +25,27 @@ __BEGIN_DECLS
 __EXPORT bool zVec3DListPCDFRead(FILE *fp, zVec3DList *pc);
 __EXPORT bool zVec3DListReadPCDFile(zVec3DList *pc, char filename[]);
 
+/*! \brief write point cloud to PCD file.
+ *
+ * zVec3DArrayPCDFWrite() writes an organized point cloud \a pc to a
+ * stream \a fp in the ASCII PCD format. Points are arranged in rows of
+ * \a width points, so that the height of the cloud is the number of
+ * points divided by \a width. A point which has a NaN component is
+ * written as a missing point. Coordinates of points are those in the
+ * frame of the viewpoint \a viewpoint, which is written in the header.
+ * If \a viewpoint is the null pointer, the identity frame is written.
+ *
+ * zVec3DArrayWritePCDFile() writes \a pc to a PCD file \a filename.
+ * \return
+ * zVec3DArrayPCDFWrite() and zVec3DArrayWritePCDFile() return the false
+ * value if the number of points is not a multiple of \a width or they
+ * fail to open the file. Otherwise, the true value is returned.
+ * \sa
+ * zVec3DListPCDFRead
+ */
+__EXPORT bool zVec3DArrayPCDFWrite(FILE *fp, zVec3DArray *pc, int width, zFrame3D *viewpoint);
+__EXPORT bool zVec3DArrayWritePCDFile(zVec3DArray *pc, int width, zFrame3D *viewpoint, char filename[]);
+
 #define ZEO_PCD_SUFFIX "pcd"
 
 __END_DECLS
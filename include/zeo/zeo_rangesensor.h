@@ -0,0 +1,147 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_rangesensor - simulation of range sensors.
+ */
+
+#ifndef __ZEO_RANGESENSOR_H__
+#define __ZEO_RANGESENSOR_H__
+
+#include <zeo/zeo_pointcloud.h>
+#include <zeo/zeo_col.h>
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zRangeScene
+ * multiple shapes with cached hierarchies for ray casting
+ * ********************************************************** */
+
+typedef struct{
+  zMShape3D *ms;  /* multiple shapes */
+  zAABBTree tree; /* tree of bounding boxes of shapes */
+  zPH3DBVH *bvh;  /* bounding volume hierarchies of polyhedral shapes (empty for the others) */
+} zRangeScene;
+
+/*! \brief create and destroy a scene of range sensors.
+ *
+ * zRangeSceneInit() initializes a scene \a scene.
+ *
+ * zRangeSceneCreate() creates a scene \a scene of multiple shapes \a ms
+ * to be scanned by range sensors. A tree of axis-aligned bounding boxes
+ * of shapes is built, and a bounding volume hierarchy is created for each
+ * polyhedral shape by zPH3DBVHCreate() with at most \a nthread threads,
+ * so that they are reused over any number of scans.
+ *
+ * \a scene refers to \a ms, which has to be kept alive and unmoved while
+ * \a scene is used. If shapes of \a ms are moved, \a scene has to be
+ * created again.
+ *
+ * zRangeSceneDestroy() destroys \a scene. \a ms is not destroyed.
+ *
+ * zRangeSceneRayCast() finds the nearest intersection of a ray \a org +
+ * t \a dir (0 <= t <= \a tmax) and shapes of \a scene. Only shapes
+ * in leaves of the tree hit by the ray are tested. Polyhedra are
+ * intersected via their hierarchies, and the other primitives
+ * analytically by zShape3DRayCast(). The parameter t at the intersection
+ * is stored in \a t unless it is the null pointer.
+ * \return
+ * zRangeSceneInit() returns a pointer \a scene.
+ * zRangeSceneCreate() returns a pointer \a scene if succeeding. If it
+ * fails to allocate memory, the null pointer is returned.
+ * zRangeSceneDestroy() returns no value.
+ * zRangeSceneRayCast() returns the index of the shape hit by the ray, or
+ * -1 if the ray hits nothing.
+ * \sa
+ * zMShape3DRayCast, zAABBTreeRayCast, zPH3DBVHRayCast
+ */
+__EXPORT zRangeScene *zRangeSceneInit(zRangeScene *scene);
+__EXPORT zRangeScene *zRangeSceneCreate(zRangeScene *scene, zMShape3D *ms, int nthread);
+__EXPORT void zRangeSceneDestroy(zRangeScene *scene);
+__EXPORT int zRangeSceneRayCast(zRangeScene *scene, zVec3D *org, zVec3D *dir, double tmax, double *t);
+
+/* ********************************************************** */
+/* CLASS: zRangeSensor
+ * range sensor which shoots a grid of rays from its origin
+ * ********************************************************** */
+
+#define ZEO_RANGESENSOR_TILE_SIZE 256 /* number of rays in a tile assigned to a thread */
+
+typedef struct{
+  int width;         /* number of columns */
+  int height;        /* number of rows */
+  zVec3D *dir;       /* directions of rays in the sensor frame arranged in rows */
+  double rmin, rmax; /* range of the ray parameter */
+  zVec3DArray point; /* organized point cloud in the sensor frame */
+} zRangeSensor;
+
+#define zRangeSensorWidth(s)      (s)->width
+#define zRangeSensorHeight(s)     (s)->height
+#define zRangeSensorRayNum(s)     ( (s)->width * (s)->height )
+#define zRangeSensorDir(s,i,j)    ( &(s)->dir[(i)*(s)->width+(j)] )
+#define zRangeSensorPoint(s,i,j)  zArrayElemNC( &(s)->point, (i)*(s)->width+(j) )
+#define zRangeSensorPointCloud(s) ( &(s)->point )
+
+/*! \brief create and destroy a range sensor.
+ *
+ * zRangeSensorInit() initializes a range sensor \a sensor.
+ *
+ * zRangeSensorCreateCamera() creates a depth camera \a sensor of the
+ * pinhole model with \a width x \a height pixels, focal lengths \a fx
+ * and \a fy and the principal point ( \a cx, \a cy ) in pixels. The
+ * optical axis is the z-axis of the sensor frame, and the x-axis and
+ * the y-axis are directed to the right and the bottom of the image,
+ * respectively. The ray through the pixel at the j-th column and the
+ * i-th row is directed to ( ( j - \a cx ) / \a fx, ( i - \a cy ) / \a fy, 1 ),
+ * so that the ray parameter is the depth. Depths out of [ \a rmin, \a rmax ]
+ * are not measured.
+ *
+ * zRangeSensorCreateLiDAR() creates a spinning multi-beam LiDAR \a sensor
+ * with \a beamnum beams arranged in elevation from \a elevmin to \a elevmax
+ * at even intervals, each of which measures at \a stepnum azimuths in a
+ * revolution about the z-axis of the sensor frame. The i-th row of the
+ * sensor corresponds to the i-th beam from the bottom, and the j-th column
+ * to the azimuth 2 pi j / \a stepnum from the x-axis. Ranges out of
+ * [ \a rmin, \a rmax ] are not measured.
+ *
+ * zRangeSensorDestroy() destroys \a sensor.
+ * \return
+ * zRangeSensorInit() returns a pointer \a sensor.
+ * zRangeSensorCreateCamera() and zRangeSensorCreateLiDAR() return a
+ * pointer \a sensor if succeeding. If the resolution is not positive or
+ * they fail to allocate memory, the null pointer is returned.
+ * zRangeSensorDestroy() returns no value.
+ */
+__EXPORT zRangeSensor *zRangeSensorInit(zRangeSensor *sensor);
+__EXPORT zRangeSensor *zRangeSensorCreateCamera(zRangeSensor *sensor, int width, int height, double fx, double fy, double cx, double cy, double rmin, double rmax);
+__EXPORT zRangeSensor *zRangeSensorCreateLiDAR(zRangeSensor *sensor, int beamnum, double elevmin, double elevmax, int stepnum, double rmin, double rmax);
+__EXPORT void zRangeSensorDestroy(zRangeSensor *sensor);
+
+/*! \brief scan a scene by a range sensor.
+ *
+ * zRangeSensorScan() scans a scene \a scene by a range sensor \a sensor
+ * posed at a frame \a pose, and stores the measured points in the
+ * organized point cloud of \a sensor, which is accessed by
+ * zRangeSensorPoint() or zRangeSensorPointCloud(). Points are represented
+ * in the sensor frame, and a point whose ray hits nothing within the range
+ * of \a sensor is filled with NaN.
+ * Rays are divided into tiles of ZEO_RANGESENSOR_TILE_SIZE rays, which
+ * are cast by at most \a nthread threads in a round-robin manner.
+ *
+ * zRangeSensorPCDFWrite() writes the point cloud of \a sensor to a stream
+ * \a fp in the PCD format, where \a pose is written as the viewpoint.
+ * zRangeSensorWritePCDFile() writes it to a PCD file \a filename.
+ * \return
+ * zRangeSensorScan() returns the number of measured points.
+ * zRangeSensorPCDFWrite() and zRangeSensorWritePCDFile() return the true
+ * value if succeeding, or the false value otherwise.
+ * \sa
+ * zRangeSceneRayCast, zVec3DArrayPCDFWrite
+ */
+__EXPORT int zRangeSensorScan(zRangeSensor *sensor, zRangeScene *scene, zFrame3D *pose, int nthread);
+#define zRangeSensorPCDFWrite(f,s,p) zVec3DArrayPCDFWrite( f, zRangeSensorPointCloud(s), zRangeSensorWidth(s), p )
+#define zRangeSensorWritePCDFile(s,p,n) zVec3DArrayWritePCDFile( zRangeSensorPointCloud(s), zRangeSensorWidth(s), p, n )
+
+__END_DECLS
+
+#endif /* __ZEO_RANGESENSOR_H__ */
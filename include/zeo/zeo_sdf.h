@@ -0,0 +1,113 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_sdf - signed distance field.
+ */
+
+#ifndef __ZEO_SDF_H__
+#define __ZEO_SDF_H__
+
+#include <zeo/zeo_col.h>
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zSDF3D
+ * signed distance field sampled on a grid of blocks
+ * ********************************************************** */
+
+#define ZEO_SDF3D_BLOCK_SIZE 8   /* number of grid points of a block along each axis */
+#define ZEO_SDF3D_BLOCK_VOL  512 /* number of grid points of a block */
+
+#define ZEO_SDF3D_DENSE      HUGE_VAL /* band of a dense grid */
+
+#define ZEO_SDF3D_BLOCK_OUT  -1 /* unallocated block outside of shapes */
+#define ZEO_SDF3D_BLOCK_IN   -2 /* unallocated block inside of shapes */
+
+typedef struct{
+  zVec3D org;    /* position of the first grid point */
+  double pitch;  /* interval of grid points */
+  int size[3];   /* numbers of grid points along axes */
+  int bsize[3];  /* numbers of blocks along axes */
+  double band;   /* truncation distance (ZEO_SDF3D_DENSE for a dense grid) */
+  int *block;    /* offsets of values of blocks, or ZEO_SDF3D_BLOCK_OUT/IN for unallocated blocks */
+  double *val;   /* values of allocated blocks */
+  int blocknum;  /* number of allocated blocks */
+} zSDF3D;
+
+#define zSDF3DPitch(s)      (s)->pitch
+#define zSDF3DSize(s,d)     (s)->size[(d)]
+#define zSDF3DBlockNum(s)   (s)->blocknum
+#define zSDF3DIsSparse(s)   ( (s)->band < ZEO_SDF3D_DENSE )
+
+/*! \brief create and destroy a signed distance field.
+ *
+ * zSDF3DInit() initializes a signed distance field \a sdf.
+ *
+ * zSDF3DCreatePH() creates a signed distance field \a sdf of a closed
+ * polyhedron \a ph on a grid with an interval \a pitch which covers
+ * the bounding box of \a ph with a margin \a margin. Grid points are
+ * grouped into blocks of ZEO_SDF3D_BLOCK_SIZE points along each axis.
+ * zSDF3DCreateShape() creates \a sdf of a shape \a shape.
+ * zSDF3DCreateMShape() creates \a sdf of the union of multiple shapes
+ * \a ms.
+ *
+ * If \a band is ZEO_SDF3D_DENSE, all blocks are allocated. Distances
+ * at blocks near the surface are computed exactly by closest-point
+ * queries on a bounding volume hierarchy of triangles, and propagated
+ * to the other blocks by the fast sweeping method, which solves the
+ * Eikonal equation with the first-order upwind scheme.
+ * Otherwise, only blocks within a distance \a band from the surface are
+ * allocated and computed exactly, and distances are truncated at
+ * -\a band and \a band, so that the other blocks only store whether
+ * they are inside or outside.
+ *
+ * The sign of distance is determined by the winding number, which is
+ * counted with crossings of lines along the x-axis through grid points
+ * and the triangles, so that it is robust against non-convex shapes.
+ * Grid points with a non-zero winding number are inside.
+ * Blocks are computed concurrently by at most \a nthread threads.
+ *
+ * zSDF3DDestroy() destroys \a sdf.
+ * \notes
+ * Primitive shapes are converted to polyhedra with their division
+ * numbers. For multiple shapes, the distance is that to the nearest
+ * surface, which underestimates the depth where shapes overlap.
+ * \return
+ * zSDF3DInit() returns a pointer \a sdf.
+ * zSDF3DCreatePH(), zSDF3DCreateShape() and zSDF3DCreateMShape() return
+ * a pointer \a sdf if succeeding. If \a pitch or \a band is not positive,
+ * the shapes have no faces, or they fail to allocate memory, the null
+ * pointer is returned.
+ * zSDF3DDestroy() returns no value.
+ */
+__EXPORT zSDF3D *zSDF3DInit(zSDF3D *sdf);
+__EXPORT zSDF3D *zSDF3DCreatePH(zSDF3D *sdf, zPH3D *ph, double pitch, double margin, double band, int nthread);
+__EXPORT zSDF3D *zSDF3DCreateShape(zSDF3D *sdf, zShape3D *shape, double pitch, double margin, double band, int nthread);
+__EXPORT zSDF3D *zSDF3DCreateMShape(zSDF3D *sdf, zMShape3D *ms, double pitch, double margin, double band, int nthread);
+__EXPORT void zSDF3DDestroy(zSDF3D *sdf);
+
+/*! \brief queries on a signed distance field.
+ *
+ * zSDF3DGridVal() returns the signed distance at the grid point of
+ * indices ( \a i, \a j, \a k ) of a signed distance field \a sdf.
+ *
+ * zSDF3DDist() computes the signed distance at a point \a p by the
+ * trilinear interpolation of the eight surrounding grid points.
+ * zSDF3DGrad() computes the signed distance at \a p in the same way,
+ * and puts the gradient of the interpolated distance into \a grad.
+ * For a point out of the grid, the distance from the nearest point on
+ * the grid is added, and the gradient along axes on which \a p is out
+ * of the grid is that of the added distance. The cost of a query is
+ * constant.
+ * \return
+ * zSDF3DGridVal(), zSDF3DDist() and zSDF3DGrad() return the signed
+ * distance, which is negative inside.
+ */
+__EXPORT double zSDF3DGridVal(zSDF3D *sdf, int i, int j, int k);
+__EXPORT double zSDF3DDist(zSDF3D *sdf, zVec3D *p);
+__EXPORT double zSDF3DGrad(zSDF3D *sdf, zVec3D *p, zVec3D *grad);
+
+__END_DECLS
+
+#endif /* __ZEO_SDF_H__ */
@@ -27,6 +27,8 @@ typedef struct{
   double (*_closest)(void*,zVec3D*,zVec3D*);
   double (*_pointdist)(void*,zVec3D*);
   bool (*_pointisinside)(void*,zVec3D*,bool);
+  zVec3D *(*_support)(void*,zVec3D*,zVec3D*);
+  bool (*_raycast)(void*,zVec3D*,zVec3D*,double,double*,zVec3D*);
   double (*_volume)(void*);
   zVec3D *(*_barycenter)(void*,zVec3D*);
   zMat3D *(*_inertia)(void*,zMat3D*);
@@ -108,6 +110,49 @@ __EXPORT double zShape3DClosest(zShape3D *shape, zVec3D *p, zVec3D *cp);
 __EXPORT double zShape3DPointDist(zShape3D *shape, zVec3D *p);
 __EXPORT bool zShape3DPointIsInside(zShape3D *shape, zVec3D *p, bool rim);
 
+/*! \brief support map of a shape.
+ *
+ * zShape3DSupportMap() finds the support point of a shape \a shape,
+ * namely, the farthest point of \a shape along a direction vector
+ * \a v, and puts it into \a sp. The point is computed by the method
+ * of each primitive shape, so that any shape is dealt with as it is
+ * without being converted to a polyhedron. The support point of a
+ * polyhedron is one of the vertices, and that of a NURBS surface is
+ * one of the control points.
+ * \return
+ * zShape3DSupportMap() returns a pointer \a sp.
+ * \sa
+ * zBox3DSupportMap, zSphere3DSupportMap, zEllips3DSupportMap,
+ * zCyl3DSupportMap, zECyl3DSupportMap, zCone3DSupportMap
+ */
+__EXPORT zVec3D *zShape3DSupportMap(zShape3D *shape, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and a shape.
+ *
+ * zShape3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of a shape \a shape. It is
+ * analytically computed for primitive shapes, namely, boxes, spheres,
+ * ellipsoids, cylinders, elliptic cylinders and cones, and by scanning
+ * faces for polyhedra. If \a org is inside of a primitive shape, the point
+ * at which the ray exits the shape is found.
+ * The parameter t at the intersection, the intersection point and the
+ * outward unit normal vector of \a shape at the point are stored in \a t,
+ * \a hit and \a norm, respectively, unless they are the null pointers.
+ * The normal vector of a polyhedron is that of the face hit by the ray.
+ *
+ * zShape3DRayAnyHit() only checks if the ray hits \a shape.
+ * \notes
+ * Rays never hit NURBS surfaces.
+ * \return
+ * zShape3DRayCast() and zShape3DRayAnyHit() return the true value if the
+ * ray hits \a shape, or the false value otherwise.
+ * \sa
+ * zBox3DRayCast, zSphere3DRayCast, zEllips3DRayCast,
+ * zCyl3DRayCast, zECyl3DRayCast, zCone3DRayCast, zPH3DRayCast
+ */
+__EXPORT bool zShape3DRayCast(zShape3D *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *hit, zVec3D *norm);
+#define zShape3DRayAnyHit(s,o,d,tmax) zShape3DRayCast( s, o, d, tmax, NULL, NULL, NULL )
+
 __EXPORT zShape3D *zShape3DToPH(zShape3D *shape);
 
 /*! \brief read a shape from a STL file. */
@@ -97,6 +97,31 @@ __EXPORT double zBox3DClosest(zBox3D *box, zVec3D *p, zVec3D *cp);
 __EXPORT double zBox3DPointDist(zBox3D *box, zVec3D *p);
 __EXPORT bool zBox3DPointIsInside(zBox3D *box, zVec3D *p, bool rim);
 
+/*! \brief support map of a box.
+ *
+ * zBox3DSupportMap() finds the support point of a box \a box, namely,
+ * the farthest point of \a box along a direction vector \a v, and puts
+ * it into \a sp. It is a vertex of \a box chosen by the signs of the
+ * components of \a v along the axes of \a box.
+ * \return
+ * zBox3DSupportMap() returns a pointer \a sp.
+ */
+__EXPORT zVec3D *zBox3DSupportMap(zBox3D *box, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and a box.
+ *
+ * zBox3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of a box \a box. If \a org is
+ * inside of \a box, the point at which the ray exits \a box is found.
+ * The parameter t at the intersection is stored in \a t, and the outward
+ * unit normal vector of the face at the intersection is put into \a norm
+ * unless they are the null pointers.
+ * \return
+ * zBox3DRayCast() returns the true value if the ray hits \a box, or the
+ * false value otherwise.
+ */
+__EXPORT bool zBox3DRayCast(zBox3D *box, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm);
+
 /*! \brief volume and inertia of a box.
  *
  * zBox3DVolume() calculates the volume of a box \a box.
@@ -77,6 +77,31 @@ __EXPORT double zCone3DClosest(zCone3D *cone, zVec3D *p, zVec3D *cp);
 __EXPORT double zCone3DPointDist(zCone3D *cone, zVec3D *p);
 __EXPORT bool zCone3DPointIsInside(zCone3D *cone, zVec3D *p, bool rim);
 
+/*! \brief support map of a cone.
+ *
+ * zCone3DSupportMap() finds the support point of a cone \a cone, namely,
+ * the farthest point of \a cone along a direction vector \a v, and puts
+ * it into \a sp. It is either the vertex or a point on the rim of the
+ * bottom face of \a cone.
+ * \return
+ * zCone3DSupportMap() returns a pointer \a sp.
+ */
+__EXPORT zVec3D *zCone3DSupportMap(zCone3D *cone, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and a cone.
+ *
+ * zCone3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of a cone \a cone, which is either
+ * the side surface or the base. If \a org is inside of \a cone, the point
+ * at which the ray exits \a cone is found. The parameter t at the
+ * intersection is stored in \a t, and the outward unit normal vector at
+ * the intersection is put into \a norm unless they are the null pointers.
+ * \return
+ * zCone3DRayCast() returns the true value if the ray hits \a cone, or the
+ * false value otherwise.
+ */
+__EXPORT bool zCone3DRayCast(zCone3D *cone, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm);
+
 /*! \brief axis vector, height and volume of 3D cone.
  *
  * zCone3DAxis() calculates the axis vector of a 3D cone \a cone; the axis
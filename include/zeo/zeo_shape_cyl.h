@@ -77,6 +77,31 @@ __EXPORT double zCyl3DClosest(zCyl3D *cyl, zVec3D *p, zVec3D *cp);
 __EXPORT double zCyl3DPointDist(zCyl3D *cyl, zVec3D *p);
 __EXPORT bool zCyl3DPointIsInside(zCyl3D *cyl, zVec3D *p, bool rim);
 
+/*! \brief support map of a cylinder.
+ *
+ * zCyl3DSupportMap() finds the support point of a cylinder \a cyl, namely,
+ * the farthest point of \a cyl along a direction vector \a v, and puts
+ * it into \a sp. It lies on the rim of either of the bottom faces.
+ * \return
+ * zCyl3DSupportMap() returns a pointer \a sp.
+ */
+__EXPORT zVec3D *zCyl3DSupportMap(zCyl3D *cyl, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and a cylinder.
+ *
+ * zCyl3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of a cylinder \a cyl, which is
+ * either the side surface or one of the bases. If \a org is inside of
+ * \a cyl, the point at which the ray exits \a cyl is found. The parameter
+ * t at the intersection is stored in \a t, and the outward unit normal
+ * vector at the intersection is put into \a norm unless they are the null
+ * pointers.
+ * \return
+ * zCyl3DRayCast() returns the true value if the ray hits \a cyl, or the
+ * false value otherwise.
+ */
+__EXPORT bool zCyl3DRayCast(zCyl3D *cyl, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm);
+
 /*! \brief axis vector, height and volume of a 3D cylinder.
  *
  * zCyl3DAxis() calculates the axis vector of a 3D cylinder \a cyl;
@@ -59,6 +59,30 @@ __EXPORT double zECyl3DPointDist(zECyl3D *cyl, zVec3D *p);
 /*! \brief check if a point is inside of an elliptic cylinder. */
 __EXPORT bool zECyl3DPointIsInside(zECyl3D *cyl, zVec3D *p, bool rim);
 
+/*! \brief support map of an elliptic cylinder.
+ *
+ * zECyl3DSupportMap() finds the support point of an elliptic cylinder \a cyl, namely,
+ * the farthest point of \a cyl along a direction vector \a v, and puts
+ * it into \a sp. It lies on the elliptic rim of either of the bottom
+ * faces.
+ * \return
+ * zECyl3DSupportMap() returns a pointer \a sp.
+ */
+__EXPORT zVec3D *zECyl3DSupportMap(zECyl3D *cyl, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and an elliptic cylinder.
+ *
+ * zECyl3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of an elliptic cylinder \a cyl in
+ * the same way with zCyl3DRayCast(). The parameter t at the intersection
+ * is stored in \a t, and the outward unit normal vector at the
+ * intersection is put into \a norm unless they are the null pointers.
+ * \return
+ * zECyl3DRayCast() returns the true value if the ray hits \a cyl, or the
+ * false value otherwise.
+ */
+__EXPORT bool zECyl3DRayCast(zECyl3D *cyl, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm);
+
 #define zECyl3DAxis(c,a) \
   zVec3DSub( zECyl3DCenter(c,1), zECyl3DCenter(c,0), a )
 /*! \brief height of a 3D elliptic cylinder. */
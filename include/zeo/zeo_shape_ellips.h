@@ -77,12 +77,24 @@ __EXPORT zEllips3D *zEllips3DMirror(zEllips3D *src, zEllips3D *dest, zAxis axis)
 __EXPORT zEllips3D *zEllips3DXform(zEllips3D *src, zFrame3D *f, zEllips3D *dest);
 __EXPORT zEllips3D *zEllips3DXformInv(zEllips3D *src, zFrame3D *f, zEllips3D *dest);
 
+#define ZEO_ELLIPS3D_CLOSEST_ITER_MAX 100 /* maximum number of iterations to find the closest point */
+
 /*! \brief distance from a 3D point to a 3D ellipsoid.
  *
  * zEllips3DClosest() calculates the closest point from a 3D
  * point \a p to a 3D ellipsoid \a ellips, and puts it into \a cp.
  * When \a p is inside of \a ellips, it copies \a p to \a cp.
  *
+ * The closest point is found by a one-dimensional search of the
+ * Lagrange multiplier, which is bracketed and found by Newton's
+ * method safeguarded by bisection without heap allocation.
+ * At most ZEO_ELLIPS3D_CLOSEST_ITER_MAX iterations are taken.
+ *
+ * zEllips3DClosestBatch() calculates the closest points from \a n
+ * points \a p[i] (i=0,...,\a n-1) to \a ellips, and puts them into
+ * \a cp[i]. The distances are put into \a d[i] unless \a d is the
+ * null pointer.
+ *
  * zEllips3DPointDist() calculates the distance from a 3D point
  * \a p to a 3D ellipsoid \a ellips.
  *
@@ -96,13 +108,43 @@ __EXPORT zEllips3D *zEllips3DXformInv(zEllips3D *src, zFrame3D *f, zEllips3D *de
  *  - a positive value when \a p is outside of \a ellips, or
  *  - a negative value when \a p is inside of \a ellips.
  *
+ * zEllips3DClosestBatch() returns no value.
+ *
  * zEllips3DPointIsInside() returns the true value if \a p is
  * inside of \a ellips, or the false value otherwise.
  */
 __EXPORT double zEllips3DClosest(zEllips3D *ellips, zVec3D *p, zVec3D *cp);
+__EXPORT void zEllips3DClosestBatch(zEllips3D *ellips, zVec3D p[], int n, zVec3D cp[], double d[]);
 __EXPORT double zEllips3DPointDist(zEllips3D *ellips, zVec3D *p);
 __EXPORT bool zEllips3DPointIsInside(zEllips3D *ellips, zVec3D *p, bool rim);
 
+/*! \brief support map of an ellipsoid.
+ *
+ * zEllips3DSupportMap() finds the support point of an ellipsoid \a ellips, namely,
+ * the farthest point of \a ellips along a direction vector \a v, and puts
+ * it into \a sp. The point is analytically found in the frame of
+ * \a ellips, where the support point of the unit sphere is scaled by
+ * the radii.
+ * \return
+ * zEllips3DSupportMap() returns a pointer \a sp.
+ */
+__EXPORT zVec3D *zEllips3DSupportMap(zEllips3D *ellips, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and an ellipsoid.
+ *
+ * zEllips3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of an ellipsoid \a ellips. It is
+ * analytically found as that of a unit sphere in the frame of \a ellips
+ * scaled by the radii. If \a org is inside of \a ellips, the point at
+ * which the ray exits \a ellips is found. The parameter t at the
+ * intersection is stored in \a t, and the outward unit normal vector at
+ * the intersection is put into \a norm unless they are the null pointers.
+ * \return
+ * zEllips3DRayCast() returns the true value if the ray hits \a ellips,
+ * or the false value otherwise.
+ */
+__EXPORT bool zEllips3DRayCast(zEllips3D *ellips, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm);
+
 /*! \brief calculate volume and inertia of a 3D ellipsoid.
  *
  * zEllips3DVolume() calculates the volume of a 3D ellipsoid
@@ -92,6 +92,31 @@ __EXPORT double zSphere3DClosest(zSphere3D *sphere, zVec3D *p, zVec3D *cp);
 __EXPORT double zSphere3DPointDist(zSphere3D *sphere, zVec3D *p);
 __EXPORT bool zSphere3DPointIsInside(zSphere3D *sphere, zVec3D *p, bool rim);
 
+/*! \brief support map of a sphere.
+ *
+ * zSphere3DSupportMap() finds the support point of a sphere \a sphere, namely,
+ * the farthest point of \a sphere along a direction vector \a v, and puts
+ * it into \a sp. If \a v is the zero vector, the center of \a sphere
+ * is put into \a sp.
+ * \return
+ * zSphere3DSupportMap() returns a pointer \a sp.
+ */
+__EXPORT zVec3D *zSphere3DSupportMap(zSphere3D *sphere, zVec3D *v, zVec3D *sp);
+
+/*! \brief intersection of a ray and a sphere.
+ *
+ * zSphere3DRayCast() finds the nearest intersection of a ray \a org + t \a dir
+ * (0 <= t <= \a tmax) and the surface of a sphere \a sphere. If \a org is
+ * inside of \a sphere, the point at which the ray exits \a sphere is
+ * found. The parameter t at the intersection is stored in \a t, and the
+ * outward unit normal vector at the intersection is put into \a norm
+ * unless they are the null pointers.
+ * \return
+ * zSphere3DRayCast() returns the true value if the ray hits \a sphere, or
+ * the false value otherwise.
+ */
+__EXPORT bool zSphere3DRayCast(zSphere3D *sphere, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm);
+
 /*! \brief volume and inertia of a 3D sphere.
  *
  * zSphere3DVolume() calculates the volume of a 3D sphere \a sphere.
@@ -0,0 +1,166 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_spinertia - compact spatial inertia.
+ */
+
+#ifndef __ZEO_SPINERTIA_H__
+#define __ZEO_SPINERTIA_H__
+
+#include <zeo/zeo_frame.h>
+#include <zeo/zeo_mat6d.h>
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/* CLASS: zSpInertia
+ * compact spatial inertia class
+ * ********************************************************** */
+
+/*! \struct zSpInertia
+ * \brief compact spatial inertia of a rigid body.
+ *
+ * The 6x6 spatial inertia matrix of a rigid body with respect to a frame
+ *  |~ m 1      -[h x] ~|
+ *  |_ [h x]     I     _|
+ * is represented only by 10 values, where m is the mass, h is the first
+ * moment of mass (the mass times the center of mass), and I is the
+ * inertia tensor about the original point of the frame. The upper
+ * triangular components of I are stored in \a i in the order of
+ * xx, xy, xz, yy, yz and zz.
+ */
+typedef struct{
+  double mass; /*!< \brief mass */
+  zVec3D h;    /*!< \brief first moment of mass */
+  double i[6]; /*!< \brief inertia tensor about the original point */
+} zSpInertia;
+
+#define zSpInertiaMass(si) (si)->mass
+#define zSpInertiaH(si)    ( &(si)->h )
+
+/*! \brief create, copy and convert a spatial inertia.
+ *
+ * zSpInertiaCreate() creates a spatial inertia \a si of a rigid body
+ * from its mass \a mass, the center of mass \a com and the inertia tensor
+ * \a inertia about \a com.
+ *
+ * zSpInertiaZero() zeroes all components of \a si.
+ *
+ * zSpInertiaCopy() copies a spatial inertia \a src to \a dest.
+ *
+ * zSpInertiaCOM() computes the center of mass of \a si and puts it into
+ * \a com.
+ *
+ * zSpInertiaInertia() expands the inertia tensor of \a si about the
+ * original point to a 3x3 matrix \a inertia.
+ *
+ * zSpInertiaBaryInertia() computes the inertia tensor of \a si about the
+ * center of mass and puts it into \a inertia.
+ *
+ * zSpInertiaToMat6D() expands \a si to the 6x6 spatial inertia matrix
+ * \a m.
+ * \return
+ * zSpInertiaCreate() and zSpInertiaZero() return a pointer \a si.
+ * zSpInertiaCOM() returns a pointer \a com, or the null pointer if the
+ * mass of \a si is zero.
+ * zSpInertiaInertia() and zSpInertiaBaryInertia() return a pointer
+ * \a inertia.
+ * zSpInertiaToMat6D() returns a pointer \a m.
+ */
+__EXPORT zSpInertia *zSpInertiaCreate(zSpInertia *si, double mass, zVec3D *com, zMat3D *inertia);
+__EXPORT zSpInertia *zSpInertiaZero(zSpInertia *si);
+#define zSpInertiaCopy(s,d) zCopy( zSpInertia, s, d )
+__EXPORT zVec3D *zSpInertiaCOM(zSpInertia *si, zVec3D *com);
+__EXPORT zMat3D *zSpInertiaInertia(zSpInertia *si, zMat3D *inertia);
+__EXPORT zMat3D *zSpInertiaBaryInertia(zSpInertia *si, zMat3D *inertia);
+__EXPORT zMat6D *zSpInertiaToMat6D(zSpInertia *si, zMat6D *m);
+
+/*! \brief add two spatial inertias.
+ *
+ * zSpInertiaAdd() adds two spatial inertias \a si1 and \a si2 with
+ * respect to the same frame, namely, computes the composite inertia
+ * of two rigid bodies. The result is put into \a si.
+ * zSpInertiaAddDRC() directly adds \a si2 to \a si1.
+ * \return
+ * zSpInertiaAdd() returns a pointer \a si.
+ * zSpInertiaAddDRC() returns a pointer \a si1.
+ */
+__EXPORT zSpInertia *zSpInertiaAdd(zSpInertia *si1, zSpInertia *si2, zSpInertia *si);
+#define zSpInertiaAddDRC(si1,si2) zSpInertiaAdd( si1, si2, si1 )
+
+/*! \brief multiply a 6D vector by a spatial inertia.
+ *
+ * zMulSpInertiaVec6D() multiplies a velocity-type 6D vector \a v by a
+ * spatial inertia \a si, and puts the resulting force-type 6D vector
+ * (momentum or inertial force) into \a f. Namely,
+ *  f_lin = m v_lin - h x v_ang
+ *  f_ang = h x v_lin + I v_ang
+ * Since the spatial inertia matrix is symmetric, the same function also
+ * serves as the multiplication by its transpose.
+ *
+ * zMulSpInertiaVec6DArray() multiplies each of \a n 6D vectors \a v[i]
+ * by \a si[i] and puts the results into \a f[i].
+ * \return
+ * zMulSpInertiaVec6D() and zMulSpInertiaVec6DArray() return a pointer
+ * \a f.
+ * \notes
+ * It is allowed to let \a f point to the same address with \a v.
+ */
+#define _zMulSpInertiaVec6D(si,v,f) do{\
+  zVec3D __hv, __hw;\
+  _zVec3DOuterProd( &(si)->h, zVec6DLin(v), &__hv );\
+  _zVec3DOuterProd( &(si)->h, zVec6DAng(v), &__hw );\
+  __hv.c.x += (si)->i[0]*zVec6DAng(v)->c.x + (si)->i[1]*zVec6DAng(v)->c.y + (si)->i[2]*zVec6DAng(v)->c.z;\
+  __hv.c.y += (si)->i[1]*zVec6DAng(v)->c.x + (si)->i[3]*zVec6DAng(v)->c.y + (si)->i[4]*zVec6DAng(v)->c.z;\
+  __hv.c.z += (si)->i[2]*zVec6DAng(v)->c.x + (si)->i[4]*zVec6DAng(v)->c.y + (si)->i[5]*zVec6DAng(v)->c.z;\
+  _zVec3DMul( zVec6DLin(v), (si)->mass, zVec6DLin(f) );\
+  _zVec3DSubDRC( zVec6DLin(f), &__hw );\
+  zVec3DCopy( &__hv, zVec6DAng(f) );\
+} while(0)
+__EXPORT zVec6D *zMulSpInertiaVec6D(zSpInertia *si, zVec6D *v, zVec6D *f);
+__EXPORT zVec6D *zMulSpInertiaVec6DArray(zSpInertia si[], zVec6D v[], int n, zVec6D f[]);
+
+/*! \brief transform a spatial inertia.
+ *
+ * zSpInertiaXform() transforms a spatial inertia \a si with respect to
+ * a frame S1 to that with respect to another S0, where \a f is for the
+ * transformation from S1 to S0. The result is put into \a sic. It is
+ * equivalent to X^T I X where I is the spatial inertia matrix of \a si
+ * and X is the spatial transformation matrix of zXform6DLin() for \a f,
+ * but it does not need any 6x6 matrix products.
+ *
+ * zSpInertiaXformInv() is the inverse transformation of zSpInertiaXform(),
+ * namely, transforms \a si with respect to S0 to that with respect to S1.
+ *
+ * zSpInertiaXformArray() and zSpInertiaXformInvArray() transform each
+ * of \a n spatial inertias \a si[i] by \a f[i] in the same manners with
+ * the above, and put the results into \a sic[i].
+ * \return
+ * Each function returns a pointer \a sic.
+ * \notes
+ * It is allowed to let \a sic point to the same address with \a si.
+ * \sa
+ * zXform6DLin, zXform6DAng
+ */
+__EXPORT zSpInertia *zSpInertiaXform(zSpInertia *si, zFrame3D *f, zSpInertia *sic);
+__EXPORT zSpInertia *zSpInertiaXformInv(zSpInertia *si, zFrame3D *f, zSpInertia *sic);
+__EXPORT zSpInertia *zSpInertiaXformArray(zSpInertia si[], zFrame3D f[], int n, zSpInertia sic[]);
+__EXPORT zSpInertia *zSpInertiaXformInvArray(zSpInertia si[], zFrame3D f[], int n, zSpInertia sic[]);
+
+/*! \brief print a spatial inertia out to a file.
+ *
+ * zSpInertiaFPrint() prints a spatial inertia \a si out to the current
+ * position of a file \a fp in the following format.
+ *  mass: <m>
+ *  h: { <hx>, <hy>, <hz> }
+ *  inertia: { <ixx>, <ixy>, <ixz>, <iyy>, <iyz>, <izz> }
+ * zSpInertiaPrint() prints \a si out to the standard output.
+ * \return
+ * zSpInertiaFPrint() and zSpInertiaPrint() return no value.
+ */
+__EXPORT void zSpInertiaFPrint(FILE *fp, zSpInertia *si);
+#define zSpInertiaPrint(si) zSpInertiaFPrint( stdout, si )
+
+__END_DECLS
+
+#endif /* __ZEO_SPINERTIA_H__ */
@@ -69,6 +69,53 @@ double zAABox3DVolume(zAABox3D *box)
              * ( box->max.e[zZ] - box->min.e[zZ] ) );
 }
 
+/* compute surface area of an axis-aligned box. */
+double zAABox3DArea(zAABox3D *box)
+{
+  double dx, dy, dz;
+
+  dx = box->max.e[zX] - box->min.e[zX];
+  dy = box->max.e[zY] - box->min.e[zY];
+  dz = box->max.e[zZ] - box->min.e[zZ];
+  return 2 * ( dx*dy + dy*dz + dz*dx );
+}
+
+/* squared distance from a point to an axis-aligned box. */
+double zAABox3DPointSqrDist(zAABox3D *box, zVec3D *p)
+{
+  double d = 0;
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( p->e[i] < box->min.e[i] ) d += zSqr( box->min.e[i] - p->e[i] );
+    else
+    if( p->e[i] > box->max.e[i] ) d += zSqr( p->e[i] - box->max.e[i] );
+  }
+  return d;
+}
+
+/* check if a ray hits an axis-aligned box (slab method). */
+bool zAABox3DRayHit(zAABox3D *box, zVec3D *org, zVec3D *dir, double tmax, double *t)
+{
+  double tmin = 0, t1, t2;
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( zIsTiny( dir->e[i] ) ){
+      if( org->e[i] < box->min.e[i] || org->e[i] > box->max.e[i] ) return false;
+      continue;
+    }
+    t1 = ( box->min.e[i] - org->e[i] ) / dir->e[i];
+    t2 = ( box->max.e[i] - org->e[i] ) / dir->e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > tmin ) tmin = t1;
+    if( t2 < tmax ) tmax = t2;
+    if( tmin > tmax ) return false;
+  }
+  if( t ) *t = tmin;
+  return true;
+}
+
 /* convert an axis-aligned box to a general box. */
 zBox3D *zAABox3DToBox3D(zAABox3D *aab, zBox3D *box)
 {
@@ -91,6 +138,29 @@ zAABox3D *zBox3DToAABox3D(zBox3D *box, zAABox3D *aabox)
   return zAABB( aabox, v, 8, NULL );
 }
 
+/* compute an axis-aligned box of a shape by its support map. */
+zAABox3D *zShape3DToAABox3D(zShape3D *shape, zAABox3D *aabox)
+{
+  zVec3D d, sp;
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    zVec3DZero( &d );
+    d.e[i] = 1;
+    if( !zShape3DSupportMap( shape, &d, &sp ) ) goto EMPTY;
+    aabox->max.e[i] = sp.e[i];
+    d.e[i] = -1;
+    if( !zShape3DSupportMap( shape, &d, &sp ) ) goto EMPTY;
+    aabox->min.e[i] = sp.e[i];
+  }
+  return aabox;
+
+ EMPTY:
+  ZRUNWARN( ZEO_ERR_EMPTYSET );
+  zAABox3DInit( aabox );
+  return NULL;
+}
+
 /* print an axis-aligned box out to a file in a format to be plotted. */
 void zAABox3DDataFPrint(FILE *fp, zAABox3D *box)
 {
@@ -7,50 +7,131 @@
 #include <zeo/zeo_bv.h>
 
 /* ********************************************************** */
-/* CLASS: zQHPoint, zQHPointList, zQHFacet, zQHFacetList, zQH
- * facet/point class for quickhull algorithm
+/* CLASS: zQHFacet, zQH
+ * facet class and working space for quickhull algorithm, which is
+ * also used as a persistent convex hull to be incrementally extended
+ *
+ * Points are referred by their indices in a flat array. Facets are
+ * allocated from an arena which consists of fixed-size blocks and is
+ * freed at once, so that pointers to facets (contiguous facets) are
+ * kept valid during the computation. The outside point set of each
+ * facet is a span of a shared index buffer.
  * ********************************************************** */
 
-typedef struct _zQHPoint{
-  zVec3D *v;    /* vertex coordinates */
-  bool discard; /* discarding flag */
-} zQHPoint;
-zListClass(zQHPointList, zQHPointListCell, zQHPoint);
-
 typedef struct _zQHFacet{
-  zQHPoint *p[3];  /* vertices */
+  int p[3];               /* vertices */
   struct _zQHFacet *c[3]; /* contiguous facets */
-  bool merge[3];  /* flag to check if merged with contiguous facets */
-  zQHPointList op; /* outside point set */
-  zVec3D n;        /* normal vector */
-  double d_max;    /* furthest point distance */
-  bool visible;    /* visible set flag */
-  bool check;      /* merge check flag */
+  bool merge[3];          /* flag to check if merged with contiguous facets */
+  zVec3D n;               /* normal vector */
+  int op_head;            /* head of outside point set in the index buffer */
+  int op_num;             /* number of outside points */
+  int op_far;             /* position of the furthest point in the index buffer */
+  double d_max;           /* furthest point distance */
+  bool visible;           /* visible set flag */
+  bool check;             /* merge check flag */
+  bool alive;             /* flag to check if the facet is on the hull */
 } zQHFacet;
-zListClass(zQHFacetList, zQHFacetListCell, zQHFacet);
 
-typedef struct{
-  zQHPointList vl; /* vertices */
-  zQHFacetList fl; /* facets */
+#define Z_QH_FACET_BLOCK_SIZE 1024
+
+typedef struct _zQHFacetBlock{
+  zQHFacet f[Z_QH_FACET_BLOCK_SIZE];
+  int num; /* number of used facets */
+  struct _zQHFacetBlock *next;
+} zQHFacetBlock;
+
+typedef struct _zQH{
+  zVec3D *v;       /* points */
+  int vnum;        /* number of points */
+  int vsize;       /* size of the point array (zero if not owned) */
+  int dim;         /* dimension of the convex hull */
+  zVec3D center;   /* interior point of the convex hull */
+  /* facet arena */
+  zQHFacetBlock *head, *tail;
+  int fnum;        /* number of facets on the hull */
+  /* outside point sets */
+  int *op;         /* index buffer of outside points */
+  int op_size;     /* size of the index buffer */
+  int op_tail;     /* tail of used buffer */
+  int *tmp;        /* points to be reassigned */
+  int *own;        /* owner facets of points to be reassigned */
+  /* visible set and cone */
+  zQHFacet **vs;   /* visible set and facets checked */
+  int vs_num, vs_size;
+  zQHFacet **cone; /* cone consisting of new facets */
+  int cone_num, cone_size;
 } zQH;
 
-/* facet/point operation */
+/* ********************************************************** */
+/* quickhull
+ * ********************************************************** */
+
+#define _zQHVert(qh,f,i) ( &(qh)->v[(f)->p[i]] )
 
-/* create a point. */
-static zQHPoint *_zQHPointCreate(zQHPoint *p, zVec3D *v)
+/* facet arena */
+
+/* allocate a new facet from the arena. */
+static zQHFacet *_zQHFacetAlloc(zQH *qh)
 {
-  p->v = v;
-  p->discard = false;
-  return p;
+  zQHFacetBlock *b;
+
+  if( !qh->tail || qh->tail->num == Z_QH_FACET_BLOCK_SIZE ){
+    if( !( b = zAlloc( zQHFacetBlock, 1 ) ) ){
+      ZALLOCERROR();
+      return NULL;
+    }
+    b->num = 0;
+    b->next = NULL;
+    if( qh->tail )
+      qh->tail->next = b;
+    else
+      qh->head = b;
+    qh->tail = b;
+  }
+  qh->fnum++;
+  return &qh->tail->f[qh->tail->num++];
+}
+
+/* free the arena of facets at once. */
+static void _zQHFacetArenaFree(zQH *qh)
+{
+  zQHFacetBlock *b;
+
+  while( qh->head ){
+    b = qh->head->next;
+    zFree( qh->head );
+    qh->head = b;
+  }
+  qh->tail = NULL;
+  qh->fnum = 0;
+}
+
+/* add a facet to an array of facets. */
+static bool _zQHFacetArrayAdd(zQHFacet ***array, int *num, int *size, zQHFacet *f)
+{
+  zQHFacet **a;
+
+  if( *num >= *size ){
+    if( !( a = zRealloc( *array, zQHFacet*, *size * 2 + 16 ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    *array = a;
+    *size = *size * 2 + 16;
+  }
+  (*array)[(*num)++] = f;
+  return true;
 }
 
+/* facet/point operation */
+
 /* create a new facet. */
-static zQHFacet *_zQHFacetCreate(zQHFacet *f, zQHPoint *p0, zQHPoint *p1, zQHPoint *p2)
+static zQHFacet *_zQHFacetCreate(zQH *qh, zQHFacet *f, int p0, int p1, int p2)
 {
   zVec3D e1, e2;
 
-  zVec3DSub( p1->v, p0->v, &e1 );
-  zVec3DSub( p2->v, p0->v, &e2 );
+  zVec3DSub( &qh->v[p1], &qh->v[p0], &e1 );
+  zVec3DSub( &qh->v[p2], &qh->v[p0], &e2 );
   zVec3DOuterProd( &e1, &e2, &f->n );
   zVec3DNormalizeNCDRC( &f->n );
   f->p[0] = p0;
@@ -58,21 +139,15 @@ static zQHFacet *_zQHFacetCreate(zQHFacet *f, zQHPoint *p0, zQHPoint *p1, zQHPoi
   f->p[2] = p2;
   f->c[0] = f->c[1] = f->c[2] = NULL;
   f->merge[0] = f->merge[1] = f->merge[2] = false;
-  zListInit( &f->op );
+  f->op_head = f->op_num = 0;
+  f->op_far = -1;
   f->d_max = -zTOL;
   f->visible = false;
   f->check = false;
+  f->alive = true;
   return f;
 }
 
-/* destroy a facet. */
-static void _zQHFacetDestroy(zQHFacet *f)
-{
-  f->p[0] = f->p[1] = f->p[2] = NULL;
-  f->c[0] = f->c[1] = f->c[2] = NULL;
-  zListDestroy( zQHPointListCell, &f->op );
-}
-
 /* bind with contiguous facets. */
 static void _zQHFacetContig(zQHFacet *f, zQHFacet *f0, zQHFacet *f1, zQHFacet *f2)
 {
@@ -82,218 +157,270 @@ static void _zQHFacetContig(zQHFacet *f, zQHFacet *f0, zQHFacet *f1, zQHFacet *f
 }
 
 /* convert a facet to a triangle element. */
-static zTri3D *_zQHFacet2Tri3D(zQHFacet *f, zTri3D *t)
+static zTri3D *_zQHFacet2Tri3D(zQH *qh, zQHFacet *f, zTri3D *t)
 {
-  zTri3DSetVert( t, 0, f->p[0]->v );
-  zTri3DSetVert( t, 1, f->p[1]->v );
-  zTri3DSetVert( t, 2, f->p[2]->v );
+  zTri3DSetVert( t, 0, _zQHVert(qh,f,0) );
+  zTri3DSetVert( t, 1, _zQHVert(qh,f,1) );
+  zTri3DSetVert( t, 2, _zQHVert(qh,f,2) );
   zTri3DSetNorm( t, &f->n );
   return t;
 }
 
 /* check if a point is on a facet. */
-static bool _zQHFacetOn(zQHFacet *f, zVec3D *v)
+static bool _zQHFacetOn(zQH *qh, zQHFacet *f, zVec3D *v)
 {
   zTri3D t;
 
-  _zQHFacet2Tri3D( f, &t );
+  _zQHFacet2Tri3D( qh, f, &t );
   return zTri3DPointIsInside( &t, v, true );
 }
 
-/* destroy facet list. */
-static void _zQHFacetListDestroy(zQHFacetList *fl)
+/* beneath-beyond test. */
+static int _zQHFacetBB(zQH *qh, zQHFacet *f, int p, zVec3D *e)
 {
-  zQHFacetListCell *fc;
+  double l;
 
-  while( !zListIsEmpty( fl ) ){
-    zListDeleteHead( fl, &fc );
-    _zQHFacetDestroy( &fc->data );
-    zFree( fc );
-  }
+  zVec3DSub( &qh->v[p], _zQHVert(qh,f,0), e );
+  if( zVec3DIsTiny(e) ) return 0; /* coincide with one vertex */
+  l = zVec3DInnerProd( &f->n, e );
+  if( l < -zTOL ) return -1; /* beneath case */
+  if( l > zTOL ) return 1;   /* beyond case */
+  return _zQHFacetOn( qh, f, &qh->v[p] ) ? 0 : 1;
 }
 
-/* initial simplex */
+/* outside point sets */
 
-/* find vertices of the initial simplex. */
-static int _zQHSimplexVert(zQHPointList *pl, zQHPointListCell *v[])
+/* compact outside point sets of facets on the hull to the head of the index buffer. */
+static void _zQHOutsideCompact(zQH *qh)
 {
-  zQHPointList reserve;
-  zVec3D e[3], d[2], n;
-  double h;
-  int dim = 4;
+  zQHFacetBlock *b;
+  zQHFacet *f;
+  register int i;
 
-  zListInit( &reserve );
-  if( zListIsEmpty( pl ) ){
-    ZRUNWARN( ZEO_ERR_EMPTYSET );
-    return 0;
-  }
-  zListDeleteTail( pl, &v[0] ); /* first vertex */
-  while( !zListIsEmpty( pl ) ){ /* second vertex */
-    zListDeleteTail( pl, &v[1] ); /* candidate */
-    zVec3DSub( v[1]->data.v, v[0]->data.v, &e[0] );
-    if( !zVec3DIsTiny( &e[0] ) ) goto THIRD;
-    zFree( v[1] );
-  }
-  ZRUNWARN( ZEO_ERR_CH_DEG1 );
-  return 1;
- THIRD:
-  zVec3DNormalize( &e[0], &d[0] );
-  while( !zListIsEmpty( pl ) ){ /* third vertex */
-    zListDeleteTail( pl, &v[2] ); /* candidate */
-    zVec3DSub( v[2]->data.v, v[0]->data.v, &e[1] );
-    if( !zVec3DIsTiny( &e[1] ) ){
-      zVec3DNormalize( &e[1], &d[1] );
-      zVec3DOuterProd( &d[0], &d[1], &n );
-      if( !zVec3DIsTiny( &n ) ){
-        zVec3DNormalizeDRC( &n );
-        goto FOURTH;
+  qh->op_tail = 0;
+  /* spans are reserved in order of facet creation, so that they never overlap */
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      f = &b->f[i];
+      if( !f->alive || f->op_num == 0 ) continue;
+      if( f->op_head != qh->op_tail ){
+        memmove( &qh->op[qh->op_tail], &qh->op[f->op_head], sizeof(int)*f->op_num );
+        f->op_far += qh->op_tail - f->op_head;
+        f->op_head = qh->op_tail;
       }
+      qh->op_tail += f->op_num;
     }
-    zListInsertTail( &reserve, v[2] );
-  }
-  ZRUNERROR( ZEO_ERR_CH_DEG2 );
-  dim = 2;
-  goto TERMINATE;
- FOURTH:
-  while( !zListIsEmpty( pl ) ){ /* fourth vertex */
-    zListDeleteTail( pl, &v[3] ); /* candidate */
-    zVec3DSub( v[3]->data.v, v[0]->data.v, &e[2] );
-    h = zVec3DInnerProd( &e[2], &n );
-    if( !zIsTiny( h ) ){
-      if( h > 0 )
-        zSwap( zQHPointListCell*, v[0], v[1] );
-      goto TERMINATE;
+}
+
+/* assign points to the outside sets of facets. */
+static void _zQHFacetAssign(zQH *qh, zQHFacet *f[], int fnum, int p[], int pnum)
+{
+  zVec3D e;
+  double d;
+  int flag, k, total = 0;
+  register int i;
+
+  for( k=0; k<fnum; k++ ){
+    f[k]->op_num = 0;
+    f[k]->op_far = -1;
+  }
+  if( qh->op_tail + pnum > qh->op_size ) _zQHOutsideCompact( qh );
+  /* find the owner facet of each point */
+  for( i=0; i<pnum; i++ ){
+    qh->own[i] = -1;
+    for( k=0; k<fnum; k++ ){
+      if( ( flag = _zQHFacetBB( qh, f[k], p[i], &e ) ) == -1 )
+        continue; /* invisible from the current facet */
+      if( flag == 1 ){ /* visible point */
+        qh->own[i] = k;
+        if( ( d = zVec3DInnerProd( &f[k]->n, &e ) ) > f[k]->d_max || f[k]->op_far < 0 ){
+          f[k]->d_max = d;
+          f[k]->op_far = f[k]->op_num; /* rank in the outside set until its span is reserved */
+        }
+        f[k]->op_num++;
+        total++;
+      } /* otherwise, discard a superficial point on a facet */
+      break;
     }
-    zListInsertTail( &reserve, v[3] );
+  } /* points not owned by any facet are inside of the convex hull */
+  if( total == 0 ) return;
+  /* reserve spans */
+  for( k=0; k<fnum; k++ ){
+    f[k]->op_head = qh->op_tail;
+    qh->op_tail += f[k]->op_num;
+    f[k]->op_num = 0;
+    if( f[k]->op_far >= 0 ) f[k]->op_far += f[k]->op_head;
   }
-  ZRUNERROR( ZEO_ERR_CH_DEG3 );
-  dim = 3;
- TERMINATE:
-  if( !zListIsEmpty( &reserve ) )
-    zListAppend( pl, &reserve );
-  return dim;
+  /* fill spans in the same order as ranked */
+  for( i=0; i<pnum; i++ )
+    if( ( k = qh->own[i] ) >= 0 )
+      qh->op[f[k]->op_head+f[k]->op_num++] = p[i];
 }
 
-/* initial simplex. */
-static int _zQHSimplex(zQH *qh, zQHPointList *pl)
+/* remove the furthest point from the outside set of a facet. */
+static int _zQHFacetPopFurthest(zQH *qh, zQHFacet *f)
 {
-  zQHPointListCell *v[4];
-  zQHFacetListCell *fc[4];
-  int ret, i;
+  zVec3D e;
+  double d;
+  int p;
+  register int i;
 
-  if( ( ret = _zQHSimplexVert( pl, v ) ) < 4 ) return ret;
-  for( i=0; i<4; i++ ){
-    zListInsertHead( &qh->vl, v[i] );
-    if( !( fc[i] = zAlloc( zQHFacetListCell, 1 ) ) ){
-      ZALLOCERROR();
-      return 0;
+  p = qh->op[f->op_far];
+  qh->op[f->op_far] = qh->op[f->op_head+--f->op_num];
+  /* find the next furthest point */
+  f->op_far = -1;
+  for( i=f->op_head; i<f->op_head+f->op_num; i++ ){
+    zVec3DSub( &qh->v[qh->op[i]], _zQHVert(qh,f,0), &e );
+    if( ( d = zVec3DInnerProd( &f->n, &e ) ) > f->d_max || f->op_far < 0 ){
+      f->d_max = d;
+      f->op_far = i;
     }
-    zListInsertHead( &qh->fl, fc[i] );
-  }
-  _zQHFacetCreate( &fc[0]->data, &v[0]->data, &v[1]->data, &v[2]->data );
-  _zQHFacetCreate( &fc[1]->data, &v[0]->data, &v[3]->data, &v[1]->data );
-  _zQHFacetCreate( &fc[2]->data, &v[1]->data, &v[3]->data, &v[2]->data );
-  _zQHFacetCreate( &fc[3]->data, &v[2]->data, &v[3]->data, &v[0]->data );
-  _zQHFacetContig( &fc[0]->data, &fc[2]->data, &fc[3]->data, &fc[1]->data );
-  _zQHFacetContig( &fc[1]->data, &fc[2]->data, &fc[0]->data, &fc[3]->data );
-  _zQHFacetContig( &fc[2]->data, &fc[3]->data, &fc[0]->data, &fc[1]->data );
-  _zQHFacetContig( &fc[3]->data, &fc[1]->data, &fc[0]->data, &fc[2]->data );
-  return ret;
+  }
+  return p;
 }
 
-/* beneath-beyond test. */
-static int _zQHFacetBB(zQHFacet *f, zQHPoint *p, zVec3D *e)
-{
-  double l;
+/* initial simplex */
 
-  zVec3DSub( p->v, f->p[0]->v, e );
-  if( zVec3DIsTiny(e) ) return 0; /* coincide with one vertex */
-  l = zVec3DInnerProd( &f->n, e );
-  if( l < -zTOL ) return -1; /* beneath case */
-  if( l > zTOL ) return 1;   /* beyond case */
-  return _zQHFacetOn( f, p->v ) ? 0 : 1;
+/* find vertices of the initial simplex. */
+static int _zQHSimplexVert(zQH *qh, int v[])
+{
+  int ext[6];
+  zVec3D e, d, n;
+  double l, l_max;
+  register int i, j;
+
+  v[2] = v[3] = 0;
+  /* extreme points along axes */
+  for( j=0; j<6; j++ ) ext[j] = 0;
+  for( i=1; i<qh->vnum; i++ )
+    for( j=0; j<3; j++ ){
+      if( qh->v[i].e[j] < qh->v[ext[j*2]].e[j] ) ext[j*2] = i;
+      if( qh->v[i].e[j] > qh->v[ext[j*2+1]].e[j] ) ext[j*2+1] = i;
+    }
+  /* first and second vertices: the most distant pair of the extreme points */
+  v[0] = v[1] = 0;
+  for( l_max=0, j=0; j<3; j++ )
+    if( ( l = zVec3DSqrDist( &qh->v[ext[j*2]], &qh->v[ext[j*2+1]] ) ) > l_max ){
+      l_max = l;
+      v[0] = ext[j*2];
+      v[1] = ext[j*2+1];
+    }
+  zVec3DSub( &qh->v[v[1]], &qh->v[v[0]], &e );
+  if( zVec3DIsTiny( &e ) ) return 1;
+  zVec3DNormalize( &e, &d );
+  /* third vertex: the furthest point from the line */
+  for( l_max=0, i=0; i<qh->vnum; i++ ){
+    zVec3DSub( &qh->v[i], &qh->v[v[0]], &e );
+    if( ( l = zVec3DOuterProdNorm( &d, &e ) ) > l_max ){
+      l_max = l;
+      v[2] = i;
+    }
+  }
+  if( zIsTiny( l_max ) ) return 2;
+  zVec3DSub( &qh->v[v[2]], &qh->v[v[0]], &e );
+  zVec3DOuterProd( &d, &e, &n );
+  zVec3DNormalizeDRC( &n );
+  /* fourth vertex: the furthest point from the plane */
+  for( l_max=0, i=0; i<qh->vnum; i++ ){
+    zVec3DSub( &qh->v[i], &qh->v[v[0]], &e );
+    if( fabs( l = zVec3DInnerProd( &e, &n ) ) > fabs( l_max ) ){
+      l_max = l;
+      v[3] = i;
+    }
+  }
+  if( zIsTiny( l_max ) ) return 3;
+  if( l_max > 0 ) zSwap( int, v[0], v[1] );
+  return 4;
 }
 
-/* assign points to the outside sets of facets. */
-static void _zQHFacetAssign(zQHFacetList *fl, zQHPointList *pl)
+/* initial simplex. */
+static int _zQHSimplex(zQH *qh)
 {
-  zQHFacetListCell *fc;
-  zQHPointListCell *pc, *pc_tmp;
-  zVec3D e;
-  double d;
-  int flag;
+  int v[4];
+  zQHFacet *f[4];
+  int ret, num = 0;
+  register int i;
 
-  zListForEach( fl, fc )
-    zListForEach( pl, pc ){
-      flag = _zQHFacetBB( &fc->data, &pc->data, &e );
-      if( flag == -1 ) continue; /* invisible from the current facet */
-      pc_tmp = zListCellPrev( pc );
-      zListPurge( pl, pc );
-      if( flag == 0 ){
-        /* discard a superficial point on a facet */
-        zFree( pc );
-      } else{ /* visible point */
-        d = zVec3DInnerProd( &fc->data.n, &e );
-        if( d > fc->data.d_max ){
-          fc->data.d_max = d;
-          zListInsertHead( &fc->data.op, pc );
-        } else
-          zListInsertTail( &fc->data.op, pc );
-      }
-      pc = pc_tmp;
-    }
-  /* discard points inside of the convex hull */
-  zListDestroy( zQHPointListCell, pl );
+  if( ( ret = _zQHSimplexVert( qh, v ) ) < 4 ) return ret;
+  for( i=0; i<4; i++ )
+    if( !( f[i] = _zQHFacetAlloc( qh ) ) ) return 0;
+  _zQHFacetCreate( qh, f[0], v[0], v[1], v[2] );
+  _zQHFacetCreate( qh, f[1], v[0], v[3], v[1] );
+  _zQHFacetCreate( qh, f[2], v[1], v[3], v[2] );
+  _zQHFacetCreate( qh, f[3], v[2], v[3], v[0] );
+  _zQHFacetContig( f[0], f[2], f[3], f[1] );
+  _zQHFacetContig( f[1], f[2], f[0], f[3] );
+  _zQHFacetContig( f[2], f[3], f[0], f[1] );
+  _zQHFacetContig( f[3], f[1], f[0], f[2] );
+  /* interior point of the convex hull */
+  zVec3DZero( &qh->center );
+  for( i=0; i<4; i++ ) zVec3DAddDRC( &qh->center, &qh->v[v[i]] );
+  zVec3DDivDRC( &qh->center, 4 );
+  /* initial beneath-beyond test */
+  for( i=0; i<qh->vnum; i++ )
+    if( i != v[0] && i != v[1] && i != v[2] && i != v[3] )
+      qh->tmp[num++] = i;
+  _zQHFacetAssign( qh, f, 4, qh->tmp, num );
+  return ret;
 }
 
 /* merge coplanar facets. */
-static void _zQHMerge(zQHFacet *f)
+static bool _zQHMerge(zQH *qh, zQHFacet *f)
 {
   f->visible = true;
   f->check = true;
-  if( f->merge[0] && !f->c[0]->check ) _zQHMerge( f->c[0] );
-  if( f->merge[1] && !f->c[1]->check ) _zQHMerge( f->c[1] );
-  if( f->merge[2] && !f->c[2]->check ) _zQHMerge( f->c[2] );
+  if( !_zQHFacetArrayAdd( &qh->vs, &qh->vs_num, &qh->vs_size, f ) ) return false;
+  if( f->merge[0] && !f->c[0]->check && !_zQHMerge( qh, f->c[0] ) ) return false;
+  if( f->merge[1] && !f->c[1]->check && !_zQHMerge( qh, f->c[1] ) ) return false;
+  if( f->merge[2] && !f->c[2]->check && !_zQHMerge( qh, f->c[2] ) ) return false;
+  return true;
 }
 
-/* reset visibility flags of all facets. */
+/* reset visibility flags of facets checked. */
 static void _zQHFacetResetFlag(zQH *qh)
 {
-  zQHFacetListCell *fc;
+  register int i;
 
-  zListForEach( &qh->fl, fc ){
-    fc->data.visible = false;
-    fc->data.check = false;
+  for( i=0; i<qh->vs_num; i++ ){
+    qh->vs[i]->visible = false;
+    qh->vs[i]->check = false;
   }
 }
 
-/* purge visible set from facet list and collect outside points. */
-static bool _zQHVisibleSet(zQH *qh, zQHPoint *p, zQHFacetList *vs, zQHPointList *pl)
+/* find the visible set from a point beyond a facet by breadth-first search.
+ * vs holds both visible facets and invisible facets adjacent to them.
+ * the point is discarded if it is on any of them including facets merged
+ * without the beneath-beyond test. */
+static int _zQHVisibleSet(zQH *qh, zQHFacet *f, int p)
 {
-  zQHFacetListCell *fc, *fc_tmp;
+  zQHFacet *g;
   zVec3D e;
   int flag;
+  register int i, s;
 
-  zListInit( vs );
-  zListInit( pl );
-  zListForEach( &qh->fl, fc ){
-    flag = _zQHFacetBB( &fc->data, p, &e );
-    if( flag == 0 ){
+  qh->vs_num = 0;
+  if( !_zQHMerge( qh, f ) ) return -1;
+  for( i=0; i<qh->vs_num; i++ ){
+    if( !qh->vs[i]->visible ) continue;
+    if( _zQHFacetBB( qh, qh->vs[i], p, &e ) == 0 ){
       _zQHFacetResetFlag( qh );
-      return false;
+      return 0;
     }
-    if( flag == 1 && !fc->data.check ) _zQHMerge( &fc->data );
-  }
-  zListForEach( &qh->fl, fc )
-    if( fc->data.visible ){ /* if visible, the facet will be deleted. */
-      fc_tmp = zListCellPrev( fc );
-      zListPurge( &qh->fl, fc ); /* delete from facet list */
-      zListInsertTail( vs, fc ); /* insert to visible set */
-      zListAppendZ( pl, &fc->data.op ); /* points to be reassigned */
-      fc->data.p[0]->discard = fc->data.p[1]->discard = fc->data.p[2]->discard = true;
-      fc = fc_tmp;
+    for( s=0; s<3; s++ ){
+      if( ( g = qh->vs[i]->c[s] )->check ) continue;
+      if( ( flag = _zQHFacetBB( qh, g, p, &e ) ) == 0 ){
+        _zQHFacetResetFlag( qh );
+        return 0;
+      }
+      if( flag == 1 ){
+        if( !_zQHMerge( qh, g ) ) return -1;
+      } else{
+        g->check = true;
+        if( !_zQHFacetArrayAdd( &qh->vs, &qh->vs_num, &qh->vs_size, g ) ) return -1;
+      }
     }
-  return true;
+  }
+  return 1;
 }
 
 /* find counter identifier of the contiguous facet. */
@@ -307,7 +434,7 @@ static int _zQHFacetContigID(zQHFacet *f, int s)
 }
 
 /* bind two contiguous facets with each other. */
-static void _zQHFacetBind(zQHFacet *f1, int s1, zQHFacet *f2, int s2)
+static void _zQHFacetBind(zQH *qh, zQHFacet *f1, int s1, zQHFacet *f2, int s2)
 {
   zVec3D e, d;
   bool flag = false;
@@ -321,7 +448,7 @@ static void _zQHFacetBind(zQHFacet *f1, int s1, zQHFacet *f2, int s2)
     if( zVec3DIsTiny( zVec3DOuterProd( &f1->n, &f2->n, &d ) ) )
       flag = true; /* normal vectors almost parallel */
     else{
-      zVec3DSub( f1->p[(s1+2)%3]->v, f1->p[(s1+1)%3]->v, &e );
+      zVec3DSub( _zQHVert(qh,f1,(s1+2)%3), _zQHVert(qh,f1,(s1+1)%3), &e );
       if( zVec3DInnerProd( &e, &d ) < 0 )
         flag = true; /* non-convex contiguous facets (abnormal) */
     }
@@ -330,51 +457,47 @@ static void _zQHFacetBind(zQHFacet *f1, int s1, zQHFacet *f2, int s2)
 }
 
 /* create a new facet from a new vertex and a horizon ridge. */
-static zQHFacetListCell *_zQHHorizonNewFacet(zQHPoint *p, zQHFacet *f, int s)
+static zQHFacet *_zQHHorizonNewFacet(zQH *qh, int p, zQHFacet *f, int s)
 {
-  zQHFacetListCell *fc;
+  zQHFacet *fn;
   int s1, s2;
 
-  if( !( fc = zAlloc( zQHFacetListCell, 1 ) ) ) return NULL;
+  if( !( fn = _zQHFacetAlloc( qh ) ) ) return NULL;
   s1 = ( s + 1 ) % 3;
   s2 = ( s + 2 ) % 3;
-  f->p[s1]->discard = f->p[s2]->discard = false;
-  if( _zQHFacetCreate( &fc->data, p, f->p[s1], f->p[s2] ) &&
-      ( s1 = _zQHFacetContigID( f, s ) ) != -1 ){
-    _zQHFacetBind( &fc->data, 0, f->c[s], s1 );
-    return fc;
-  }
-  ZRUNERROR( ZEO_ERR_FATAL );
-  zFree( fc );
-  return NULL;
+  _zQHFacetCreate( qh, fn, p, f->p[s1], f->p[s2] );
+  if( ( s1 = _zQHFacetContigID( f, s ) ) == -1 ) return NULL;
+  _zQHFacetBind( qh, fn, 0, f->c[s], s1 );
+  return _zQHFacetArrayAdd( &qh->cone, &qh->cone_num, &qh->cone_size, fn ) ? fn : NULL;
 }
 
 /* find the horizon ridges and create new facets. */
-static bool _zQHHorizon(zQHFacetList *vs, zQHPoint *p, zQHFacetList *cone)
+static bool _zQHHorizon(zQH *qh, int p)
 {
-  zQHFacetListCell *fc;
-  zQHFacet *f, *f_prev;
-  zQHPoint *p0;
-  int n;
-  register int i = 0, s;
+  zQHFacet *f = NULL, *f_prev;
+  int p0, n;
+  register int i, s;
 
-  zListInit( cone );
+  qh->cone_num = 0;
   /* find first ridge */
-  zListForEach( vs, fc )
+  for( i=0; i<qh->vs_num; i++ ){
+    if( !qh->vs[i]->visible ) continue;
     for( s=0; s<3; s++ )
-      if( !fc->data.c[s]->visible ) goto START;
+      if( !qh->vs[i]->c[s]->visible ){
+        f = qh->vs[i];
+        goto START;
+      }
+  }
   ZRUNERROR( ZEO_ERR_FATAL );
   return false;
 
  START:
+  n = qh->vs_num * 3;
   /* first facet in the cone */
-  f = &fc->data;
-  if( !( fc = _zQHHorizonNewFacet( p, f, s ) ) )
-    return false;
-  zListInsertHead( cone, fc );
+  if( !_zQHHorizonNewFacet( qh, p, f, s ) ) return false;
   s = ( s + 1 ) % 3;
   p0 = f->p[s];
-  n = zListSize( vs ) * 3;
+  i = 0;
   do{
     if( i++ > n ){ /* probably a circulation occurs */
       ZRUNERROR( ZEO_ERR_FATAL );
@@ -389,138 +512,202 @@ static bool _zQHHorizon(zQHFacetList *vs, zQHPoint *p, zQHFacetList *cone)
       }
       s = ( s + 1 ) % 3;
     } else{
-      if( !( fc = _zQHHorizonNewFacet( p, f, s ) ) )
-        return false;
-      _zQHFacetBind( &fc->data, 2, &zListHead(cone)->data, 1 );
-      zListInsertHead( cone, fc );
+      if( !_zQHHorizonNewFacet( qh, p, f, s ) ) return false;
+      _zQHFacetBind( qh, qh->cone[qh->cone_num-1], 2, qh->cone[qh->cone_num-2], 1 );
       s = ( s + 1 ) % 3;
     }
   } while( f->p[(s+1)%3] != p0 );
   /* bind head and tail of the cone */
-  _zQHFacetBind( &zListHead(cone)->data, 1, &zListTail(cone)->data, 2 );
+  _zQHFacetBind( qh, qh->cone[qh->cone_num-1], 1, qh->cone[0], 2 );
   return true;
 }
 
 /* incrementally create new vertices and facets. */
 static bool _zQHInc(zQH *qh, zQHFacet *f)
 {
-  zQHPointListCell *pc; /* furthest point */
-  zQHPointList pl; /* list of points to be reassigned */
-  zQHFacetList vs; /* visible facet set */
-  zQHFacetList cone; /* cone consisting of new facets */
+  zQHFacet *g;
+  int p, num = 0, ret;
+  register int i, j;
 
   /* pick up a new vertex */
-  zListDeleteHead( &f->op, &pc );
-  /* create visible set and collect points to be reassigned */
-  if( !_zQHVisibleSet( qh, &pc->data, &vs, &pl ) ){
-    zFree( pc );
-    return true; /* retry another facet */
-  }
-  zListInsertHead( &qh->vl, pc );
+  p = _zQHFacetPopFurthest( qh, f );
+  /* create visible set */
+  if( ( ret = _zQHVisibleSet( qh, f, p ) ) <= 0 )
+    return ret == 0; /* retry another point */
   /* create a cone of the new vertex and horizon ridges */
-  if( !_zQHHorizon( &vs, &pc->data, &cone ) ){
-    _zQHFacetListDestroy( &cone );
-    _zQHFacetListDestroy( &vs );
-    return false;
+  if( !_zQHHorizon( qh, p ) ) return false;
+  /* remove visible facets and collect points to be reassigned */
+  for( i=0; i<qh->vs_num; i++ ){
+    g = qh->vs[i];
+    g->check = false;
+    if( !g->visible ) continue;
+    for( j=g->op_head; j<g->op_head+g->op_num; j++ )
+      qh->tmp[num++] = qh->op[j];
+    g->op_num = 0;
+    g->alive = false;
+    qh->fnum--;
   }
-  _zQHFacetAssign( &cone, &pl ); /* reassign points outside of the cone */
-  zListAppendA( &qh->fl, &cone ); /* merge the cone to the convex hull */
-  _zQHFacetListDestroy( &vs ); /* destroy visible set */
+  _zQHFacetAssign( qh, qh->cone, qh->cone_num, qh->tmp, num );
   return true;
 }
 
-/* discard old vertices inside of the convex hull. */
-static void _zQHDiscard(zQH *qh, zQHPointList *pl)
+/* initialize working space for quickhull. */
+static bool _zQHInit(zQH *qh, zVec3D v[], int num)
 {
-  zQHPointListCell *pc;
-
-  zListAppend( pl, &qh->vl );
-  while( !zListIsEmpty(pl) ){
-    zListDeleteTail( pl, &pc );
-    if( pc->data.discard )
-      zFree( pc );
-    else
-      zListInsertHead( &qh->vl, pc );
+  qh->v = v;
+  qh->vnum = num;
+  qh->vsize = 0;
+  qh->dim = 0;
+  qh->head = qh->tail = NULL;
+  qh->fnum = 0;
+  qh->op_size = 2 * num;
+  qh->op_tail = 0;
+  qh->op = zAlloc( int, qh->op_size );
+  qh->tmp = zAlloc( int, num );
+  qh->own = zAlloc( int, num );
+  qh->vs = qh->cone = NULL;
+  qh->vs_num = qh->vs_size = qh->cone_num = qh->cone_size = 0;
+  if( !qh->op || !qh->tmp || !qh->own ){
+    ZALLOCERROR();
+    return false;
   }
+  return true;
 }
 
-/* create the convex hull of a point set. */
-static int _zQHCreate(zQH *qh, zQHPointList *pl)
-{
-  zQHFacetListCell *fc;
-  int dim;
-
-  /* initialize vertex & facet list */
-  zListInit( &qh->vl );
-  zListInit( &qh->fl );
-  /* create simplex */
-  if( ( dim = _zQHSimplex( qh, pl ) ) < 4 ) return dim;
-  _zQHFacetAssign( &qh->fl, pl ); /* initial beneath-beyond test */
-
-  /* incrementally generate new facets */
-  zListForEach( &qh->fl, fc )
-    if( !zListIsEmpty( &fc->data.op ) ){
-      if( !_zQHInc( qh, &fc->data ) ) break;
-      fc = zListRoot( &qh->fl ); /* retry from the tail */
-    }
+/* destroy working space for quickhull. */
+static void _zQHDestroy(zQH *qh)
+{
+  _zQHFacetArenaFree( qh );
+  zFree( qh->op );
+  zFree( qh->tmp );
+  zFree( qh->own );
+  zFree( qh->vs );
+  zFree( qh->cone );
+  if( qh->vsize > 0 ) zFree( qh->v );
+  qh->vnum = qh->vsize = 0;
+  qh->dim = 0;
+}
+
+/* expand the convex hull until outside point sets of all facets get empty. */
+static bool _zQHExpand(zQH *qh)
+{
+  zQHFacetBlock *b;
+  zQHFacet *f;
+  register int i;
 
-  _zQHDiscard( qh, pl ); /* discard old vertices */
-  return dim;
+  /* new facets are appended to the arena */
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ )
+      for( f=&b->f[i]; f->alive && f->op_num > 0; )
+        if( !_zQHInc( qh, f ) ) return false;
+  return true;
 }
 
-/* destroy the convex hull. */
-static void _zQHDestroy(zQH *qh)
+/* create the convex hull of a point set. */
+static int _zQHCreate(zQH *qh)
 {
-  zListDestroy( zQHPointListCell, &qh->vl );
-  _zQHFacetListDestroy( &qh->fl );
+  if( ( qh->dim = _zQHSimplex( qh ) ) < 4 ) return qh->dim;
+  if( _zQHExpand( qh ) ) return qh->dim;
+  _zQHFacetArenaFree( qh );
+  return ( qh->dim = 0 );
 }
 
 /* convert the convex hull to a polyhedron. */
 static zPH3D *_zQH2PH3D(zQH *qh, zPH3D *ph)
 {
-  zVec3D *vp;
-  zTri3D *fp;
-  zQHPointListCell *pc;
-  zQHFacetListCell *fc;
-
-  if( !zPH3DAlloc( ph, zListSize(&qh->vl), zListSize(&qh->fl) ) )
-    return NULL;
-  vp = zPH3DVertBuf(ph);
-  zListForEach( &qh->vl, pc ){
-    zVec3DCopy( pc->data.v, vp );
-    pc->data.v = vp++;
-  }
-  fp = zPH3DFaceBuf(ph);
-  zListForEach( &qh->fl, fc )
-    _zQHFacet2Tri3D( &fc->data, fp++ );
+  zQHFacetBlock *b;
+  zQHFacet *f;
+  zTri3D *t;
+  int vnum = 0;
+  register int i, j;
+
+  for( i=0; i<qh->vnum; i++ ) qh->own[i] = -1;
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      if( !( f = &b->f[i] )->alive ) continue;
+      for( j=0; j<3; j++ )
+        if( qh->own[f->p[j]] < 0 ) qh->own[f->p[j]] = vnum++;
+    }
+  if( !zPH3DAlloc( ph, vnum, qh->fnum ) ) return NULL;
+  for( i=0; i<qh->vnum; i++ )
+    if( qh->own[i] >= 0 ) zVec3DCopy( &qh->v[i], zPH3DVert(ph,qh->own[i]) );
+  t = zPH3DFaceBuf(ph);
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      if( !( f = &b->f[i] )->alive ) continue;
+      for( j=0; j<3; j++ )
+        zTri3DSetVert( t, j, zPH3DVert(ph,qh->own[f->p[j]]) );
+      zTri3DSetNorm( t, &f->n );
+      t++;
+    }
   return ph;
 }
 
-/* convex hull from list of 3D points. */
-zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *vl)
+/* vertex adjacency of the convex hull.
+ * NOTE: it assumes that the convex hull is already converted to a polyhedron. */
+static zPH3DAdj *_zQH2Adj(zQH *qh, zPH3D *ph, zPH3DAdj *adj)
+{
+  zQHFacetBlock *b;
+  zQHFacet *f;
+  register int i, j;
+
+  /* each directed edge appears exactly once on a closed hull */
+  if( !zPH3DAdjAlloc( adj, zPH3DVertNum(ph), qh->fnum*3 ) ) return NULL;
+  for( i=0; i<=adj->num; i++ ) adj->head[i] = 0;
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      if( !( f = &b->f[i] )->alive ) continue;
+      for( j=0; j<3; j++ ) adj->head[qh->own[f->p[j]]+1]++;
+    }
+  for( i=0; i<adj->num; i++ ) adj->head[i+1] += adj->head[i];
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      if( !( f = &b->f[i] )->alive ) continue;
+      for( j=0; j<3; j++ )
+        adj->idx[adj->head[qh->own[f->p[j]]]++] = qh->own[f->p[(j+1)%3]];
+    }
+  for( i=adj->num; i>0; i-- ) adj->head[i] = adj->head[i-1];
+  adj->head[0] = 0;
+  return adj;
+}
+
+/* convex hull of 3D points and its vertex adjacency. */
+static zPH3D *_zCH3D(zPH3D *ch, zPH3DAdj *adj, zVec3D p[], int num)
 {
-  zVec3DListCell *vc;
-  zQHPointListCell *pc;
-  zQHPointList pl;
   zQH qh;
   int ret;
 
-  /* create point list */
-  zListInit( &pl );
-  zListForEach( vl, vc ){
-    if( !( pc = zAlloc( zQHPointListCell, 1 ) ) ) break;
-    _zQHPointCreate( &pc->data, vc->data );
-    zListInsertHead( &pl, pc );
+  zPH3DInit( ch );
+  if( adj ) zPH3DAdjInit( adj );
+  if( num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  if( !_zQHInit( &qh, p, num ) ){
+    _zQHDestroy( &qh );
+    return NULL;
   }
   /* quickhull */
-  if( ( ret = _zQHCreate( &qh, &pl ) ) < 4 ){
-    zListDestroy( zQHPointListCell, &pl );
-    if( ret == 3 ) /* planar convex hull */
-      return zCH2DPL2PH3D( ch, vl );
+  if( ( ret = _zQHCreate( &qh ) ) < 4 ){
+    _zQHDestroy( &qh );
+    if( ret == 1 ) ZRUNWARN( ZEO_ERR_CH_DEG1 );
+    if( ret == 2 ) ZRUNERROR( ZEO_ERR_CH_DEG2 );
+    if( ret == 3 ){ /* planar convex hull */
+      ZRUNERROR( ZEO_ERR_CH_DEG3 );
+      if( !zCH2D2PH3D( ch, p, num ) ) return NULL;
+      if( adj && !zPH3DAdjCreate( adj, ch ) ){
+        zPH3DDestroy( ch );
+        return NULL;
+      }
+      return ch;
+    }
     return NULL;
   }
   /* convert to a polyhedron */
-  _zQH2PH3D( &qh, ch );
+  if( !_zQH2PH3D( &qh, ch ) || ( adj && !_zQH2Adj( &qh, ch, adj ) ) ){
+    zPH3DDestroy( ch );
+    ch = NULL;
+  }
   _zQHDestroy( &qh );
   return ch;
 }
@@ -528,115 +715,491 @@ zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *vl)
 /* convex hull of 3D points. */
 zPH3D *zCH3D(zPH3D *ch, zVec3D p[], int num)
 {
-  zQHPointListCell *pc;
-  zQHPointList pl;
-  zQH qh;
-  register int i;
-  int ret;
+  return _zCH3D( ch, NULL, p, num );
+}
+
+/* convex hull of 3D points with vertex adjacency. */
+zPH3D *zCH3DAdj(zPH3D *ch, zPH3DAdj *adj, zVec3D p[], int num)
+{
+  return _zCH3D( ch, adj, p, num );
+}
+
+/* convex hull from list of 3D points. */
+zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *vl)
+{
+  zVec3DListCell *vc;
+  zVec3D *p;
+  int num = 0;
 
   zPH3DInit( ch );
-  /* create point list */
-  zListInit( &pl );
-  for( i=0; i<num; i++ ){
-    if( !( pc = zAlloc( zQHPointListCell, 1 ) ) ) break;
-    _zQHPointCreate( &pc->data, &p[i] );
-    zListInsertHead( &pl, pc );
+  if( zListIsEmpty( vl ) ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
   }
-  /* quickhull */
-  if( ( ret = _zQHCreate( &qh, &pl ) ) < 4 ){
-    zListDestroy( zQHPointListCell, &pl );
-    if( ret == 3 ) /* planar convex hull */
-      return zCH2D2PH3D( ch, p, num );
+  if( !( p = zAlloc( zVec3D, zListSize(vl) ) ) ){
+    ZALLOCERROR();
     return NULL;
   }
-  /* convert to a polyhedron */
-  _zQH2PH3D( &qh, ch );
-  _zQHDestroy( &qh );
+  zListForEach( vl, vc )
+    zVec3DCopy( vc->data, &p[num++] );
+  ch = zCH3D( ch, p, num );
+  zFree( p );
   return ch;
 }
 
-/* for debug */
-#ifdef DEBUG
-static void _zQHFacetInfo(zQHFacet *f)
+/* ********************************************************** */
+/* incremental convex hull
+ * ********************************************************** */
+
+/* reserve working space for incremental convex hull. */
+static bool _zQHReserve(zQH *qh, int num)
 {
-  printf( ">> facet:%p\n", f );
-  printf( "[vert#0] " ); zVec3DPrint( f->p[0]->v );
-  printf( "[vert#1] " ); zVec3DPrint( f->p[1]->v );
-  printf( "[vert#2] " ); zVec3DPrint( f->p[2]->v );
-  printf( "[contig#0] %p %g %s\n", f->c[0], zVec3DInnerProd(&f->n,&f->c[0]->n)-1, f->merge[0] ? " :merged" : "" );
-  printf( "[contig#1] %p %g %s\n", f->c[1], zVec3DInnerProd(&f->n,&f->c[1]->n)-1, f->merge[1] ? " :merged" : "" );
-  printf( "[contig#2] %p %g %s\n", f->c[2], zVec3DInnerProd(&f->n,&f->c[2]->n)-1, f->merge[2] ? " :merged" : "" );
-  printf( "normal vector: " ); zVec3DPrint( &f->n );
+  zVec3D *v;
+  int *op, *tmp, *own, size;
+
+  if( num <= qh->vsize ) return true;
+  size = zMax( num, qh->vsize * 2 );
+  if( !( v = zRealloc( qh->v, zVec3D, size ) ) ) goto FAILURE;
+  qh->v = v;
+  if( !( op = zRealloc( qh->op, int, size * 2 ) ) ) goto FAILURE;
+  qh->op = op;
+  if( !( tmp = zRealloc( qh->tmp, int, size ) ) ) goto FAILURE;
+  qh->tmp = tmp;
+  if( !( own = zRealloc( qh->own, int, size ) ) ) goto FAILURE;
+  qh->own = own;
+  qh->vsize = size;
+  qh->op_size = size * 2;
+  return true;
+ FAILURE:
+  ZALLOCERROR();
+  return false;
 }
 
-static void _zQHFacetListInfo(zQHFacetList *fl)
+/* collect garbage vertices and facets which are no longer on the hull. */
+static bool _zQHCollectGarbage(zQH *qh)
 {
-  zQHFacetListCell *fc;
+  zQHFacetBlock *b, *head;
+  zQHFacet *f, *fn;
+  int vnum = 0, fnum = 0;
+  register int i, j;
+
+  /* renumber vertices and facets on the hull */
+  for( i=0; i<qh->vnum; i++ ) qh->own[i] = -1;
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      if( !( f = &b->f[i] )->alive ) continue;
+      f->op_head = fnum++; /* outside sets are all empty */
+      for( j=0; j<3; j++ ) qh->own[f->p[j]] = 0;
+    }
+  for( i=0; i<qh->vnum; i++ )
+    if( qh->own[i] == 0 ){
+      zVec3DCopy( &qh->v[i], &qh->v[vnum] );
+      qh->own[i] = vnum++;
+    }
+  qh->vnum = vnum;
+  /* move facets to a new arena */
+  head = qh->head;
+  qh->head = qh->tail = NULL;
+  qh->fnum = qh->vs_num = 0;
+  for( b=head; b; b=b->next )
+    for( i=0; i<b->num; i++ ){
+      if( !( f = &b->f[i] )->alive ) continue;
+      if( !( fn = _zQHFacetAlloc( qh ) ) ||
+          !_zQHFacetArrayAdd( &qh->vs, &qh->vs_num, &qh->vs_size, fn ) ) goto TERMINATE;
+      zCopy( zQHFacet, f, fn );
+      for( j=0; j<3; j++ ) fn->p[j] = qh->own[f->p[j]];
+      fn->op_head = fn->op_num = 0;
+    }
+  for( i=0; i<qh->vs_num; i++ )
+    for( j=0; j<3; j++ )
+      qh->vs[i]->c[j] = qh->vs[qh->vs[i]->c[j]->op_head];
+  qh->op_tail = 0;
+ TERMINATE:
+  for( ; head; head=b ){
+    b = head->next;
+    zFree( head );
+  }
+  qh->vs_num = 0;
+  return qh->fnum == fnum;
+}
 
-  zListForEach( fl, fc )
-    _zQHFacetInfo( &fc->data );
+/* find a facet through which a ray from the interior point to a point passes. */
+static zQHFacet *_zQHFacetLocate(zQH *qh, zQHFacet *f, zVec3D *p)
+{
+  zVec3D d, e1, e2, m, e0;
+  int step;
+  register int i, s;
+
+  zVec3DSub( p, &qh->center, &d );
+  for( step=0; step<qh->fnum; step++ ){
+    for( i=0; i<3; i++ ){
+      s = ( i + step ) % 3;
+      zVec3DSub( _zQHVert(qh,f,(s+1)%3), &qh->center, &e1 );
+      zVec3DSub( _zQHVert(qh,f,(s+2)%3), &qh->center, &e2 );
+      zVec3DSub( _zQHVert(qh,f,s), &qh->center, &e0 );
+      zVec3DOuterProd( &e1, &e2, &m );
+      if( zVec3DInnerProd( &m, &d ) * zVec3DInnerProd( &m, &e0 ) < 0 ) break;
+    }
+    if( i == 3 ) return f;
+    f = f->c[s]; /* move to the contiguous facet across the separating ridge */
+  }
+  return NULL; /* a circulation occurs */
 }
 
-static void _zQHPointListPrint(zQHPointList *pl, char filename[])
+/* find the owner facet of a new point of an incremental convex hull. */
+static zQHFacet *_zQHFacetOwner(zQH *qh, zQHFacet *f, int p)
 {
-  zQHPointListCell *pc;
-  FILE *fp;
+  zQHFacetBlock *b;
+  zVec3D e;
+  register int i;
 
-  fp = fopen( filename, "w" );
-  zListForEach( pl, pc )
-    zVec3DDataNLFPrint( fp, pc->data.v );
-  fclose( fp );
+  if( ( f = _zQHFacetLocate( qh, f, &qh->v[p] ) ) )
+    return _zQHFacetBB( qh, f, p, &e ) == 1 ? f : NULL;
+  /* exhaustive search */
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ )
+      if( b->f[i].alive && _zQHFacetBB( qh, &b->f[i], p, &e ) == 1 ) return &b->f[i];
+  return NULL;
 }
 
-static void _zQHFacetListPrint(zQHFacetList *fl, char filename[])
+/* assign new points to outside sets of facets on an incremental convex hull. */
+static bool _zQHFacetAssignInc(zQH *qh, int p, int num)
 {
-  zQHFacetListCell *fc;
-  FILE *fp;
+  zQHFacetBlock *b;
+  zQHFacet *f, *fs;
+  zVec3D e;
+  double d;
+  register int i;
 
-  fp = fopen( filename, "w" );
-  zListForEach( fl, fc ){
-    zVec3DDataNLFPrint( fp, fc->data.p[1]->v );
-    zVec3DDataNLFPrint( fp, fc->data.p[2]->v );
-    fprintf( fp, "\n" );
-    zVec3DDataNLFPrint( fp, fc->data.p[0]->v );
-    zVec3DDataNLFPrint( fp, fc->data.p[0]->v );
-    fprintf( fp, "\n\n" );
+  for( fs=NULL, b=qh->head; b && !fs; b=b->next )
+    for( i=0; i<b->num; i++ )
+      if( b->f[i].alive ){
+        fs = &b->f[i];
+        break;
+      }
+  /* find owner facets */
+  qh->cone_num = 0;
+  for( i=p; i<p+num; i++ ){
+    if( ( f = _zQHFacetOwner( qh, fs, i ) ) ){
+      zVec3DSub( &qh->v[i], _zQHVert(qh,f,0), &e );
+      if( ( d = zVec3DInnerProd( &f->n, &e ) ) > f->d_max || f->op_num == 0 ){
+        f->d_max = d;
+        f->op_far = f->op_num; /* rank in the outside set until its span is reserved */
+      }
+      f->op_num++;
+      fs = f;
+    }
+    if( !_zQHFacetArrayAdd( &qh->cone, &qh->cone_num, &qh->cone_size, f ) ) return false;
   }
-  fclose(fp);
+  /* reserve spans of the outside sets and fill them */
+  qh->op_tail = 0; /* outside sets are all empty */
+  for( i=0; i<num; i++ ){
+    if( !( f = qh->cone[i] ) ) continue;
+    if( !f->check ){
+      f->check = true;
+      f->op_head = qh->op_tail;
+      qh->op_tail += f->op_num;
+      f->op_num = 0;
+      f->op_far += f->op_head;
+    }
+    qh->op[f->op_head+f->op_num++] = p + i;
+  }
+  for( i=0; i<num; i++ )
+    if( qh->cone[i] ) qh->cone[i]->check = false;
+  return true;
 }
 
-static void _zQHPrint(zQH *qh)
+/* initialize the working space of an incremental convex hull. */
+static zQH *_zQHIncInit(zQH *qh)
 {
-  zQHFacetListCell *fc;
-  zQHPointListCell *pc;
-  FILE *fp;
+  qh->v = NULL;
+  qh->vnum = qh->vsize = 0;
+  qh->dim = 0;
+  qh->head = qh->tail = NULL;
+  qh->fnum = 0;
+  qh->op = qh->tmp = qh->own = NULL;
+  qh->op_size = qh->op_tail = 0;
+  qh->vs = qh->cone = NULL;
+  qh->vs_num = qh->vs_size = qh->cone_num = qh->cone_size = 0;
+  return qh;
+}
 
-  _zQHFacetListPrint( &qh->fl, "ch" );
-  _zQHPointListPrint( &qh->vl, "chv" );
-  fp = fopen( "op", "w" );
-  zListForEach( &qh->fl, fc )
-    zListForEach( &fc->data.op, pc )
-      zVec3DDataNLFPrint( fp, pc->data.v );
-  fclose( fp );
+/* initialize an incremental convex hull. */
+zCH3DInc *zCH3DIncInit(zCH3DInc *ch)
+{
+  ch->qh = NULL; /* allocated when the first point is added */
+  return ch;
 }
 
-static void _zQHPrint2(zQH *qh)
+/* add points to an incremental convex hull. */
+bool zCH3DIncAdd(zCH3DInc *ch, zVec3D p[], int num)
 {
-  zQHFacetListCell *fc;
-  zQHPointListCell *pc;
-  FILE *fp;
-  int i=0;
-  char filename[BUFSIZ];
+  zQH *qh;
+  zQHFacetBlock *b;
+  int fsize = 0;
+
+  if( num <= 0 ) return true;
+  if( !ch->qh ){
+    if( !( ch->qh = zAlloc( zQH, 1 ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    _zQHIncInit( ch->qh );
+  }
+  qh = ch->qh;
+  if( !_zQHReserve( qh, qh->vnum + num ) ) return false;
+  memcpy( &qh->v[qh->vnum], p, sizeof(zVec3D)*num );
+  if( qh->dim < 4 ){ /* the convex hull has not been created yet */
+    qh->vnum += num;
+    if( qh->vnum < 4 ) return true;
+    return _zQHCreate( qh ) > 0;
+  }
+  /* assign new points to outside sets of facets on the hull */
+  qh->vnum += num;
+  if( !_zQHFacetAssignInc( qh, qh->vnum - num, num ) ||
+      !_zQHExpand( qh ) ) return false;
+  for( b=qh->head; b; b=b->next ) fsize += b->num;
+  /* collect garbage if more than a half of vertices or facets are out of the hull */
+  if( fsize > 2 * qh->fnum + Z_QH_FACET_BLOCK_SIZE || qh->vnum > qh->fnum + 4 )
+    return _zQHCollectGarbage( qh );
+  return true;
+}
 
-  _zQHFacetListPrint( &qh->fl, "ch" );
-  _zQHPointListPrint( &qh->vl, "chv" );
-  zListForEach( &qh->fl, fc ){
-    sprintf( filename, "op%03d", i );
-    fp = fopen( filename, "w" );
-    zListForEach( &fc->data.op, pc )
-      zVec3DDataNLFPrint( fp, pc->data.v );
-    fclose( fp );
-    i++;
+/* convert an incremental convex hull to a polyhedron. */
+zPH3D *zCH3DInc2PH3D(zCH3DInc *ch, zPH3D *ph)
+{
+  zPH3DInit( ph );
+  switch( ch->qh ? ch->qh->dim : 0 ){
+  case 4: return _zQH2PH3D( ch->qh, ph );
+  case 3: return zCH2D2PH3D( ph, ch->qh->v, ch->qh->vnum );
+  case 0: ZRUNWARN( ZEO_ERR_EMPTYSET ); break;
+  case 1: ZRUNWARN( ZEO_ERR_CH_DEG1 ); break;
+  default: ZRUNERROR( ZEO_ERR_CH_DEG2 );
   }
+  return NULL;
+}
+
+/* destroy an incremental convex hull. */
+void zCH3DIncDestroy(zCH3DInc *ch)
+{
+  if( !ch->qh ) return;
+  _zQHDestroy( ch->qh );
+  zFree( ch->qh );
+}
+
+/* ********************************************************** */
+/* parallel convex hull
+ * ********************************************************** */
+
+#define Z_CH3D_PARALLEL_MIN 4096 /* minimum number of points per thread */
+#define Z_CH3D_EXTREME_NUM  26   /* number of directions to find extreme points */
+
+/* thread argument for parallel convex hull. */
+typedef struct{
+  zVec3D *p;   /* points */
+  int head;    /* head of the partition */
+  int num;     /* number of points in the partition */
+  int ext[Z_CH3D_EXTREME_NUM]; /* extreme points */
+  zPH3D *poly; /* polytope to filter interior points */
+  zVec3D *q;   /* buffer to store surviving points */
+  int qnum;    /* number of surviving points */
+  zPH3D ch;    /* partial convex hull */
+  bool ok;     /* flag to check if the partial convex hull is computed */
+} zCH3DThreadArg;
+
+/* direction to find extreme points. */
+static void _zCH3DExtremeDir(int k, zVec3D *d)
+{
+  if( k >= 13 ) k++; /* skip the zero vector */
+  zVec3DCreate( d, k % 3 - 1, k / 3 % 3 - 1, k / 9 - 1 );
+}
+
+/* find extreme points of a partition (thread function). */
+static void *_zCH3DExtremeThread(void *arg)
+{
+  zCH3DThreadArg *a;
+  zVec3D d[Z_CH3D_EXTREME_NUM];
+  double val[Z_CH3D_EXTREME_NUM], v;
+  register int i, k;
+
+  a = (zCH3DThreadArg *)arg;
+  for( k=0; k<Z_CH3D_EXTREME_NUM; k++ ){
+    _zCH3DExtremeDir( k, &d[k] );
+    a->ext[k] = a->head;
+    val[k] = zVec3DInnerProd( &d[k], &a->p[a->head] );
+  }
+  for( i=a->head+1; i<a->head+a->num; i++ )
+    for( k=0; k<Z_CH3D_EXTREME_NUM; k++ )
+      if( ( v = zVec3DInnerProd( &d[k], &a->p[i] ) ) > val[k] ){
+        val[k] = v;
+        a->ext[k] = i;
+      }
+  return NULL;
+}
+
+/* check if a point is strictly inside of a convex polytope. */
+static bool _zCH3DPolyIsInside(zPH3D *poly, zVec3D *p)
+{
+  zVec3D e;
+  register int i;
+
+  for( i=0; i<zPH3DFaceNum(poly); i++ ){
+    zVec3DSub( p, zPH3DFaceVert(poly,i,0), &e );
+    if( zVec3DInnerProd( zPH3DFaceNorm(poly,i), &e ) > -zTOL ) return false;
+  }
+  return true;
+}
+
+/* discard points inside of the extreme polytope (thread function). */
+static void *_zCH3DFilterThread(void *arg)
+{
+  zCH3DThreadArg *a;
+  register int i;
+
+  a = (zCH3DThreadArg *)arg;
+  for( a->qnum=0, i=a->head; i<a->head+a->num; i++ )
+    if( !a->poly || !_zCH3DPolyIsInside( a->poly, &a->p[i] ) )
+      zVec3DCopy( &a->p[i], &a->q[a->head+a->qnum++] );
+  return NULL;
+}
+
+/* convex hull of a partition (thread function). */
+static void *_zCH3DPartThread(void *arg)
+{
+  zCH3DThreadArg *a;
+
+  a = (zCH3DThreadArg *)arg;
+  a->ok = a->num >= 4 && zCH3D( &a->ch, &a->p[a->head], a->num ) ? true : false;
+  return NULL;
+}
+
+/* partition points for threads. */
+static void _zCH3DPartition(zCH3DThreadArg arg[], int nthread, zVec3D p[], int num)
+{
+  register int i;
+
+  for( i=0; i<nthread; i++ ){
+    arg[i].p = p;
+    arg[i].head = num * i / nthread;
+    arg[i].num = num * ( i + 1 ) / nthread - arg[i].head;
+  }
+}
+
+/* extreme polytope of points which is used to discard interior points. */
+static zPH3D *_zCH3DExtremePoly(zPH3D *poly, zCH3DThreadArg arg[], int nthread)
+{
+  zVec3D ext[Z_CH3D_EXTREME_NUM];
+  int idx[Z_CH3D_EXTREME_NUM*2], num = 0;
+  register int i, j, k;
+  double val, v;
+  zVec3D d;
+
+  /* reduce extreme points of partitions */
+  for( k=0; k<Z_CH3D_EXTREME_NUM; k++ ){
+    _zCH3DExtremeDir( k, &d );
+    idx[k] = arg[0].ext[k];
+    val = zVec3DInnerProd( &d, &arg[0].p[idx[k]] );
+    for( i=1; i<nthread; i++ )
+      if( ( v = zVec3DInnerProd( &d, &arg[i].p[arg[i].ext[k]] ) ) > val ){
+        val = v;
+        idx[k] = arg[i].ext[k];
+      }
+    for( j=0; j<k; j++ )
+      if( idx[j] == idx[k] ) break;
+    if( j == k ) zVec3DCopy( &arg[0].p[idx[k]], &ext[num++] );
+  }
+  if( num < 4 ) return NULL;
+  zPH3DInit( poly );
+  if( !zCH3D( poly, ext, num ) ) return NULL;
+  if( zPH3DVolume( poly ) < zTOL ){ /* degenerate polytope */
+    zPH3DDestroy( poly );
+    return NULL;
+  }
+  return poly;
+}
+
+/* convex hull of 3D points computed in parallel. */
+zPH3D *zCH3DParallel(zPH3D *ch, zVec3D p[], int num, int nthread)
+{
+  zCH3DThreadArg *arg;
+  zPH3D poly, *pp;
+  zVec3D *q;
+  int qnum;
+  register int i, j;
+
+  if( nthread > num / Z_CH3D_PARALLEL_MIN )
+    nthread = num / Z_CH3D_PARALLEL_MIN;
+  if( nthread <= 1 ) return zCH3D( ch, p, num );
+  zPH3DInit( ch );
+  arg = zAlloc( zCH3DThreadArg, nthread );
+  q = zAlloc( zVec3D, num );
+  if( !arg || !q ){
+    ZALLOCERROR();
+    ch = NULL;
+    goto TERMINATE;
+  }
+  /* discard interior points with an extreme polytope */
+  _zCH3DPartition( arg, nthread, p, num );
+  zThreadRun( _zCH3DExtremeThread, arg, sizeof(zCH3DThreadArg), nthread );
+  pp = _zCH3DExtremePoly( &poly, arg, nthread );
+  for( i=0; i<nthread; i++ ){
+    arg[i].poly = pp;
+    arg[i].q = q;
+  }
+  zThreadRun( _zCH3DFilterThread, arg, sizeof(zCH3DThreadArg), nthread );
+  if( pp ) zPH3DDestroy( pp );
+  for( qnum=0, i=0; i<nthread; i++ ){
+    memmove( &q[qnum], &q[arg[i].head], sizeof(zVec3D)*arg[i].qnum );
+    qnum += arg[i].qnum;
+  }
+  /* convex hulls of partitions */
+  if( nthread > qnum / Z_CH3D_PARALLEL_MIN )
+    nthread = qnum / Z_CH3D_PARALLEL_MIN;
+  if( nthread > 1 ){
+    _zCH3DPartition( arg, nthread, q, qnum );
+    zThreadRun( _zCH3DPartThread, arg, sizeof(zCH3DThreadArg), nthread );
+    /* merge vertices of partial convex hulls */
+    for( qnum=0, i=0; i<nthread; i++ ){
+      if( !arg[i].ok ){ /* pass points through */
+        memmove( &q[qnum], &q[arg[i].head], sizeof(zVec3D)*arg[i].num );
+        qnum += arg[i].num;
+        continue;
+      }
+      for( j=0; j<zPH3DVertNum(&arg[i].ch); j++ )
+        zVec3DCopy( zPH3DVert(&arg[i].ch,j), &q[qnum++] );
+      zPH3DDestroy( &arg[i].ch );
+    }
+  }
+  ch = zCH3D( ch, q, qnum );
+
+ TERMINATE:
+  zFree( arg );
+  zFree( q );
+  return ch;
+}
+
+/* for debug */
+#ifdef DEBUG
+static void _zQHFacetInfo(zQH *qh, zQHFacet *f)
+{
+  printf( ">> facet:%p\n", f );
+  printf( "[vert#0] " ); zVec3DPrint( _zQHVert(qh,f,0) );
+  printf( "[vert#1] " ); zVec3DPrint( _zQHVert(qh,f,1) );
+  printf( "[vert#2] " ); zVec3DPrint( _zQHVert(qh,f,2) );
+  printf( "[contig#0] %p %g %s\n", f->c[0], zVec3DInnerProd(&f->n,&f->c[0]->n)-1, f->merge[0] ? " :merged" : "" );
+  printf( "[contig#1] %p %g %s\n", f->c[1], zVec3DInnerProd(&f->n,&f->c[1]->n)-1, f->merge[1] ? " :merged" : "" );
+  printf( "[contig#2] %p %g %s\n", f->c[2], zVec3DInnerProd(&f->n,&f->c[2]->n)-1, f->merge[2] ? " :merged" : "" );
+  printf( "normal vector: " ); zVec3DPrint( &f->n );
+  printf( "outside points: %d\n", f->op_num );
+}
+
+static void _zQHFacetListInfo(zQH *qh)
+{
+  zQHFacetBlock *b;
+  register int i;
+
+  for( b=qh->head; b; b=b->next )
+    for( i=0; i<b->num; i++ )
+      if( b->f[i].alive ) _zQHFacetInfo( qh, &b->f[i] );
 }
 #endif /* DEBUG */
@@ -0,0 +1,436 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_aabbtree - collision checking: dynamic AABB tree.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* ********************************************************** */
+/* CLASS: zAABBTree
+ * dynamic bounding volume hierarchy of axis-aligned boxes
+ * ********************************************************** */
+
+#define ZEO_AABBTREE_STACK_SIZE 64
+
+/* stack of node indices for traversal */
+typedef struct{
+  int *buf, size, num;
+  int local[ZEO_AABBTREE_STACK_SIZE];
+} zAABBTreeStack;
+
+/* initialize a stack. */
+static void _zAABBTreeStackInit(zAABBTreeStack *stack)
+{
+  stack->buf = stack->local;
+  stack->size = ZEO_AABBTREE_STACK_SIZE;
+  stack->num = 0;
+}
+
+/* destroy a stack. */
+static void _zAABBTreeStackDestroy(zAABBTreeStack *stack)
+{
+  if( stack->buf != stack->local ) zFree( stack->buf );
+}
+
+/* push a node index to a stack. */
+static bool _zAABBTreeStackPush(zAABBTreeStack *stack, int id)
+{
+  int *buf;
+
+  if( stack->num == stack->size ){
+    if( !( buf = zAlloc( int, stack->size*2 ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    memcpy( buf, stack->buf, sizeof(int)*stack->num );
+    _zAABBTreeStackDestroy( stack );
+    stack->buf = buf;
+    stack->size *= 2;
+  }
+  stack->buf[stack->num++] = id;
+  return true;
+}
+
+#define _zAABBTreeStackPop(s) (s)->buf[--(s)->num]
+
+/* check if an axis-aligned box contains another. */
+static bool _zAABox3DContain(zAABox3D *box, zAABox3D *inner)
+{
+  return box->min.e[zX] <= inner->min.e[zX] && inner->max.e[zX] <= box->max.e[zX] &&
+         box->min.e[zY] <= inner->min.e[zY] && inner->max.e[zY] <= box->max.e[zY] &&
+         box->min.e[zZ] <= inner->min.e[zZ] && inner->max.e[zZ] <= box->max.e[zZ];
+}
+
+#define _zAABBTreeNode(t,id) ( &(t)->node[(id)] )
+
+/* allocate a node from the pool. */
+static int _zAABBTreeAllocNode(zAABBTree *tree)
+{
+  zAABBTreeNode *node;
+  int size, id;
+  register int i;
+
+  if( tree->vacant < 0 ){
+    size = tree->size == 0 ? 16 : tree->size * 2;
+    if( !( node = zRealloc( tree->node, zAABBTreeNode, size ) ) ){
+      ZALLOCERROR();
+      return -1;
+    }
+    tree->node = node;
+    for( i=tree->size; i<size; i++ ){
+      tree->node[i].parent = i + 1 < size ? i + 1 : -1;
+      tree->node[i].height = -1;
+    }
+    tree->vacant = tree->size;
+    tree->size = size;
+  }
+  id = tree->vacant;
+  node = _zAABBTreeNode(tree,id);
+  tree->vacant = node->parent;
+  node->parent = node->child[0] = node->child[1] = -1;
+  node->height = 0;
+  node->data = NULL;
+  tree->num++;
+  return id;
+}
+
+/* return a node to the pool. */
+static void _zAABBTreeFreeNode(zAABBTree *tree, int id)
+{
+  tree->node[id].parent = tree->vacant;
+  tree->node[id].height = -1;
+  tree->vacant = id;
+  tree->num--;
+}
+
+/* rotate a subtree if it is imbalanced, and return the new root of the subtree. */
+static int _zAABBTreeBalance(zAABBTree *tree, int ia)
+{
+  zAABBTreeNode *a, *b, *c, *f, *g;
+  int ib, ic, i0, i1, side;
+
+  a = _zAABBTreeNode(tree,ia);
+  if( a->child[0] < 0 || a->height < 2 ) return ia;
+  /* the higher child (c) is rotated up, and the other (b) is left */
+  ib = a->child[0];
+  ic = a->child[1];
+  side = 1;
+  if( tree->node[ic].height - tree->node[ib].height < -1 ){
+    zSwap( int, ib, ic );
+    side = 0;
+  } else
+  if( tree->node[ic].height - tree->node[ib].height <= 1 ) return ia;
+  b = _zAABBTreeNode(tree,ib);
+  c = _zAABBTreeNode(tree,ic);
+  i0 = c->child[0];
+  i1 = c->child[1];
+  f = _zAABBTreeNode(tree,i0);
+  g = _zAABBTreeNode(tree,i1);
+  /* swap a and c */
+  c->child[0] = ia;
+  c->parent = a->parent;
+  a->parent = ic;
+  if( c->parent >= 0 ){
+    if( tree->node[c->parent].child[0] == ia )
+      tree->node[c->parent].child[0] = ic;
+    else
+      tree->node[c->parent].child[1] = ic;
+  } else
+    tree->root = ic;
+  /* the higher grandchild stays with c, and the other goes under a */
+  if( f->height > g->height ){
+    zSwap( int, i0, i1 );
+    zSwap( zAABBTreeNode*, f, g );
+  }
+  c->child[1] = i1;
+  a->child[side] = i0;
+  f->parent = ia;
+  zAABox3DMerge( &a->box, &b->box, &f->box );
+  zAABox3DMerge( &c->box, &a->box, &g->box );
+  a->height = 1 + zMax( b->height, f->height );
+  c->height = 1 + zMax( a->height, g->height );
+  return ic;
+}
+
+/* refit boxes and heights of ancestors of a node with rebalancing. */
+static void _zAABBTreeRefit(zAABBTree *tree, int id)
+{
+  zAABBTreeNode *node;
+
+  while( id >= 0 ){
+    id = _zAABBTreeBalance( tree, id );
+    node = _zAABBTreeNode(tree,id);
+    node->height = 1 + zMax( tree->node[node->child[0]].height, tree->node[node->child[1]].height );
+    zAABox3DMerge( &node->box, &tree->node[node->child[0]].box, &tree->node[node->child[1]].box );
+    id = node->parent;
+  }
+}
+
+/* insert a leaf into a tree. */
+static bool _zAABBTreeInsertLeaf(zAABBTree *tree, int leaf)
+{
+  zAABBTreeNode *node;
+  zAABox3D *box, merged;
+  double area, cost, inherit, cost_child[2];
+  int id, sibling, parent;
+  register int i;
+
+  if( tree->root < 0 ){
+    tree->root = leaf;
+    tree->node[leaf].parent = -1;
+    return true;
+  }
+  /* find the best sibling */
+  box = &tree->node[leaf].box;
+  for( id=tree->root; !zAABBTreeIsLeaf(tree,id); ){
+    node = _zAABBTreeNode(tree,id);
+    area = zAABox3DArea( &node->box );
+    cost = 2 * zAABox3DArea( zAABox3DMerge( &merged, &node->box, box ) );
+    inherit = cost - 2 * area; /* minimum cost to push the leaf down */
+    for( i=0; i<2; i++ ){
+      cost_child[i] = zAABox3DArea( zAABox3DMerge( &merged, &tree->node[node->child[i]].box, box ) ) + inherit;
+      if( !zAABBTreeIsLeaf(tree,node->child[i]) )
+        cost_child[i] -= zAABox3DArea( &tree->node[node->child[i]].box );
+    }
+    if( cost < cost_child[0] && cost < cost_child[1] ) break;
+    id = node->child[cost_child[0] < cost_child[1] ? 0 : 1];
+  }
+  sibling = id;
+  /* create a new parent */
+  if( ( parent = _zAABBTreeAllocNode( tree ) ) < 0 ) return false;
+  node = _zAABBTreeNode(tree,parent); /* the pool might be reallocated */
+  node->parent = tree->node[sibling].parent;
+  zAABox3DMerge( &node->box, &tree->node[leaf].box, &tree->node[sibling].box );
+  node->height = tree->node[sibling].height + 1;
+  node->child[0] = sibling;
+  node->child[1] = leaf;
+  if( node->parent >= 0 ){
+    if( tree->node[node->parent].child[0] == sibling )
+      tree->node[node->parent].child[0] = parent;
+    else
+      tree->node[node->parent].child[1] = parent;
+  } else
+    tree->root = parent;
+  tree->node[sibling].parent = tree->node[leaf].parent = parent;
+  _zAABBTreeRefit( tree, tree->node[leaf].parent );
+  return true;
+}
+
+/* remove a leaf from a tree. */
+static void _zAABBTreeRemoveLeaf(zAABBTree *tree, int leaf)
+{
+  int parent, grandparent, sibling;
+
+  if( leaf == tree->root ){
+    tree->root = -1;
+    return;
+  }
+  parent = tree->node[leaf].parent;
+  grandparent = tree->node[parent].parent;
+  sibling = tree->node[parent].child[0] == leaf ?
+    tree->node[parent].child[1] : tree->node[parent].child[0];
+  tree->node[sibling].parent = grandparent;
+  if( grandparent >= 0 ){
+    if( tree->node[grandparent].child[0] == parent )
+      tree->node[grandparent].child[0] = sibling;
+    else
+      tree->node[grandparent].child[1] = sibling;
+    _zAABBTreeRefit( tree, grandparent );
+  } else
+    tree->root = sibling;
+  _zAABBTreeFreeNode( tree, parent );
+}
+
+/* initialize a dynamic AABB tree. */
+zAABBTree *zAABBTreeInit(zAABBTree *tree, double margin)
+{
+  tree->node = NULL;
+  tree->size = tree->num = 0;
+  tree->root = tree->vacant = -1;
+  tree->margin = margin;
+  return tree;
+}
+
+/* destroy a dynamic AABB tree. */
+void zAABBTreeDestroy(zAABBTree *tree)
+{
+  zFree( tree->node );
+  zAABBTreeInit( tree, tree->margin );
+}
+
+/* fatten a box of a leaf. */
+static void _zAABBTreeFatten(zAABBTree *tree, int id, zAABox3D *box, zVec3D *disp)
+{
+  zAABox3D *fat;
+  register int i;
+
+  fat = &tree->node[id].box;
+  for( i=zX; i<=zZ; i++ ){
+    fat->min.e[i] = box->min.e[i] - tree->margin;
+    fat->max.e[i] = box->max.e[i] + tree->margin;
+    if( !disp ) continue;
+    if( disp->e[i] < 0 )
+      fat->min.e[i] += disp->e[i];
+    else
+      fat->max.e[i] += disp->e[i];
+  }
+}
+
+/* insert an object into a dynamic AABB tree. */
+int zAABBTreeInsert(zAABBTree *tree, zAABox3D *box, void *data)
+{
+  int id;
+
+  if( ( id = _zAABBTreeAllocNode( tree ) ) < 0 ) return -1;
+  _zAABBTreeFatten( tree, id, box, NULL );
+  tree->node[id].data = data;
+  if( !_zAABBTreeInsertLeaf( tree, id ) ){
+    _zAABBTreeFreeNode( tree, id );
+    return -1;
+  }
+  return id;
+}
+
+/* remove an object from a dynamic AABB tree. */
+bool zAABBTreeRemove(zAABBTree *tree, int id)
+{
+  if( id < 0 || id >= tree->size || tree->node[id].height != 0 ){
+    ZRUNWARN( ZEO_WARN_AABBTREE_INVALID_ID, id );
+    return false;
+  }
+  _zAABBTreeRemoveLeaf( tree, id );
+  _zAABBTreeFreeNode( tree, id );
+  return true;
+}
+
+/* move an object in a dynamic AABB tree. */
+bool zAABBTreeMove(zAABBTree *tree, int id, zAABox3D *box, zVec3D *disp)
+{
+  if( id < 0 || id >= tree->size || tree->node[id].height != 0 ){
+    ZRUNWARN( ZEO_WARN_AABBTREE_INVALID_ID, id );
+    return false;
+  }
+  if( _zAABox3DContain( &tree->node[id].box, box ) ) return false;
+  _zAABBTreeRemoveLeaf( tree, id );
+  _zAABBTreeFatten( tree, id, box, disp );
+  return _zAABBTreeInsertLeaf( tree, id );
+}
+
+/* find leaves which overlap with a box. */
+void zAABBTreeQuery(zAABBTree *tree, zAABox3D *box, bool (*callback)(int,void*), void *priv)
+{
+  zAABBTreeStack stack;
+  int id;
+
+  if( tree->root < 0 ) return;
+  _zAABBTreeStackInit( &stack );
+  _zAABBTreeStackPush( &stack, tree->root );
+  while( stack.num > 0 ){
+    id = _zAABBTreeStackPop( &stack );
+    if( !zColChkAABox3D( &tree->node[id].box, box ) ) continue;
+    if( zAABBTreeIsLeaf(tree,id) ){
+      if( !callback( id, priv ) ) break;
+    } else
+    if( !_zAABBTreeStackPush( &stack, tree->node[id].child[0] ) ||
+        !_zAABBTreeStackPush( &stack, tree->node[id].child[1] ) ) break;
+  }
+  _zAABBTreeStackDestroy( &stack );
+}
+
+/* find leaves which are hit by a ray. */
+void zAABBTreeRayCast(zAABBTree *tree, zVec3D *org, zVec3D *dir, double tmax, double (*callback)(int,zVec3D*,zVec3D*,double,void*), void *priv)
+{
+  zAABBTreeStack stack;
+  double t;
+  int id;
+
+  if( tree->root < 0 ) return;
+  _zAABBTreeStackInit( &stack );
+  _zAABBTreeStackPush( &stack, tree->root );
+  while( stack.num > 0 ){
+    id = _zAABBTreeStackPop( &stack );
+    if( !zAABox3DRayHit( &tree->node[id].box, org, dir, tmax, NULL ) ) continue;
+    if( zAABBTreeIsLeaf(tree,id) ){
+      if( ( t = callback( id, org, dir, tmax, priv ) ) < 0 ) break;
+      if( t < tmax ) tmax = t;
+    } else
+    if( !_zAABBTreeStackPush( &stack, tree->node[id].child[0] ) ||
+        !_zAABBTreeStackPush( &stack, tree->node[id].child[1] ) ) break;
+  }
+  _zAABBTreeStackDestroy( &stack );
+}
+
+/* find the leaf which has the closest object from a point. */
+int zAABBTreeClosest(zAABBTree *tree, zVec3D *p, double (*callback)(int,zVec3D*,void*), void *priv, double *dist)
+{
+  zAABBTreeStack stack;
+  double d, dmin = HUGE_VAL, d0, d1;
+  int id, imin = -1, c0, c1;
+
+  if( tree->root < 0 ) goto TERMINATE;
+  _zAABBTreeStackInit( &stack );
+  _zAABBTreeStackPush( &stack, tree->root );
+  while( stack.num > 0 ){
+    id = _zAABBTreeStackPop( &stack );
+    if( zAABox3DPointSqrDist( &tree->node[id].box, p ) >= dmin*dmin ) continue;
+    if( zAABBTreeIsLeaf(tree,id) ){
+      if( ( d = callback( id, p, priv ) ) < dmin ){
+        dmin = d;
+        imin = id;
+      }
+      continue;
+    }
+    /* the nearer child is visited first */
+    c0 = tree->node[id].child[0];
+    c1 = tree->node[id].child[1];
+    d0 = zAABox3DPointSqrDist( &tree->node[c0].box, p );
+    d1 = zAABox3DPointSqrDist( &tree->node[c1].box, p );
+    if( d0 < d1 ) zSwap( int, c0, c1 );
+    if( !_zAABBTreeStackPush( &stack, c0 ) || !_zAABBTreeStackPush( &stack, c1 ) ) break;
+  }
+  _zAABBTreeStackDestroy( &stack );
+ TERMINATE:
+  if( dist ) *dist = dmin;
+  return imin;
+}
+
+/* find pairs of leaves of two trees which overlap with each other. */
+void zAABBTreeQueryTree(zAABBTree *tree1, zAABBTree *tree2, bool (*callback)(int,int,void*), void *priv)
+{
+  zAABBTreeStack stack;
+  zAABBTreeNode *n1, *n2;
+  int id1, id2;
+  bool ret = true;
+
+  if( tree1->root < 0 || tree2->root < 0 ) return;
+  _zAABBTreeStackInit( &stack );
+  _zAABBTreeStackPush( &stack, tree1->root );
+  _zAABBTreeStackPush( &stack, tree2->root );
+  while( stack.num > 0 && ret ){
+    id2 = _zAABBTreeStackPop( &stack );
+    id1 = _zAABBTreeStackPop( &stack );
+    n1 = _zAABBTreeNode(tree1,id1);
+    n2 = _zAABBTreeNode(tree2,id2);
+    if( tree1 == tree2 && id1 == id2 ){ /* self pairs in a subtree */
+      if( n1->child[0] < 0 ) continue;
+      ret = _zAABBTreeStackPush( &stack, n1->child[0] ) && _zAABBTreeStackPush( &stack, n1->child[0] ) &&
+            _zAABBTreeStackPush( &stack, n1->child[1] ) && _zAABBTreeStackPush( &stack, n1->child[1] ) &&
+            _zAABBTreeStackPush( &stack, n1->child[0] ) && _zAABBTreeStackPush( &stack, n1->child[1] );
+      continue;
+    }
+    if( !zColChkAABox3D( &n1->box, &n2->box ) ) continue;
+    if( n1->child[0] < 0 && n2->child[0] < 0 ){
+      ret = tree1 == tree2 && id1 > id2 ?
+        callback( id2, id1, priv ) : callback( id1, id2, priv );
+    } else
+    if( n2->child[0] < 0 || ( n1->child[0] >= 0 && zAABox3DArea( &n1->box ) > zAABox3DArea( &n2->box ) ) ){
+      ret = _zAABBTreeStackPush( &stack, n1->child[0] ) && _zAABBTreeStackPush( &stack, id2 ) &&
+            _zAABBTreeStackPush( &stack, n1->child[1] ) && _zAABBTreeStackPush( &stack, id2 );
+    } else{
+      ret = _zAABBTreeStackPush( &stack, id1 ) && _zAABBTreeStackPush( &stack, n2->child[0] ) &&
+            _zAABBTreeStackPush( &stack, id1 ) && _zAABBTreeStackPush( &stack, n2->child[1] );
+    }
+  }
+  _zAABBTreeStackDestroy( &stack );
+}
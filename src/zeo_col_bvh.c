@@ -0,0 +1,947 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_bvh - collision checking: static bounding volume hierarchy of a polyhedron.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* ********************************************************** */
+/* CLASS: zPH3DBVH
+ * static bounding volume hierarchy over triangles of a polyhedron
+ * ********************************************************** */
+
+#define ZEO_PH3D_BVH_BIN          16   /* number of bins for the surface area heuristic */
+#define ZEO_PH3D_BVH_COST_TRAV    1.0  /* cost to traverse a node relative to a face test */
+#define ZEO_PH3D_BVH_PARALLEL_MIN 4096 /* minimum number of faces of a subtree built by another thread */
+
+/* make an axis-aligned box empty. */
+static void _zAABox3DEmpty(zAABox3D *box)
+{
+  zVec3DCreate( &box->min, HUGE_VAL, HUGE_VAL, HUGE_VAL );
+  zVec3DCreate( &box->max,-HUGE_VAL,-HUGE_VAL,-HUGE_VAL );
+}
+
+/* expand an axis-aligned box to include a point. */
+static void _zAABox3DExpand(zAABox3D *box, zVec3D *p)
+{
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( p->e[i] < box->min.e[i] ) box->min.e[i] = p->e[i];
+    if( p->e[i] > box->max.e[i] ) box->max.e[i] = p->e[i];
+  }
+}
+
+/* expand an axis-aligned box to include another. */
+static void _zAABox3DMergeDRC(zAABox3D *box, zAABox3D *b)
+{
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( b->min.e[i] < box->min.e[i] ) box->min.e[i] = b->min.e[i];
+    if( b->max.e[i] > box->max.e[i] ) box->max.e[i] = b->max.e[i];
+  }
+}
+
+/* check if two axis-aligned boxes overlap with each other including touching boundaries. */
+static bool _zAABox3DOverlap(zAABox3D *b1, zAABox3D *b2)
+{
+  return b1->min.e[zX] <= b2->max.e[zX] && b2->min.e[zX] <= b1->max.e[zX] &&
+         b1->min.e[zY] <= b2->max.e[zY] && b2->min.e[zY] <= b1->max.e[zY] &&
+         b1->min.e[zZ] <= b2->max.e[zZ] && b2->min.e[zZ] <= b1->max.e[zZ];
+}
+
+/* reference to a face to be sorted in building a hierarchy. */
+typedef struct{
+  zAABox3D box; /* bounding box of a face */
+  zVec3D c;     /* centroid of the bounding box */
+  int face;     /* index of a face */
+} zPH3DBVHRef;
+
+/* workspace to build a hierarchy. */
+typedef struct{
+  zPH3DBVH *bvh;
+  zPH3DBVHRef *ref; /* references to faces */
+} zPH3DBVHBuilder;
+
+/* thread argument to build a subtree. */
+typedef struct{
+  zPH3DBVHBuilder *builder;
+  int id;      /* node to be built */
+  int head;    /* head of the range of faces */
+  int num;     /* number of faces */
+  int level;   /* level of the node */
+  int nthread; /* number of threads assigned */
+  int height;  /* resulting height of the subtree */
+} zPH3DBVHBuildArg;
+
+/* bounding boxes of faces and their centroids in a range. */
+static void _zPH3DBVHBound(zPH3DBVHBuilder *builder, int head, int num, zAABox3D *box, zAABox3D *cbox)
+{
+  zPH3DBVHRef *ref;
+  register int i;
+
+  ref = builder->ref + head;
+  _zAABox3DEmpty( box );
+  _zAABox3DEmpty( cbox );
+  for( i=0; i<num; i++ ){
+    _zAABox3DMergeDRC( box, &ref[i].box );
+    _zAABox3DExpand( cbox, &ref[i].c );
+  }
+}
+
+/* number of bins for faces; small ranges are binned more coarsely. */
+#define _zPH3DBVHBinNum(num) zMin( num, ZEO_PH3D_BVH_BIN )
+
+/* bin of a centroid along an axis; scale is the number of bins divided by the extent of centroids. */
+static int _zPH3DBVHBin(zVec3D *c, zAABox3D *cbox, int axis, int nbin, double scale)
+{
+  int k;
+
+  k = scale * ( c->e[axis] - cbox->min.e[axis] );
+  return k < nbin ? k : nbin - 1;
+}
+
+#define _zPH3DBVHBinScale(cbox,axis,nbin) ( (nbin) / ( (cbox)->max.e[axis] - (cbox)->min.e[axis] ) )
+
+/* find the best split of faces by binned surface area heuristic. */
+static bool _zPH3DBVHSplitSAH(zPH3DBVHBuilder *builder, int head, int num, zAABox3D *box, zAABox3D *cbox, int *axis, int *split, double *cost)
+{
+  zAABox3D bbox[3][ZEO_PH3D_BVH_BIN], acc;
+  zPH3DBVHRef *ref;
+  int bnum[3][ZEO_PH3D_BVH_BIN], nbin, k, nl, nr;
+  double area, rarea[ZEO_PH3D_BVH_BIN], c, scale[3];
+  bool valid[3];
+  register int i, j;
+
+  if( zIsTiny( ( area = zAABox3DArea( box ) ) ) ) return false;
+  ref = builder->ref + head;
+  nbin = _zPH3DBVHBinNum( num );
+  for( i=zX; i<=zZ; i++ ){
+    if( !( valid[i] = !zIsTiny( cbox->max.e[i] - cbox->min.e[i] ) ) ) continue;
+    scale[i] = _zPH3DBVHBinScale( cbox, i, nbin );
+    for( j=0; j<nbin; j++ ){
+      _zAABox3DEmpty( &bbox[i][j] );
+      bnum[i][j] = 0;
+    }
+  }
+  /* bin faces along three axes in a pass */
+  for( j=0; j<num; j++ )
+    for( i=zX; i<=zZ; i++ ){
+      if( !valid[i] ) continue;
+      k = _zPH3DBVHBin( &ref[j].c, cbox, i, nbin, scale[i] );
+      _zAABox3DMergeDRC( &bbox[i][k], &ref[j].box );
+      bnum[i][k]++;
+    }
+  *cost = HUGE_VAL;
+  for( i=zX; i<=zZ; i++ ){
+    if( !valid[i] ) continue;
+    _zAABox3DEmpty( &acc );
+    for( j=nbin-1; j>0; j-- ){
+      _zAABox3DMergeDRC( &acc, &bbox[i][j] );
+      rarea[j] = zAABox3DArea( &acc );
+    }
+    _zAABox3DEmpty( &acc );
+    for( nl=0, j=1; j<nbin; j++ ){
+      _zAABox3DMergeDRC( &acc, &bbox[i][j-1] );
+      if( ( nl += bnum[i][j-1] ) == 0 || ( nr = num - nl ) == 0 ) continue;
+      c = ZEO_PH3D_BVH_COST_TRAV + ( zAABox3DArea( &acc ) * nl + rarea[j] * nr ) / area;
+      if( c < *cost ){
+        *cost = c;
+        *axis = i;
+        *split = j;
+      }
+    }
+  }
+  return *cost < HUGE_VAL;
+}
+
+/* partition faces by a split of bins. */
+static int _zPH3DBVHPartition(zPH3DBVHBuilder *builder, int head, int num, zAABox3D *cbox, int axis, int split)
+{
+  zPH3DBVHRef *ref;
+  int nbin;
+  double scale;
+  register int i, j;
+
+  ref = builder->ref + head;
+  nbin = _zPH3DBVHBinNum( num );
+  scale = _zPH3DBVHBinScale( cbox, axis, nbin );
+  for( i=0, j=num-1; i<=j; ){
+    if( _zPH3DBVHBin( &ref[i].c, cbox, axis, nbin, scale ) < split )
+      i++;
+    else{
+      zSwap( zPH3DBVHRef, ref[i], ref[j] );
+      j--;
+    }
+  }
+  return i;
+}
+
+/* partition faces at the median of centroids along an axis (quickselect). */
+static int _zPH3DBVHPartitionMedian(zPH3DBVHBuilder *builder, int head, int num, zAABox3D *cbox)
+{
+  zPH3DBVHRef *ref;
+  int axis, k, l, r;
+  double pivot;
+  register int i, j;
+
+  axis = zX;
+  for( i=zY; i<=zZ; i++ )
+    if( cbox->max.e[i] - cbox->min.e[i] > cbox->max.e[axis] - cbox->min.e[axis] ) axis = i;
+  ref = builder->ref + head;
+  for( k=num/2, l=0, r=num-1; l<r; ){
+    pivot = ref[(l+r)/2].c.e[axis];
+    for( i=l, j=r; i<=j; ){
+      while( ref[i].c.e[axis] < pivot ) i++;
+      while( ref[j].c.e[axis] > pivot ) j--;
+      if( i <= j ){
+        zSwap( zPH3DBVHRef, ref[i], ref[j] );
+        i++; j--;
+      }
+    }
+    if( k <= j ) r = j;
+    else if( k >= i ) l = i;
+    else break;
+  }
+  return k;
+}
+
+static int _zPH3DBVHBuild(zPH3DBVHBuilder *builder, int id, int head, int num, int level, int nthread);
+
+/* build a subtree (thread function). */
+static void *_zPH3DBVHBuildThread(void *arg)
+{
+  zPH3DBVHBuildArg *a;
+
+  a = arg;
+  a->height = _zPH3DBVHBuild( a->builder, a->id, a->head, a->num, a->level, a->nthread );
+  return NULL;
+}
+
+/* build a subtree of faces in a range; returns the height of the subtree.
+ * the first child of a node is placed next to it, and the second child
+ * after slots reserved for the first subtree, which has at most 2n-1
+ * nodes for n faces. */
+static int _zPH3DBVHBuild(zPH3DBVHBuilder *builder, int id, int head, int num, int level, int nthread)
+{
+  zPH3DBVHNode *node;
+  zAABox3D cbox;
+  zPH3DBVHBuildArg arg[2];
+  int axis = zX, split = 0, nl, h0, h1;
+  double cost;
+  bool sah;
+  register int i;
+
+  node = &builder->bvh->node[id];
+  _zPH3DBVHBound( builder, head, num, &node->box, &cbox );
+  sah = num > 1 && level < ZEO_PH3D_BVH_DEPTH_MAX/2 &&
+    _zPH3DBVHSplitSAH( builder, head, num, &node->box, &cbox, &axis, &split, &cost );
+  if( num <= 1 || ( num <= ZEO_PH3D_BVH_LEAF_SIZE && ( !sah || cost >= num ) ) ){
+    node->head = head;
+    node->num = num;
+    for( i=0; i<num; i++ )
+      builder->bvh->face[head+i] = builder->ref[head+i].face;
+    return 0;
+  }
+  nl = sah ? _zPH3DBVHPartition( builder, head, num, &cbox, axis, split ) :
+             _zPH3DBVHPartitionMedian( builder, head, num, &cbox );
+  node->head = id + 2*nl;
+  node->num = 0;
+  if( nthread > 1 && num >= ZEO_PH3D_BVH_PARALLEL_MIN ){
+    for( i=0; i<2; i++ ){
+      arg[i].builder = builder;
+      arg[i].level = level + 1;
+    }
+    arg[0].id = id + 1;
+    arg[0].head = head;
+    arg[0].num = nl;
+    arg[0].nthread = nthread / 2;
+    arg[1].id = id + 2*nl;
+    arg[1].head = head + nl;
+    arg[1].num = num - nl;
+    arg[1].nthread = nthread - nthread/2;
+    zThreadRun( _zPH3DBVHBuildThread, arg, sizeof(zPH3DBVHBuildArg), 2 );
+    return 1 + zMax( arg[0].height, arg[1].height );
+  }
+  h0 = _zPH3DBVHBuild( builder, id + 1, head, nl, level + 1, nthread );
+  h1 = _zPH3DBVHBuild( builder, id + 2*nl, head + nl, num - nl, level + 1, nthread );
+  return 1 + zMax( h0, h1 );
+}
+
+/* initialize a bounding volume hierarchy of a polyhedron. */
+zPH3DBVH *zPH3DBVHInit(zPH3DBVH *bvh)
+{
+  bvh->ph = NULL;
+  bvh->face = NULL;
+  bvh->node = NULL;
+  bvh->nodenum = 0;
+  bvh->depth = 0;
+  bvh->cost0 = bvh->cost = 0;
+  return bvh;
+}
+
+/* create a bounding volume hierarchy of a polyhedron. */
+zPH3DBVH *zPH3DBVHCreate(zPH3DBVH *bvh, zPH3D *ph, int nthread)
+{
+  zPH3DBVHBuilder builder;
+  zPH3DBVHNode *node;
+  zPH3DBVHRef *ref;
+  zTri3D *t;
+  int n, *map = NULL;
+  register int i, j;
+
+  zPH3DBVHInit( bvh );
+  if( ( n = zPH3DFaceNum(ph) ) == 0 ){
+    ZRUNERROR( ZEO_ERR_NOFACE );
+    return NULL;
+  }
+  bvh->ph = ph;
+  bvh->face = zAlloc( int, n );
+  bvh->node = zAlloc( zPH3DBVHNode, 2*n-1 );
+  builder.bvh = bvh;
+  builder.ref = zAlloc( zPH3DBVHRef, n );
+  map = zAlloc( int, 2*n-1 );
+  if( !bvh->face || !bvh->node || !builder.ref || !map ){
+    ZALLOCERROR();
+    zPH3DBVHDestroy( bvh );
+    bvh = NULL;
+    goto TERMINATE;
+  }
+  for( ref=builder.ref, i=0; i<n; i++, ref++ ){
+    ref->face = i;
+    t = zPH3DFace(ph,i);
+    _zAABox3DEmpty( &ref->box );
+    for( j=0; j<3; j++ )
+      _zAABox3DExpand( &ref->box, zTri3DVert(t,j) );
+    zVec3DMid( &ref->box.min, &ref->box.max, &ref->c );
+  }
+  for( i=0; i<2*n-1; i++ ) bvh->node[i].num = -1; /* unused slot */
+  bvh->depth = _zPH3DBVHBuild( &builder, 0, 0, n, 0, nthread );
+  /* pack nodes; slots are used in depth-first order */
+  for( j=0, i=0; i<2*n-1; i++ )
+    if( bvh->node[i].num >= 0 ){
+      map[i] = j;
+      if( j < i ) bvh->node[j] = bvh->node[i];
+      j++;
+    }
+  for( i=0; i<j; i++ )
+    if( bvh->node[i].num == 0 ) bvh->node[i].head = map[bvh->node[i].head];
+  if( ( node = zRealloc( bvh->node, zPH3DBVHNode, j ) ) ) bvh->node = node;
+  bvh->nodenum = j;
+  bvh->cost0 = zPH3DBVHRefit( bvh )->cost;
+
+ TERMINATE:
+  zFree( builder.ref );
+  zFree( map );
+  return bvh;
+}
+
+/* destroy a bounding volume hierarchy of a polyhedron. */
+void zPH3DBVHDestroy(zPH3DBVH *bvh)
+{
+  zFree( bvh->face );
+  zFree( bvh->node );
+  zPH3DBVHInit( bvh );
+}
+
+/* refit a bounding volume hierarchy of a polyhedron. */
+zPH3DBVH *zPH3DBVHRefit(zPH3DBVH *bvh)
+{
+  zPH3DBVHNode *node;
+  zTri3D *t;
+  double cost = 0;
+  register int i, j, k;
+
+  if( bvh->nodenum == 0 ) return bvh;
+  /* children follow their parent in the node array */
+  for( i=bvh->nodenum-1; i>=0; i-- ){
+    node = &bvh->node[i];
+    if( node->num > 0 ){
+      _zAABox3DEmpty( &node->box );
+      for( j=0; j<node->num; j++ ){
+        t = zPH3DFace( bvh->ph, zPH3DBVHLeafFace(bvh,i,j) );
+        for( k=0; k<3; k++ )
+          _zAABox3DExpand( &node->box, zTri3DVert(t,k) );
+      }
+      cost += zAABox3DArea( &node->box ) * node->num;
+    } else{
+      zAABox3DCopy( &bvh->node[i+1].box, &node->box );
+      _zAABox3DMergeDRC( &node->box, &bvh->node[node->head].box );
+      cost += zAABox3DArea( &node->box ) * ZEO_PH3D_BVH_COST_TRAV;
+    }
+  }
+  bvh->cost = cost / zMax( zAABox3DArea( &bvh->node[0].box ), zTOL );
+  return bvh;
+}
+
+/* transform a polyhedron of a bounding volume hierarchy and refit it. */
+zPH3DBVH *zPH3DBVHXform(zPH3DBVH *bvh, zPH3D *src, zFrame3D *f)
+{
+  zPH3DXform( src, f, bvh->ph );
+  return zPH3DBVHRefit( bvh );
+}
+
+/* inversely transform a polyhedron of a bounding volume hierarchy and refit it. */
+zPH3DBVH *zPH3DBVHXformInv(zPH3DBVH *bvh, zPH3D *src, zFrame3D *f)
+{
+  zPH3DXformInv( src, f, bvh->ph );
+  return zPH3DBVHRefit( bvh );
+}
+
+/* find the nearest object in leaves nearer than dmin by a best-first descent. */
+static double _zPH3DBVHNearest(zPH3DBVH *bvh, zVec3D *p, double dmin, double (*leaf)(zPH3DBVH*,int,zVec3D*,double,void*), void *priv)
+{
+  int stack[ZEO_PH3D_BVH_DEPTH_MAX+1], sp = 0, id, c0, c1;
+  double dstack[ZEO_PH3D_BVH_DEPTH_MAX+1], d0, d1;
+
+  stack[sp] = 0;
+  dstack[sp++] = zAABox3DPointSqrDist( &bvh->node[0].box, p );
+  while( sp > 0 ){
+    id = stack[--sp];
+    if( dstack[sp] >= dmin*dmin ) continue;
+    if( zPH3DBVHIsLeaf(bvh,id) ){
+      dmin = leaf( bvh, id, p, dmin, priv );
+      continue;
+    }
+    c0 = id + 1;
+    c1 = bvh->node[id].head;
+    d0 = zAABox3DPointSqrDist( &bvh->node[c0].box, p );
+    d1 = zAABox3DPointSqrDist( &bvh->node[c1].box, p );
+    if( d0 > d1 ){
+      zSwap( int, c0, c1 );
+      zSwap( double, d0, d1 );
+    }
+    if( d1 < dmin*dmin ){
+      stack[sp] = c1; dstack[sp++] = d1;
+    }
+    if( d0 < dmin*dmin ){
+      stack[sp] = c0; dstack[sp++] = d0;
+    }
+  }
+  return dmin;
+}
+
+/* query of the closest point */
+typedef struct{
+  zVec3D *cp;
+  int face;
+} zPH3DBVHClosestData;
+
+/* the closest point on faces of a leaf. */
+static double _zPH3DBVHClosestLeaf(zPH3DBVH *bvh, int id, zVec3D *p, double dmin, void *priv)
+{
+  zPH3DBVHClosestData *data;
+  zVec3D cp;
+  double d;
+  int f;
+  register int i;
+
+  data = priv;
+  for( i=0; i<bvh->node[id].num; i++ ){
+    f = zPH3DBVHLeafFace(bvh,id,i);
+    if( ( d = zTri3DClosest( zPH3DFace(bvh->ph,f), p, &cp ) ) < dmin ){
+      zVec3DCopy( &cp, data->cp );
+      data->face = f;
+      dmin = d;
+    }
+  }
+  return dmin;
+}
+
+/* the closest point on a polyhedron of a bounding volume hierarchy. */
+double zPH3DBVHClosest(zPH3DBVH *bvh, zVec3D *p, zVec3D *cp, int *face)
+{
+  zPH3DBVHClosestData data;
+  double d;
+
+  if( bvh->nodenum == 0 ){
+    ZRUNERROR( ZEO_ERR_NOFACE );
+    zVec3DCopy( p, cp );
+    if( face ) *face = -1;
+    return 0;
+  }
+  data.cp = cp;
+  data.face = -1;
+  d = _zPH3DBVHNearest( bvh, p, HUGE_VAL, _zPH3DBVHClosestLeaf, &data );
+  if( face ) *face = data.face;
+  return d;
+}
+
+/* the contiguous vertex of faces of a leaf. */
+static double _zPH3DBVHContigVertLeaf(zPH3DBVH *bvh, int id, zVec3D *p, double dmin, void *priv)
+{
+  zTri3D *t;
+  double d;
+  register int i, j;
+
+  for( i=0; i<bvh->node[id].num; i++ ){
+    t = zPH3DFace( bvh->ph, zPH3DBVHLeafFace(bvh,id,i) );
+    for( j=0; j<3; j++ )
+      if( ( d = zVec3DDist( zTri3DVert(t,j), p ) ) < dmin ){
+        *(zVec3D **)priv = zTri3DVert(t,j);
+        dmin = d;
+      }
+  }
+  return dmin;
+}
+
+/* the contiguous vertex of a polyhedron of a bounding volume hierarchy. */
+zVec3D *zPH3DBVHContigVert(zPH3DBVH *bvh, zVec3D *p, double *d)
+{
+  zVec3D *v = NULL;
+  double _d;
+
+  if( !d ) d = &_d;
+  if( bvh->nodenum == 0 ) return NULL;
+  *d = _zPH3DBVHNearest( bvh, p, HUGE_VAL, _zPH3DBVHContigVertLeaf, &v );
+  return v;
+}
+
+/* ray casting to a polyhedron of a bounding volume hierarchy. */
+int zPH3DBVHRayCast(zPH3DBVH *bvh, zVec3D *org, zVec3D *dir, double tmax, double *t)
+{
+  int stack[ZEO_PH3D_BVH_DEPTH_MAX+1], sp = 0, id, c0, c1, f, face = -1;
+  double tstack[ZEO_PH3D_BVH_DEPTH_MAX+1], t0, t1, tf;
+  bool h0, h1;
+  register int i;
+
+  if( bvh->nodenum == 0 || !zAABox3DRayHit( &bvh->node[0].box, org, dir, tmax, &t0 ) ) return -1;
+  stack[sp] = 0;
+  tstack[sp++] = t0;
+  while( sp > 0 ){
+    id = stack[--sp];
+    if( tstack[sp] > tmax ) continue;
+    if( zPH3DBVHIsLeaf(bvh,id) ){
+      for( i=0; i<bvh->node[id].num; i++ ){
+        f = zPH3DBVHLeafFace(bvh,id,i);
+        if( zTri3DRayHit( zPH3DFace(bvh->ph,f), org, dir, tmax, &tf ) ){
+          tmax = tf;
+          face = f;
+        }
+      }
+      continue;
+    }
+    c0 = id + 1;
+    c1 = bvh->node[id].head;
+    h0 = zAABox3DRayHit( &bvh->node[c0].box, org, dir, tmax, &t0 );
+    h1 = zAABox3DRayHit( &bvh->node[c1].box, org, dir, tmax, &t1 );
+    if( h0 && h1 && t0 > t1 ){
+      zSwap( int, c0, c1 );
+      zSwap( double, t0, t1 );
+    }
+    if( h1 ){
+      stack[sp] = c1; tstack[sp++] = t1;
+    }
+    if( h0 ){
+      stack[sp] = c0; tstack[sp++] = t0;
+    }
+  }
+  if( face >= 0 && t ) *t = tmax;
+  return face;
+}
+
+/* check if a ray hits any face of a polyhedron of a bounding volume hierarchy. */
+int zPH3DBVHRayAnyHit(zPH3DBVH *bvh, zVec3D *org, zVec3D *dir, double tmax)
+{
+  int stack[ZEO_PH3D_BVH_DEPTH_MAX+1], sp = 0, id, f;
+  register int i;
+
+  if( bvh->nodenum == 0 ) return -1;
+  stack[sp++] = 0;
+  while( sp > 0 ){
+    id = stack[--sp];
+    if( !zAABox3DRayHit( &bvh->node[id].box, org, dir, tmax, NULL ) ) continue;
+    if( zPH3DBVHIsLeaf(bvh,id) ){
+      for( i=0; i<bvh->node[id].num; i++ )
+        if( zTri3DRayHit( zPH3DFace(bvh->ph,( f = zPH3DBVHLeafFace(bvh,id,i) )), org, dir, tmax, NULL ) )
+          return f;
+      continue;
+    }
+    stack[sp++] = bvh->node[id].head;
+    stack[sp++] = id + 1;
+  }
+  return -1;
+}
+
+/* find faces of a polyhedron of a bounding volume hierarchy which intersect with an axis-aligned box. */
+void zPH3DBVHQueryAABox3D(zPH3DBVH *bvh, zAABox3D *box, bool (*callback)(int,void*), void *priv)
+{
+  int stack[ZEO_PH3D_BVH_DEPTH_MAX+1], sp = 0, id, f;
+  register int i;
+
+  if( bvh->nodenum == 0 ) return;
+  stack[sp++] = 0;
+  while( sp > 0 ){
+    id = stack[--sp];
+    if( !_zAABox3DOverlap( &bvh->node[id].box, box ) ) continue;
+    if( zPH3DBVHIsLeaf(bvh,id) ){
+      for( i=0; i<bvh->node[id].num; i++ ){
+        f = zPH3DBVHLeafFace(bvh,id,i);
+        if( zColChkTriAABox3D( zPH3DFace(bvh->ph,f), box ) && !callback( f, priv ) ) return;
+      }
+      continue;
+    }
+    stack[sp++] = bvh->node[id].head;
+    stack[sp++] = id + 1;
+  }
+}
+
+/* find pairs of intersecting faces of polyhedra of two bounding volume hierarchies. */
+void zPH3DBVHQueryPair(zPH3DBVH *bvh1, zPH3DBVH *bvh2, bool (*callback)(int,int,void*), void *priv)
+{
+  int stack[4*ZEO_PH3D_BVH_DEPTH_MAX], sp = 0, id1, id2, f1, f2;
+  zPH3DBVHNode *n1, *n2;
+  register int i, j;
+
+  if( bvh1->nodenum == 0 || bvh2->nodenum == 0 ) return;
+  stack[sp++] = 0; stack[sp++] = 0;
+  while( sp > 0 ){
+    id2 = stack[--sp];
+    id1 = stack[--sp];
+    n1 = &bvh1->node[id1];
+    n2 = &bvh2->node[id2];
+    if( !_zAABox3DOverlap( &n1->box, &n2->box ) ) continue;
+    if( n1->num > 0 && n2->num > 0 ){
+      for( i=0; i<n1->num; i++ ){
+        f1 = bvh1->face[n1->head+i];
+        for( j=0; j<n2->num; j++ ){
+          f2 = bvh2->face[n2->head+j];
+          if( zColChkTri3D( zPH3DFace(bvh1->ph,f1), zPH3DFace(bvh2->ph,f2) ) && !callback( f1, f2, priv ) ) return;
+        }
+      }
+      continue;
+    }
+    /* descend into the larger branch */
+    if( n2->num > 0 || ( n1->num == 0 && zAABox3DArea( &n1->box ) > zAABox3DArea( &n2->box ) ) ){
+      stack[sp++] = n1->head; stack[sp++] = id2;
+      stack[sp++] = id1 + 1;  stack[sp++] = id2;
+    } else{
+      stack[sp++] = id1; stack[sp++] = n2->head;
+      stack[sp++] = id1; stack[sp++] = id2 + 1;
+    }
+  }
+}
+
+/* store the first pair of intersecting faces. */
+static bool _zPH3DBVHColChkPair(int f1, int f2, void *priv)
+{
+  ((int *)priv)[0] = f1;
+  ((int *)priv)[1] = f2;
+  return false;
+}
+
+/* check if polyhedra of two bounding volume hierarchies intersect with each other. */
+bool zPH3DBVHColChk(zPH3DBVH *bvh1, zPH3DBVH *bvh2, int *face1, int *face2)
+{
+  int pair[2] = { -1, -1 };
+
+  zPH3DBVHQueryPair( bvh1, bvh2, _zPH3DBVHColChkPair, pair );
+  if( face1 ) *face1 = pair[0];
+  if( face2 ) *face2 = pair[1];
+  return pair[0] >= 0;
+}
+
+/* directions of rays to count crossings with faces, which are chosen to be unlikely aligned with edges. */
+static const double _zeo_ph3d_bvh_inside_dir[][3] = {
+  { 0.5477225575, 0.2672612419, 0.7745966692 },
+  {-0.3015113446, 0.8528028654, 0.4264014327 },
+  { 0.6324555320,-0.5163977795, 0.5773502692 },
+  {-0.7071067812,-0.1825741858,-0.6831300511 },
+};
+#define ZEO_PH3D_BVH_INSIDE_DIR_NUM ( (int)( sizeof(_zeo_ph3d_bvh_inside_dir)/sizeof(_zeo_ph3d_bvh_inside_dir[0]) ) )
+
+#define ZEO_PH3D_BVH_INSIDE_EPS 1.0e-9 /* relative margin of barycentric coordinates to detect degenerate crossings */
+
+/* crossing of a ray and a face; returns -1 for a degenerate crossing, 0 for no crossing,
+ * and 1 for a crossing. the direction of crossing is stored in sgn. */
+static int _zPH3DBVHCrossFace(zTri3D *tri, zVec3D *org, zVec3D *dir, int *sgn)
+{
+  zVec3D e1, e2, n, s, pv, qv;
+  double a, det, u, v, t;
+
+  zVec3DSub( zTri3DVert(tri,1), zTri3DVert(tri,0), &e1 );
+  zVec3DSub( zTri3DVert(tri,2), zTri3DVert(tri,0), &e2 );
+  zVec3DOuterProd( &e1, &e2, &n );
+  if( zIsTiny( ( a = zVec3DNorm(&n) ) ) ) return 0; /* a face without area is never crossed */
+  zVec3DSub( org, zTri3DVert(tri,0), &s );
+  zVec3DOuterProd( dir, &e2, &pv );
+  if( fabs( ( det = zVec3DInnerProd( &e1, &pv ) ) ) <= ZEO_PH3D_BVH_INSIDE_EPS * a * zVec3DNorm(dir) )
+    /* the ray parallel to the face crosses it only if it lies on the plane */
+    return zIsTiny( zVec3DInnerProd( &s, &n ) / a ) ? -1 : 0;
+  u = zVec3DInnerProd( &s, &pv ) / det;
+  zVec3DOuterProd( &s, &e1, &qv );
+  v = zVec3DInnerProd( dir, &qv ) / det;
+  t = zVec3DInnerProd( &e2, &qv ) / det;
+  if( u < -ZEO_PH3D_BVH_INSIDE_EPS || v < -ZEO_PH3D_BVH_INSIDE_EPS || u + v > 1 + ZEO_PH3D_BVH_INSIDE_EPS || t < 0 )
+    return 0;
+  /* the ray passes an edge or a vertex */
+  if( u < ZEO_PH3D_BVH_INSIDE_EPS || v < ZEO_PH3D_BVH_INSIDE_EPS || u + v > 1 - ZEO_PH3D_BVH_INSIDE_EPS ) return -1;
+  *sgn = det < 0 ? 1 : -1; /* det is negative if the ray goes along the normal vector */
+  return 1;
+}
+
+/* winding number of a polyhedron around a point counted with signed crossings of a ray;
+ * returns the false value if the ray passes an edge or a vertex, where the count may be wrong. */
+static bool _zPH3DBVHWindingNum(zPH3DBVH *bvh, zVec3D *p, zVec3D *dir, int *wn)
+{
+  int stack[ZEO_PH3D_BVH_DEPTH_MAX+1], sp = 0, id, sgn = 0, ret;
+  bool regular = true;
+  register int i;
+
+  *wn = 0;
+  stack[sp++] = 0;
+  while( sp > 0 ){
+    id = stack[--sp];
+    if( !zAABox3DRayHit( &bvh->node[id].box, p, dir, HUGE_VAL, NULL ) ) continue;
+    if( zPH3DBVHIsLeaf(bvh,id) ){
+      for( i=0; i<bvh->node[id].num; i++ ){
+        if( ( ret = _zPH3DBVHCrossFace( zPH3DFace(bvh->ph,zPH3DBVHLeafFace(bvh,id,i)), p, dir, &sgn ) ) < 0 )
+          regular = false;
+        else if( ret > 0 ) *wn += sgn;
+      }
+      continue;
+    }
+    stack[sp++] = bvh->node[id].head;
+    stack[sp++] = id + 1;
+  }
+  return regular;
+}
+
+/* check if a point is inside of a polyhedron of a bounding volume hierarchy. */
+bool zPH3DBVHPointIsInside(zPH3DBVH *bvh, zVec3D *p, bool rim)
+{
+  zVec3D cp, dir;
+  int wn = 0;
+  register int i;
+
+  if( bvh->nodenum == 0 ) return false;
+  if( zPH3DBVHClosest( bvh, p, &cp, NULL ) < zTOL ) return rim;
+  for( i=0; i<ZEO_PH3D_BVH_INSIDE_DIR_NUM; i++ ){
+    zVec3DCreate( &dir, _zeo_ph3d_bvh_inside_dir[i][0], _zeo_ph3d_bvh_inside_dir[i][1], _zeo_ph3d_bvh_inside_dir[i][2] );
+    if( _zPH3DBVHWindingNum( bvh, p, &dir, &wn ) ) break;
+  } /* the last count is adopted if all rays pass edges or vertices */
+  return wn != 0;
+}
+
+/* arguments of a thread to check if points are inside of a polyhedron */
+typedef struct{
+  zPH3DBVH *bvh;
+  zVec3D *p;
+  int n;
+  bool rim;
+  bool *inside;
+  int count;
+} zPH3DBVHPointIsInsideArg;
+
+/* check if points are inside of a polyhedron (thread function). */
+static void *_zPH3DBVHPointIsInsideThread(void *arg)
+{
+  zPH3DBVHPointIsInsideArg *a;
+  register int i;
+
+  a = arg;
+  for( a->count=0, i=0; i<a->n; i++ )
+    if( ( a->inside[i] = zPH3DBVHPointIsInside( a->bvh, &a->p[i], a->rim ) ) ) a->count++;
+  return NULL;
+}
+
+/* check if points are inside of a polyhedron of a bounding volume hierarchy. */
+int zPH3DBVHPointIsInsideBatch(zPH3DBVH *bvh, zVec3D p[], int n, bool rim, bool inside[], int nthread)
+{
+  zPH3DBVHPointIsInsideArg *arg;
+  int chunk, count = 0;
+  register int i;
+
+  if( nthread > n ) nthread = n;
+  if( nthread < 1 ) nthread = 1;
+  chunk = ( n + nthread - 1 ) / nthread;
+  if( !( arg = zAlloc( zPH3DBVHPointIsInsideArg, nthread ) ) ){
+    ZALLOCERROR();
+    return 0;
+  }
+  for( i=0; i<nthread; i++ ){
+    arg[i].bvh = bvh;
+    arg[i].p = p + i*chunk;
+    arg[i].n = zMin( chunk, n - i*chunk );
+    arg[i].rim = rim;
+    arg[i].inside = inside + i*chunk;
+  }
+  zThreadRun( _zPH3DBVHPointIsInsideThread, arg, sizeof(zPH3DBVHPointIsInsideArg), nthread );
+  for( i=0; i<nthread; i++ )
+    count += arg[i].count;
+  zFree( arg );
+  return count;
+}
+
+/* ********************************************************** */
+/* CLASS: zMShape3DBVH
+ * two-level bounding volume hierarchy of multiple shapes
+ * ********************************************************** */
+
+/* initialize a two-level bounding volume hierarchy of multiple shapes. */
+zMShape3DBVH *zMShape3DBVHInit(zMShape3DBVH *mb, zMShape3D *ms)
+{
+  mb->ms = ms;
+  zAABBTreeInit( &mb->tree, zTOL ); /* margin for points on the rim */
+  mb->bvh = NULL;
+  mb->built = false;
+  return mb;
+}
+
+/* build a two-level bounding volume hierarchy of multiple shapes. */
+bool zMShape3DBVHBuild(zMShape3DBVH *mb)
+{
+  zShape3D *shape;
+  zAABox3D box;
+  register int i;
+
+  zMShape3DBVHReset( mb );
+  if( zMShape3DShapeNum(mb->ms) == 0 ) return ( mb->built = true );
+  if( !( mb->bvh = zAlloc( zPH3DBVH, zMShape3DShapeNum(mb->ms) ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  for( i=0; i<zMShape3DShapeNum(mb->ms); i++ ){
+    shape = zMShape3DShape(mb->ms,i);
+    zPH3DBVHInit( &mb->bvh[i] );
+    if( shape->com == &zeo_shape3d_ph_com && zPH3DFaceNum(zShape3DPH(shape)) > 0 &&
+        !zPH3DBVHCreate( &mb->bvh[i], zShape3DPH(shape), 1 ) ) goto FAILURE;
+    if( !zShape3DToAABox3D( shape, &box ) ) continue; /* an empty shape is never hit */
+    if( zAABBTreeInsert( &mb->tree, &box, shape ) < 0 ) goto FAILURE;
+  }
+  return ( mb->built = true );
+
+ FAILURE:
+  zMShape3DBVHReset( mb );
+  return false;
+}
+
+/* discard a two-level bounding volume hierarchy of multiple shapes. */
+void zMShape3DBVHReset(zMShape3DBVH *mb)
+{
+  register int i;
+
+  if( mb->bvh ){
+    for( i=0; i<zMShape3DShapeNum(mb->ms); i++ )
+      zPH3DBVHDestroy( &mb->bvh[i] );
+    zFree( mb->bvh );
+  }
+  zAABBTreeDestroy( &mb->tree );
+  mb->built = false;
+}
+
+/* destroy a two-level bounding volume hierarchy of multiple shapes. */
+void zMShape3DBVHDestroy(zMShape3DBVH *mb)
+{
+  zMShape3DBVHReset( mb );
+  mb->ms = NULL;
+}
+
+/* build a two-level bounding volume hierarchy if it is not yet. */
+static bool _zMShape3DBVHPrepare(zMShape3DBVH *mb)
+{
+  return mb->built || zMShape3DBVHBuild( mb );
+}
+
+/* query of the closest point on multiple shapes */
+typedef struct{
+  zMShape3DBVH *mb;
+  zVec3D *cp;
+  int id;
+  double dmin;
+} zMShape3DBVHClosestData;
+
+/* the closest point on a shape of a leaf nearer than the closest one found so far. */
+static double _zMShape3DBVHClosestLeaf(int leaf, zVec3D *p, void *priv)
+{
+  zMShape3DBVHClosestData *data;
+  zPH3DBVHClosestData phdata;
+  zVec3D cp;
+  double d;
+  int i;
+
+  data = priv;
+  i = (zShape3D *)zAABBTreeData(&data->mb->tree,leaf) - zMShape3DShapeBuf(data->mb->ms);
+  if( zPH3DBVHNodeNum(&data->mb->bvh[i]) > 0 ){
+    phdata.cp = &cp;
+    phdata.face = -1;
+    /* faces farther than the closest point on other shapes are pruned */
+    d = _zPH3DBVHNearest( &data->mb->bvh[i], p, data->dmin, _zPH3DBVHClosestLeaf, &phdata );
+    if( phdata.face < 0 ) return HUGE_VAL;
+  } else
+    d = zShape3DClosest( zMShape3DShape(data->mb->ms,i), p, &cp );
+  if( d < data->dmin ){
+    zVec3DCopy( &cp, data->cp );
+    data->id = i;
+    data->dmin = d;
+  }
+  return d;
+}
+
+/* the closest point on multiple shapes of a two-level bounding volume hierarchy. */
+double zMShape3DBVHClosest(zMShape3DBVH *mb, zVec3D *p, zVec3D *cp, int *id)
+{
+  zMShape3DBVHClosestData data;
+  zVec3D ncp;
+  double d;
+  register int i;
+
+  data.mb = mb;
+  data.cp = cp;
+  data.id = -1;
+  data.dmin = HUGE_VAL;
+  if( _zMShape3DBVHPrepare( mb ) )
+    zAABBTreeClosest( &mb->tree, p, _zMShape3DBVHClosestLeaf, &data, NULL );
+  else{ /* fall back to the linear scan over shapes */
+    for( i=0; i<zMShape3DShapeNum(mb->ms); i++ )
+      if( ( d = zShape3DClosest( zMShape3DShape(mb->ms,i), p, &ncp ) ) < data.dmin ){
+        zVec3DCopy( &ncp, cp );
+        data.id = i;
+        data.dmin = d;
+      }
+  }
+  if( data.id < 0 ) zVec3DCopy( p, cp );
+  if( id ) *id = data.id;
+  return data.dmin;
+}
+
+/* query of a point inside of multiple shapes */
+typedef struct{
+  zMShape3DBVH *mb;
+  zVec3D *p;
+  bool rim;
+  bool inside;
+} zMShape3DBVHPointIsInsideData;
+
+/* check if a point is inside of a shape of a leaf. */
+static bool _zMShape3DBVHPointIsInsideLeaf(int leaf, void *priv)
+{
+  zMShape3DBVHPointIsInsideData *data;
+  int i;
+
+  data = priv;
+  i = (zShape3D *)zAABBTreeData(&data->mb->tree,leaf) - zMShape3DShapeBuf(data->mb->ms);
+  data->inside = zPH3DBVHNodeNum(&data->mb->bvh[i]) > 0 ?
+    zPH3DBVHPointIsInside( &data->mb->bvh[i], data->p, data->rim ) :
+    zShape3DPointIsInside( zMShape3DShape(data->mb->ms,i), data->p, data->rim );
+  return !data->inside;
+}
+
+/* check if a point is inside of multiple shapes of a two-level bounding volume hierarchy. */
+bool zMShape3DBVHPointIsInside(zMShape3DBVH *mb, zVec3D *p, bool rim)
+{
+  zMShape3DBVHPointIsInsideData data;
+  zAABox3D box;
+
+  if( !_zMShape3DBVHPrepare( mb ) )
+    return zMShape3DPointIsInside( mb->ms, p, rim );
+  data.mb = mb;
+  data.p = p;
+  data.rim = rim;
+  data.inside = false;
+  zAABox3DCreate( &box, p->c.x, p->c.y, p->c.z, p->c.x, p->c.y, p->c.z );
+  zAABBTreeQuery( &mb->tree, &box, _zMShape3DBVHPointIsInsideLeaf, &data );
+  return data.inside;
+}
@@ -0,0 +1,408 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_contact - collision checking: contact manifold.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* tolerance on the cosine to regard faces as coplanar */
+#define ZEO_CONTACT_COPLANAR_TOL 1.0e-6
+/* bias to prefer a reference face on object 1 for temporal coherence */
+#define ZEO_CONTACT_REF_BIAS     1.0e-2
+
+/* an object which provides faces to be clipped */
+typedef struct{
+  zPH3D *ph;    /* convex polyhedron */
+  zBox3D *box;  /* box */
+  zFrame3D *f;  /* frame of the object (null for the identity) */
+  int vnum;     /* maximum number of vertices on a face */
+} zContactBody;
+
+static void _zContactBodyPH3D(zContactBody *b, zPH3D *ph, zFrame3D *f);
+static void _zContactBodyBox3D(zContactBody *b, zBox3D *box);
+static zVec3D *_zContactBodyXform(zContactBody *b, zVec3D *v, zVec3D *tv);
+static zVec3D *_zContactBodyXformInv(zContactBody *b, zVec3D *v, zVec3D *tv);
+static int _zContactBodyFacePH3D(zContactBody *b, zVec3D *dir, zVec3D poly[], zVec3D *norm, double *align);
+static int _zContactBodyFaceBox3D(zContactBody *b, zVec3D *dir, zVec3D poly[], zVec3D *norm, double *align);
+static int _zContactBodyFace(zContactBody *b, zVec3D *dir, zVec3D poly[], zVec3D *norm, double *align);
+static int _zContactClipPlane(zVec3D src[], int n, zVec3D *p, zVec3D *nv, zVec3D dest[]);
+static int _zContactClip(zVec3D ref[], int nr, zVec3D *norm, zVec3D inc[], int ni, zVec3D buf[]);
+static double _zContactArea(zVec3D *p0, zVec3D *p1, zVec3D *p2, zVec3D *norm);
+static int _zContactReduce(zContact3D c[], int n, zVec3D *norm);
+static void _zContactManifold3DMerge(zContactManifold3D *m, zContact3D c[], int n, zContactBody *b1, zContactBody *b2);
+static int _zContactManifold3D(zContactManifold3D *m, zContactBody *b1, zConvex3D *cv1, zContactBody *b2, zConvex3D *cv2);
+
+/* a convex polyhedron as an object to be clipped. */
+void _zContactBodyPH3D(zContactBody *b, zPH3D *ph, zFrame3D *f)
+{
+  b->ph = ph;
+  b->box = NULL;
+  b->f = f;
+  b->vnum = zPH3DVertNum(ph);
+}
+
+/* a box as an object to be clipped. */
+void _zContactBodyBox3D(zContactBody *b, zBox3D *box)
+{
+  b->ph = NULL;
+  b->box = box;
+  b->f = &box->f;
+  b->vnum = 4;
+}
+
+/* transform a point from the local frame of an object. */
+zVec3D *_zContactBodyXform(zContactBody *b, zVec3D *v, zVec3D *tv)
+{
+  return b->f ? zXform3D( b->f, v, tv ) : zVec3DCopy( v, tv );
+}
+
+/* transform a point to the local frame of an object. */
+zVec3D *_zContactBodyXformInv(zContactBody *b, zVec3D *v, zVec3D *tv)
+{
+  return b->f ? zXform3DInv( b->f, v, tv ) : zVec3DCopy( v, tv );
+}
+
+/* face of a convex polyhedron most aligned with a direction. */
+int _zContactBodyFacePH3D(zContactBody *b, zVec3D *dir, zVec3D poly[], zVec3D *norm, double *align)
+{
+  zVec3D d, nl, e1, e2, c, v;
+  double a, ai, aj;
+  register int i, j, k, n = 0, imax = 0;
+
+  if( b->f )
+    zMulMat3DTVec3D( zFrame3DAtt(b->f), dir, &d );
+  else
+    zVec3DCopy( dir, &d );
+  for( *align=-HUGE_VAL, i=0; i<zPH3DFaceNum(b->ph); i++ )
+    if( ( a = zVec3DInnerProd( zPH3DFaceNorm(b->ph,i), &d ) ) > *align ){
+      *align = a;
+      imax = i;
+    }
+  zVec3DCopy( zPH3DFaceNorm(b->ph,imax), &nl );
+  /* merge coplanar triangles into a polygon */
+  for( i=0; i<zPH3DFaceNum(b->ph); i++ ){
+    if( zVec3DInnerProd( zPH3DFaceNorm(b->ph,i), &nl ) < 1 - ZEO_CONTACT_COPLANAR_TOL ) continue;
+    for( j=0; j<3; j++ ){
+      for( k=0; k<n; k++ )
+        if( zVec3DEqual( &poly[k], zPH3DFaceVert(b->ph,i,j) ) ) break;
+      if( k == n ) zVec3DCopy( zPH3DFaceVert(b->ph,i,j), &poly[n++] );
+    }
+  }
+  /* sort vertices counterclockwise about the normal */
+  for( zVec3DZero( &c ), i=0; i<n; i++ ) zVec3DAddDRC( &c, &poly[i] );
+  zVec3DDivDRC( &c, n );
+  zVec3DOrthoSpace( &nl, &e1, &e2 );
+  zVec3DOuterProd( &nl, &e1, &e2 );
+  for( i=1; i<n; i++ ){
+    zVec3DCopy( &poly[i], &v );
+    zVec3DSub( &v, &c, &d );
+    ai = atan2( zVec3DInnerProd(&d,&e2), zVec3DInnerProd(&d,&e1) );
+    for( j=i; j>0; j-- ){
+      zVec3DSub( &poly[j-1], &c, &d );
+      aj = atan2( zVec3DInnerProd(&d,&e2), zVec3DInnerProd(&d,&e1) );
+      if( aj <= ai ) break;
+      zVec3DCopy( &poly[j-1], &poly[j] );
+    }
+    zVec3DCopy( &v, &poly[j] );
+  }
+  for( i=0; i<n; i++ ){
+    _zContactBodyXform( b, &poly[i], &v );
+    zVec3DCopy( &v, &poly[i] );
+  }
+  if( b->f )
+    zMulMat3DVec3D( zFrame3DAtt(b->f), &nl, norm );
+  else
+    zVec3DCopy( &nl, norm );
+  return n;
+}
+
+/* face of a box most aligned with a direction. */
+int _zContactBodyFaceBox3D(zContactBody *b, zVec3D *dir, zVec3D poly[], zVec3D *norm, double *align)
+{
+  zVec3D c, u, v;
+  double a, s = 1;
+  register int i, imax = 0;
+  static const double su[] = { 1, -1, -1, 1 }, sv[] = { 1, 1, -1, -1 };
+
+  for( *align=-HUGE_VAL, i=zX; i<=zZ; i++ ){
+    if( ( a = zVec3DInnerProd( zBox3DAxis(b->box,i), dir ) ) > *align ){
+      *align = a; imax = i; s = 1;
+    }
+    if( -a > *align ){
+      *align = -a; imax = i; s = -1;
+    }
+  }
+  zVec3DMul( zBox3DAxis(b->box,imax), s, norm );
+  zVec3DCat( zBox3DCenter(b->box), 0.5*zBox3DDia(b->box,imax), norm, &c );
+  zVec3DMul( zBox3DAxis(b->box,(imax+1)%3), 0.5*zBox3DDia(b->box,(imax+1)%3), &u );
+  zVec3DMul( zBox3DAxis(b->box,(imax+2)%3), 0.5*zBox3DDia(b->box,(imax+2)%3), &v );
+  for( i=0; i<4; i++ ) /* counterclockwise about the normal */
+    zVec3DCat( &c, su[i], &u, &poly[s > 0 ? i : 3-i] );
+  for( i=0; i<4; i++ )
+    zVec3DCatDRC( &poly[s > 0 ? i : 3-i], sv[i], &v );
+  return 4;
+}
+
+/* face of an object most aligned with a direction. */
+int _zContactBodyFace(zContactBody *b, zVec3D *dir, zVec3D poly[], zVec3D *norm, double *align)
+{
+  return b->ph ?
+    _zContactBodyFacePH3D( b, dir, poly, norm, align ) :
+    _zContactBodyFaceBox3D( b, dir, poly, norm, align );
+}
+
+/* clip a polygon by a plane (Sutherland-Hodgman). */
+int _zContactClipPlane(zVec3D src[], int n, zVec3D *p, zVec3D *nv, zVec3D dest[])
+{
+  zVec3D d;
+  double d0, d1;
+  register int i, m = 0;
+
+  if( n == 0 ) return 0;
+  zVec3DSub( &src[n-1], p, &d );
+  d0 = zVec3DInnerProd( &d, nv );
+  for( i=0; i<n; i++ ){
+    zVec3DSub( &src[i], p, &d );
+    d1 = zVec3DInnerProd( &d, nv );
+    if( ( d0 <= 0 ) != ( d1 <= 0 ) ) /* crossing point */
+      zVec3DInterDiv( &src[i==0?n-1:i-1], &src[i], d0/(d0-d1), &dest[m++] );
+    if( d1 <= 0 ) zVec3DCopy( &src[i], &dest[m++] );
+    d0 = d1;
+  }
+  return m;
+}
+
+/* clip an incident face by side planes of a reference face. */
+int _zContactClip(zVec3D ref[], int nr, zVec3D *norm, zVec3D inc[], int ni, zVec3D buf[])
+{
+  zVec3D e, sn;
+  register int i;
+
+  for( i=0; i<nr && ni>0; i++ ){
+    zVec3DSub( &ref[(i+1)%nr], &ref[i], &e );
+    zVec3DOuterProd( &e, norm, &sn );
+    ni = _zContactClipPlane( inc, ni, &ref[i], &sn, buf );
+    memcpy( inc, buf, sizeof(zVec3D)*ni );
+  }
+  return ni;
+}
+
+/* signed area of a triangle projected onto a plane. */
+double _zContactArea(zVec3D *p0, zVec3D *p1, zVec3D *p2, zVec3D *norm)
+{
+  zVec3D e1, e2, n;
+
+  zVec3DSub( p1, p0, &e1 );
+  zVec3DSub( p2, p0, &e2 );
+  zVec3DOuterProd( &e1, &e2, &n );
+  return zVec3DInnerProd( &n, norm );
+}
+
+#define _zContactSwap(c,i,j) do{\
+  zContact3D __tmp;\
+  if( (i) != (j) ){\
+    zCopy( zContact3D, &(c)[i], &__tmp );\
+    zCopy( zContact3D, &(c)[j], &(c)[i] );\
+    zCopy( zContact3D, &__tmp, &(c)[j] );\
+  }\
+} while(0)
+
+/* reduce contact points to four which span the largest area. */
+int _zContactReduce(zContact3D c[], int n, zVec3D *norm)
+{
+  double val, max, a;
+  register int i, imax;
+
+  if( n <= ZEO_CONTACT_MANIFOLD_SIZE ) return n;
+  /* the deepest point */
+  for( imax=0, i=1; i<n; i++ )
+    if( c[i].depth > c[imax].depth ) imax = i;
+  _zContactSwap( c, 0, imax );
+  /* the farthest point from the first */
+  for( max=-1, imax=1, i=1; i<n; i++ )
+    if( ( val = zVec3DSqrDist( &c[i].p1, &c[0].p1 ) ) > max ){
+      max = val; imax = i;
+    }
+  _zContactSwap( c, 1, imax );
+  /* the point which maximizes the triangle area */
+  for( max=-1, imax=2, i=2; i<n; i++ )
+    if( ( val = fabs( _zContactArea( &c[0].p1, &c[1].p1, &c[i].p1, norm ) ) ) > max ){
+      max = val; imax = i;
+    }
+  _zContactSwap( c, 2, imax );
+  if( _zContactArea( &c[0].p1, &c[1].p1, &c[2].p1, norm ) < 0 )
+    _zContactSwap( c, 1, 2 );
+  /* the point which enlarges the triangle most */
+  for( max=0, imax=-1, i=3; i<n; i++ ){
+    val = -_zContactArea( &c[0].p1, &c[1].p1, &c[i].p1, norm );
+    if( ( a = -_zContactArea( &c[1].p1, &c[2].p1, &c[i].p1, norm ) ) > val ) val = a;
+    if( ( a = -_zContactArea( &c[2].p1, &c[0].p1, &c[i].p1, norm ) ) > val ) val = a;
+    if( val > max ){
+      max = val; imax = i;
+    }
+  }
+  if( imax < 0 ) return 3;
+  _zContactSwap( c, 3, imax );
+  return ZEO_CONTACT_MANIFOLD_SIZE;
+}
+
+/* merge new contact points with persistent ones. */
+void _zContactManifold3DMerge(zContactManifold3D *m, zContact3D c[], int n, zContactBody *b1, zContactBody *b2)
+{
+  zContact3D old[ZEO_CONTACT_MANIFOLD_SIZE];
+  zVec3D d;
+  double dist, min, tol2;
+  register int i, j, jmin, no = 0;
+
+  tol2 = m->tol * m->tol;
+  /* refresh persistent points at the current frames */
+  for( i=0; i<m->num; i++ ){
+    _zContactBodyXform( b1, &m->cp[i].lp1, &m->cp[i].p1 );
+    _zContactBodyXform( b2, &m->cp[i].lp2, &m->cp[i].p2 );
+    zVec3DSub( &m->cp[i].p1, &m->cp[i].p2, &d );
+    m->cp[i].depth = zVec3DInnerProd( &d, &m->norm );
+    if( m->cp[i].depth < -m->tol ) continue; /* separated */
+    zVec3DCatDRC( &d, -m->cp[i].depth, &m->norm );
+    if( zVec3DSqrNorm( &d ) > tol2 ) continue; /* slid */
+    zCopy( zContact3D, &m->cp[i], &old[no++] );
+  }
+  /* inherit warm-starting data from the nearest persistent point */
+  for( i=0; i<n; i++ ){
+    for( min=tol2, jmin=-1, j=0; j<no; j++ )
+      if( ( dist = zVec3DSqrDist( &c[i].p1, &old[j].p1 ) ) <= min ){
+        min = dist; jmin = j;
+      }
+    if( jmin < 0 ) continue;
+    c[i].impulse = old[jmin].impulse;
+    c[i].life = old[jmin].life + 1;
+    zCopy( zContact3D, &old[--no], &old[jmin] );
+  }
+  /* keep unmatched persistent points */
+  for( j=0; j<no; j++, n++ ){
+    zCopy( zContact3D, &old[j], &c[n] );
+    c[n].life++;
+  }
+  m->num = _zContactReduce( c, n, &m->norm );
+  memcpy( m->cp, c, sizeof(zContact3D)*m->num );
+}
+
+/* contact manifold of a pair of objects. */
+int _zContactManifold3D(zContactManifold3D *m, zContactBody *b1, zConvex3D *cv1, zContactBody *b2, zConvex3D *cv2)
+{
+  zVec3D mtv, c1, c2, n1, n2, *ref, *buf;
+  zVec3D *poly1, *poly2, *p;
+  zContact3D *c;
+  zContactBody *rb, *ib;
+  double a1, a2, depth;
+  int nr, ni, size;
+  register int i, n = 0;
+
+  if( !zEPAConvex( cv1, cv2, 0, 0, &mtv, &c1, &c2 ) ){
+    m->num = 0;
+    return 0;
+  }
+  if( zVec3DIsTiny( &mtv ) ){ /* touching */
+    zConvex3DCenter( cv1, &n1 );
+    zConvex3DCenter( cv2, &n2 );
+    zVec3DSub( &n2, &n1, &mtv );
+    if( zVec3DIsTiny( &mtv ) ) zVec3DCreate( &mtv, 0, 0, 1 );
+  }
+  zVec3DNormalize( &mtv, &m->norm );
+  size = b1->vnum + b2->vnum;
+  poly1 = zAlloc( zVec3D, b1->vnum );
+  poly2 = zAlloc( zVec3D, b2->vnum );
+  buf = zAlloc( zVec3D, size*2 );
+  c = zAlloc( zContact3D, size + ZEO_CONTACT_MANIFOLD_SIZE );
+  if( !poly1 || !poly2 || !buf || !c ){
+    ZALLOCERROR();
+    m->num = 0;
+    goto TERMINATE;
+  }
+  /* reference and incident faces */
+  _zContactBodyFace( b1, &m->norm, poly1, &n1, &a1 );
+  zVec3DRev( &m->norm, &mtv );
+  _zContactBodyFace( b2, &mtv, poly2, &n2, &a2 );
+  if( a2 > a1 + ZEO_CONTACT_REF_BIAS ){
+    rb = b2; ib = b1; ref = poly2;
+  } else{
+    rb = b1; ib = b2; ref = poly1;
+  }
+  nr = _zContactBodyFace( rb, rb == b1 ? &m->norm : &mtv, ref, &n1, &a1 );
+  zVec3DRev( &n1, &n2 );
+  ni = _zContactBodyFace( ib, &n2, buf, &n2, &a2 );
+  ni = _zContactClip( ref, nr, &n1, buf, ni, buf+size );
+  /* contact points under the reference face */
+  for( i=0; i<ni; i++ ){
+    zVec3DSub( &ref[0], &buf[i], &mtv );
+    if( ( depth = zVec3DInnerProd( &mtv, &n1 ) ) < -zTOL ) continue;
+    p = &buf[i];
+    zVec3DCopy( p, rb == b1 ? &c[n].p2 : &c[n].p1 );
+    zVec3DCat( p, depth, &n1, rb == b1 ? &c[n].p1 : &c[n].p2 );
+    c[n++].depth = depth;
+  }
+  if( n == 0 ){ /* edge-to-edge contact */
+    zVec3DCopy( &c1, &c[0].p1 );
+    zVec3DCopy( &c2, &c[0].p2 );
+    zVec3DSub( &c1, &c2, &mtv );
+    c[n++].depth = zVec3DInnerProd( &mtv, &m->norm );
+  }
+  for( i=0; i<n; i++ ){
+    _zContactBodyXformInv( b1, &c[i].p1, &c[i].lp1 );
+    _zContactBodyXformInv( b2, &c[i].p2, &c[i].lp2 );
+    c[i].impulse = 0;
+    c[i].life = 0;
+  }
+  n = _zContactReduce( c, n, &m->norm );
+  _zContactManifold3DMerge( m, c, n, b1, b2 );
+
+ TERMINATE:
+  zFree( poly1 );
+  zFree( poly2 );
+  zFree( buf );
+  zFree( c );
+  return m->num;
+}
+
+/* initialize a contact manifold. */
+zContactManifold3D *zContactManifold3DInit(zContactManifold3D *m)
+{
+  m->num = 0;
+  zVec3DZero( &m->norm );
+  m->tol = ZEO_CONTACT_MANIFOLD_TOL;
+  return m;
+}
+
+/* contact manifold of a pair of convex polyhedra. */
+int zContactManifold3DPH3D(zContactManifold3D *m, zPH3D *ph1, zFrame3D *f1, zPH3D *ph2, zFrame3D *f2)
+{
+  zContactBody b1, b2;
+  zConvex3D cv1, cv2;
+
+  _zContactBodyPH3D( &b1, ph1, f1 );
+  _zContactBodyPH3D( &b2, ph2, f2 );
+  zConvex3DPH3D( &cv1, ph1, NULL );
+  zConvex3DSetFrame( &cv1, f1 );
+  zConvex3DPH3D( &cv2, ph2, NULL );
+  zConvex3DSetFrame( &cv2, f2 );
+  return _zContactManifold3D( m, &b1, &cv1, &b2, &cv2 );
+}
+
+/* contact manifold of a pair of boxes. */
+int zContactManifold3DBox3D(zContactManifold3D *m, zBox3D *box1, zBox3D *box2)
+{
+  zContactBody b1, b2;
+  zConvex3D cv1, cv2;
+  zVec3D v1[8], v2[8];
+  register int i;
+
+  _zContactBodyBox3D( &b1, box1 );
+  _zContactBodyBox3D( &b2, box2 );
+  for( i=0; i<8; i++ ){
+    zBox3DVert( box1, i, &v1[i] );
+    zBox3DVert( box2, i, &v2[i] );
+  }
+  zConvex3DPoints( &cv1, v1, 8 );
+  zConvex3DPoints( &cv2, v2, 8 );
+  return _zContactManifold3D( m, &b1, &cv1, &b2, &cv2 );
+}
@@ -0,0 +1,140 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_convex - collision checking: convex object with support map.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* ********************************************************** */
+/* CLASS: zConvex3D
+ * convex object represented by a support map
+ * ********************************************************** */
+
+/* support map of a set of points by a linear scan. */
+static zVec3D *_zConvex3DSupportMapScan(zConvex3D *c, zVec3D *v, zVec3D *sp)
+{
+  zVec3D vl, *p;
+
+  if( !c->f ){
+    c->hint = ( p = zVec3DSupportMap( c->vert, c->vnum, v ) ) - c->vert;
+    return zVec3DCopy( p, sp );
+  }
+  zMulMat3DTVec3D( zFrame3DAtt(c->f), v, &vl );
+  c->hint = ( p = zVec3DSupportMap( c->vert, c->vnum, &vl ) ) - c->vert;
+  return zXform3D( c->f, p, sp );
+}
+
+/* support vertex of a convex polyhedron by hill-climbing from the one cached for the octant of a direction. */
+static zVec3D *_zConvex3DSupportVertHC(zConvex3D *c, zVec3D *v)
+{
+  zVec3D *p;
+  int *cache;
+
+  cache = &c->cache[( v->c.x < 0 ) | ( v->c.y < 0 ) << 1 | ( v->c.z < 0 ) << 2];
+  if( *cache < 0 ) *cache = c->hint;
+  p = zPH3DAdjSupportMap( c->adj, c->vert, v, cache );
+  c->hint = *cache;
+  return p;
+}
+
+/* support map of a convex polyhedron by hill-climbing. */
+static zVec3D *_zConvex3DSupportMapHC(zConvex3D *c, zVec3D *v, zVec3D *sp)
+{
+  zVec3D vl;
+
+  if( !c->f )
+    return zVec3DCopy( _zConvex3DSupportVertHC( c, v ), sp );
+  zMulMat3DTVec3D( zFrame3DAtt(c->f), v, &vl );
+  return zXform3D( c->f, _zConvex3DSupportVertHC( c, &vl ), sp );
+}
+
+/* support map of a shape. */
+static zVec3D *_zConvex3DSupportMapShape(zConvex3D *c, zVec3D *v, zVec3D *sp)
+{
+  zVec3D vl, spl;
+
+  if( !c->f )
+    return zShape3DSupportMap( c->shape, v, sp );
+  zMulMat3DTVec3D( zFrame3DAtt(c->f), v, &vl );
+  if( !zShape3DSupportMap( c->shape, &vl, &spl ) ) return NULL;
+  return zXform3D( c->f, &spl, sp );
+}
+
+/* initialize a convex object. */
+static zConvex3D *_zConvex3DInit(zConvex3D *c, zVec3D p[], int n)
+{
+  register int i;
+
+  c->vert = p;
+  c->vnum = n;
+  c->adj = NULL;
+  c->shape = NULL;
+  c->hint = 0;
+  for( i=0; i<8; i++ ) c->cache[i] = -1;
+  c->f = NULL;
+  zVec3DZero( &c->center );
+  for( i=0; i<n; i++ )
+    zVec3DAddDRC( &c->center, &p[i] );
+  if( n > 0 ) zVec3DDivDRC( &c->center, n );
+  c->_support = _zConvex3DSupportMapScan;
+  return c;
+}
+
+/* create a convex object from a set of points. */
+zConvex3D *zConvex3DPoints(zConvex3D *c, zVec3D p[], int n)
+{
+  return _zConvex3DInit( c, p, n );
+}
+
+/* create a convex object from a convex polyhedron. */
+zConvex3D *zConvex3DPH3D(zConvex3D *c, zPH3D *ph, zPH3DAdj *adj)
+{
+  _zConvex3DInit( c, zPH3DVertBuf(ph), zPH3DVertNum(ph) );
+  if( adj && adj->num == zPH3DVertNum(ph) ){
+    c->adj = adj;
+    c->_support = _zConvex3DSupportMapHC;
+  }
+  return c;
+}
+
+/* create a convex object from a shape. */
+zConvex3D *zConvex3DShape(zConvex3D *c, zShape3D *shape)
+{
+  zVec3D v, sp;
+  register zDir d;
+
+  _zConvex3DInit( c, NULL, 0 );
+  c->hint = -1;
+  c->shape = shape;
+  c->_support = _zConvex3DSupportMapShape;
+  /* the mean of support points along the six principal directions */
+  for( d=zX; d<=zZ; d++ ){
+    zVec3DZero( &v );
+    v.e[d] = 1;
+    if( !zShape3DSupportMap( shape, &v, &sp ) ) goto EMPTY;
+    zVec3DAddDRC( &c->center, &sp );
+    v.e[d] =-1;
+    if( !zShape3DSupportMap( shape, &v, &sp ) ) goto EMPTY;
+    zVec3DAddDRC( &c->center, &sp );
+  }
+  zVec3DDivDRC( &c->center, 6 );
+  return c;
+
+ EMPTY:
+  ZRUNWARN( ZEO_ERR_EMPTYSET );
+  return NULL;
+}
+
+/* center of a convex object. */
+zVec3D *zConvex3DCenter(zConvex3D *c, zVec3D *center)
+{
+  return c->f ? zXform3D( c->f, &c->center, center ) : zVec3DCopy( &c->center, center );
+}
+
+/* a vertex of a convex object. */
+zVec3D *zConvex3DVert(zConvex3D *c, int i, zVec3D *v)
+{
+  if( !c->vert || i < 0 || i >= c->vnum ) return NULL;
+  return c->f ? zXform3D( c->f, &c->vert[i], v ) : zVec3DCopy( &c->vert[i], v );
+}
@@ -6,12 +6,16 @@
 
 #include <zeo/zeo_col.h>
 
+#define ZEO_GJK_TOL 1.0e-10 /* relative tolerance of convergence */
+#define ZEO_GJK_EPS 1.0e-11 /* relative precision of the proximity */
+
 typedef struct{
   bool sw_w;  /* included in W (the smallest simplex) */
   bool sw_y;  /* included in Y (the updated simplex) */
   zVec3D w;   /* support map of Minkowski's sum */
-  zVec3D *p1; /* corresponding vertex on object 1 to the support map */
-  zVec3D *p2; /* corresponding vertex on object 2 to the support map */
+  zVec3D p1;  /* corresponding point on object 1 to the support map */
+  zVec3D p2;  /* corresponding point on object 2 to the support map */
+  int i1, i2; /* indices of vertices of objects 1 and 2 (-1 for a shape) */
   double s;   /* linear sum coefficient */
 } zGJKSlot;
 
@@ -25,7 +29,9 @@ static void _zGJKSlotInit(zGJKSlot *slot)
 {
   slot->sw_w = slot->sw_y = false;
   zVec3DZero( &slot->w );
-  slot->p1 = slot->p2 = NULL;
+  zVec3DZero( &slot->p1 );
+  zVec3DZero( &slot->p2 );
+  slot->i1 = slot->i2 = -1;
   slot->s = 0;
 }
 
@@ -34,16 +40,16 @@ static void _zGJKSlotInit(zGJKSlot *slot)
 static void _zGJKSlotPrint(zGJKSlot *slot)
 {
   printf( " w: " ); zVec3DPrint( &slot->w );
-  printf( " p1: " ); zVec3DPrint( slot->p1 );
-  printf( " p2: " ); zVec3DPrint( slot->p2 );
+  printf( " p1: " ); zVec3DPrint( &slot->p1 );
+  printf( " p2: " ); zVec3DPrint( &slot->p2 );
   printf( " s = %g\n", slot->s );
 }
 
 /* print out vertices of a slot. */
 static void _zGJKSlotVertFPrint(FILE *fp, zGJKSlot *slot)
 {
-  zVec3DDataFPrint( fp, slot->p1 );
-  zVec3DDataFPrint( fp, slot->p2 );
+  zVec3DDataFPrint( fp, &slot->p1 );
+  zVec3DDataFPrint( fp, &slot->p2 );
 }
 #endif
 
@@ -105,13 +111,13 @@ static void _zGJKSimplexWVertFPrint(FILE *fp, zGJKSimplex *s)
 }
 #endif
 
-/* check if the specified slot is already in the previous testing simplex. */
+/* check if the specified slot is already in the current minimum simplex. */
 static bool _zGJKSimplexCheckSlot(zGJKSimplex *s, zGJKSlot *slot)
 {
   register int i;
 
   for( i=0; i<4; i++ )
-    if( s->slot[i].sw_y && zVec3DMatch( &s->slot[i].w, &slot->w ) )
+    if( s->slot[i].sw_w && zVec3DMatch( &s->slot[i].w, &slot->w ) )
       return true;
   return false;
 }
@@ -127,8 +133,10 @@ static int _zGJKSimplexAddSlot(zGJKSimplex *s, zGJKSlot *slot)
     if( !s->slot[i].sw_y ){
       s->slot[i].sw_y = true;
       zVec3DCopy( &slot->w, &s->slot[i].w );
-      s->slot[i].p1 = slot->p1;
-      s->slot[i].p2 = slot->p2;
+      zVec3DCopy( &slot->p1, &s->slot[i].p1 );
+      zVec3DCopy( &slot->p2, &s->slot[i].p2 );
+      s->slot[i].i1 = slot->i1;
+      s->slot[i].i2 = slot->i2;
       s->slot[i].s = slot->s;
       return i;
     }
@@ -195,15 +203,60 @@ static void _zGJKSimplexMinimize(zGJKSimplex *s)
   }
 }
 
+/* check if the origin is enclosed by the simplex, namely, the proximity vanishes relative to the size of the tested simplex. */
+static bool _zGJKCheck(zGJKSimplex *s, zVec3D *v)
+{
+  double w2max = 0;
+  register int i;
+
+  for( i=0; i<4; i++ )
+    if( s->slot[i].sw_y )
+      w2max = zMax( w2max, zVec3DSqrNorm( &s->slot[i].w ) );
+  return zVec3DSqrNorm( v ) <= zSqr( ZEO_GJK_EPS ) * w2max;
+}
+
+/* find the closest point on the testing simplex to the origin and minimize the simplex. */
+static double _zGJKSimplexProx(zGJKSimplex *s, zVec3D *v)
+{
+  register int i, imin;
+
+  _zGJKSimplexClosest( s, v );
+  _zGJKSimplexMinimize( s );
+  if( s->n == 4 && !_zGJKCheck( s, v ) ){
+    /* a degenerate tetrahedron which does not enclose the origin: drop the least weighted vertex */
+    for( imin=0, i=1; i<4; i++ )
+      if( s->slot[i].s < s->slot[imin].s ) imin = i;
+    s->slot[imin].sw_w = false;
+    s->slot[imin].s = 0;
+    for( i=0; i<4; i++ )
+      s->slot[i].sw_y = s->slot[i].sw_w;
+    _zGJKSimplexClosest( s, v );
+    _zGJKSimplexMinimize( s );
+  }
+  return zVec3DSqrNorm( v );
+}
+
+/* check if the iteration converges, namely, the support point does not go beyond the proximity. */
+#define _zGJKConverge(s,slot,v,dv2) \
+  ( _zGJKSimplexCheckSlot( s, slot ) || (dv2) - zVec3DInnerProd(&(slot)->w,v) <= ZEO_GJK_TOL * (dv2) )
+
+/* check if the proximity still approaches the origin; it stalls within the precision of the simplex solver. */
+#define _zGJKProgress(dv2_prev,dv2) ( (dv2) < (dv2_prev) )
+
+/* check if the support point lies behind the origin beyond the precision, namely, the proximity is not a separating direction. */
+#define _zGJKBeyond(slot,v) ( zVec3DInnerProd( &(slot)->w, v ) < -ZEO_GJK_EPS * zVec3DSqrNorm( &(slot)->w ) )
+
 /* support map of Minkowski difference. */
-static zVec3D *_zGJKSupportMap(zGJKSlot *s, zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *v)
+static zVec3D *_zGJKSupportMap(zGJKSlot *s, zConvex3D *c1, zConvex3D *c2, zVec3D *v)
 {
   zVec3D nv;
 
   zVec3DRev( v, &nv );
-  s->p1 = zVec3DSupportMap( p1, n1, &nv );
-  s->p2 = zVec3DSupportMap( p2, n2,   v );
-  zVec3DSub( s->p1, s->p2, &s->w );
+  zConvex3DSupportMap( c1, &nv, &s->p1 );
+  zConvex3DSupportMap( c2,   v, &s->p2 );
+  s->i1 = c1->vert ? c1->hint : -1;
+  s->i2 = c2->vert ? c2->hint : -1;
+  zVec3DSub( &s->p1, &s->p2, &s->w );
   return &s->w;
 }
 
@@ -213,9 +266,9 @@ static zVec3D *_zGJKSupportMapPL(zGJKSlot *s, zVec3DList *pl1, zVec3DList *pl2,
   zVec3D nv;
 
   zVec3DRev( v, &nv );
-  s->p1 = zVec3DListSupportMap( pl1, &nv );
-  s->p2 = zVec3DListSupportMap( pl2,   v );
-  zVec3DSub( s->p1, s->p2, &s->w );
+  zVec3DCopy( zVec3DListSupportMap( pl1, &nv ), &s->p1 );
+  zVec3DCopy( zVec3DListSupportMap( pl2,   v ), &s->p2 );
+  zVec3DSub( &s->p1, &s->p2, &s->w );
   return &s->w;
 }
 
@@ -228,8 +281,8 @@ static void _zGJKPair(zGJKSimplex *s, zVec3D *c1, zVec3D *c2)
   zVec3DZero( c2 );
   for( i=0; i<4; i++ )
     if( s->slot[i].sw_w ){
-      zVec3DCatDRC( c1, s->slot[i].s, s->slot[i].p1 );
-      zVec3DCatDRC( c2, s->slot[i].s, s->slot[i].p2 );
+      zVec3DCatDRC( c1, s->slot[i].s, &s->slot[i].p1 );
+      zVec3DCatDRC( c2, s->slot[i].s, &s->slot[i].p2 );
     }
 }
 
@@ -266,17 +319,17 @@ static zGJKSlotListCell *_zGJKSlotListInsert(zGJKSlotList *sl, zGJKSlot *s)
     return NULL;
   }
   zVec3DCopy( &s->w, &sc->data.w );
-  sc->data.p1 = s->p1;
-  sc->data.p2 = s->p2;
+  zVec3DCopy( &s->p1, &sc->data.p1 );
+  zVec3DCopy( &s->p2, &sc->data.p2 );
   zListInsertHead( sl, sc );
   return sc;
 }
 
-static bool _zGJKPDInitAddPoint(zVec3D p1[], int n1, zVec3D p2[], int n2, zGJKSlotList *slist, zVec3DList *vlist, zVec3D *v, zEdge3D *edge, zTri3D *tri)
+static bool _zGJKPDInitAddPoint(zConvex3D *c1, zConvex3D *c2, zGJKSlotList *slist, zVec3DList *vlist, zVec3D *v, zEdge3D *edge, zTri3D *tri)
 {
   zGJKSlot  ns;
 
-  _zGJKSupportMap( &ns, p1, n1, p2, n2, v );
+  _zGJKSupportMap( &ns, c1, c2, v );
   if( ( edge != NULL && zIsTiny( zEdge3DPointDist( edge, &ns.w ) ) ) ||
       ( tri != NULL && zIsTiny( zTri3DPointDist( tri, &ns.w ) ) ) )
     return false;
@@ -285,7 +338,7 @@ static bool _zGJKPDInitAddPoint(zVec3D p1[], int n1, zVec3D p2[], int n2, zGJKSl
   return true;
 }
 
-static bool _zGJKPDInit(zVec3D p1[], int n1, zVec3D p2[], int n2, zGJKSimplex *s, zGJKSlotList *slist, zVec3DList *vlist)
+static bool _zGJKPDInit(zConvex3D *c1, zConvex3D *c2, zGJKSimplex *s, zGJKSlotList *slist, zVec3DList *vlist)
 {
   register int i;
   zGJKSlotListCell *sc;
@@ -304,13 +357,13 @@ static bool _zGJKPDInit(zVec3D p1[], int n1, zVec3D p2[], int n2, zGJKSimplex *s
   if( s->n == 2 ){
     zEdge3DCreate( &edge, &s->slot[0].w, &s->slot[1].w );
     zVec3DOrthoSpace( zEdge3DVec(&edge), &v1, &v2 );
-    if( !_zGJKPDInitAddPoint( p1, n1, p2, n2, slist, vlist, &v1, &edge, NULL ) )
+    if( !_zGJKPDInitAddPoint( c1, c2, slist, vlist, &v1, &edge, NULL ) )
       goto FALSE;
-    if( !_zGJKPDInitAddPoint( p1, n1, p2, n2, slist, vlist, &v2, &edge, NULL ) )
+    if( !_zGJKPDInitAddPoint( c1, c2, slist, vlist, &v2, &edge, NULL ) )
       goto FALSE;
-    if( !_zGJKPDInitAddPoint( p1, n1, p2, n2, slist, vlist, zVec3DRevDRC( &v1 ), &edge, NULL ) )
+    if( !_zGJKPDInitAddPoint( c1, c2, slist, vlist, zVec3DRevDRC( &v1 ), &edge, NULL ) )
       goto FALSE;
-    if( !_zGJKPDInitAddPoint( p1, n1, p2, n2, slist, vlist, zVec3DRevDRC( &v2 ), &edge, NULL ) )
+    if( !_zGJKPDInitAddPoint( c1, c2, slist, vlist, zVec3DRevDRC( &v2 ), &edge, NULL ) )
       goto FALSE;
     zCH3DPL( &ph, vlist );
     if( !zPH3DPointIsInside( &ph, ZVEC3DZERO, false ) ){
@@ -321,9 +374,9 @@ static bool _zGJKPDInit(zVec3D p1[], int n1, zVec3D p2[], int n2, zGJKSimplex *s
   } else
   if( s->n == 3 ){
     zTri3DCreate( &tri, &s->slot[0].w, &s->slot[1].w, &s->slot[2].w );
-    if( !_zGJKPDInitAddPoint( p1, n1, p2, n2, slist, vlist, zTri3DNorm(&tri), NULL, &tri ) )
+    if( !_zGJKPDInitAddPoint( c1, c2, slist, vlist, zTri3DNorm(&tri), NULL, &tri ) )
       goto FALSE;
-    if( !_zGJKPDInitAddPoint( p1, n1, p2, n2, slist, vlist, zVec3DRev( zTri3DNorm(&tri), &v1 ), NULL, &tri ) )
+    if( !_zGJKPDInitAddPoint( c1, c2, slist, vlist, zVec3DRev( zTri3DNorm(&tri), &v1 ), NULL, &tri ) )
       goto FALSE;
     }
     return true;
@@ -335,7 +388,7 @@ static bool _zGJKPDInit(zVec3D p1[], int n1, zVec3D p2[], int n2, zGJKSimplex *s
 }
 
 /* penetration depth */
-static bool _zGJKPD(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D *c2, zGJKSimplex *s)
+static bool _zGJKPD(zConvex3D *cv1, zConvex3D *cv2, zVec3D *c1, zVec3D *c2, zGJKSimplex *s)
 {
   register int i, j;
   zGJKSlot  ns;
@@ -347,7 +400,7 @@ static bool _zGJKPD(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D
   int id = 0;
   double l[3];
 
-  if( !_zGJKPDInit( p1, n1, p2, n2, s, &slist, &vlist ) ) return false;
+  if( !_zGJKPDInit( cv1, cv2, s, &slist, &vlist ) ) return false;
   zVec3DZero( &v_temp );
   while( 1 ){
     zCH3DPL( &ph, &vlist );
@@ -355,7 +408,7 @@ static bool _zGJKPD(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D
     if( zVec3DEqual( &v, &v_temp ) ) break; /* success! */
     zVec3DCopy( &v, &v_temp );
     zVec3DRevDRC( &v );
-    _zGJKSupportMap( &ns, p1, n1, p2, n2, &v );
+    _zGJKSupportMap( &ns, cv1, cv2, &v );
     zListForEach( &slist, sc )
       if( zVec3DEqual( &ns.w, &sc->data.w ) ) goto BREAK;
     _zGJKSlotListInsert( &slist, &ns );
@@ -370,8 +423,8 @@ static bool _zGJKPD(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D
   zListForEach( &slist, sc ){
     for( i=0; i<3; i++ ){
       if( zVec3DEqual( zPH3DFaceVert(&ph,id,i), &sc->data.w ) ){
-        zVec3DCatDRC( c1, l[i], sc->data.p1 );
-        zVec3DCatDRC( c2, l[i], sc->data.p2 );
+        zVec3DCatDRC( c1, l[i], &sc->data.p1 );
+        zVec3DCatDRC( c2, l[i], &sc->data.p2 );
         j++;
       }
     }
@@ -383,65 +436,516 @@ static bool _zGJKPD(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D
   return true;
 }
 
-static bool _zGJKCheck(zGJKSimplex *s)
+/* initial guess of the proximity, which is a point in Minkowski difference. */
+static double _zGJKInitProx(zConvex3D *c1, zConvex3D *c2, zVec3D *v)
+{
+  zGJKSlot slot;
+  zVec3D v2;
+  double dv2;
+
+  zConvex3DCenter( c1, v );
+  zConvex3DCenter( c2, &v2 );
+  zVec3DSubDRC( v, &v2 );
+  if( !zIsTiny( ( dv2 = zVec3DSqrNorm( v ) ) ) ) return dv2;
+  _zGJKSupportMap( &slot, c1, c2, zVec3DCreate( &v2, 1, 0, 0 ) );
+  zVec3DCopy( &slot.w, v );
+  return zVec3DSqrNorm( v );
+}
+
+/* restore the simplex of the previous query stored in a cache. */
+static double _zGJKCacheRestore(zGJKCache *cache, zConvex3D *c1, zConvex3D *c2, zGJKSimplex *s, zVec3D *v)
 {
-  zTri3D t;
-  zEdge3D e;
+  zGJKSlot *slot;
+  register int i;
 
-  switch( s->n ){
-  case 4: return true;
-  case 3: zTri3DCreate( &t, &s->slot[0].w, &s->slot[1].w, &s->slot[2].w );
-          return zTri3DPointIsOn( &t, ZVEC3DZERO ) ? true : false;
-  case 2: zEdge3DCreate( &e, &s->slot[0].w, &s->slot[1].w );
-          return zEdge3DPointIsOn( &e, ZVEC3DZERO ) ? true : false;
-  default: ;
+  for( i=0; i<cache->n; i++ ){
+    slot = &s->slot[s->n];
+    if( !zConvex3DVert( c1, ( slot->i1 = cache->i1[i] ), &slot->p1 ) ||
+        !zConvex3DVert( c2, ( slot->i2 = cache->i2[i] ), &slot->p2 ) ) continue;
+    zVec3DSub( &slot->p1, &slot->p2, &slot->w );
+    if( _zGJKSimplexCheckSlot( s, slot ) ) continue;
+    slot->sw_y = true;
+    s->n++;
   }
-  return false;
+  if( s->n == 0 ){ /* shapes: start from the support point along the cached direction */
+    _zGJKSupportMap( &s->slot[0], c1, c2, &cache->v );
+    s->slot[0].sw_y = true;
+    s->n = 1;
+  }
+  return _zGJKSimplexProx( s, v );
+}
+
+/* store the simplex into a cache. */
+static void _zGJKCacheStore(zGJKCache *cache, zGJKSimplex *s, zVec3D *v, int iter)
+{
+  register int i;
+
+  for( cache->n=0, i=0; i<4; i++ )
+    if( s->slot[i].sw_w ){
+      cache->i1[cache->n] = s->slot[i].i1;
+      cache->i2[cache->n] = s->slot[i].i2;
+      cache->n++;
+    }
+  if( !zVec3DIsTiny( v ) ) zVec3DCopy( v, &cache->v );
+  cache->iter = iter;
 }
 
-static bool _zGJK(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D *c2, zGJKSimplex *s)
+static bool _zGJK(zConvex3D *cv1, zConvex3D *cv2, zVec3D *c1, zVec3D *c2, zGJKSimplex *s, zGJKCache *cache)
 {
   zGJKSimplex _s; /* simplex */
   zGJKSlot slot;
   zVec3D v; /* proximity */
-  double dv2 = 0;
-  register int i, j;
+  double dv2, dv2_prev;
+  int iter = 0;
 
   if( s == NULL ) s = &_s;
-  for( i=0; i<n1; i++ )
-    for( j=0; j<n2; j++ ){
-      zVec3DSub( &p1[i], &p2[j], &v );
-      if( !zIsTiny( ( dv2 = zVec3DSqrNorm( &v ) ) ) ) break;
-    }
   _zGJKSimplexInit( s );
+  if( cache && cache->iter >= 0 ){ /* warm start */
+    dv2 = _zGJKCacheRestore( cache, cv1, cv2, s, &v );
+    if( _zGJKCheck( s, &v ) ) goto TERMINATE;
+  } else
+    dv2 = _zGJKInitProx( cv1, cv2, &v );
   do{
-    _zGJKSupportMap( &slot, p1, n1, p2, n2, &v );
-    if( _zGJKSimplexCheckSlot( s, &slot ) ||
-        dv2 - zVec3DInnerProd(&slot.w,&v) <= zTOL ){
-      break; /* succeed */
-    }
+    iter++;
+    _zGJKSupportMap( &slot, cv1, cv2, &v );
+    if( _zGJKConverge( s, &slot, &v, dv2 ) ) break; /* succeed */
+    dv2_prev = s->n > 0 ? dv2 : HUGE_VAL; /* the initial guess may not be on the simplex */
     _zGJKSimplexAddSlot( s, &slot );
-    _zGJKSimplexClosest( s, &v );
-    _zGJKSimplexMinimize( s );
-    dv2 = zVec3DSqrNorm( &v );
-  } while( s->n < 4 );
+    dv2 = _zGJKSimplexProx( s, &v );
+  } while( !_zGJKCheck( s, &v ) && _zGJKProgress( dv2_prev, dv2 ) && iter < Z_MAX_ITER_NUM ); /* a curved surface is approached asymptotically */
+ TERMINATE:
+  if( cache ) _zGJKCacheStore( cache, s, &v, iter );
   _zGJKPair( s, c1, c2 );
-  return _zGJKCheck( s );
+  return _zGJKCheck( s, &v ) || _zGJKBeyond( &slot, &v );
 }
 
 /* Gilbert-Johnson-Keerthi algorithm. */
 bool zGJK(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D *c2)
 {
-  return _zGJK( p1, n1, p2, n2, c1, c2, NULL );
+  zConvex3D cv1, cv2;
+
+  zConvex3DPoints( &cv1, p1, n1 );
+  zConvex3DPoints( &cv2, p2, n2 );
+  return _zGJK( &cv1, &cv2, c1, c2, NULL, NULL );
 }
 
 /* GJK algorithm followed by Johnson's penetration depth */
 bool zGJKDepth(zVec3D p1[], int n1, zVec3D p2[], int n2, zVec3D *c1, zVec3D *c2)
+{
+  zConvex3D cv1, cv2;
+
+  zConvex3DPoints( &cv1, p1, n1 );
+  zConvex3DPoints( &cv2, p2, n2 );
+  return zGJKDepthConvex( &cv1, &cv2, c1, c2 );
+}
+
+/* Gilbert-Johnson-Keerthi algorithm for convex objects. */
+bool zGJKConvex(zConvex3D *cv1, zConvex3D *cv2, zVec3D *c1, zVec3D *c2)
+{
+  return _zGJK( cv1, cv2, c1, c2, NULL, NULL );
+}
+
+/* GJK algorithm followed by Johnson's penetration depth for convex objects. */
+bool zGJKDepthConvex(zConvex3D *cv1, zConvex3D *cv2, zVec3D *c1, zVec3D *c2)
 {
   zGJKSimplex s;
 
-  return _zGJK( p1, n1, p2, n2, c1, c2, &s ) ?
-    _zGJKPD( p1, n1, p2, n2, c1, c2, &s ) : false;
+  return _zGJK( cv1, cv2, c1, c2, &s, NULL ) ?
+    _zGJKPD( cv1, cv2, c1, c2, &s ) : false;
+}
+
+/* create a GJK cache for a pair of convex objects. */
+zGJKCache *zGJKCacheCreate(zGJKCache *cache, zConvex3D *cv1, zConvex3D *cv2)
+{
+  cache->cv1 = cv1;
+  cache->cv2 = cv2;
+  cache->n = 0;
+  zVec3DCreate( &cache->v, 1, 0, 0 );
+  cache->iter = -1;
+  return cache;
+}
+
+/* destroy a GJK cache. */
+void zGJKCacheDestroy(zGJKCache *cache)
+{
+  zGJKCacheCreate( cache, NULL, NULL );
+}
+
+/* Gilbert-Johnson-Keerthi algorithm warm-started from a cache. */
+bool zGJKCacheCheck(zGJKCache *cache, zVec3D *c1, zVec3D *c2)
+{
+  return _zGJK( cache->cv1, cache->cv2, c1, c2, NULL, cache );
+}
+
+/* Gilbert-Johnson-Keerthi algorithm for shapes. */
+bool zGJKShape(zShape3D *s1, zFrame3D *f1, zShape3D *s2, zFrame3D *f2, zVec3D *c1, zVec3D *c2)
+{
+  zConvex3D cv1, cv2;
+
+  if( !zConvex3DShape( &cv1, s1 ) || !zConvex3DShape( &cv2, s2 ) ) return false;
+  zConvex3DSetFrame( &cv1, f1 );
+  zConvex3DSetFrame( &cv2, f2 );
+  return _zGJK( &cv1, &cv2, c1, c2, NULL, NULL );
+}
+
+/* ********************************************************** */
+/* expanding polytope algorithm
+ * ********************************************************** */
+
+typedef struct{
+  int v[3];   /* indices of vertices */
+  zVec3D n;   /* outward normal vector */
+  double d;   /* distance from the origin */
+  bool alive; /* false if removed from the polytope */
+} zEPAFace;
+
+typedef struct{
+  zGJKSlot *vert; /* pool of vertices */
+  int vnum, vsize;
+  zEPAFace *face; /* pool of faces */
+  int fnum, fsize;
+  int *heap;      /* binary heap of faces in ascending order of distance */
+  int hnum, hsize;
+  int *edge;      /* pairs of vertex indices on the horizon */
+  int ednum, edsize;
+  zVec3D center;  /* an interior point of the polytope */
+} zEPAPolytope;
+
+/* reserve an array of the expanding polytope. */
+static void *_zEPAReserve(void *array, int *size, int num, size_t unit)
+{
+  void *a;
+
+  if( num < *size ) return array;
+  if( !( a = zRealloc( array, char, unit * ( *size * 2 + 16 ) ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  *size = *size * 2 + 16;
+  return a;
+}
+
+/* initialize the expanding polytope. */
+static void _zEPAInit(zEPAPolytope *epa)
+{
+  epa->vert = NULL; epa->vnum = epa->vsize = 0;
+  epa->face = NULL; epa->fnum = epa->fsize = 0;
+  epa->heap = NULL; epa->hnum = epa->hsize = 0;
+  epa->edge = NULL; epa->ednum = epa->edsize = 0;
+  zVec3DZero( &epa->center );
+}
+
+/* destroy the expanding polytope. */
+static void _zEPADestroy(zEPAPolytope *epa)
+{
+  zFree( epa->vert );
+  zFree( epa->face );
+  zFree( epa->heap );
+  zFree( epa->edge );
+}
+
+/* add a vertex to the expanding polytope. */
+static int _zEPAAddVert(zEPAPolytope *epa, zGJKSlot *slot)
+{
+  zGJKSlot *v;
+
+  if( !( v = _zEPAReserve( epa->vert, &epa->vsize, epa->vnum, sizeof(zGJKSlot) ) ) ) return -1;
+  epa->vert = v;
+  epa->vert[epa->vnum] = *slot;
+  return epa->vnum++;
+}
+
+/* push a face to the heap. */
+static bool _zEPAHeapPush(zEPAPolytope *epa, int f)
+{
+  int *h, i, p;
+
+  if( !( h = _zEPAReserve( epa->heap, &epa->hsize, epa->hnum, sizeof(int) ) ) ) return false;
+  epa->heap = h;
+  for( i=epa->hnum++; i>0; i=p ){
+    p = ( i - 1 ) / 2;
+    if( epa->face[h[p]].d <= epa->face[f].d ) break;
+    h[i] = h[p];
+  }
+  h[i] = f;
+  return true;
+}
+
+/* pop the closest face alive from the heap. */
+static int _zEPAHeapPop(zEPAPolytope *epa)
+{
+  int *h, f, last, i, c;
+
+  h = epa->heap;
+  while( epa->hnum > 0 ){
+    f = h[0];
+    last = h[--epa->hnum];
+    for( i=0; ( c = 2*i + 1 ) < epa->hnum; i=c ){
+      if( c + 1 < epa->hnum && epa->face[h[c+1]].d < epa->face[h[c]].d ) c++;
+      if( epa->face[last].d <= epa->face[h[c]].d ) break;
+      h[i] = h[c];
+    }
+    h[i] = last;
+    if( epa->face[f].alive ) return f;
+  }
+  return -1;
+}
+
+/* add a face to the expanding polytope, which faces outward. */
+static bool _zEPAAddFace(zEPAPolytope *epa, int v0, int v1, int v2)
+{
+  zEPAFace *f;
+  zVec3D e1, e2, d;
+  double l;
+
+  if( !( f = _zEPAReserve( epa->face, &epa->fsize, epa->fnum, sizeof(zEPAFace) ) ) ) return false;
+  epa->face = f;
+  f = &epa->face[epa->fnum];
+  zVec3DSub( &epa->vert[v1].w, &epa->vert[v0].w, &e1 );
+  zVec3DSub( &epa->vert[v2].w, &epa->vert[v0].w, &e2 );
+  zVec3DOuterProd( &e1, &e2, &f->n );
+  zVec3DSub( &epa->vert[v0].w, &epa->center, &d );
+  f->v[0] = v0;
+  if( zVec3DInnerProd( &f->n, &d ) < 0 ){
+    zVec3DRevDRC( &f->n );
+    f->v[1] = v2; f->v[2] = v1;
+  } else{
+    f->v[1] = v1; f->v[2] = v2;
+  }
+  f->alive = true;
+  if( zIsTiny( ( l = zVec3DNorm( &f->n ) ) ) ){ /* degenerate face is never chosen */
+    f->d = HUGE_VAL;
+    epa->fnum++;
+    return true;
+  }
+  zVec3DDivDRC( &f->n, l );
+  f->d = zVec3DInnerProd( &f->n, &epa->vert[v0].w );
+  return _zEPAHeapPush( epa, epa->fnum++ );
+}
+
+/* add a directed edge on the horizon, or cancel it with the reversed one. */
+static bool _zEPAAddEdge(zEPAPolytope *epa, int v0, int v1)
+{
+  int *e;
+  register int i;
+
+  for( i=0; i<epa->ednum; i++ )
+    if( epa->edge[2*i] == v1 && epa->edge[2*i+1] == v0 ){
+      epa->ednum--;
+      epa->edge[2*i]   = epa->edge[2*epa->ednum];
+      epa->edge[2*i+1] = epa->edge[2*epa->ednum+1];
+      return true;
+    }
+  if( !( e = _zEPAReserve( epa->edge, &epa->edsize, 2*epa->ednum+1, sizeof(int) ) ) ) return false;
+  epa->edge = e;
+  epa->edge[2*epa->ednum]   = v0;
+  epa->edge[2*epa->ednum+1] = v1;
+  epa->ednum++;
+  return true;
+}
+
+/* expand the polytope by a new vertex. */
+static bool _zEPAExpand(zEPAPolytope *epa, int v)
+{
+  zEPAFace *f;
+  zVec3D d;
+  register int i, n;
+
+  epa->ednum = 0;
+  for( n=epa->fnum, i=0; i<n; i++ ){
+    f = &epa->face[i];
+    if( !f->alive ) continue;
+    zVec3DSub( &epa->vert[v].w, &epa->vert[f->v[0]].w, &d );
+    if( zVec3DInnerProd( &f->n, &d ) <= zTOL ) continue;
+    f->alive = false;
+    if( !_zEPAAddEdge( epa, f->v[0], f->v[1] ) ||
+        !_zEPAAddEdge( epa, f->v[1], f->v[2] ) ||
+        !_zEPAAddEdge( epa, f->v[2], f->v[0] ) ) return false;
+  }
+  for( i=0; i<epa->ednum; i++ )
+    if( !_zEPAAddFace( epa, epa->edge[2*i], epa->edge[2*i+1], v ) ) return false;
+  return true;
+}
+
+/* add the support point of Minkowski difference along a direction to the polytope. */
+static int _zEPASupportMap(zEPAPolytope *epa, zConvex3D *c1, zConvex3D *c2, zVec3D *dir)
+{
+  zGJKSlot slot;
+  zVec3D v;
+
+  _zGJKSlotInit( &slot );
+  _zGJKSupportMap( &slot, c1, c2, zVec3DRev( dir, &v ) );
+  return _zEPAAddVert( epa, &slot );
+}
+
+/* distance from a vertex of the polytope to a line or a plane. */
+static double _zEPAVertDist(zEPAPolytope *epa, int v, int v0, zVec3D *dir, bool isline)
+{
+  zVec3D d, dp;
+
+  zVec3DSub( &epa->vert[v].w, &epa->vert[v0].w, &d );
+  if( !isline ) return zVec3DInnerProd( &d, dir );
+  zVec3DOuterProd( &d, dir, &dp );
+  return zVec3DNorm( &dp );
+}
+
+/* create the initial polytope from the terminal simplex of GJK.
+ * the false value is returned if the objects just touch each other. */
+static bool _zEPAInitPolytope(zEPAPolytope *epa, zConvex3D *c1, zConvex3D *c2, zGJKSimplex *s, double tol)
+{
+  zVec3D e1, e2, n, dir;
+  int v[5];
+  register int i, k;
+
+  for( i=0; i<4; i++ )
+    if( s->slot[i].sw_w ) _zEPAAddVert( epa, &s->slot[i] );
+  if( epa->vnum == 2 ){ /* expand the segment to a bipyramid */
+    zVec3DSub( &epa->vert[1].w, &epa->vert[0].w, &n );
+    zVec3DNormalizeDRC( &n );
+    zVec3DOrthoSpace( &n, &e1, &e2 );
+    for( k=0; k<3; k++ ){
+      zVec3DMul( &e1, cos(zPIx2*k/3), &dir );
+      zVec3DCatDRC( &dir, sin(zPIx2*k/3), &e2 );
+      if( ( v[k+2] = _zEPASupportMap( epa, c1, c2, &dir ) ) < 0 ) return false;
+      if( _zEPAVertDist( epa, v[k+2], 0, &n, true ) <= tol ) return false;
+    }
+    for( i=0; i<3; i++ ) zVec3DAddDRC( &epa->center, &epa->vert[i+2].w );
+    zVec3DDivDRC( &epa->center, 3 );
+    for( k=0; k<3; k++ )
+      if( !_zEPAAddFace( epa, 0, k+2, (k+1)%3+2 ) ||
+          !_zEPAAddFace( epa, 1, k+2, (k+1)%3+2 ) ) return false;
+    return true;
+  }
+  if( epa->vnum == 3 ){ /* expand the triangle to a bipyramid */
+    zVec3DSub( &epa->vert[1].w, &epa->vert[0].w, &e1 );
+    zVec3DSub( &epa->vert[2].w, &epa->vert[0].w, &e2 );
+    zVec3DOuterProd( &e1, &e2, &n );
+    if( zIsTiny( zVec3DNormalizeDRC( &n ) ) ) return false;
+    if( ( v[3] = _zEPASupportMap( epa, c1, c2, &n ) ) < 0 ||
+        _zEPAVertDist( epa, v[3], 0, &n, false ) <= tol ) return false;
+    zVec3DRevDRC( &n );
+    if( ( v[4] = _zEPASupportMap( epa, c1, c2, &n ) ) < 0 ||
+        _zEPAVertDist( epa, v[4], 0, &n, false ) <= tol ) return false;
+    for( i=0; i<3; i++ ) zVec3DAddDRC( &epa->center, &epa->vert[i].w );
+    zVec3DDivDRC( &epa->center, 3 );
+    for( k=0; k<3; k++ )
+      if( !_zEPAAddFace( epa, k, (k+1)%3, 3 ) ||
+          !_zEPAAddFace( epa, k, (k+1)%3, 4 ) ) return false;
+    return true;
+  }
+  if( epa->vnum == 4 ){ /* tetrahedron */
+    for( i=0; i<4; i++ ) zVec3DAddDRC( &epa->center, &epa->vert[i].w );
+    zVec3DDivDRC( &epa->center, 4 );
+    return _zEPAAddFace( epa, 0, 1, 2 ) && _zEPAAddFace( epa, 0, 1, 3 ) &&
+           _zEPAAddFace( epa, 0, 2, 3 ) && _zEPAAddFace( epa, 1, 2, 3 );
+  }
+  return false; /* touching at a point */
+}
+
+/* witness points on the original objects of the closest point on a face. */
+static void _zEPAFacePair(zEPAPolytope *epa, zEPAFace *f, zVec3D *mtv, zVec3D *c1, zVec3D *c2)
+{
+  zGJKSlot *s0, *s1, *s2;
+  zVec3D e1, e2, ep;
+  double d11, d12, d22, dp1, dp2, det, l1, l2;
+
+  s0 = &epa->vert[f->v[0]];
+  s1 = &epa->vert[f->v[1]];
+  s2 = &epa->vert[f->v[2]];
+  zVec3DMul( &f->n, f->d, mtv );
+  zVec3DSub( &s1->w, &s0->w, &e1 );
+  zVec3DSub( &s2->w, &s0->w, &e2 );
+  zVec3DSub( mtv, &s0->w, &ep );
+  d11 = zVec3DSqrNorm( &e1 );
+  d12 = zVec3DInnerProd( &e1, &e2 );
+  d22 = zVec3DSqrNorm( &e2 );
+  dp1 = zVec3DInnerProd( &ep, &e1 );
+  dp2 = zVec3DInnerProd( &ep, &e2 );
+  if( zIsTiny( ( det = d11*d22 - d12*d12 ) ) ){
+    l1 = l2 = 0;
+  } else{
+    l1 = ( d22*dp1 - d12*dp2 ) / det;
+    l2 = ( d11*dp2 - d12*dp1 ) / det;
+  }
+  zVec3DMul( &s0->p1, 1-l1-l2, c1 );
+  zVec3DCatDRC( c1, l1, &s1->p1 );
+  zVec3DCatDRC( c1, l2, &s2->p1 );
+  zVec3DMul( &s0->p2, 1-l1-l2, c2 );
+  zVec3DCatDRC( c2, l1, &s1->p2 );
+  zVec3DCatDRC( c2, l2, &s2->p2 );
+}
+
+/* expanding polytope algorithm from the terminal simplex of GJK. */
+static bool _zEPA(zConvex3D *cv1, zConvex3D *cv2, zGJKSimplex *s, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2)
+{
+  zEPAPolytope epa;
+  int f = -1, fi, v;
+  register int i;
+  bool ret = true;
+
+  if( tol <= 0 ) tol = zTOL;
+  ZITERINIT( iter );
+  _zEPAInit( &epa );
+  if( !_zEPAInitPolytope( &epa, cv1, cv2, s, tol ) ){
+    zVec3DZero( mtv ); /* touching */
+    goto TERMINATE;
+  }
+  for( i=0; i<iter; i++ ){
+    if( ( fi = _zEPAHeapPop( &epa ) ) < 0 ) break;
+    f = fi;
+    if( ( v = _zEPASupportMap( &epa, cv1, cv2, &epa.face[f].n ) ) < 0 ){
+      ret = false;
+      break;
+    }
+    if( zVec3DInnerProd( &epa.vert[v].w, &epa.face[f].n ) - epa.face[f].d <= tol ) break; /* converged */
+    if( !_zEPAExpand( &epa, v ) ){
+      ret = false;
+      break;
+    }
+  }
+  if( i == iter ) ZITERWARN( iter );
+  if( f >= 0 )
+    _zEPAFacePair( &epa, &epa.face[f], mtv, c1, c2 );
+  else
+    zVec3DZero( mtv );
+ TERMINATE:
+  _zEPADestroy( &epa );
+  return ret;
+}
+
+/* expanding polytope algorithm for convex objects. */
+bool zEPAConvex(zConvex3D *cv1, zConvex3D *cv2, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2)
+{
+  zGJKSimplex s;
+
+  if( !_zGJK( cv1, cv2, c1, c2, &s, NULL ) ){
+    zVec3DZero( mtv );
+    return false;
+  }
+  if( !_zEPA( cv1, cv2, &s, tol, iter, mtv, c1, c2 ) )
+    zVec3DZero( mtv );
+  return true;
+}
+
+/* expanding polytope algorithm. */
+bool zEPA(zVec3D p1[], int n1, zVec3D p2[], int n2, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2)
+{
+  zConvex3D cv1, cv2;
+
+  zConvex3DPoints( &cv1, p1, n1 );
+  zConvex3DPoints( &cv2, p2, n2 );
+  return zEPAConvex( &cv1, &cv2, tol, iter, mtv, c1, c2 );
+}
+
+/* expanding polytope algorithm for shapes. */
+bool zEPAShape(zShape3D *s1, zFrame3D *f1, zShape3D *s2, zFrame3D *f2, double tol, int iter, zVec3D *mtv, zVec3D *c1, zVec3D *c2)
+{
+  zConvex3D cv1, cv2;
+
+  if( !zConvex3DShape( &cv1, s1 ) || !zConvex3DShape( &cv2, s2 ) ) return false;
+  zConvex3DSetFrame( &cv1, f1 );
+  zConvex3DSetFrame( &cv2, f2 );
+  return zEPAConvex( &cv1, &cv2, tol, iter, mtv, c1, c2 );
 }
 
 /* Gilbert-Johnson-Keerthi algorithm. */
@@ -450,23 +954,20 @@ bool zGJKPL(zVec3DList *pl1, zVec3DList *pl2, zVec3D *c1, zVec3D *c2)
   zGJKSimplex s; /* simplex */
   zGJKSlot slot;
   zVec3D v; /* proximity */
-  double dv2;
+  double dv2, dv2_prev;
 
   zVec3DSub( zListTail(pl1)->data, zListTail(pl2)->data, &v );
   dv2 = zVec3DSqrNorm( &v );
   _zGJKSimplexInit( &s );
   do{
     _zGJKSupportMapPL( &slot, pl1, pl2, &v );
-    if( _zGJKSimplexCheckSlot( &s, &slot ) ||
-        dv2 - zVec3DInnerProd(&slot.w,&v) <= zTOL )
-      break; /* succeed */
+    if( _zGJKConverge( &s, &slot, &v, dv2 ) ) break; /* succeed */
+    dv2_prev = s.n > 0 ? dv2 : HUGE_VAL; /* the initial guess may not be on the simplex */
     _zGJKSimplexAddSlot( &s, &slot );
-    _zGJKSimplexClosest( &s, &v );
-    _zGJKSimplexMinimize( &s );
-    dv2 = zVec3DSqrNorm( &v );
-  } while( s.n < 4 );
+    dv2 = _zGJKSimplexProx( &s, &v );
+  } while( !_zGJKCheck( &s, &v ) && _zGJKProgress( dv2_prev, dv2 ) );
   _zGJKPair( &s, c1, c2 );
-  return _zGJKCheck( &s );
+  return _zGJKCheck( &s, &v ) || _zGJKBeyond( &slot, &v );
 }
 
 /* support map of Minkowski difference. */
@@ -475,8 +976,8 @@ static zVec3D *_zGJKPointSupportMap(zGJKSlot *s, zVec3D pl[], int n, zVec3D *v)
   zVec3D nv;
 
   zVec3DRev( v, &nv );
-  s->p1 = zVec3DSupportMap( pl, n, &nv );
-  zVec3DSub( s->p1, s->p2, &s->w );
+  zVec3DCopy( zVec3DSupportMap( pl, n, &nv ), &s->p1 );
+  zVec3DSub( &s->p1, &s->p2, &s->w );
   return &s->w;
 }
 
@@ -488,7 +989,7 @@ static void _zGJKPointClosest(zGJKSimplex *s, zVec3D *c)
   zVec3DZero( c );
   for( i=0; i<4; i++ )
     if( s->slot[i].sw_w )
-      zVec3DCatDRC( c, s->slot[i].s, s->slot[i].p1 );
+      zVec3DCatDRC( c, s->slot[i].s, &s->slot[i].p1 );
 }
 
 /* Gilbert-Johnson-Keerthi algorithm for a set of points and an independent point. */
@@ -497,10 +998,10 @@ bool zGJKPoint(zVec3D pl[], int n, zVec3D *p, zVec3D *c)
   zGJKSimplex s; /* simplex */
   zGJKSlot slot;
   zVec3D v; /* proximity */
-  double dv2 = 0;
+  double dv2 = 0, dv2_prev;
   register int i;
 
-  slot.p2 = p;
+  zVec3DCopy( p, &slot.p2 );
   for( i=0; i<n; i++ ){
     zVec3DSub( &pl[i], p, &v );
     if( !zIsTiny( ( dv2 = zVec3DSqrNorm( &v ) ) ) ) break;
@@ -508,15 +1009,11 @@ bool zGJKPoint(zVec3D pl[], int n, zVec3D *p, zVec3D *c)
   _zGJKSimplexInit( &s );
   do{
     _zGJKPointSupportMap( &slot, pl, n, &v );
-    if( _zGJKSimplexCheckSlot( &s, &slot ) ||
-        dv2 - zVec3DInnerProd(&slot.w,&v) <= zTOL ){
-      break; /* succeed */
-    }
+    if( _zGJKConverge( &s, &slot, &v, dv2 ) ) break; /* succeed */
+    dv2_prev = s.n > 0 ? dv2 : HUGE_VAL; /* the initial guess may not be on the simplex */
     _zGJKSimplexAddSlot( &s, &slot );
-    _zGJKSimplexClosest( &s, &v );
-    _zGJKSimplexMinimize( &s );
-    dv2 = zVec3DSqrNorm( &v );
-  } while( s.n < 4 );
+    dv2 = _zGJKSimplexProx( &s, &v );
+  } while( !_zGJKCheck( &s, &v ) && _zGJKProgress( dv2_prev, dv2 ) );
   _zGJKPointClosest( &s, c );
-  return _zGJKCheck( &s );
+  return _zGJKCheck( &s, &v ) || _zGJKBeyond( &slot, &v );
 }
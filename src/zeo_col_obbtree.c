@@ -0,0 +1,291 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_obbtree - collision checking: OBB tree of a polyhedron.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* ********************************************************** */
+/* CLASS: zPH3DOBBTree
+ * hierarchy of oriented bounding boxes over triangles of a polyhedron
+ * ********************************************************** */
+
+/* workspace to build a tree. */
+typedef struct{
+  zPH3DOBBTree *tree;
+  zVec3D *fc; /* centroids of faces */
+  double *fa; /* areas of faces */
+  double *key; /* projections of centroids to partition faces */
+} zPH3DOBBTreeBuilder;
+
+/* fit an oriented box to faces in a range by the area-weighted covariance. */
+static void _zPH3DOBBTreeFit(zPH3DOBBTreeBuilder *builder, int head, int num, zBox3D *obb, zVec3D *mean)
+{
+  zMat3D cov;
+  zVec3D axis[3], *v, c;
+  zTri3D *t;
+  double w, wsum = 0, eval[3], d, min[3], max[3];
+  bool area;
+  int *face;
+  register int i, j, k, l;
+
+  face = builder->tree->face + head;
+  for( area=false, i=0; i<num; i++ )
+    if( !zIsTiny( builder->fa[face[i]] ) ){
+      area = true;
+      break;
+    }
+  /* second moment of triangles about the origin */
+  zMat3DZero( &cov );
+  zVec3DZero( mean );
+  for( i=0; i<num; i++ ){
+    t = zPH3DFace( builder->tree->ph, face[i] );
+    w = area ? builder->fa[face[i]] : 1; /* equally weighted if all faces are degenerate */
+    wsum += w;
+    zVec3DCatDRC( mean, w, &builder->fc[face[i]] );
+    for( j=0; j<3; j++ )
+      for( k=0; k<3; k++ ){
+        d = 9 * builder->fc[face[i]].e[j] * builder->fc[face[i]].e[k];
+        for( l=0; l<3; l++ )
+          d += zTri3DVert(t,l)->e[j] * zTri3DVert(t,l)->e[k];
+        cov.e[j][k] += w * d / 12;
+      }
+  }
+  zVec3DDivDRC( mean, wsum );
+  for( j=0; j<3; j++ )
+    for( k=0; k<3; k++ )
+      cov.e[j][k] = cov.e[j][k] / wsum - mean->e[j] * mean->e[k];
+  zMat3DSymEigTrig( &cov, eval, axis );
+  /* extents along principal axes */
+  for( j=0; j<3; j++ ){
+    min[j] = HUGE_VAL;
+    max[j] =-HUGE_VAL;
+  }
+  for( i=0; i<num; i++ ){
+    t = zPH3DFace( builder->tree->ph, face[i] );
+    for( l=0; l<3; l++ ){
+      v = zTri3DVert(t,l);
+      for( j=0; j<3; j++ ){
+        d = zVec3DInnerProd( v, &axis[j] );
+        if( d < min[j] ) min[j] = d;
+        if( d > max[j] ) max[j] = d;
+      }
+    }
+  }
+  zVec3DZero( &c );
+  for( j=0; j<3; j++ )
+    zVec3DCatDRC( &c, 0.5*( min[j] + max[j] ), &axis[j] );
+  /* inflate the box so that coplanar triangles are checked conservatively */
+  zBox3DCreate( obb, &c, &axis[0], &axis[1], &axis[2],
+    max[0] - min[0] + 2*zTOL, max[1] - min[1] + 2*zTOL, max[2] - min[2] + 2*zTOL );
+}
+
+/* partition faces at the median of keys (quickselect). */
+static int _zPH3DOBBTreePartitionMedian(zPH3DOBBTreeBuilder *builder, int head, int num)
+{
+  int *face, k, l, r;
+  double *key, pivot;
+  register int i, j;
+
+  face = builder->tree->face + head;
+  key = builder->key + head;
+  for( k=num/2, l=0, r=num-1; l<r; ){
+    pivot = key[(l+r)/2];
+    for( i=l, j=r; i<=j; ){
+      while( key[i] < pivot ) i++;
+      while( key[j] > pivot ) j--;
+      if( i <= j ){
+        zSwap( int, face[i], face[j] );
+        zSwap( double, key[i], key[j] );
+        i++; j--;
+      }
+    }
+    if( k <= j ) r = j;
+    else if( k >= i ) l = i;
+    else break;
+  }
+  return k;
+}
+
+/* partition faces by the projection of centroids to the longest axis. */
+static int _zPH3DOBBTreePartition(zPH3DOBBTreeBuilder *builder, int head, int num, int level, zBox3D *obb, zVec3D *mean)
+{
+  zVec3D *axis;
+  int *face, split;
+  double *key, d;
+  register int i, j;
+
+  axis = zBox3DAxis(obb,zX);
+  for( i=zY; i<=zZ; i++ )
+    if( zBox3DDia(obb,i) > zBox3DDia(obb,zX) ) axis = zBox3DAxis(obb,i);
+  face = builder->tree->face + head;
+  key = builder->key + head;
+  d = zVec3DInnerProd( mean, axis );
+  for( i=0; i<num; i++ )
+    key[i] = zVec3DInnerProd( &builder->fc[face[i]], axis ) - d;
+  if( level >= ZEO_PH3D_OBBTREE_DEPTH_MAX/2 )
+    return _zPH3DOBBTreePartitionMedian( builder, head, num );
+  for( i=0, j=num-1; i<=j; ){
+    if( key[i] < 0 )
+      i++;
+    else{
+      zSwap( int, face[i], face[j] );
+      zSwap( double, key[i], key[j] );
+      j--;
+    }
+  }
+  if( ( split = i ) == 0 || split == num ) /* all on one side */
+    return _zPH3DOBBTreePartitionMedian( builder, head, num );
+  return split;
+}
+
+/* build a subtree of faces in a range; returns the height of the subtree. */
+static int _zPH3DOBBTreeBuild(zPH3DOBBTreeBuilder *builder, int head, int num, int level)
+{
+  zPH3DOBBTreeNode *node;
+  zVec3D mean;
+  int id, nl, h0, h1;
+
+  id = builder->tree->nodenum++;
+  node = &builder->tree->node[id];
+  _zPH3DOBBTreeFit( builder, head, num, &node->obb, &mean );
+  if( num == 1 ){
+    node->head = head;
+    node->num = 1;
+    return 0;
+  }
+  nl = _zPH3DOBBTreePartition( builder, head, num, level, &node->obb, &mean );
+  node->num = 0;
+  h0 = _zPH3DOBBTreeBuild( builder, head, nl, level+1 );
+  node->head = builder->tree->nodenum;
+  h1 = _zPH3DOBBTreeBuild( builder, head+nl, num-nl, level+1 );
+  return 1 + zMax( h0, h1 );
+}
+
+/* initialize an OBB tree of a polyhedron. */
+zPH3DOBBTree *zPH3DOBBTreeInit(zPH3DOBBTree *tree)
+{
+  tree->ph = NULL;
+  tree->face = NULL;
+  tree->node = NULL;
+  tree->nodenum = 0;
+  tree->depth = 0;
+  return tree;
+}
+
+/* create an OBB tree of a polyhedron. */
+zPH3DOBBTree *zPH3DOBBTreeCreate(zPH3DOBBTree *tree, zPH3D *ph)
+{
+  zPH3DOBBTreeBuilder builder;
+  int n;
+  register int i;
+
+  zPH3DOBBTreeInit( tree );
+  if( ( n = zPH3DFaceNum(ph) ) == 0 ){
+    ZRUNERROR( ZEO_ERR_NOFACE );
+    return NULL;
+  }
+  tree->ph = ph;
+  tree->face = zAlloc( int, n );
+  tree->node = zAlloc( zPH3DOBBTreeNode, 2*n-1 );
+  builder.tree = tree;
+  builder.fc = zAlloc( zVec3D, n );
+  builder.fa = zAlloc( double, n );
+  builder.key = zAlloc( double, n );
+  if( !tree->face || !tree->node || !builder.fc || !builder.fa || !builder.key ){
+    ZALLOCERROR();
+    zPH3DOBBTreeDestroy( tree );
+    tree = NULL;
+    goto TERMINATE;
+  }
+  for( i=0; i<n; i++ ){
+    tree->face[i] = i;
+    zTri3DBarycenter( zPH3DFace(ph,i), &builder.fc[i] );
+    builder.fa[i] = zTri3DArea( zPH3DFace(ph,i) );
+  }
+  tree->depth = _zPH3DOBBTreeBuild( &builder, 0, n, 0 );
+
+ TERMINATE:
+  zFree( builder.fc );
+  zFree( builder.fa );
+  zFree( builder.key );
+  return tree;
+}
+
+/* destroy an OBB tree of a polyhedron. */
+void zPH3DOBBTreeDestroy(zPH3DOBBTree *tree)
+{
+  zFree( tree->face );
+  zFree( tree->node );
+  zPH3DOBBTreeInit( tree );
+}
+
+/* check if a face of the first polyhedron and that of the second transformed by a relative frame intersect. */
+static bool _zPH3DOBBTreeColChkFace(zTri3D *t1, zTri3D *t2, zFrame3D *f)
+{
+  zVec3D v[3];
+  zTri3D t;
+  register int i;
+
+  for( i=0; i<3; i++ ){
+    zXform3D( f, zTri3DVert(t2,i), &v[i] );
+    zTri3DSetVert( &t, i, &v[i] );
+  }
+  zMulMat3DVec3D( zFrame3DAtt(f), zTri3DNorm(t2), zTri3DNorm(&t) );
+  return zColChkTri3D( t1, &t );
+}
+
+/* find pairs of intersecting faces of two posed polyhedra of OBB trees. */
+void zPH3DOBBTreeQueryPair(zPH3DOBBTree *tree1, zFrame3D *f1, zPH3DOBBTree *tree2, zFrame3D *f2, bool (*callback)(int,int,void*), void *priv)
+{
+  int stack[4*ZEO_PH3D_OBBTREE_DEPTH_MAX], sp = 0, id1, id2, fi1, fi2;
+  zPH3DOBBTreeNode *n1, *n2;
+  zFrame3D f;
+  zBox3D obb;
+
+  if( tree1->nodenum == 0 || tree2->nodenum == 0 ) return;
+  zFrame3DXform( f1, f2, &f ); /* from the frame of tree2 to that of tree1 */
+  stack[sp++] = 0; stack[sp++] = 0;
+  while( sp > 0 ){
+    id2 = stack[--sp];
+    id1 = stack[--sp];
+    n1 = &tree1->node[id1];
+    n2 = &tree2->node[id2];
+    if( !zColChkBox3D( &n1->obb, zBox3DXform( &n2->obb, &f, &obb ) ) ) continue;
+    if( n1->num > 0 && n2->num > 0 ){
+      fi1 = tree1->face[n1->head];
+      fi2 = tree2->face[n2->head];
+      if( _zPH3DOBBTreeColChkFace( zPH3DFace(tree1->ph,fi1), zPH3DFace(tree2->ph,fi2), &f ) &&
+          !callback( fi1, fi2, priv ) ) return;
+      continue;
+    }
+    /* descend into the larger branch */
+    if( n2->num > 0 || ( n1->num == 0 && zBox3DVolume( &n1->obb ) > zBox3DVolume( &n2->obb ) ) ){
+      stack[sp++] = n1->head; stack[sp++] = id2;
+      stack[sp++] = id1 + 1;  stack[sp++] = id2;
+    } else{
+      stack[sp++] = id1; stack[sp++] = n2->head;
+      stack[sp++] = id1; stack[sp++] = id2 + 1;
+    }
+  }
+}
+
+/* store the first pair of intersecting faces. */
+static bool _zPH3DOBBTreeColChkPair(int f1, int f2, void *priv)
+{
+  ((int *)priv)[0] = f1;
+  ((int *)priv)[1] = f2;
+  return false;
+}
+
+/* check if two posed polyhedra of OBB trees intersect with each other. */
+bool zPH3DOBBTreeColChk(zPH3DOBBTree *tree1, zFrame3D *f1, zPH3DOBBTree *tree2, zFrame3D *f2, int *face1, int *face2)
+{
+  int pair[2] = { -1, -1 };
+
+  zPH3DOBBTreeQueryPair( tree1, f1, tree2, f2, _zPH3DOBBTreeColChkPair, pair );
+  if( face1 ) *face1 = pair[0];
+  if( face2 ) *face2 = pair[1];
+  return pair[0] >= 0;
+}
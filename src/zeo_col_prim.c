@@ -0,0 +1,218 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_prim - collision checking: narrow phase between primitive shapes.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* ********************************************************** */
+/* edges and capsules
+ * ********************************************************** */
+
+/* the closest points of two edges. */
+double zEdge3DClosestPair(zEdge3D *e1, zEdge3D *e2, zVec3D *c1, zVec3D *c2)
+{
+  zVec3D d1, d2, r;
+  double a, b, c, e, f, denom, s, t;
+
+  zVec3DSub( zEdge3DVert(e1,1), zEdge3DVert(e1,0), &d1 );
+  zVec3DSub( zEdge3DVert(e2,1), zEdge3DVert(e2,0), &d2 );
+  zVec3DSub( zEdge3DVert(e1,0), zEdge3DVert(e2,0), &r );
+  a = zVec3DSqrNorm( &d1 );
+  e = zVec3DSqrNorm( &d2 );
+  f = zVec3DInnerProd( &d2, &r );
+  if( zIsTiny( a ) && zIsTiny( e ) ){ /* both edges are degenerated to points */
+    s = t = 0;
+  } else
+  if( zIsTiny( a ) ){ /* the first edge is degenerated to a point */
+    s = 0;
+    t = _zLimit( f / e, 0, 1 );
+  } else{
+    c = zVec3DInnerProd( &d1, &r );
+    if( zIsTiny( e ) ){ /* the second edge is degenerated to a point */
+      t = 0;
+      s = _zLimit( -c / a, 0, 1 );
+    } else{
+      b = zVec3DInnerProd( &d1, &d2 );
+      /* parameter on the first edge closest to the line of the second, or 0 for parallel edges */
+      s = ( denom = a*e - b*b ) > zTOL * a * e ? _zLimit( ( b*f - c*e ) / denom, 0, 1 ) : 0;
+      if( ( t = ( b*s + f ) / e ) < 0 ){
+        t = 0;
+        s = _zLimit( -c / a, 0, 1 );
+      } else
+      if( t > 1 ){
+        t = 1;
+        s = _zLimit( ( b - c ) / a, 0, 1 );
+      }
+    }
+  }
+  zVec3DCat( zEdge3DVert(e1,0), s, &d1, c1 );
+  zVec3DCat( zEdge3DVert(e2,0), t, &d2, c2 );
+  return zVec3DDist( c1, c2 );
+}
+
+/* a point in the intersection of two balls, or the closest points of them. */
+static bool _zBallClosestPair(zVec3D *p1, double r1, zVec3D *p2, double r2, double d, zVec3D *c1, zVec3D *c2)
+{
+  zVec3D u;
+  double t;
+
+  if( zIsTiny( d ) ){ /* concentric balls */
+    zVec3DCopy( p1, c1 );
+    zVec3DCopy( p1, c2 );
+    return true;
+  }
+  zVec3DSub( p2, p1, &u );
+  zVec3DDivDRC( &u, d );
+  if( d > r1 + r2 ){
+    zVec3DCat( p1, r1, &u, c1 );
+    zVec3DCat( p2,-r2, &u, c2 );
+    return false;
+  }
+  /* the middle of the overlap along the line between centers */
+  t = 0.5 * ( zMax( d - r2, -r1 ) + zMin( d + r2, r1 ) );
+  zVec3DCat( p1, t, &u, c1 );
+  zVec3DCopy( c1, c2 );
+  return true;
+}
+
+/* the closest points of two capsules. */
+bool zCapsule3DClosestPair(zEdge3D *e1, double r1, zEdge3D *e2, double r2, zVec3D *c1, zVec3D *c2)
+{
+  zVec3D p1, p2;
+  double d;
+
+  d = zEdge3DClosestPair( e1, e2, &p1, &p2 );
+  return _zBallClosestPair( &p1, r1, &p2, r2, d, c1, c2 );
+}
+
+/* ********************************************************** */
+/* kernels between primitive shapes
+ * ********************************************************** */
+
+/* intersection of two spheres. */
+static bool _zColChkSphereSphere(zShape3D *s1, zShape3D *s2)
+{
+  return zVec3DSqrDist( zSphere3DCenter(zShape3DSphere(s1)), zSphere3DCenter(zShape3DSphere(s2)) ) <=
+    zSqr( zSphere3DRadius(zShape3DSphere(s1)) + zSphere3DRadius(zShape3DSphere(s2)) );
+}
+
+/* the closest points of two spheres. */
+static bool _zSphereSphereClosestPair(zShape3D *s1, zShape3D *s2, zVec3D *c1, zVec3D *c2)
+{
+  zSphere3D *sp1, *sp2;
+
+  sp1 = zShape3DSphere(s1);
+  sp2 = zShape3DSphere(s2);
+  return _zBallClosestPair( zSphere3DCenter(sp1), zSphere3DRadius(sp1), zSphere3DCenter(sp2), zSphere3DRadius(sp2),
+    zVec3DDist( zSphere3DCenter(sp1), zSphere3DCenter(sp2) ), c1, c2 );
+}
+
+/* intersection of a sphere and a convex primitive. */
+static bool _zColChkSphereShape(zShape3D *s1, zShape3D *s2)
+{
+  zVec3D cp;
+  return zShape3DClosest( s2, zSphere3DCenter(zShape3DSphere(s1)), &cp ) <= zSphere3DRadius(zShape3DSphere(s1));
+}
+
+/* the closest points of a sphere and a convex primitive. */
+static bool _zSphereShapeClosestPair(zShape3D *s1, zShape3D *s2, zVec3D *c1, zVec3D *c2)
+{
+  zSphere3D *sp;
+  double d;
+
+  sp = zShape3DSphere(s1);
+  if( ( d = zShape3DClosest( s2, zSphere3DCenter(sp), c2 ) ) <= zSphere3DRadius(sp) ){
+    zVec3DCopy( c2, c1 ); /* on the surface of or inside of the primitive */
+    return true;
+  }
+  zVec3DInterDiv( zSphere3DCenter(sp), c2, zSphere3DRadius(sp)/d, c1 );
+  return false;
+}
+
+/* intersection of two boxes by the separating axis test. */
+static bool _zColChkBoxBox(zShape3D *s1, zShape3D *s2)
+{
+  return zColChkBox3D( zShape3DBox(s1), zShape3DBox(s2) );
+}
+
+/* intersection of two shapes by GJK. */
+static bool _zColChkGJKShape(zShape3D *s1, zShape3D *s2)
+{
+  zVec3D c1, c2;
+  return zGJKShape( s1, NULL, s2, NULL, &c1, &c2 );
+}
+
+/* the closest points of two shapes by GJK. */
+static bool _zGJKShapeClosestPair(zShape3D *s1, zShape3D *s2, zVec3D *c1, zVec3D *c2)
+{
+  return zGJKShape( s1, NULL, s2, NULL, c1, c2 );
+}
+
+/* types of shapes to dispatch kernels */
+enum{
+  ZEO_COL_PRIM_SPHERE=0, ZEO_COL_PRIM_BOX, ZEO_COL_PRIM_CYL, ZEO_COL_PRIM_ELLIPS, ZEO_COL_PRIM_OTHER, ZEO_COL_PRIM_TYPE_NUM,
+};
+
+/* type of a shape to dispatch kernels. */
+static int _zShape3DColPrimType(zShape3D *shape)
+{
+  if( shape->com == &zeo_shape3d_sphere_com ) return ZEO_COL_PRIM_SPHERE;
+  if( shape->com == &zeo_shape3d_box_com )    return ZEO_COL_PRIM_BOX;
+  if( shape->com == &zeo_shape3d_cyl_com )    return ZEO_COL_PRIM_CYL;
+  if( shape->com == &zeo_shape3d_ellips_com ) return ZEO_COL_PRIM_ELLIPS;
+  return ZEO_COL_PRIM_OTHER;
+}
+
+/* kernels for a pair of types of shapes; the shapes are swapped if swap is true */
+typedef struct{
+  bool (*colchk)(zShape3D*,zShape3D*);
+  bool (*closest)(zShape3D*,zShape3D*,zVec3D*,zVec3D*);
+  bool swap;
+} zShape3DColKernel;
+
+#define ZEO_COL_PRIM_SS  { _zColChkSphereSphere, _zSphereSphereClosestPair, false }
+#define ZEO_COL_PRIM_SX  { _zColChkSphereShape, _zSphereShapeClosestPair, false }
+#define ZEO_COL_PRIM_XS  { _zColChkSphereShape, _zSphereShapeClosestPair, true }
+#define ZEO_COL_PRIM_BB  { _zColChkBoxBox, _zGJKShapeClosestPair, false }
+#define ZEO_COL_PRIM_GJK { _zColChkGJKShape, _zGJKShapeClosestPair, false }
+
+/* dispatch table indexed by types of shapes */
+static const zShape3DColKernel _zeo_shape3d_col_kernel[ZEO_COL_PRIM_TYPE_NUM][ZEO_COL_PRIM_TYPE_NUM] = {
+  /*           sphere           box               cyl               ellips            other */
+  /* sphere */ { ZEO_COL_PRIM_SS, ZEO_COL_PRIM_SX,  ZEO_COL_PRIM_SX,  ZEO_COL_PRIM_SX,  ZEO_COL_PRIM_GJK },
+  /* box    */ { ZEO_COL_PRIM_XS, ZEO_COL_PRIM_BB,  ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK },
+  /* cyl    */ { ZEO_COL_PRIM_XS, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK },
+  /* ellips */ { ZEO_COL_PRIM_XS, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK },
+  /* other  */ { ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK, ZEO_COL_PRIM_GJK },
+};
+
+#define _zShape3DColKernel(s1,s2) \
+  ( &_zeo_shape3d_col_kernel[_zShape3DColPrimType(s1)][_zShape3DColPrimType(s2)] )
+
+/* check if two shapes intersect with each other. */
+bool zColChkShape3D(zShape3D *s1, zShape3D *s2)
+{
+  const zShape3DColKernel *k;
+
+  k = _zShape3DColKernel( s1, s2 );
+  return k->swap ? k->colchk( s2, s1 ) : k->colchk( s1, s2 );
+}
+
+/* the closest points of two shapes. */
+bool zShape3DClosestPair(zShape3D *s1, zShape3D *s2, zVec3D *c1, zVec3D *c2)
+{
+  const zShape3DColKernel *k;
+
+  k = _zShape3DColKernel( s1, s2 );
+  return k->swap ? k->closest( s2, s1, c2, c1 ) : k->closest( s1, s2, c1, c2 );
+}
+
+/* distance between two shapes. */
+double zShape3DDist(zShape3D *s1, zShape3D *s2)
+{
+  zVec3D c1, c2;
+
+  return zShape3DClosestPair( s1, s2, &c1, &c2 ) ? 0 : zVec3DDist( &c1, &c2 );
+}
@@ -0,0 +1,422 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_col_sap - collision checking: sweep-and-prune broad phase.
+ */
+
+#include <zeo/zeo_col.h>
+
+/* ********************************************************** */
+/* CLASS: zSAP
+ * incremental sweep-and-prune over axis-aligned boxes
+ * ********************************************************** */
+
+#define _zSAPEndpointID(e)    ( (e)->data >> 1 )
+#define _zSAPEndpointIsMax(e) ( (e)->data & 0x1 )
+
+/* check if an endpoint precedes another; a maximum endpoint precedes a minimum one at the same coordinate. */
+#define _zSAPEndpointLess(e1,e2) \
+  ( (e1)->val < (e2)->val || ( (e1)->val == (e2)->val && _zSAPEndpointIsMax(e1) && !_zSAPEndpointIsMax(e2) ) )
+
+/* add a pair to a list. */
+static bool _zSAPPairListAdd(zSAPPairList *list, int i, int j)
+{
+  zSAPPair *buf;
+  int size;
+
+  if( list->num == list->size ){
+    size = list->size == 0 ? 16 : list->size * 2;
+    if( !( buf = zRealloc( list->buf, zSAPPair, size ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    list->buf = buf;
+    list->size = size;
+  }
+  list->buf[list->num].i = i;
+  list->buf[list->num++].j = j;
+  return true;
+}
+
+/* delete a pair from a list. */
+static bool _zSAPPairListDelete(zSAPPairList *list, int i, int j)
+{
+  register int k;
+
+  for( k=0; k<list->num; k++ )
+    if( list->buf[k].i == i && list->buf[k].j == j ){
+      list->buf[k] = list->buf[--list->num];
+      return true;
+    }
+  return false;
+}
+
+/* hash key of a pair. */
+#define _zSAPHashKey(sap,i,j) \
+  ( ( (unsigned)(i)*73856093u ^ (unsigned)(j)*19349663u ) & (unsigned)( (sap)->hsize - 1 ) )
+
+/* find a slot of the hash table which refers a pair. */
+static int _zSAPHashFind(zSAP *sap, int i, int j)
+{
+  int h, k;
+
+  if( sap->hsize == 0 ) return -1;
+  for( h=_zSAPHashKey(sap,i,j); ( k = sap->hash[h] ) != -1; h=(h+1)&(sap->hsize-1) )
+    if( k >= 0 && sap->pair.buf[k].i == i && sap->pair.buf[k].j == j ) return h;
+  return -1;
+}
+
+/* insert an index of a pair to the hash table. */
+static void _zSAPHashInsert(zSAP *sap, int k)
+{
+  int h;
+
+  for( h=_zSAPHashKey(sap,sap->pair.buf[k].i,sap->pair.buf[k].j); sap->hash[h] >= 0; h=(h+1)&(sap->hsize-1) );
+  if( sap->hash[h] == -1 ) sap->hused++;
+  sap->hash[h] = k;
+}
+
+/* rebuild the hash table of pairs. */
+static bool _zSAPHashRehash(zSAP *sap)
+{
+  int size;
+  register int k;
+
+  for( size=16; size < sap->pair.num*4; size*=2 );
+  zFree( sap->hash );
+  if( !( sap->hash = zAlloc( int, size ) ) ){
+    ZALLOCERROR();
+    sap->hsize = sap->hused = 0;
+    return false;
+  }
+  sap->hsize = size;
+  sap->hused = 0;
+  for( k=0; k<size; k++ ) sap->hash[k] = -1; /* empty */
+  for( k=0; k<sap->pair.num; k++ ) _zSAPHashInsert( sap, k );
+  return true;
+}
+
+/* register a pair which began to overlap. */
+static bool _zSAPPairBegin(zSAP *sap, int i, int j)
+{
+  if( i > j ) zSwap( int, i, j );
+  if( _zSAPHashFind( sap, i, j ) >= 0 ) return true;
+  if( ( sap->hused + 1 ) * 2 > sap->hsize && !_zSAPHashRehash( sap ) ) return false;
+  if( !_zSAPPairListAdd( &sap->pair, i, j ) ) return false;
+  _zSAPHashInsert( sap, sap->pair.num-1 );
+  /* a pair which ceased to overlap after the last update is just restored */
+  return _zSAPPairListDelete( &sap->removed, i, j ) ?
+    true : _zSAPPairListAdd( &sap->added, i, j );
+}
+
+/* unregister a pair of a hash slot. */
+static void _zSAPPairDelete(zSAP *sap, int h)
+{
+  int k, last;
+
+  k = sap->hash[h];
+  sap->hash[h] = -2; /* deleted */
+  if( k != ( last = --sap->pair.num ) ){
+    h = _zSAPHashFind( sap, sap->pair.buf[last].i, sap->pair.buf[last].j );
+    sap->pair.buf[k] = sap->pair.buf[last];
+    sap->hash[h] = k;
+  }
+}
+
+/* unregister a pair which ceased to overlap. */
+static bool _zSAPPairCease(zSAP *sap, int i, int j)
+{
+  int h;
+
+  if( i > j ) zSwap( int, i, j );
+  if( ( h = _zSAPHashFind( sap, i, j ) ) < 0 ) return true;
+  _zSAPPairDelete( sap, h );
+  /* a pair which began to overlap after the last update is just forgotten */
+  return _zSAPPairListDelete( &sap->added, i, j ) ?
+    true : _zSAPPairListAdd( &sap->removed, i, j );
+}
+
+/* clear lists of changed pairs reported at the last update. */
+static void _zSAPFlush(zSAP *sap)
+{
+  if( !sap->flushed ) return;
+  sap->added.num = sap->removed.num = 0;
+  sap->flushed = false;
+}
+
+/* reserve slots of boxes. */
+static bool _zSAPReserve(zSAP *sap, int size)
+{
+  zAABox3D *box;
+  bool *alive;
+  int *vacant;
+  zSAPEndpoint *ep;
+  register int k;
+
+  if( size <= sap->size ) return true;
+  if( size < sap->size * 2 ) size = sap->size * 2;
+  if( !( box = zRealloc( sap->box, zAABox3D, size ) ) ) goto FAILURE;
+  sap->box = box;
+  if( !( alive = zRealloc( sap->alive, bool, size ) ) ) goto FAILURE;
+  sap->alive = alive;
+  if( !( vacant = zRealloc( sap->vacant, int, size ) ) ) goto FAILURE;
+  sap->vacant = vacant;
+  for( k=zX; k<=zZ; k++ ){
+    if( !( ep = zRealloc( sap->ep[k], zSAPEndpoint, size*2 ) ) ) goto FAILURE;
+    sap->ep[k] = ep;
+  }
+  sap->size = size;
+  return true;
+
+ FAILURE:
+  ZALLOCERROR();
+  return false;
+}
+
+/* initialize a sweep-and-prune structure. */
+zSAP *zSAPInit(zSAP *sap)
+{
+  register int k;
+
+  sap->num = sap->size = 0;
+  sap->box = NULL;
+  sap->alive = NULL;
+  sap->vacant = NULL;
+  sap->vnum = sap->pending = sap->epnum = 0;
+  for( k=zX; k<=zZ; k++ ) sap->ep[k] = NULL;
+  sap->pair.num = sap->pair.size = 0;
+  sap->pair.buf = NULL;
+  sap->hash = NULL;
+  sap->hsize = sap->hused = 0;
+  sap->added.num = sap->added.size = 0;
+  sap->added.buf = NULL;
+  sap->removed.num = sap->removed.size = 0;
+  sap->removed.buf = NULL;
+  sap->flushed = false;
+  return sap;
+}
+
+/* destroy a sweep-and-prune structure. */
+void zSAPDestroy(zSAP *sap)
+{
+  register int k;
+
+  zFree( sap->box );
+  zFree( sap->alive );
+  zFree( sap->vacant );
+  for( k=zX; k<=zZ; k++ ) zFree( sap->ep[k] );
+  zFree( sap->pair.buf );
+  zFree( sap->hash );
+  zFree( sap->added.buf );
+  zFree( sap->removed.buf );
+  zSAPInit( sap );
+}
+
+/* add a box to a sweep-and-prune structure. */
+int zSAPAdd(zSAP *sap, zAABox3D *box)
+{
+  int id;
+  register int k;
+
+  _zSAPFlush( sap );
+  if( sap->vnum > 0 )
+    id = sap->vacant[--sap->vnum];
+  else{
+    if( !_zSAPReserve( sap, sap->num+1 ) ) return -1;
+    id = sap->num++;
+  }
+  zAABox3DCopy( box, &sap->box[id] );
+  sap->alive[id] = true;
+  for( k=zX; k<=zZ; k++ ){ /* endpoints are sorted at the next update */
+    sap->ep[k][sap->epnum  ].val = box->min.e[k];
+    sap->ep[k][sap->epnum  ].data = id << 1;
+    sap->ep[k][sap->epnum+1].val = box->max.e[k];
+    sap->ep[k][sap->epnum+1].data = id << 1 | 0x1;
+  }
+  sap->epnum += 2;
+  sap->pending++;
+  return id;
+}
+
+/* remove a box from a sweep-and-prune structure. */
+bool zSAPRemove(zSAP *sap, int id)
+{
+  register int i, j, k;
+
+  if( id < 0 || id >= sap->num || !sap->alive[id] ){
+    ZRUNWARN( ZEO_WARN_SAP_INVALID_ID, id );
+    return false;
+  }
+  _zSAPFlush( sap );
+  for( k=sap->pair.num-1; k>=0; k-- )
+    if( sap->pair.buf[k].i == id || sap->pair.buf[k].j == id )
+      if( !_zSAPPairCease( sap, sap->pair.buf[k].i, sap->pair.buf[k].j ) ) return false;
+  for( k=zX; k<=zZ; k++ ){
+    for( i=j=0; i<sap->epnum; i++ )
+      if( _zSAPEndpointID(&sap->ep[k][i]) != id ) sap->ep[k][j++] = sap->ep[k][i];
+  }
+  sap->epnum -= 2;
+  sap->alive[id] = false;
+  sap->vacant[sap->vnum++] = id;
+  return true;
+}
+
+/* move a box in a sweep-and-prune structure. */
+bool zSAPMove(zSAP *sap, int id, zAABox3D *box)
+{
+  if( id < 0 || id >= sap->num || !sap->alive[id] ){
+    ZRUNWARN( ZEO_WARN_SAP_INVALID_ID, id );
+    return false;
+  }
+  _zSAPFlush( sap );
+  zAABox3DCopy( box, &sap->box[id] );
+  return true;
+}
+
+/* refresh coordinates of endpoints along an axis. */
+static void _zSAPRefresh(zSAP *sap, int k)
+{
+  zSAPEndpoint *ep;
+  register int i;
+
+  for( i=0; i<sap->epnum; i++ ){
+    ep = &sap->ep[k][i];
+    ep->val = _zSAPEndpointIsMax(ep) ?
+      sap->box[_zSAPEndpointID(ep)].max.e[k] : sap->box[_zSAPEndpointID(ep)].min.e[k];
+  }
+}
+
+/* sort endpoints along an axis by insertion sort, and check swapped pairs. */
+static bool _zSAPSortInc(zSAP *sap, int k)
+{
+  zSAPEndpoint e, *ep;
+  int id1, id2;
+  register int i, j;
+
+  ep = sap->ep[k];
+  for( i=1; i<sap->epnum; i++ ){
+    e = ep[i];
+    for( j=i; j>0 && _zSAPEndpointLess(&e,&ep[j-1]); j-- ){
+      if( ( id1 = _zSAPEndpointID(&e) ) != ( id2 = _zSAPEndpointID(&ep[j-1]) ) ){
+        if( !_zSAPEndpointIsMax(&e) && _zSAPEndpointIsMax(&ep[j-1]) ){
+          /* intervals began to overlap */
+          if( zColChkAABox3D( &sap->box[id1], &sap->box[id2] ) &&
+              !_zSAPPairBegin( sap, id1, id2 ) ) return false;
+        } else
+        if( _zSAPEndpointIsMax(&e) && !_zSAPEndpointIsMax(&ep[j-1]) ){
+          /* intervals ceased to overlap */
+          if( !_zSAPPairCease( sap, id1, id2 ) ) return false;
+        }
+      }
+      ep[j] = ep[j-1];
+    }
+    ep[j] = e;
+  }
+  return true;
+}
+
+/* comparison function of endpoints for quick sort. */
+static int _zSAPEndpointCmp(void *e1, void *e2, void *priv)
+{
+  if( _zSAPEndpointLess( (zSAPEndpoint*)e1, (zSAPEndpoint*)e2 ) ) return -1;
+  if( _zSAPEndpointLess( (zSAPEndpoint*)e2, (zSAPEndpoint*)e1 ) ) return 1;
+  return 0;
+}
+
+/* sort endpoints from scratch, and sweep along x axis to find overlapping pairs. */
+static bool _zSAPSortAll(zSAP *sap)
+{
+  int *active, anum = 0, oldnum, id, h;
+  char *keep;
+  bool ret = false;
+  register int i, j, k;
+
+  for( k=zX; k<=zZ; k++ ){
+    _zSAPRefresh( sap, k );
+    zQuickSort( sap->ep[k], sap->epnum, sizeof(zSAPEndpoint), _zSAPEndpointCmp, NULL );
+  }
+  oldnum = sap->pair.num;
+  active = zAlloc( int, sap->epnum/2 + 1 );
+  keep = zAlloc( char, oldnum + 1 );
+  if( !active || !keep ){
+    ZALLOCERROR();
+    goto TERMINATE;
+  }
+  for( i=0; i<sap->epnum; i++ ){
+    id = _zSAPEndpointID(&sap->ep[zX][i]);
+    if( _zSAPEndpointIsMax(&sap->ep[zX][i]) ){
+      for( j=0; j<anum; j++ )
+        if( active[j] == id ){
+          active[j] = active[--anum];
+          break;
+        }
+      continue;
+    }
+    for( j=0; j<anum; j++ ){
+      if( !zColChkAABox3D( &sap->box[id], &sap->box[active[j]] ) ) continue;
+      h = id < active[j] ? _zSAPHashFind( sap, id, active[j] ) : _zSAPHashFind( sap, active[j], id );
+      if( h >= 0 ){
+        if( sap->hash[h] < oldnum ) keep[sap->hash[h]] = 1;
+      } else
+      if( !_zSAPPairBegin( sap, id, active[j] ) ) goto TERMINATE;
+    }
+    active[anum++] = id;
+  }
+  for( k=oldnum-1; k>=0; k-- )
+    if( !keep[k] && !_zSAPPairCease( sap, sap->pair.buf[k].i, sap->pair.buf[k].j ) ) goto TERMINATE;
+  ret = true;
+
+ TERMINATE:
+  zFree( active );
+  zFree( keep );
+  return ret;
+}
+
+/* update overlapping pairs of a sweep-and-prune structure. */
+bool zSAPUpdate(zSAP *sap)
+{
+  bool ret = true;
+  register int k;
+
+  _zSAPFlush( sap );
+  if( sap->pending * 4 > sap->num - sap->vnum ){
+    ret = _zSAPSortAll( sap );
+  } else{
+    for( k=zX; k<=zZ; k++ ){
+      _zSAPRefresh( sap, k );
+      if( !( ret = _zSAPSortInc( sap, k ) ) ) break;
+    }
+  }
+  sap->pending = 0;
+  sap->flushed = true;
+  return ret;
+}
+
+/* create a sweep-and-prune structure for multiple shapes. */
+bool zSAPCreateMShape3D(zSAP *sap, zMShape3D *ms)
+{
+  zAABox3D box;
+  register int i;
+
+  zSAPInit( sap );
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    zShape3DToAABox3D( zMShape3DShape(ms,i), &box ); /* a point box for an empty shape */
+    if( zSAPAdd( sap, &box ) < 0 ) return false;
+  }
+  return zSAPUpdate( sap );
+}
+
+/* update a sweep-and-prune structure for moved multiple shapes. */
+bool zSAPUpdateMShape3D(zSAP *sap, zMShape3D *ms)
+{
+  register int i;
+
+  if( sap->num != zMShape3DShapeNum(ms) ){
+    ZRUNERROR( ZEO_ERR_SAP_SIZMIS );
+    return false;
+  }
+  _zSAPFlush( sap );
+  for( i=0; i<zMShape3DShapeNum(ms); i++ )
+    zShape3DToAABox3D( zMShape3DShape(ms,i), &sap->box[i] );
+  return zSAPUpdate( sap );
+}
@@ -0,0 +1,197 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_dq - unit dual quaternion for rigid transformation.
+ */
+
+#include <zeo/zeo_dq.h>
+
+/* ********************************************************** */
+/* CLASS: zDQ
+ * unit dual quaternion class
+ * ********************************************************** */
+
+/* quaternion product a b (note that zEPCascade(e1,e2,e) computes e2 e1). */
+#define _zDQQuatMul(a,b,c) zEPCascade( b, a, c )
+
+/* quaternion conjugate. */
+#define _zDQQuatConj(a,c) do{\
+  (c)->ex.w = (a)->ex.w;\
+  _zVec3DRev( &(a)->ex.v, &(c)->ex.v );\
+} while(0)
+
+/* create a unit dual quaternion from Euler parameter and position vector. */
+zDQ *zDQCreate(zDQ *dq, zEP *ep, zVec3D *pos)
+{
+  zEP p;
+
+  zEPCopy( ep, &dq->q.r );
+  p.ex.w = 0;
+  zVec3DMul( pos, 0.5, &p.ex.v );
+  _zDQQuatMul( &p, &dq->q.r, &dq->q.d );
+  return dq;
+}
+
+/* create a unit dual quaternion for the identity transformation. */
+zDQ *zDQIdent(zDQ *dq)
+{
+  register int i;
+
+  for( i=1; i<8; i++ ) dq->e[i] = 0;
+  dq->e[0] = 1;
+  return dq;
+}
+
+/* abstract translation vector of a unit dual quaternion. */
+zVec3D *zDQPos(zDQ *dq, zVec3D *pos)
+{
+  zEP rc, p;
+
+  _zDQQuatConj( &dq->q.r, &rc );
+  _zDQQuatMul( &dq->q.d, &rc, &p );
+  return zVec3DMul( &p.ex.v, 2, pos );
+}
+
+/* convert a 3D frame to a unit dual quaternion. */
+zDQ *zDQFromFrame3D(zDQ *dq, zFrame3D *f)
+{
+  zEP ep;
+
+  if( !zMat3DToEP( zFrame3DAtt(f), &ep ) ) return NULL;
+  return zDQCreate( dq, &ep, zFrame3DPos(f) );
+}
+
+/* convert a unit dual quaternion to a 3D frame. */
+zFrame3D *zDQToFrame3D(zDQ *dq, zFrame3D *f)
+{
+  zMat3DFromEP( zFrame3DAtt(f), &dq->q.r );
+  zDQPos( dq, zFrame3DPos(f) );
+  return f;
+}
+
+/* normalize a dual quaternion. */
+zDQ *zDQNormalize(zDQ *dq)
+{
+  double norm, ip;
+  register int i;
+
+  if( zIsTiny( ( norm = zEPNorm( &dq->q.r ) ) ) ){
+    ZRUNERROR( ZEO_ERR_ZERODIV );
+    return NULL;
+  }
+  for( i=0; i<8; i++ ) dq->e[i] /= norm;
+  ip = zEPInnerProd( &dq->q.r, &dq->q.d );
+  for( i=0; i<4; i++ ) dq->q.d.e[i] -= ip * dq->q.r.e[i];
+  return dq;
+}
+
+/* inverse transformation of a unit dual quaternion. */
+zDQ *zDQInv(zDQ *dq, zDQ *dqi)
+{
+  _zDQQuatConj( &dq->q.r, &dqi->q.r );
+  _zDQQuatConj( &dq->q.d, &dqi->q.d );
+  return dqi;
+}
+
+/* cascade a unit dual quaternion to another. */
+zDQ *zDQCascade(zDQ *dq1, zDQ *dq2, zDQ *dq)
+{
+  zDQ tmp;
+  zEP e;
+  register int i;
+
+  _zDQQuatMul( &dq1->q.r, &dq2->q.r, &tmp.q.r );
+  _zDQQuatMul( &dq1->q.r, &dq2->q.d, &tmp.q.d );
+  _zDQQuatMul( &dq1->q.d, &dq2->q.r, &e );
+  for( i=0; i<4; i++ ) tmp.q.d.e[i] += e.e[i]; /* zEPCat() normalizes the result */
+  return zDQCopy( &tmp, dq );
+}
+
+/* transformation from a unit dual quaternion to another. */
+zDQ *zDQXform(zDQ *dq1, zDQ *dq2, zDQ *dq)
+{
+  zDQ dqi;
+
+  return zDQCascade( zDQInv( dq1, &dqi ), dq2, dq );
+}
+
+/* transform a 3D vector by a unit dual quaternion. */
+zVec3D *zXform3DDQ(zDQ *dq, zVec3D *v, zVec3D *tv)
+{
+  zVec3D pos;
+
+  zDQPos( dq, &pos );
+  zEPRotVec3D( &dq->q.r, v, tv );
+  return zVec3DAddDRC( tv, &pos );
+}
+
+/* transform a 3D vector by the inverse of a unit dual quaternion. */
+zVec3D *zXform3DInvDQ(zDQ *dq, zVec3D *v, zVec3D *tv)
+{
+  zVec3D dv;
+  zEP rc;
+
+  zDQPos( dq, &dv );
+  zVec3DSub( v, &dv, &dv );
+  _zDQQuatConj( &dq->q.r, &rc );
+  return zEPRotVec3D( &rc, &dv, tv );
+}
+
+/* interior division of two unit dual quaternions for ScLERP. */
+zDQ *zDQInterDiv(zDQ *dq1, zDQ *dq2, double t, zDQ *dq)
+{
+  zDQ diff;
+  zVec3D l, m;
+  double s, theta, h, st, ct;
+  register int i;
+
+  zDQXform( dq1, dq2, &diff );
+  if( diff.q.r.ex.w < 0 ) /* choose the shorter path */
+    for( i=0; i<8; i++ ) diff.e[i] = -diff.e[i];
+  if( zIsTiny( ( s = zVec3DNorm( &diff.q.r.ex.v ) ) ) ){
+    /* pure translation */
+    diff.q.r.ex.w = 1;
+    zVec3DZero( &diff.q.r.ex.v );
+    diff.q.d.ex.w = 0;
+    zVec3DMulDRC( &diff.q.d.ex.v, t );
+  } else{
+    /* screw parameters: angle, pitch distance, axis direction and moment */
+    theta = 2 * atan2( s, diff.q.r.ex.w );
+    h = -2 * diff.q.d.ex.w / s;
+    zVec3DDiv( &diff.q.r.ex.v, s, &l );
+    zVec3DCat( &diff.q.d.ex.v, -0.5*h*diff.q.r.ex.w, &l, &m );
+    zVec3DDivDRC( &m, s );
+    /* scaled screw motion */
+    theta *= t;
+    h *= t;
+    zSinCos( 0.5*theta, &st, &ct );
+    diff.q.r.ex.w = ct;
+    zVec3DMul( &l, st, &diff.q.r.ex.v );
+    diff.q.d.ex.w = -0.5*h*st;
+    zVec3DMul( &m, st, &diff.q.d.ex.v );
+    zVec3DCatDRC( &diff.q.d.ex.v, 0.5*h*ct, &l );
+  }
+  zDQCascade( dq1, &diff, dq );
+  return zDQNormalize( dq );
+}
+
+/* dual quaternion linear blending. */
+zDQ *zDQBlend(zDQ dq[], double w[], int n, zDQ *dqb)
+{
+  double k;
+  register int i, j;
+
+  for( j=0; j<8; j++ ) dqb->e[j] = 0;
+  for( i=0; i<n; i++ ){
+    k = zEPInnerProd( &dq[0].q.r, &dq[i].q.r ) < 0 ? -w[i] : w[i];
+    for( j=0; j<8; j++ ) dqb->e[j] += k * dq[i].e[j];
+  }
+  return zDQNormalize( dqb );
+}
+
+/* print a dual quaternion out to a file. */
+void zDQFPrint(FILE *fp, zDQ *dq)
+{
+  zEPFPrint( fp, &dq->q.r );
+  zEPFPrint( fp, &dq->q.d );
+}
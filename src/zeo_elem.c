@@ -69,13 +69,8 @@ zPlane3D *zPlane3DMean(zPlane3D *pl, zVec3D *pc, zVec3D v[], int n)
   }
   zVec3DDiv( &p, n, pc );
   zMat3DSubDyad( &m, &p, pc );
-  zMat3DSymEig( &m, eval, evec );
-
-  if( eval[0] < eval[1] )
-    i = eval[0] < eval[2] ? 0 : 2;
-  else
-    i = eval[1] < eval[2] ? 1 : 2;
-  return zPlane3DCreate( pl, pc, &evec[i] );
+  zMat3DSymEigTrig( &m, eval, evec );
+  return zPlane3DCreate( pl, pc, &evec[2] ); /* eigenvector for the minimum eigenvalue */
 }
 
 /* print information of a plane to a file. */
@@ -520,6 +515,25 @@ double zTri3DClosest(zTri3D *t, zVec3D *v, zVec3D *cp)
   return zVec3DDist( v, cp );
 }
 
+/* intersection of a ray and a triangle (Moller-Trumbore's algorithm). */
+bool zTri3DRayHit(zTri3D *tri, zVec3D *org, zVec3D *dir, double tmax, double *t)
+{
+  zVec3D e1, e2, s, pv, qv;
+  double det, u, v, tt;
+
+  zVec3DSub( zTri3DVert(tri,1), zTri3DVert(tri,0), &e1 );
+  zVec3DSub( zTri3DVert(tri,2), zTri3DVert(tri,0), &e2 );
+  zVec3DOuterProd( dir, &e2, &pv );
+  if( zIsTiny( ( det = zVec3DInnerProd( &e1, &pv ) ) ) ) return false;
+  zVec3DSub( org, zTri3DVert(tri,0), &s );
+  if( ( u = zVec3DInnerProd( &s, &pv ) / det ) < 0 || u > 1 ) return false;
+  zVec3DOuterProd( &s, &e1, &qv );
+  if( ( v = zVec3DInnerProd( dir, &qv ) / det ) < 0 || u + v > 1 ) return false;
+  if( ( tt = zVec3DInnerProd( &e2, &qv ) / det ) < 0 || tt > tmax ) return false;
+  if( t ) *t = tt;
+  return true;
+}
+
 /* volume of a cone. */
 double zTri3DConeVolume(zTri3D *t, zVec3D *v)
 {
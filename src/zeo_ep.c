@@ -62,22 +62,8 @@ zEP *zAA2EP(zVec3D *aa, zEP *ep)
 /* convert Euler parameter to attitude matrix. */
 zMat3D *zMat3DFromEP(zMat3D *m, zEP* ep)
 {
-  double e00, e11, e22, e33, e12, e23, e31, e01, e02, e03;
-
-  e00 = zSqr(ep->e[0]);
-  e11 = zSqr(ep->e[1]);
-  e22 = zSqr(ep->e[2]);
-  e33 = zSqr(ep->e[3]);
-  e12 = ep->e[1] * ep->e[2];
-  e23 = ep->e[2] * ep->e[3];
-  e31 = ep->e[3] * ep->e[1];
-  e01 = ep->e[0] * ep->e[1];
-  e02 = ep->e[0] * ep->e[2];
-  e03 = ep->e[0] * ep->e[3];
-  return zMat3DCreate( m,
-    e00+e11-e22-e33,     2*(e12-e03),     2*(e31+e02),
-        2*(e12+e03), e00-e11+e22-e33,     2*(e23-e01),
-        2*(e31-e02),     2*(e23+e01), e00-e11-e22+e33 );
+  _zMat3DFromEP( m, ep );
+  return m;
 }
 
 /* convert attitude matrix to Euler parameter. */
@@ -135,10 +121,8 @@ zVec3D *zEPRotVec3D(zEP *ep, zVec3D *v, zVec3D *rv)
 /* convert from Euler parameter derivative to angular velocity. */
 zVec3D *zEPVel2AngVel(zEP *epvel, zEP *ep, zVec3D *angvel)
 {
-  _zVec3DOuterProd( &ep->ex.v, &epvel->ex.v, angvel );
-  _zVec3DCatDRC( angvel, ep->ex.w, &epvel->ex.v );
-  _zVec3DCatDRC( angvel,-epvel->ex.w, &ep->ex.v );
-  return zVec3DMulDRC( angvel, 2 );
+  _zEPVel2AngVel( epvel, ep, angvel );
+  return angvel;
 }
 
 /* convert from angular velocity to Euler parameter derivative. */
@@ -256,6 +240,12 @@ zEP *zEPInterDiv(zEP *ep1, zEP *ep2, double t, zEP *ep)
   return zEPNormalize( ep );
 }
 
+/* interior division of Euler parameter for NLERP. */
+zEP *zEPInterDivNL(zEP *ep1, zEP *ep2, double t, zEP *ep)
+{
+  return zEPInterDivNLArray( ep1, ep2, &t, 1, ep );
+}
+
 /* interior division of two attitude matrices for SLERP. */
 zMat3D *zMat3DInterDiv(zMat3D *m1, zMat3D *m2, double t, zMat3D *m)
 {
@@ -267,6 +257,233 @@ zMat3D *zMat3DInterDiv(zMat3D *m1, zMat3D *m2, double t, zMat3D *m)
   return zMat3DFromEP( m, &ep );
 }
 
+/* ********************************************************** */
+/* batch operations on arrays of Euler parameters
+ * ********************************************************** */
+
+/* size of blocks of arrays processed in a pass */
+#define ZEO_EP_ARRAY_BLOCK 64
+
+/* normalize a block of Euler parameters with their squared norms. */
+static void _zEPArrayNormalize(zEP ep[], double s[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i++ ) /* scalar: sqrt() may set errno */
+    s[i] = 1.0 / sqrt( s[i] );
+  for( i=0; i<n; i++ ){
+    ep[i].e[0] *= s[i];
+    ep[i].e[1] *= s[i];
+    ep[i].e[2] *= s[i];
+    ep[i].e[3] *= s[i];
+  }
+}
+
+/* a block of interior division of Euler parameters for SLERP. */
+static void _zEPInterDivArrayBlock(zEP ep1[], zEP ep2[], double t[], int n, zEP ep[])
+{
+  double c[ZEO_EP_ARRAY_BLOCK], k1[ZEO_EP_ARRAY_BLOCK], k2[ZEO_EP_ARRAY_BLOCK], th, sth;
+  register int i;
+
+  for( i=0; i<n; i++ )
+    c[i] = ep1[i].e[0]*ep2[i].e[0] + ep1[i].e[1]*ep2[i].e[1] + ep1[i].e[2]*ep2[i].e[2] + ep1[i].e[3]*ep2[i].e[3];
+  for( i=0; i<n; i++ ){ /* scalar: trigonometric functions */
+    th = acos( zMin( fabs(c[i]), 1.0 ) );
+    if( zIsTiny( ( sth = sin( th ) ) ) ){
+      k1[i] = 1 - t[i];
+      k2[i] = t[i];
+    } else{
+      k1[i] = sin( th - th*t[i] );
+      k2[i] = sin( th*t[i] );
+    }
+  }
+  for( i=0; i<n; i++ ){
+    k2[i] = c[i] < 0 ? -k2[i] : k2[i]; /* choose the shorter path */
+    ep[i].e[0] = k1[i]*ep1[i].e[0] + k2[i]*ep2[i].e[0];
+    ep[i].e[1] = k1[i]*ep1[i].e[1] + k2[i]*ep2[i].e[1];
+    ep[i].e[2] = k1[i]*ep1[i].e[2] + k2[i]*ep2[i].e[2];
+    ep[i].e[3] = k1[i]*ep1[i].e[3] + k2[i]*ep2[i].e[3];
+    c[i] = zSqr(ep[i].e[0]) + zSqr(ep[i].e[1]) + zSqr(ep[i].e[2]) + zSqr(ep[i].e[3]);
+  }
+  _zEPArrayNormalize( ep, c, n );
+}
+
+/* interior division of arrays of Euler parameters for SLERP. */
+zEP *zEPInterDivArray(zEP ep1[], zEP ep2[], double t[], int n, zEP ep[])
+{
+  register int i;
+
+  for( i=0; i<n; i+=ZEO_EP_ARRAY_BLOCK )
+    _zEPInterDivArrayBlock( ep1+i, ep2+i, t+i, zMin( n-i, ZEO_EP_ARRAY_BLOCK ), ep+i );
+  return ep;
+}
+
+/* a block of interior division of Euler parameters for NLERP. */
+static void _zEPInterDivNLArrayBlock(zEP ep1[], zEP ep2[], double t[], int n, zEP ep[])
+{
+  double s[ZEO_EP_ARRAY_BLOCK], c, k1, k2;
+  register int i;
+
+  for( i=0; i<n; i++ ){
+    c = ep1[i].e[0]*ep2[i].e[0] + ep1[i].e[1]*ep2[i].e[1] + ep1[i].e[2]*ep2[i].e[2] + ep1[i].e[3]*ep2[i].e[3];
+    k1 = 1 - t[i];
+    k2 = c < 0 ? -t[i] : t[i]; /* choose the shorter path */
+    ep[i].e[0] = k1*ep1[i].e[0] + k2*ep2[i].e[0];
+    ep[i].e[1] = k1*ep1[i].e[1] + k2*ep2[i].e[1];
+    ep[i].e[2] = k1*ep1[i].e[2] + k2*ep2[i].e[2];
+    ep[i].e[3] = k1*ep1[i].e[3] + k2*ep2[i].e[3];
+    s[i] = zSqr(ep[i].e[0]) + zSqr(ep[i].e[1]) + zSqr(ep[i].e[2]) + zSqr(ep[i].e[3]);
+  }
+  _zEPArrayNormalize( ep, s, n );
+}
+
+/* interior division of arrays of Euler parameters for NLERP. */
+zEP *zEPInterDivNLArray(zEP ep1[], zEP ep2[], double t[], int n, zEP ep[])
+{
+  register int i;
+
+  for( i=0; i<n; i+=ZEO_EP_ARRAY_BLOCK )
+    _zEPInterDivNLArrayBlock( ep1+i, ep2+i, t+i, zMin( n-i, ZEO_EP_ARRAY_BLOCK ), ep+i );
+  return ep;
+}
+
+/* a block of conversion from Euler parameters to attitude matrices. */
+static void _zMat3DFromEPArrayBlock(zMat3D m[], zEP ep[], int n)
+{
+  double a[9][ZEO_EP_ARRAY_BLOCK], e00, e11, e22, e33, e12, e23, e31, e01, e02, e03;
+  register int i;
+
+  for( i=0; i<n; i++ ){ /* into structure of arrays */
+    e00 = zSqr(ep[i].e[0]);
+    e11 = zSqr(ep[i].e[1]);
+    e22 = zSqr(ep[i].e[2]);
+    e33 = zSqr(ep[i].e[3]);
+    e12 = ep[i].e[1] * ep[i].e[2];
+    e23 = ep[i].e[2] * ep[i].e[3];
+    e31 = ep[i].e[3] * ep[i].e[1];
+    e01 = ep[i].e[0] * ep[i].e[1];
+    e02 = ep[i].e[0] * ep[i].e[2];
+    e03 = ep[i].e[0] * ep[i].e[3];
+    a[0][i] = e00+e11-e22-e33;
+    a[1][i] = 2*(e12+e03);
+    a[2][i] = 2*(e31-e02);
+    a[3][i] = 2*(e12-e03);
+    a[4][i] = e00-e11+e22-e33;
+    a[5][i] = 2*(e23+e01);
+    a[6][i] = 2*(e31+e02);
+    a[7][i] = 2*(e23-e01);
+    a[8][i] = e00-e11-e22+e33;
+  }
+  for( i=0; i<n; i++ ){ /* back to array of structures */
+    m[i].c.xx = a[0][i];
+    m[i].c.xy = a[1][i];
+    m[i].c.xz = a[2][i];
+    m[i].c.yx = a[3][i];
+    m[i].c.yy = a[4][i];
+    m[i].c.yz = a[5][i];
+    m[i].c.zx = a[6][i];
+    m[i].c.zy = a[7][i];
+    m[i].c.zz = a[8][i];
+  }
+}
+
+/* convert an array of Euler parameters to attitude matrices. */
+zMat3D *zMat3DFromEPArray(zMat3D m[], zEP ep[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i+=ZEO_EP_ARRAY_BLOCK )
+    _zMat3DFromEPArrayBlock( m+i, ep+i, zMin( n-i, ZEO_EP_ARRAY_BLOCK ) );
+  return m;
+}
+
+/* a block of conversion from attitude matrices to Euler parameters. */
+static bool _zMat3DToEPArrayBlock(zMat3D m[], zEP ep[], int n)
+{
+  double a[9][ZEO_EP_ARRAY_BLOCK], r[ZEO_EP_ARRAY_BLOCK], p[ZEO_EP_ARRAY_BLOCK], s0, s1, s2, s3, k, d, u, v, w, x, y, z;
+  register int i;
+  bool ret = true;
+
+  for( i=0; i<n; i++ ){ /* into structure of arrays */
+    a[0][i] = m[i].c.xx;
+    a[1][i] = m[i].c.xy;
+    a[2][i] = m[i].c.xz;
+    a[3][i] = m[i].c.yx;
+    a[4][i] = m[i].c.yy;
+    a[5][i] = m[i].c.yz;
+    a[6][i] = m[i].c.zx;
+    a[7][i] = m[i].c.zy;
+    a[8][i] = m[i].c.zz;
+  }
+  for( i=0; i<n; i++ ){ /* the first one of the largest pivots as zMat3DToEP() selects */
+    s0 = a[0][i] + a[4][i] + a[8][i] + 1.0;
+    s1 = a[0][i] - a[4][i] - a[8][i] + 1.0;
+    s2 =-a[0][i] + a[4][i] - a[8][i] + 1.0;
+    s3 =-a[0][i] - a[4][i] + a[8][i] + 1.0;
+    p[i] = s1 > s0 ? 1 : 0;
+    r[i] = s1 > s0 ? s1 : s0;
+    p[i] = s2 > r[i] ? 2 : p[i];
+    r[i] = s2 > r[i] ? s2 : r[i];
+    p[i] = s3 > r[i] ? 3 : p[i];
+    r[i] = s3 > r[i] ? s3 : r[i];
+  }
+  for( i=0; i<n; i++ ){ /* scalar: sqrt() may set errno */
+    if( r[i] <= 0 ) ret = false;
+    r[i] = 0.5 * sqrt( zMax( r[i], zTOL ) );
+  }
+  for( i=0; i<n; i++ ){
+    k = 0.25 / r[i];
+    d = k * ( a[5][i] - a[7][i] ); /* m[1][2] - m[2][1] */
+    u = k * ( a[6][i] - a[2][i] ); /* m[2][0] - m[0][2] */
+    v = k * ( a[1][i] - a[3][i] ); /* m[0][1] - m[1][0] */
+    x = k * ( a[3][i] + a[1][i] ); /* m[1][0] + m[0][1] */
+    y = k * ( a[2][i] + a[6][i] ); /* m[0][2] + m[2][0] */
+    z = k * ( a[7][i] + a[5][i] ); /* m[2][1] + m[1][2] */
+    w = p[i] < 0.5 ? r[i] : d;
+    w = p[i] > 1.5 ? u : w;
+    w = p[i] > 2.5 ? v : w;
+    ep[i].e[0] = w;
+    w = p[i] < 0.5 ? d : r[i];
+    w = p[i] > 1.5 ? x : w;
+    w = p[i] > 2.5 ? y : w;
+    ep[i].e[1] = w;
+    w = p[i] < 0.5 ? u : x;
+    w = p[i] > 1.5 ? r[i] : w;
+    w = p[i] > 2.5 ? z : w;
+    ep[i].e[2] = w;
+    w = p[i] < 0.5 ? v : y;
+    w = p[i] > 1.5 ? z : w;
+    w = p[i] > 2.5 ? r[i] : w;
+    ep[i].e[3] = w;
+  }
+  return ret;
+}
+
+/* convert an array of attitude matrices to Euler parameters. */
+zEP *zMat3DToEPArray(zMat3D m[], zEP ep[], int n)
+{
+  register int i;
+  bool ret = true;
+
+  for( i=0; i<n; i+=ZEO_EP_ARRAY_BLOCK )
+    if( !_zMat3DToEPArrayBlock( m+i, ep+i, zMin( n-i, ZEO_EP_ARRAY_BLOCK ) ) ) ret = false;
+  if( !ret ){
+    ZRUNERROR( ZEO_ERR_NONSO3 );
+    return NULL;
+  }
+  return ep;
+}
+
+/* convert an array of Euler parameter derivatives to angular velocities. */
+zVec3D *zEPVel2AngVelArray(zEP epvel[], zEP ep[], zVec3D angvel[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i++ )
+    _zEPVel2AngVel( &epvel[i], &ep[i], &angvel[i] );
+  return angvel;
+}
+
 /* print Euler parameter out to a file. */
 void zEPFPrint(FILE *fp, zEP *ep)
 {
@@ -71,10 +71,8 @@ zVec3D *zXform3DInv(zFrame3D *f, zVec3D *v, zVec3D *tv)
  */
 zVec6D *zXform6DLin(zFrame3D *f, zVec6D *v, zVec6D *vc)
 {
-  zVec6D tmp;
-
-  zVec6DLinShift( v, zFrame3DPos(f), &tmp );
-  return zMulMat3DTVec6D( zFrame3DAtt(f), &tmp, vc );
+  _zXform6DLin( f, v, vc );
+  return vc;
 }
 
 /* vc_lin = R       v_lin
@@ -82,8 +80,62 @@ zVec6D *zXform6DLin(zFrame3D *f, zVec6D *v, zVec6D *vc)
  */
 zVec6D *zXform6DAng(zFrame3D *f, zVec6D *v, zVec6D *vc)
 {
-  zMulMat3DVec6D( zFrame3DAtt(f), v, vc );
-  return zVec6DAngShiftDRC( vc, zFrame3DPos(f) );
+  _zXform6DAng( f, v, vc );
+  return vc;
+}
+
+/* vc_lin = R v_lin + p x R v_ang
+   vc_ang = R v_ang
+ */
+zVec6D *zXform6DLinInv(zFrame3D *f, zVec6D *v, zVec6D *vc)
+{
+  _zXform6DLinInv( f, v, vc );
+  return vc;
+}
+
+/* vc_lin = R^T   v_lin
+   vc_ang = R^T ( v_ang - p x v_lin )
+ */
+zVec6D *zXform6DAngInv(zFrame3D *f, zVec6D *v, zVec6D *vc)
+{
+  _zXform6DAngInv( f, v, vc );
+  return vc;
+}
+
+/* transform an array of velocity-type 6D vectors. */
+zVec6D *zXform6DLinArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[])
+{
+  register int i;
+
+  for( i=0; i<n; i++ ) _zXform6DLin( &f[i], &v[i], &vc[i] );
+  return vc;
+}
+
+/* transform an array of force-type 6D vectors. */
+zVec6D *zXform6DAngArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[])
+{
+  register int i;
+
+  for( i=0; i<n; i++ ) _zXform6DAng( &f[i], &v[i], &vc[i] );
+  return vc;
+}
+
+/* inversely transform an array of velocity-type 6D vectors. */
+zVec6D *zXform6DLinInvArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[])
+{
+  register int i;
+
+  for( i=0; i<n; i++ ) _zXform6DLinInv( &f[i], &v[i], &vc[i] );
+  return vc;
+}
+
+/* inversely transform an array of force-type 6D vectors. */
+zVec6D *zXform6DAngInvArray(zFrame3D f[], zVec6D v[], int n, zVec6D vc[])
+{
+  register int i;
+
+  for( i=0; i<n; i++ ) _zXform6DAngInv( &f[i], &v[i], &vc[i] );
+  return vc;
 }
 
 /* twist a 3D frame by a torsion vector
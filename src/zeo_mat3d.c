@@ -862,6 +862,118 @@ void zMat3DSymEig(zMat3D *m, double eval[], zVec3D evec[])
   }
 }
 
+/* eigenvector of a symmetric 3x3 matrix for an isolated eigenvalue. */
+static bool _zMat3DSymEigTrigVec(zMat3D *m, double eval, zVec3D *evec);
+bool _zMat3DSymEigTrigVec(zMat3D *m, double eval, zVec3D *evec)
+{
+  zVec3D r[3], c[3];
+  double d[3];
+  register int i, imax;
+
+  for( i=0; i<3; i++ ){
+    zVec3DCopy( &m->v[i], &r[i] );
+    r[i].e[i] -= eval;
+  }
+  _zVec3DOuterProd( &r[0], &r[1], &c[0] );
+  _zVec3DOuterProd( &r[0], &r[2], &c[1] );
+  _zVec3DOuterProd( &r[1], &r[2], &c[2] );
+  for( imax=0, i=0; i<3; i++ )
+    if( ( d[i] = _zVec3DSqrNorm( &c[i] ) ) > d[imax] ) imax = i;
+  if( zIsTiny( d[imax] ) ) return false;
+  _zVec3DMul( &c[imax], 1.0/sqrt(d[imax]), evec );
+  return true;
+}
+
+/* eigensystem of a symmetric 3x3 matrix by a closed-form method. */
+void zMat3DSymEigTrig(zMat3D *m, double eval[], zVec3D evec[])
+{
+  zMat3D l;
+  zVec3D u, v, mu, mv;
+  double scale, q, p, r, cp, sp, e[3], a, b, c, t, s;
+  register int i, j, k;
+
+  /* normalize the matrix to avoid overflow and underflow */
+  for( scale=0, i=0; i<3; i++ )
+    for( j=0; j<3; j++ )
+      if( fabs( m->e[i][j] ) > scale ) scale = fabs( m->e[i][j] );
+  if( zIsTiny( scale ) ) goto JACOBI;
+  _zMat3DMul( m, 1.0/scale, &l );
+  /* eigenvalues by the trigonometric solution of the characteristic equation */
+  q = ( l.c.xx + l.c.yy + l.c.zz ) / 3;
+  p = zSqr(l.c.xy) + zSqr(l.c.yz) + zSqr(l.c.zx);
+  p = sqrt( ( zSqr(l.c.xx-q) + zSqr(l.c.yy-q) + zSqr(l.c.zz-q) + 2*p ) / 6 );
+  if( zIsTiny( p ) ) goto JACOBI;
+  for( i=0; i<3; i++ ) l.e[i][i] -= q;
+  r = 0.5 * zMat3DDet( &l ) / ( p*p*p );
+  for( i=0; i<3; i++ ) l.e[i][i] += q;
+  cp = cos( acos( zLimit( r, -1, 1 ) ) / 3 );
+  sp = sqrt( 1 - cp*cp );
+  e[0] = q + 2*p*cp;
+  e[2] = q - p*( cp + sqrt(3)*sp ); /* q + 2 p cos( phi + 2 pi / 3 ) */
+  e[1] = 3*q - e[0] - e[2];
+  /* eigenvector for the eigenvalue isolated from the others */
+  k = e[0] - e[1] > e[1] - e[2] ? 0 : 2;
+  if( !_zMat3DSymEigTrigVec( &l, e[k], &evec[k] ) ) goto JACOBI;
+  /* 2x2 eigensystem in the orthogonal complement by a Jacobi rotation */
+  i = fabs( evec[k].c.x ) < fabs( evec[k].c.y ) ?
+    ( fabs( evec[k].c.x ) < fabs( evec[k].c.z ) ? zX : zZ ) :
+    ( fabs( evec[k].c.y ) < fabs( evec[k].c.z ) ? zY : zZ );
+  zVec3DZero( &v );
+  v.e[i] = 1.0;
+  _zVec3DOuterProd( &evec[k], &v, &u );
+  zVec3DNormalizeDRC( &u );
+  _zVec3DOuterProd( &evec[k], &u, &v );
+  _zMulMat3DVec3D( &l, &u, &mu );
+  _zMulMat3DVec3D( &l, &v, &mv );
+  a = _zVec3DInnerProd( &u, &mu );
+  b = _zVec3DInnerProd( &u, &mv );
+  c = _zVec3DInnerProd( &v, &mv );
+  if( zIsTiny( b ) ){
+    t = 0;
+  } else{
+    t = 0.5 * ( c - a ) / b;
+    t = ( t < 0 ? -1 : 1 ) / ( fabs( t ) + sqrt( t*t + 1 ) );
+  }
+  s = t * ( r = 1 / sqrt( t*t + 1 ) ); /* sine and cosine of the rotation */
+  i = k == 0 ? 1 : 0;
+  j = k == 0 ? 2 : 1;
+  e[i] = a - t * b;
+  e[j] = c + t * b;
+  _zVec3DMul( &u, r, &evec[i] );
+  _zVec3DCatDRC( &evec[i],-s, &v );
+  _zVec3DMul( &v, r, &evec[j] );
+  _zVec3DCatDRC( &evec[j], s, &u );
+  if( e[i] < e[j] ){
+    zSwap( double, e[i], e[j] );
+    zSwap( zVec3D, evec[i], evec[j] );
+  }
+  for( i=0; i<3; i++ ) eval[i] = e[i] * scale;
+  /* make the basis right-handed */
+  _zVec3DOuterProd( &evec[0], &evec[1], &evec[2] );
+  return;
+
+ JACOBI:
+  zMat3DSymEig( m, eval, evec );
+  /* sort in descending order */
+  for( i=0; i<2; i++ )
+    for( j=i+1; j<3; j++ )
+      if( eval[j] > eval[i] ){
+        zSwap( double, eval[i], eval[j] );
+        zSwap( zVec3D, evec[i], evec[j] );
+      }
+  if( zVec3DGrassmannProd( &evec[0], &evec[1], &evec[2] ) < 0 )
+    _zVec3DRevDRC( &evec[2] );
+}
+
+/* eigensystems of an array of symmetric 3x3 matrices by a closed-form method. */
+void zMat3DSymEigTrigArray(zMat3D m[], int n, double eval[], zVec3D evec[])
+{
+  register int i;
+
+  for( i=0; i<n; i++ )
+    zMat3DSymEigTrig( &m[i], &eval[3*i], &evec[3*i] );
+}
+
 /* ********************************************************** */
 /* I/O
  * ********************************************************** */
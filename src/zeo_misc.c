@@ -5,6 +5,7 @@
  */
 
 #include <zeo/zeo_misc.h>
+#include <pthread.h>
 
 static char *__zaxisname[] = { "x", "y", "z", "tilt", "elev", "azim", NULL };
 
@@ -39,3 +40,28 @@ zDir zDirRev(zDir dir)
 {
   return dir == zNONE ? zNONE : ( 1 + dir - (dir+1)%2 *2 );
 }
+
+/* run a function concurrently over an array of arguments. */
+void zThreadRun(void *(*func)(void*), void *arg, size_t size, int n)
+{
+  pthread_t *th;
+  bool *created;
+  register int i;
+
+  if( n <= 0 ) return;
+  th = zAlloc( pthread_t, n-1 );
+  created = zAlloc( bool, n-1 );
+  for( i=0; i<n-1; i++ ){
+    if( th && created && pthread_create( &th[i], NULL, func, (char *)arg + i*size ) == 0 )
+      created[i] = true;
+    else{ /* run in the current thread instead */
+      if( created ) created[i] = false;
+      func( (char *)arg + i*size );
+    }
+  }
+  func( (char *)arg + i*size );
+  for( i=0; i<n-1; i++ )
+    if( th && created && created[i] ) pthread_join( th[i], NULL );
+  zFree( th );
+  zFree( created );
+}
@@ -117,6 +117,37 @@ bool zMShape3DPointIsInside(zMShape3D *ms, zVec3D *p, bool rim)
   return false;
 }
 
+/* intersection of a ray and multiple shapes. */
+int zMShape3DRayCast(zMShape3D *ms, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *hit, zVec3D *norm)
+{
+  zVec3D n;
+  double ts;
+  int id = -1;
+  register int i;
+
+  for( i=0; i<zMShape3DShapeNum(ms); i++ )
+    if( zShape3DRayCast( zMShape3DShape(ms,i), org, dir, tmax, &ts, NULL, norm ? &n : NULL ) ){
+      tmax = ts;
+      id = i;
+      if( norm ) zVec3DCopy( &n, norm );
+    }
+  if( id >= 0 ){
+    if( t ) *t = tmax;
+    if( hit ) zVec3DCat( org, tmax, dir, hit );
+  }
+  return id;
+}
+
+/* check if a ray hits any of multiple shapes. */
+int zMShape3DRayAnyHit(zMShape3D *ms, zVec3D *org, zVec3D *dir, double tmax)
+{
+  register int i;
+
+  for( i=0; i<zMShape3DShapeNum(ms); i++ )
+    if( zShape3DRayAnyHit( zMShape3DShape(ms,i), org, dir, tmax ) ) return i;
+  return -1;
+}
+
 /* convert multiple shapes to polyhedra. */
 zMShape3D *zMShape3DToPH(zMShape3D *ms)
 {
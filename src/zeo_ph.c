@@ -179,6 +179,133 @@ bool zPH3DPointIsInside(zPH3D *ph, zVec3D *p, bool rim)
   return true;
 }
 
+/* intersection of a ray and a polyhedron. */
+int zPH3DRayCast(zPH3D *ph, zVec3D *org, zVec3D *dir, double tmax, double *t)
+{
+  int face = -1;
+  double tf;
+  register int i;
+
+  for( i=0; i<zPH3DFaceNum(ph); i++ )
+    if( zTri3DRayHit( zPH3DFace(ph,i), org, dir, tmax, &tf ) ){
+      tmax = tf;
+      face = i;
+    }
+  if( face >= 0 && t ) *t = tmax;
+  return face;
+}
+
+/* ********************************************************** */
+/* CLASS: zPH3DAdj
+ * vertex adjacency of a 3D polyhedron in compressed sparse row form
+ * ********************************************************** */
+
+/* initialize vertex adjacency of a 3D polyhedron. */
+zPH3DAdj *zPH3DAdjInit(zPH3DAdj *adj)
+{
+  adj->num = 0;
+  adj->head = adj->idx = NULL;
+  return adj;
+}
+
+/* allocate vertex adjacency of a 3D polyhedron. */
+zPH3DAdj *zPH3DAdjAlloc(zPH3DAdj *adj, int vnum, int nnum)
+{
+  zPH3DAdjInit( adj );
+  adj->head = zAlloc( int, vnum+1 );
+  adj->idx = zAlloc( int, zMax(nnum,1) );
+  if( !adj->head || !adj->idx ){
+    ZALLOCERROR();
+    zPH3DAdjDestroy( adj );
+    return NULL;
+  }
+  adj->num = vnum;
+  return adj;
+}
+
+/* create vertex adjacency of a 3D polyhedron. */
+zPH3DAdj *zPH3DAdjCreate(zPH3DAdj *adj, zPH3D *ph)
+{
+  int a, b, n;
+  register int i, j, k;
+
+  if( !zPH3DAdjAlloc( adj, zPH3DVertNum(ph), zPH3DFaceNum(ph)*6 ) ) return NULL;
+  /* count edges in both directions */
+  for( i=0; i<=adj->num; i++ ) adj->head[i] = 0;
+  for( i=0; i<zPH3DFaceNum(ph); i++ )
+    for( j=0; j<3; j++ ){
+      adj->head[zPH3DFaceVert(ph,i,j)-zPH3DVertBuf(ph)+1]++;
+      adj->head[zPH3DFaceVert(ph,i,(j+1)%3)-zPH3DVertBuf(ph)+1]++;
+    }
+  for( i=0; i<adj->num; i++ ) adj->head[i+1] += adj->head[i];
+  for( i=0; i<zPH3DFaceNum(ph); i++ )
+    for( j=0; j<3; j++ ){
+      a = zPH3DFaceVert(ph,i,j) - zPH3DVertBuf(ph);
+      b = zPH3DFaceVert(ph,i,(j+1)%3) - zPH3DVertBuf(ph);
+      adj->idx[adj->head[a]++] = b;
+      adj->idx[adj->head[b]++] = a;
+    }
+  for( i=adj->num; i>0; i-- ) adj->head[i] = adj->head[i-1];
+  adj->head[0] = 0;
+  /* sort and unify duplicate neighbors */
+  for( n=0, i=0; i<adj->num; i++ ){
+    for( j=adj->head[i]+1; j<adj->head[i+1]; j++ ){
+      a = adj->idx[j];
+      for( k=j; k>adj->head[i] && adj->idx[k-1] > a; k-- )
+        adj->idx[k] = adj->idx[k-1];
+      adj->idx[k] = a;
+    }
+    for( k=n, j=adj->head[i]; j<adj->head[i+1]; j++ )
+      if( j == adj->head[i] || adj->idx[j] != adj->idx[j-1] )
+        adj->idx[n++] = adj->idx[j];
+    adj->head[i] = k;
+  }
+  adj->head[adj->num] = n;
+  return adj;
+}
+
+/* destroy vertex adjacency of a 3D polyhedron. */
+void zPH3DAdjDestroy(zPH3DAdj *adj)
+{
+  zFree( adj->head );
+  zFree( adj->idx );
+  adj->num = 0;
+}
+
+/* support map of a convex polyhedron by hill-climbing. */
+zVec3D *zPH3DAdjSupportMap(zPH3DAdj *adj, zVec3D vert[], zVec3D *v, int *hint)
+{
+  int cur, next;
+  double d, d_max;
+  bool flat;
+  register int j;
+
+  if( adj->num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  cur = *hint >= 0 && *hint < adj->num ? *hint : 0;
+  d_max = _zVec3DInnerProd( &vert[cur], v );
+  while( 1 ){
+    for( flat=true, next=cur, j=adj->head[cur]; j<adj->head[cur+1]; j++ ){
+      if( ( d = _zVec3DInnerProd( &vert[adj->idx[j]], v ) ) > d_max ){
+        d_max = d;
+        next = adj->idx[j];
+      }
+      if( d < d_max - zTOL ) flat = false;
+    }
+    if( next != cur ){
+      cur = next;
+      continue;
+    }
+    /* all neighbors are level with a non-extreme vertex inside of a face
+       perpendicular to v, which may be the bottom of the polytope */
+    if( flat ) cur = zVec3DSupportMap( vert, adj->num, v ) - vert;
+    break;
+  }
+  return &vert[( *hint = cur )];
+}
+
 /* volume of a 3D polyhedron. */
 double zPH3DVolume(zPH3D *ph)
 {
@@ -494,3 +494,66 @@ bool zVec3DListReadPCDFile(zVec3DList *pc, char filename[])
   fclose( fp );
   return ret;
 }
+
+/* ********************************************************** */
+/* PCD format encoder
+ * ********************************************************** */
+
+/* write a component of a point to a stream of PCD file. */
+static void _zPCDValFWrite(FILE *fp, double val)
+{
+  if( zIsNan( val ) )
+    fprintf( fp, "nan" );
+  else
+    fprintf( fp, "%.10g", val );
+}
+
+/* write an organized point cloud to a stream of PCD file. */
+bool zVec3DArrayPCDFWrite(FILE *fp, zVec3DArray *pc, int width, zFrame3D *viewpoint)
+{
+  zEP ep;
+  zVec3D *v;
+  register int i;
+
+  if( width <= 0 || zArraySize(pc) % width != 0 ){
+    ZRUNERROR( ZEO_ERR_PCD_SIZMIS, zArraySize(pc), width );
+    return false;
+  }
+  fprintf( fp, "# .PCD v0.7 - Point Cloud Data file format\n" );
+  fprintf( fp, "VERSION 0.7\n" );
+  fprintf( fp, "FIELDS x y z\n" );
+  fprintf( fp, "SIZE 4 4 4\n" );
+  fprintf( fp, "TYPE F F F\n" );
+  fprintf( fp, "COUNT 1 1 1\n" );
+  fprintf( fp, "WIDTH %d\n", width );
+  fprintf( fp, "HEIGHT %d\n", zArraySize(pc) / width );
+  if( viewpoint ){
+    zMat3DToEP( zFrame3DAtt(viewpoint), &ep );
+    fprintf( fp, "VIEWPOINT %.10g %.10g %.10g %.10g %.10g %.10g %.10g\n",
+      zFrame3DPos(viewpoint)->c.x, zFrame3DPos(viewpoint)->c.y, zFrame3DPos(viewpoint)->c.z,
+      ep.ex.w, ep.ex.v.c.x, ep.ex.v.c.y, ep.ex.v.c.z );
+  } else
+    fprintf( fp, "VIEWPOINT 0 0 0 1 0 0 0\n" );
+  fprintf( fp, "POINTS %d\n", zArraySize(pc) );
+  fprintf( fp, "DATA ascii\n" );
+  for( i=0; i<zArraySize(pc); i++ ){
+    v = zArrayElemNC(pc,i);
+    _zPCDValFWrite( fp, v->c.x ); fprintf( fp, " " );
+    _zPCDValFWrite( fp, v->c.y ); fprintf( fp, " " );
+    _zPCDValFWrite( fp, v->c.z ); fprintf( fp, "\n" );
+  }
+  return true;
+}
+
+/* write an organized point cloud to PCD file. */
+bool zVec3DArrayWritePCDFile(zVec3DArray *pc, int width, zFrame3D *viewpoint, char filename[])
+{
+  FILE *fp;
+  bool ret;
+
+  if( !( fp = zOpenFile( filename, ZEO_PCD_SUFFIX, "w" ) ) )
+    return false;
+  ret = zVec3DArrayPCDFWrite( fp, pc, width, viewpoint );
+  fclose( fp );
+  return ret;
+}
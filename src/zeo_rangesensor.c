@@ -0,0 +1,246 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_rangesensor - simulation of range sensors.
+ */
+
+#include <zeo/zeo_rangesensor.h>
+
+/* ********************************************************** */
+/* CLASS: zRangeScene
+ * multiple shapes with cached hierarchies for ray casting
+ * ********************************************************** */
+
+/* initialize a scene of range sensors. */
+zRangeScene *zRangeSceneInit(zRangeScene *scene)
+{
+  scene->ms = NULL;
+  zAABBTreeInit( &scene->tree, 0 ); /* shapes are never moved */
+  scene->bvh = NULL;
+  return scene;
+}
+
+/* create a scene of range sensors. */
+zRangeScene *zRangeSceneCreate(zRangeScene *scene, zMShape3D *ms, int nthread)
+{
+  zShape3D *shape;
+  zAABox3D box;
+  int n;
+  register int i;
+
+  zRangeSceneInit( scene );
+  scene->ms = ms;
+  if( ( n = zMShape3DShapeNum(ms) ) == 0 ) return scene;
+  if( !( scene->bvh = zAlloc( zPH3DBVH, n ) ) ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  for( i=0; i<n; i++ )
+    zPH3DBVHInit( &scene->bvh[i] );
+  for( i=0; i<n; i++ ){
+    shape = zMShape3DShape(ms,i);
+    if( shape->com == &zeo_shape3d_ph_com && zPH3DFaceNum(zShape3DPH(shape)) > 0 &&
+        !zPH3DBVHCreate( &scene->bvh[i], zShape3DPH(shape), nthread ) ) goto FAILURE;
+    if( !zShape3DToAABox3D( shape, &box ) ) continue; /* an empty shape is never hit */
+    if( zAABBTreeInsert( &scene->tree, &box, shape ) < 0 ) goto FAILURE;
+  }
+  return scene;
+
+ FAILURE:
+  zRangeSceneDestroy( scene );
+  return NULL;
+}
+
+/* destroy a scene of range sensors. */
+void zRangeSceneDestroy(zRangeScene *scene)
+{
+  register int i;
+
+  if( scene->bvh )
+    for( i=0; i<zMShape3DShapeNum(scene->ms); i++ )
+      zPH3DBVHDestroy( &scene->bvh[i] );
+  zFree( scene->bvh );
+  zAABBTreeDestroy( &scene->tree );
+  zRangeSceneInit( scene );
+}
+
+/* ray casting query to a scene of range sensors */
+typedef struct{
+  zRangeScene *scene;
+  int id;
+  double t;
+} zRangeSceneRayCastData;
+
+/* intersection of a ray and a shape of a leaf. */
+static double _zRangeSceneRayCastLeaf(int leaf, zVec3D *org, zVec3D *dir, double tmax, void *priv)
+{
+  zRangeSceneRayCastData *data;
+  double t;
+  int i;
+
+  data = priv;
+  i = (zShape3D *)zAABBTreeData(&data->scene->tree,leaf) - zMShape3DShapeBuf(data->scene->ms);
+  if( zPH3DBVHNodeNum(&data->scene->bvh[i]) > 0 ){
+    if( zPH3DBVHRayCast( &data->scene->bvh[i], org, dir, tmax, &t ) < 0 ) return tmax;
+  } else
+  if( !zShape3DRayCast( zMShape3DShape(data->scene->ms,i), org, dir, tmax, &t, NULL, NULL ) ) return tmax;
+  /* a tie is broken by the larger index as zMShape3DRayCast() does */
+  if( t < tmax || data->id < 0 || i > data->id ){
+    data->id = i;
+    data->t = t;
+  }
+  return t;
+}
+
+/* intersection of a ray and shapes of a scene of range sensors. */
+int zRangeSceneRayCast(zRangeScene *scene, zVec3D *org, zVec3D *dir, double tmax, double *t)
+{
+  zRangeSceneRayCastData data;
+
+  data.scene = scene;
+  data.id = -1;
+  zAABBTreeRayCast( &scene->tree, org, dir, tmax, _zRangeSceneRayCastLeaf, &data );
+  if( data.id >= 0 && t ) *t = data.t;
+  return data.id;
+}
+
+/* ********************************************************** */
+/* CLASS: zRangeSensor
+ * range sensor which shoots a grid of rays from its origin
+ * ********************************************************** */
+
+/* initialize a range sensor. */
+zRangeSensor *zRangeSensorInit(zRangeSensor *sensor)
+{
+  sensor->width = sensor->height = 0;
+  sensor->dir = NULL;
+  sensor->rmin = 0;
+  sensor->rmax = HUGE_VAL;
+  zArrayInit( &sensor->point );
+  return sensor;
+}
+
+/* allocate directions of rays and a point cloud of a range sensor. */
+static zRangeSensor *_zRangeSensorAlloc(zRangeSensor *sensor, int width, int height, double rmin, double rmax)
+{
+  zRangeSensorInit( sensor );
+  if( width <= 0 || height <= 0 ){
+    ZRUNERROR( ZEO_ERR_RANGESENSOR_INVSIZ );
+    return NULL;
+  }
+  sensor->dir = zAlloc( zVec3D, width*height );
+  zArrayAlloc( &sensor->point, zVec3D, width*height );
+  if( !sensor->dir || zArraySize(&sensor->point) == 0 ){
+    ZALLOCERROR();
+    zRangeSensorDestroy( sensor );
+    return NULL;
+  }
+  sensor->width = width;
+  sensor->height = height;
+  sensor->rmin = rmin;
+  sensor->rmax = rmax;
+  return sensor;
+}
+
+/* create a depth camera of the pinhole model. */
+zRangeSensor *zRangeSensorCreateCamera(zRangeSensor *sensor, int width, int height, double fx, double fy, double cx, double cy, double rmin, double rmax)
+{
+  register int i, j;
+
+  if( !_zRangeSensorAlloc( sensor, width, height, rmin, rmax ) ) return NULL;
+  for( i=0; i<height; i++ )
+    for( j=0; j<width; j++ )
+      zVec3DCreate( zRangeSensorDir(sensor,i,j), ( j - cx ) / fx, ( i - cy ) / fy, 1 );
+  return sensor;
+}
+
+/* create a spinning multi-beam LiDAR. */
+zRangeSensor *zRangeSensorCreateLiDAR(zRangeSensor *sensor, int beamnum, double elevmin, double elevmax, int stepnum, double rmin, double rmax)
+{
+  double elev, azim;
+  register int i, j;
+
+  if( !_zRangeSensorAlloc( sensor, stepnum, beamnum, rmin, rmax ) ) return NULL;
+  for( i=0; i<beamnum; i++ ){
+    elev = beamnum > 1 ? elevmin + ( elevmax - elevmin ) * i / ( beamnum - 1 ) : elevmin;
+    for( j=0; j<stepnum; j++ ){
+      azim = 2 * zPI * j / stepnum;
+      zVec3DCreate( zRangeSensorDir(sensor,i,j),
+        cos(elev)*cos(azim), cos(elev)*sin(azim), sin(elev) );
+    }
+  }
+  return sensor;
+}
+
+/* destroy a range sensor. */
+void zRangeSensorDestroy(zRangeSensor *sensor)
+{
+  zFree( sensor->dir );
+  zArrayFree( &sensor->point );
+  zRangeSensorInit( sensor );
+}
+
+typedef struct{
+  zRangeSensor *sensor;
+  zRangeScene *scene;
+  zFrame3D *pose;
+  int tile;   /* the first tile */
+  int stride; /* interval of tiles */
+  int count;  /* number of measured points */
+} zRangeSensorThreadArg;
+
+/* cast rays of tiles assigned to a thread. */
+static void *_zRangeSensorScanThread(void *arg)
+{
+  zRangeSensorThreadArg *a;
+  zVec3D dir, *p;
+  double t;
+  int n, head, tail;
+  register int i;
+
+  a = arg;
+  a->count = 0;
+  n = zRangeSensorRayNum(a->sensor);
+  for( head=a->tile*ZEO_RANGESENSOR_TILE_SIZE; head<n; head+=a->stride*ZEO_RANGESENSOR_TILE_SIZE ){
+    tail = zMin( head + ZEO_RANGESENSOR_TILE_SIZE, n );
+    for( i=head; i<tail; i++ ){
+      p = zArrayElemNC( &a->sensor->point, i );
+      zMulMat3DVec3D( zFrame3DAtt(a->pose), &a->sensor->dir[i], &dir );
+      if( zRangeSceneRayCast( a->scene, zFrame3DPos(a->pose), &dir, a->sensor->rmax, &t ) >= 0 &&
+          t >= a->sensor->rmin ){
+        zVec3DMul( &a->sensor->dir[i], t, p );
+        a->count++;
+      } else
+        zVec3DCreate( p, NAN, NAN, NAN );
+    }
+  }
+  return NULL;
+}
+
+/* scan a scene by a range sensor. */
+int zRangeSensorScan(zRangeSensor *sensor, zRangeScene *scene, zFrame3D *pose, int nthread)
+{
+  zRangeSensorThreadArg *arg;
+  int tilenum, count = 0;
+  register int i;
+
+  tilenum = ( zRangeSensorRayNum(sensor) + ZEO_RANGESENSOR_TILE_SIZE - 1 ) / ZEO_RANGESENSOR_TILE_SIZE;
+  if( nthread > tilenum ) nthread = tilenum;
+  if( nthread < 1 ) nthread = 1;
+  if( !( arg = zAlloc( zRangeSensorThreadArg, nthread ) ) ){
+    ZALLOCERROR();
+    return 0;
+  }
+  for( i=0; i<nthread; i++ ){
+    arg[i].sensor = sensor;
+    arg[i].scene = scene;
+    arg[i].pose = pose;
+    arg[i].tile = i;
+    arg[i].stride = nthread;
+  }
+  zThreadRun( _zRangeSensorScanThread, arg, sizeof(zRangeSensorThreadArg), nthread );
+  for( i=0; i<nthread; i++ )
+    count += arg[i].count;
+  zFree( arg );
+  return count;
+}
@@ -0,0 +1,469 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_sdf - signed distance field.
+ */
+
+#include <zeo/zeo_sdf.h>
+
+/* ********************************************************** */
+/* CLASS: zSDF3D
+ * signed distance field sampled on a grid of blocks
+ * ********************************************************** */
+
+#define _zSDF3DBlockID(s,bi,bj,bk) ( ( (bk)*(s)->bsize[1] + (bj) )*(s)->bsize[0] + (bi) )
+#define _zSDF3DLocalID(i,j,k) \
+  ( ( (k)%ZEO_SDF3D_BLOCK_SIZE*ZEO_SDF3D_BLOCK_SIZE + (j)%ZEO_SDF3D_BLOCK_SIZE )*ZEO_SDF3D_BLOCK_SIZE + (i)%ZEO_SDF3D_BLOCK_SIZE )
+
+/* pointer to the value at a grid point of an allocated block. */
+#define _zSDF3DValPtr(s,b,i,j,k) ( &(s)->val[(s)->block[(b)]*ZEO_SDF3D_BLOCK_VOL+_zSDF3DLocalID(i,j,k)] )
+
+/* initialize a signed distance field. */
+zSDF3D *zSDF3DInit(zSDF3D *sdf)
+{
+  zVec3DZero( &sdf->org );
+  sdf->pitch = 0;
+  sdf->size[0] = sdf->size[1] = sdf->size[2] = 0;
+  sdf->bsize[0] = sdf->bsize[1] = sdf->bsize[2] = 0;
+  sdf->band = ZEO_SDF3D_DENSE;
+  sdf->block = NULL;
+  sdf->val = NULL;
+  sdf->blocknum = 0;
+  return sdf;
+}
+
+/* destroy a signed distance field. */
+void zSDF3DDestroy(zSDF3D *sdf)
+{
+  zFree( sdf->block );
+  zFree( sdf->val );
+  zSDF3DInit( sdf );
+}
+
+/* workspace to build a signed distance field. */
+typedef struct{
+  zSDF3D *sdf;
+  zPH3D *ph;     /* polyhedron of the surface */
+  zPH3DBVH bvh;  /* hierarchy of triangles of the surface */
+  bool *near;    /* flags of blocks whose distances are computed exactly */
+} zSDF3DBuilder;
+
+typedef struct{
+  zSDF3DBuilder *builder;
+  int slab;   /* the first layer of blocks along the z-axis */
+  int stride; /* interval of layers */
+  int *wind;  /* winding numbers of grid points of a layer */
+} zSDF3DThreadArg;
+
+/* range of grid points of a block along an axis. */
+static void _zSDF3DBlockRange(zSDF3D *sdf, int d, int b, int *i0, int *i1)
+{
+  *i0 = b * ZEO_SDF3D_BLOCK_SIZE;
+  *i1 = zMin( *i0 + ZEO_SDF3D_BLOCK_SIZE, sdf->size[d] ) - 1;
+}
+
+/* position of a grid point. */
+static zVec3D *_zSDF3DGridPos(zSDF3D *sdf, double i, double j, double k, zVec3D *p)
+{
+  return zVec3DCreate( p,
+    sdf->org.c.x + sdf->pitch*i, sdf->org.c.y + sdf->pitch*j, sdf->org.c.z + sdf->pitch*k );
+}
+
+/* classify blocks of layers into those near the surface and the others. */
+static void *_zSDF3DClassifyThread(void *arg)
+{
+  zSDF3DThreadArg *a;
+  zSDF3D *sdf;
+  zVec3D c, cp;
+  double r, thr;
+  int i0, i1, j0, j1, k0, k1;
+  register int bi, bj, bk;
+
+  a = arg;
+  sdf = a->builder->sdf;
+  /* a dense grid is computed exactly around the surface, and by sweeping elsewhere */
+  thr = zSDF3DIsSparse(sdf) ? sdf->band : 2 * sdf->pitch;
+  for( bk=a->slab; bk<sdf->bsize[2]; bk+=a->stride ){
+    _zSDF3DBlockRange( sdf, zZ, bk, &k0, &k1 );
+    for( bj=0; bj<sdf->bsize[1]; bj++ ){
+      _zSDF3DBlockRange( sdf, zY, bj, &j0, &j1 );
+      for( bi=0; bi<sdf->bsize[0]; bi++ ){
+        _zSDF3DBlockRange( sdf, zX, bi, &i0, &i1 );
+        _zSDF3DGridPos( sdf, 0.5*(i0+i1), 0.5*(j0+j1), 0.5*(k0+k1), &c );
+        r = 0.5 * sdf->pitch * sqrt( zSqr(i1-i0) + zSqr(j1-j0) + zSqr(k1-k0) );
+        a->builder->near[_zSDF3DBlockID(sdf,bi,bj,bk)] =
+          zPH3DBVHClosest( &a->builder->bvh, &c, &cp, NULL ) <= r + thr;
+      }
+    }
+  }
+  return NULL;
+}
+
+/* orientation of a triangle of the origin and two points on a plane with a consistent tie-breaking rule. */
+static int _zSDF3DOrient(double x1, double y1, double x2, double y2, double *area)
+{
+  *area = y1*x2 - x1*y2;
+  if( *area > 0 ) return 1;
+  if( *area < 0 ) return -1;
+  if( y2 > y1 ) return 1;
+  if( y2 < y1 ) return -1;
+  if( x1 > x2 ) return 1;
+  if( x1 < x2 ) return -1;
+  return 0; /* degenerate */
+}
+
+/* check if a point is inside of a triangle on a plane, and compute barycentric coordinates. */
+static int _zSDF3DPointInTri2D(double x0, double y0, double x[], double y[], double w[])
+{
+  int s0, s1, s2;
+  double sum;
+
+  if( ( s0 = _zSDF3DOrient( x[1]-x0, y[1]-y0, x[2]-x0, y[2]-y0, &w[0] ) ) == 0 ) return 0;
+  if( ( s1 = _zSDF3DOrient( x[2]-x0, y[2]-y0, x[0]-x0, y[0]-y0, &w[1] ) ) != s0 ) return 0;
+  if( ( s2 = _zSDF3DOrient( x[0]-x0, y[0]-y0, x[1]-x0, y[1]-y0, &w[2] ) ) != s0 ) return 0;
+  if( ( sum = w[0] + w[1] + w[2] ) == 0 ) return 0;
+  w[0] /= sum; w[1] /= sum; w[2] /= sum;
+  return s0;
+}
+
+/* count winding numbers of grid points of a layer by crossings of lines along the x-axis and triangles. */
+static void _zSDF3DWind(zSDF3DBuilder *builder, int k0, int k1, int *wind)
+{
+  zSDF3D *sdf;
+  zTri3D *t;
+  double y[3], z[3], w[3], x, ymin, ymax, zmin, zmax;
+  int jmin, jmax, kmin, kmax, i0, s, nx, ny;
+  register int f, i, j, k, l;
+
+  sdf = builder->sdf;
+  nx = sdf->size[0];
+  ny = sdf->size[1];
+  memset( wind, 0, sizeof(int)*nx*ny*(k1-k0+1) );
+  for( f=0; f<zPH3DFaceNum(builder->ph); f++ ){
+    t = zPH3DFace(builder->ph,f);
+    for( l=0; l<3; l++ ){
+      y[l] = ( zTri3DVert(t,l)->c.y - sdf->org.c.y ) / sdf->pitch;
+      z[l] = ( zTri3DVert(t,l)->c.z - sdf->org.c.z ) / sdf->pitch;
+    }
+    zmin = zMin( z[0], zMin( z[1], z[2] ) ); zmax = zMax( z[0], zMax( z[1], z[2] ) );
+    if( ( kmin = zMax( (int)ceil( zmin ), k0 ) ) > ( kmax = zMin( (int)floor( zmax ), k1 ) ) ) continue;
+    ymin = zMin( y[0], zMin( y[1], y[2] ) ); ymax = zMax( y[0], zMax( y[1], y[2] ) );
+    if( ( jmin = zMax( (int)ceil( ymin ), 0 ) ) > ( jmax = zMin( (int)floor( ymax ), ny-1 ) ) ) continue;
+    for( k=kmin; k<=kmax; k++ )
+      for( j=jmin; j<=jmax; j++ ){
+        if( ( s = _zSDF3DPointInTri2D( j, k, y, z, w ) ) == 0 ) continue;
+        x = w[0]*zTri3DVert(t,0)->c.x + w[1]*zTri3DVert(t,1)->c.x + w[2]*zTri3DVert(t,2)->c.x;
+        if( ( i0 = zMax( (int)ceil( ( x - sdf->org.c.x ) / sdf->pitch ), 0 ) ) >= nx ) continue;
+        /* a crossing into the solid from the negative side along the x-axis counts one */
+        wind[((k-k0)*ny+j)*nx+i0] += s;
+      }
+  }
+  for( k=0; k<=k1-k0; k++ )
+    for( j=0; j<ny; j++ )
+      for( i=1; i<nx; i++ )
+        wind[(k*ny+j)*nx+i] += wind[(k*ny+j)*nx+i-1];
+}
+
+/* compute distances of blocks of layers. */
+static void *_zSDF3DComputeThread(void *arg)
+{
+  zSDF3DThreadArg *a;
+  zSDF3D *sdf;
+  zVec3D p, cp;
+  double d;
+  int i0, i1, j0, j1, k0, k1, b, w;
+  register int bi, bj, bk, i, j, k;
+
+  a = arg;
+  sdf = a->builder->sdf;
+  for( bk=a->slab; bk<sdf->bsize[2]; bk+=a->stride ){
+    _zSDF3DBlockRange( sdf, zZ, bk, &k0, &k1 );
+    _zSDF3DWind( a->builder, k0, k1, a->wind );
+    for( bj=0; bj<sdf->bsize[1]; bj++ ){
+      _zSDF3DBlockRange( sdf, zY, bj, &j0, &j1 );
+      for( bi=0; bi<sdf->bsize[0]; bi++ ){
+        _zSDF3DBlockRange( sdf, zX, bi, &i0, &i1 );
+        b = _zSDF3DBlockID(sdf,bi,bj,bk);
+        if( !a->builder->near[b] ){ /* no surface in the block */
+          w = a->wind[(j0*sdf->size[0])+i0];
+          if( zSDF3DIsSparse(sdf) )
+            sdf->block[b] = w != 0 ? ZEO_SDF3D_BLOCK_IN : ZEO_SDF3D_BLOCK_OUT;
+          else
+            for( k=k0; k<=k1; k++ )
+              for( j=j0; j<=j1; j++ )
+                for( i=i0; i<=i1; i++ )
+                  *_zSDF3DValPtr(sdf,b,i,j,k) = w != 0 ? -HUGE_VAL : HUGE_VAL;
+          continue;
+        }
+        for( k=k0; k<=k1; k++ )
+          for( j=j0; j<=j1; j++ )
+            for( i=i0; i<=i1; i++ ){
+              d = zPH3DBVHClosest( &a->builder->bvh, _zSDF3DGridPos( sdf, i, j, k, &p ), &cp, NULL );
+              if( d > sdf->band ) d = sdf->band;
+              *_zSDF3DValPtr(sdf,b,i,j,k) = a->wind[((k-k0)*sdf->size[1]+j)*sdf->size[0]+i] != 0 ? -d : d;
+            }
+      }
+    }
+  }
+  return NULL;
+}
+
+/* update the unsigned distance at a grid point by the Eikonal equation. */
+static double _zSDF3DEikonal(double a[], double h)
+{
+  double x, s, q;
+
+  if( a[0] > a[1] ) zSwap( double, a[0], a[1] );
+  if( a[1] > a[2] ) zSwap( double, a[1], a[2] );
+  if( a[0] > a[1] ) zSwap( double, a[0], a[1] );
+  if( a[0] == HUGE_VAL ) return HUGE_VAL;
+  if( ( x = a[0] + h ) <= a[1] ) return x;
+  x = 0.5 * ( a[0] + a[1] + sqrt( 2*h*h - zSqr(a[0]-a[1]) ) );
+  if( x <= a[2] ) return x;
+  s = a[0] + a[1] + a[2];
+  q = a[0]*a[0] + a[1]*a[1] + a[2]*a[2];
+  return ( s + sqrt( s*s - 3*( q - h*h ) ) ) / 3;
+}
+
+/* absolute value at a grid point of a dense grid. */
+static double _zSDF3DAbsVal(zSDF3D *sdf, int i, int j, int k)
+{
+  return fabs( *_zSDF3DValPtr( sdf,
+    _zSDF3DBlockID(sdf,i/ZEO_SDF3D_BLOCK_SIZE,j/ZEO_SDF3D_BLOCK_SIZE,k/ZEO_SDF3D_BLOCK_SIZE), i, j, k ) );
+}
+
+/* propagate distances to blocks far from the surface by the fast sweeping method. */
+static void _zSDF3DSweep(zSDF3DBuilder *builder)
+{
+  zSDF3D *sdf;
+  double a[3], x, *v;
+  int n[3], di, dj, dk, b;
+  register int s, i, j, k;
+
+  sdf = builder->sdf;
+  n[0] = sdf->size[0]; n[1] = sdf->size[1]; n[2] = sdf->size[2];
+  for( s=0; s<8; s++ ){ /* eight orderings of sweeping */
+    di = s & 1 ? -1 : 1;
+    dj = s & 2 ? -1 : 1;
+    dk = s & 4 ? -1 : 1;
+    for( k=( dk>0 ? 0 : n[2]-1 ); k>=0 && k<n[2]; k+=dk )
+      for( j=( dj>0 ? 0 : n[1]-1 ); j>=0 && j<n[1]; j+=dj )
+        for( i=( di>0 ? 0 : n[0]-1 ); i>=0 && i<n[0]; i+=di ){
+          b = _zSDF3DBlockID(sdf,i/ZEO_SDF3D_BLOCK_SIZE,j/ZEO_SDF3D_BLOCK_SIZE,k/ZEO_SDF3D_BLOCK_SIZE);
+          if( builder->near[b] ) continue;
+          a[0] = zMin( i > 0 ? _zSDF3DAbsVal(sdf,i-1,j,k) : HUGE_VAL, i < n[0]-1 ? _zSDF3DAbsVal(sdf,i+1,j,k) : HUGE_VAL );
+          a[1] = zMin( j > 0 ? _zSDF3DAbsVal(sdf,i,j-1,k) : HUGE_VAL, j < n[1]-1 ? _zSDF3DAbsVal(sdf,i,j+1,k) : HUGE_VAL );
+          a[2] = zMin( k > 0 ? _zSDF3DAbsVal(sdf,i,j,k-1) : HUGE_VAL, k < n[2]-1 ? _zSDF3DAbsVal(sdf,i,j,k+1) : HUGE_VAL );
+          v = _zSDF3DValPtr(sdf,b,i,j,k);
+          if( ( x = _zSDF3DEikonal( a, sdf->pitch ) ) < fabs( *v ) )
+            *v = *v < 0 ? -x : x;
+        }
+  }
+}
+
+/* create a signed distance field of the surface of a polyhedron. */
+static zSDF3D *_zSDF3DCreate(zSDF3D *sdf, zPH3D *ph, double pitch, double margin, double band, int nthread)
+{
+  zSDF3DBuilder builder;
+  zSDF3DThreadArg *arg = NULL;
+  zVec3D min, max;
+  int n;
+  register int i, d;
+
+  zSDF3DInit( sdf );
+  if( pitch <= 0 || band <= 0 ){
+    ZRUNERROR( ZEO_ERR_SDF_INVPITCH );
+    return NULL;
+  }
+  builder.sdf = sdf;
+  builder.ph = ph;
+  builder.near = NULL;
+  if( !zPH3DBVHCreate( zPH3DBVHInit( &builder.bvh ), ph, nthread ) ) return NULL;
+  /* grid */
+  zVec3DCopy( zPH3DVert(ph,0), &min );
+  zVec3DCopy( zPH3DVert(ph,0), &max );
+  for( i=1; i<zPH3DVertNum(ph); i++ )
+    for( d=zX; d<=zZ; d++ ){
+      if( zPH3DVert(ph,i)->e[d] < min.e[d] ) min.e[d] = zPH3DVert(ph,i)->e[d];
+      if( zPH3DVert(ph,i)->e[d] > max.e[d] ) max.e[d] = zPH3DVert(ph,i)->e[d];
+    }
+  if( margin < 0 ) margin = 0;
+  sdf->pitch = pitch;
+  sdf->band = band;
+  for( d=zX; d<=zZ; d++ ){
+    sdf->org.e[d] = min.e[d] - margin;
+    sdf->size[d] = zMax( (int)ceil( ( max.e[d] - min.e[d] + 2*margin ) / pitch ) + 1, 2 );
+    sdf->bsize[d] = ( sdf->size[d] + ZEO_SDF3D_BLOCK_SIZE - 1 ) / ZEO_SDF3D_BLOCK_SIZE;
+  }
+  n = sdf->bsize[0] * sdf->bsize[1] * sdf->bsize[2];
+  if( nthread > sdf->bsize[2] ) nthread = sdf->bsize[2];
+  if( nthread < 1 ) nthread = 1;
+  sdf->block = zAlloc( int, n );
+  builder.near = zAlloc( bool, n );
+  if( !sdf->block || !builder.near || !( arg = zAlloc( zSDF3DThreadArg, nthread ) ) ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  for( i=0; i<nthread; i++ ){
+    arg[i].builder = &builder;
+    arg[i].slab = i;
+    arg[i].stride = nthread;
+    arg[i].wind = NULL;
+  }
+  zThreadRun( _zSDF3DClassifyThread, arg, sizeof(zSDF3DThreadArg), nthread );
+  /* allocate blocks */
+  for( sdf->blocknum=0, i=0; i<n; i++ )
+    sdf->block[i] = builder.near[i] || !zSDF3DIsSparse(sdf) ? sdf->blocknum++ : ZEO_SDF3D_BLOCK_OUT;
+  if( sdf->blocknum > 0 && !( sdf->val = zAlloc( double, sdf->blocknum*ZEO_SDF3D_BLOCK_VOL ) ) ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  for( i=0; i<nthread; i++ )
+    if( !( arg[i].wind = zAlloc( int, sdf->size[0]*sdf->size[1]*ZEO_SDF3D_BLOCK_SIZE ) ) ){
+      ZALLOCERROR();
+      goto FAILURE;
+    }
+  zThreadRun( _zSDF3DComputeThread, arg, sizeof(zSDF3DThreadArg), nthread );
+  if( !zSDF3DIsSparse(sdf) ) _zSDF3DSweep( &builder );
+  goto TERMINATE;
+
+ FAILURE:
+  zSDF3DDestroy( sdf );
+  sdf = NULL;
+ TERMINATE:
+  if( arg )
+    for( i=0; i<nthread; i++ ) zFree( arg[i].wind );
+  zFree( arg );
+  zFree( builder.near );
+  zPH3DBVHDestroy( &builder.bvh );
+  return sdf;
+}
+
+/* create a signed distance field of a polyhedron. */
+zSDF3D *zSDF3DCreatePH(zSDF3D *sdf, zPH3D *ph, double pitch, double margin, double band, int nthread)
+{
+  return _zSDF3DCreate( sdf, ph, pitch, margin, band, nthread );
+}
+
+/* create a signed distance field of a shape. */
+zSDF3D *zSDF3DCreateShape(zSDF3D *sdf, zShape3D *shape, double pitch, double margin, double band, int nthread)
+{
+  zPH3D ph;
+
+  if( shape->com == &zeo_shape3d_ph_com )
+    return _zSDF3DCreate( sdf, zShape3DPH(shape), pitch, margin, band, nthread );
+  zPH3DInit( &ph );
+  if( !shape->com->_toph( shape->body, &ph ) ){
+    zSDF3DInit( sdf );
+    return NULL;
+  }
+  sdf = _zSDF3DCreate( sdf, &ph, pitch, margin, band, nthread );
+  zPH3DDestroy( &ph );
+  return sdf;
+}
+
+/* create a signed distance field of multiple shapes. */
+zSDF3D *zSDF3DCreateMShape(zSDF3D *sdf, zMShape3D *ms, double pitch, double margin, double band, int nthread)
+{
+  zPH3D *ph, *src, merged;
+  int vn = 0, fn = 0;
+  register int i, j;
+
+  zSDF3DInit( sdf );
+  if( zMShape3DShapeNum(ms) == 0 ){
+    ZRUNERROR( ZEO_ERR_NOFACE );
+    return NULL;
+  }
+  if( !( ph = zAlloc( zPH3D, zMShape3DShapeNum(ms) ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ) zPH3DInit( &ph[i] );
+  zPH3DInit( &merged );
+  /* merge surfaces of all shapes into a polyhedron */
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    if( zMShape3DShape(ms,i)->com != &zeo_shape3d_ph_com &&
+        !zMShape3DShape(ms,i)->com->_toph( zMShape3DShape(ms,i)->body, &ph[i] ) ) goto TERMINATE;
+    src = zMShape3DShape(ms,i)->com == &zeo_shape3d_ph_com ? zShape3DPH(zMShape3DShape(ms,i)) : &ph[i];
+    vn += zPH3DVertNum(src);
+    fn += zPH3DFaceNum(src);
+  }
+  if( !zPH3DAlloc( &merged, vn, fn ) ) goto TERMINATE;
+  for( vn=0, fn=0, i=0; i<zMShape3DShapeNum(ms); i++ ){
+    src = zMShape3DShape(ms,i)->com == &zeo_shape3d_ph_com ? zShape3DPH(zMShape3DShape(ms,i)) : &ph[i];
+    for( j=0; j<zPH3DVertNum(src); j++ )
+      zVec3DCopy( zPH3DVert(src,j), zPH3DVert(&merged,vn+j) );
+    for( j=0; j<zPH3DFaceNum(src); j++ )
+      zTri3DCreate( zPH3DFace(&merged,fn+j),
+        zPH3DVert(&merged,vn+(zPH3DFaceVert(src,j,0)-zPH3DVertBuf(src))),
+        zPH3DVert(&merged,vn+(zPH3DFaceVert(src,j,1)-zPH3DVertBuf(src))),
+        zPH3DVert(&merged,vn+(zPH3DFaceVert(src,j,2)-zPH3DVertBuf(src))) );
+    vn += zPH3DVertNum(src);
+    fn += zPH3DFaceNum(src);
+  }
+  sdf = _zSDF3DCreate( sdf, &merged, pitch, margin, band, nthread );
+
+ TERMINATE:
+  if( zPH3DFaceNum(&merged) == 0 ) sdf = NULL;
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ) zPH3DDestroy( &ph[i] );
+  zFree( ph );
+  zPH3DDestroy( &merged );
+  return sdf;
+}
+
+/* signed distance at a grid point. */
+double zSDF3DGridVal(zSDF3D *sdf, int i, int j, int k)
+{
+  int b;
+
+  b = _zSDF3DBlockID(sdf,i/ZEO_SDF3D_BLOCK_SIZE,j/ZEO_SDF3D_BLOCK_SIZE,k/ZEO_SDF3D_BLOCK_SIZE);
+  if( sdf->block[b] >= 0 ) return *_zSDF3DValPtr(sdf,b,i,j,k);
+  return sdf->block[b] == ZEO_SDF3D_BLOCK_IN ? -sdf->band : sdf->band;
+}
+
+/* signed distance and its gradient at a point by the trilinear interpolation. */
+double zSDF3DGrad(zSDF3D *sdf, zVec3D *p, zVec3D *grad)
+{
+  zVec3D e;
+  double x[3], f[3], v[8], d, out;
+  int n[3];
+  register int l;
+
+  for( l=zX; l<=zZ; l++ ){
+    x[l] = ( p->e[l] - sdf->org.e[l] ) / sdf->pitch;
+    e.e[l] = 0; /* displacement out of the grid */
+    if( x[l] < 0 ){
+      e.e[l] = x[l] * sdf->pitch;
+      x[l] = 0;
+    } else
+    if( x[l] > sdf->size[l] - 1 ){
+      e.e[l] = ( x[l] - sdf->size[l] + 1 ) * sdf->pitch;
+      x[l] = sdf->size[l] - 1;
+    }
+    if( ( n[l] = (int)x[l] ) > sdf->size[l] - 2 ) n[l] = sdf->size[l] - 2;
+    f[l] = x[l] - n[l];
+  }
+  for( l=0; l<8; l++ )
+    v[l] = zSDF3DGridVal( sdf, n[0]+(l&1), n[1]+(l>>1&1), n[2]+(l>>2) );
+  d = (1-f[2])*( (1-f[1])*( (1-f[0])*v[0] + f[0]*v[1] ) + f[1]*( (1-f[0])*v[2] + f[0]*v[3] ) )
+    +    f[2] *( (1-f[1])*( (1-f[0])*v[4] + f[0]*v[5] ) + f[1]*( (1-f[0])*v[6] + f[0]*v[7] ) );
+  out = zVec3DNorm( &e );
+  if( grad ){
+    grad->c.x = ( (1-f[2])*( (1-f[1])*( v[1] - v[0] ) + f[1]*( v[3] - v[2] ) )
+                +    f[2] *( (1-f[1])*( v[5] - v[4] ) + f[1]*( v[7] - v[6] ) ) ) / sdf->pitch;
+    grad->c.y = ( (1-f[2])*( (1-f[0])*( v[2] - v[0] ) + f[0]*( v[3] - v[1] ) )
+                +    f[2] *( (1-f[0])*( v[6] - v[4] ) + f[0]*( v[7] - v[5] ) ) ) / sdf->pitch;
+    grad->c.z = ( (1-f[1])*( (1-f[0])*( v[4] - v[0] ) + f[0]*( v[5] - v[1] ) )
+                +    f[1] *( (1-f[0])*( v[6] - v[2] ) + f[0]*( v[7] - v[3] ) ) ) / sdf->pitch;
+    if( out > 0 ) /* the distance grows along axes on which the point is out of the grid */
+      for( l=zX; l<=zZ; l++ )
+        if( e.e[l] != 0 ) grad->e[l] = e.e[l] / out;
+  }
+  return d + out;
+}
+
+/* signed distance at a point by the trilinear interpolation. */
+double zSDF3DDist(zSDF3D *sdf, zVec3D *p)
+{
+  return zSDF3DGrad( sdf, p, NULL );
+}
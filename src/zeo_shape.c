@@ -102,6 +102,23 @@ bool zShape3DPointIsInside(zShape3D *shape, zVec3D *p, bool rim)
   return shape->com->_pointisinside( shape->body, p, rim );
 }
 
+/* support point of a 3D shape. */
+zVec3D *zShape3DSupportMap(zShape3D *shape, zVec3D *v, zVec3D *sp)
+{
+  return shape->com->_support( shape->body, v, sp );
+}
+
+/* intersection of a ray and a 3D shape. */
+bool zShape3DRayCast(zShape3D *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *hit, zVec3D *norm)
+{
+  double _t;
+
+  if( !t ) t = &_t;
+  if( !shape->com->_raycast( shape->body, org, dir, tmax, t, norm ) ) return false;
+  if( hit ) zVec3DCat( org, *t, dir, hit );
+  return true;
+}
+
 /* convert a shape to a polyhedron. */
 zShape3D *zShape3DToPH(zShape3D *shape)
 {
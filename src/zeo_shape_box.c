@@ -127,6 +127,50 @@ bool zBox3DPointIsInside(zBox3D *box, zVec3D *p, bool rim)
   return true;
 }
 
+/* support point of a box with respect to a direction vector. */
+zVec3D *zBox3DSupportMap(zBox3D *box, zVec3D *v, zVec3D *sp)
+{
+  register zDir d;
+
+  zVec3DCopy( zBox3DCenter(box), sp );
+  for( d=zX; d<=zZ; d++ )
+    zVec3DCatDRC( sp, zVec3DInnerProd( v, zBox3DAxis(box,d) ) >= 0 ?
+      0.5*zBox3DDia(box,d) : -0.5*zBox3DDia(box,d), zBox3DAxis(box,d) );
+  return sp;
+}
+
+/* intersection of a ray and a box (slab method in the frame of the box). */
+bool zBox3DRayCast(zBox3D *box, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm)
+{
+  zVec3D o, d;
+  double tin = -HUGE_VAL, tout = HUGE_VAL, t1, t2, h, sgn, sgnin = 0, sgnout = 0;
+  int ain = -1, aout = -1;
+  register zDir i;
+
+  zXform3DInv( &box->f, org, &o );
+  zMulMat3DTVec3D( zFrame3DAtt(&box->f), dir, &d );
+  for( i=zX; i<=zZ; i++ ){
+    h = 0.5 * zBox3DDia(box,i);
+    if( zIsTiny( d.e[i] ) ){
+      if( fabs( o.e[i] ) > h ) return false;
+      continue;
+    }
+    t1 = ( -h - o.e[i] ) / d.e[i];
+    t2 = (  h - o.e[i] ) / d.e[i];
+    if( ( sgn = d.e[i] > 0 ? -1 : 1 ) > 0 ) zSwap( double, t1, t2 );
+    if( t1 > tin ){ tin = t1; ain = i; sgnin = sgn; }
+    if( t2 < tout ){ tout = t2; aout = i; sgnout = -sgn; }
+    if( tin > tout ) return false;
+  }
+  if( tin < 0 ){ /* from inside */
+    tin = tout; ain = aout; sgnin = sgnout;
+  }
+  if( ain < 0 || tin < 0 || tin > tmax ) return false;
+  if( t ) *t = tin;
+  if( norm ) zVec3DMul( zBox3DAxis(box,ain), sgnin, norm );
+  return true;
+}
+
 /* volume of a 3D box. */
 double zBox3DVolume(zBox3D *box)
 {
@@ -293,6 +337,10 @@ static double _zShape3DBoxPointDist(void *shape, zVec3D *p){
   return zBox3DPointDist( shape, p ); }
 static bool _zShape3DBoxPointIsInside(void *shape, zVec3D *p, bool rim){
   return zBox3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DBoxSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  return zBox3DSupportMap( shape, v, sp ); }
+static bool _zShape3DBoxRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return zBox3DRayCast( shape, org, dir, tmax, t, norm ); }
 static double _zShape3DBoxVolume(void *shape){
   return zBox3DVolume( shape ); }
 static zVec3D *_zShape3DBoxBarycenter(void *shape, zVec3D *c){
@@ -324,6 +372,8 @@ zShape3DCom zeo_shape3d_box_com = {
   _zShape3DBoxClosest,
   _zShape3DBoxPointDist,
   _zShape3DBoxPointIsInside,
+  _zShape3DBoxSupportMap,
+  _zShape3DBoxRayCast,
   _zShape3DBoxVolume,
   _zShape3DBoxBarycenter,
   _zShape3DBoxInertia,
@@ -159,6 +159,85 @@ bool zCone3DPointIsInside(zCone3D *cone, zVec3D *p, bool rim)
   return -d <= l + ( rim ? zTOL : 0 ) ? true : false;
 }
 
+/* support point of a cone with respect to a direction vector. */
+zVec3D *zCone3DSupportMap(zCone3D *cone, zVec3D *v, zVec3D *sp)
+{
+  zVec3D axis, vr;
+  double l;
+
+  zCone3DAxis( cone, &axis );
+  zVec3DNormalizeDRC( &axis );
+  zVec3DCat( v, -zVec3DInnerProd( v, &axis ), &axis, &vr );
+  zVec3DCopy( zCone3DCenter(cone), sp );
+  if( !zIsTiny( ( l = zVec3DNorm( &vr ) ) ) )
+    zVec3DCatDRC( sp, zCone3DRadius(cone)/l, &vr );
+  if( zVec3DInnerProd( v, zCone3DVert(cone) ) > zVec3DInnerProd( v, sp ) )
+    zVec3DCopy( zCone3DVert(cone), sp );
+  return sp;
+}
+
+/* intersection of a ray and a cone. */
+bool zCone3DRayCast(zCone3D *cone, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm)
+{
+  zVec3D axis, o, d, p;
+  double h, k2, os, ds, a, b, c, disc, tc[2], s, tin = HUGE_VAL, tout = -HUGE_VAL;
+  int n = 0, sidein = 0, sideout = 0; /* 0: side, -1: base */
+  register int i;
+
+  zCone3DAxis( cone, &axis );
+  if( zIsTiny( ( h = zVec3DNorm( &axis ) ) ) || zVec3DIsTiny( dir ) ) return false;
+  zVec3DDivDRC( &axis, h );
+  k2 = zSqr( zCone3DRadius(cone) / h );
+  zVec3DSub( org, zCone3DCenter(cone), &o );
+  os = zVec3DInnerProd( &o, &axis );
+  ds = zVec3DInnerProd( dir, &axis );
+  zVec3DCatDRC( &o, -os, &axis );
+  zVec3DCat( dir, -ds, &axis, &d );
+  /* side surface: |radial component|^2 = k2 (h-s)^2 on the nappe of 0 <= s <= h */
+  a = zVec3DSqrNorm( &d ) - k2*ds*ds;
+  b = zVec3DInnerProd( &o, &d ) + k2*( h - os )*ds;
+  c = zVec3DSqrNorm( &o ) - k2*zSqr( h - os );
+  if( zIsTiny( a ) ){
+    if( !zIsTiny( b ) ) tc[n++] = -0.5 * c / b;
+  } else
+  if( ( disc = b*b - a*c ) >= 0 ){
+    disc = sqrt( disc );
+    tc[n++] = ( -b - disc ) / a;
+    tc[n++] = ( -b + disc ) / a;
+  }
+  /* the ray passes through a convex solid between the nearest and farthest crossings of the surface */
+  for( i=0; i<n; i++ ){
+    if( ( s = os + tc[i]*ds ) < -zTOL || s > h + zTOL ) continue;
+    if( tc[i] < tin ){ tin = tc[i]; sidein = 0; }
+    if( tc[i] > tout ){ tout = tc[i]; sideout = 0; }
+  }
+  /* base */
+  if( !zIsTiny( ds ) ){
+    tc[0] = -os / ds;
+    zVec3DCat( &o, tc[0], &d, &p );
+    if( zVec3DSqrNorm( &p ) <= zSqr( zCone3DRadius(cone) ) + zTOL ){
+      if( tc[0] < tin ){ tin = tc[0]; sidein = -1; }
+      if( tc[0] > tout ){ tout = tc[0]; sideout = -1; }
+    }
+  }
+  if( tin > tout ) return false;
+  if( tin < 0 ){ /* from inside */
+    tin = tout; sidein = sideout;
+  }
+  if( tin < 0 || tin > tmax ) return false;
+  if( t ) *t = tin;
+  if( norm ){
+    if( sidein == 0 ){ /* gradient of the implicit function */
+      zVec3DCat( &o, tin, &d, norm );
+      zVec3DCatDRC( norm, k2*( h - os - tin*ds ), &axis );
+      if( zVec3DIsTiny( norm ) ) zVec3DCopy( &axis, norm ); /* at the vertex */
+      zVec3DNormalizeDRC( norm );
+    } else
+      zVec3DRev( &axis, norm );
+  }
+  return true;
+}
+
 /* height of a 3D cone. */
 double zCone3DHeight(zCone3D *cone)
 {
@@ -300,6 +379,10 @@ static double _zShape3DConePointDist(void *shape, zVec3D *p){
   return zCone3DPointDist( shape, p ); }
 static bool _zShape3DConePointIsInside(void *shape, zVec3D *p, bool rim){
   return zCone3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DConeSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  return zCone3DSupportMap( shape, v, sp ); }
+static bool _zShape3DConeRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return zCone3DRayCast( shape, org, dir, tmax, t, norm ); }
 static double _zShape3DConeVolume(void *shape){
   return zCone3DVolume( shape ); }
 static zVec3D *_zShape3DConeBarycenter(void *shape, zVec3D *c){
@@ -331,6 +414,8 @@ zShape3DCom zeo_shape3d_cone_com = {
   _zShape3DConeClosest,
   _zShape3DConePointDist,
   _zShape3DConePointIsInside,
+  _zShape3DConeSupportMap,
+  _zShape3DConeRayCast,
   _zShape3DConeVolume,
   _zShape3DConeBarycenter,
   _zShape3DConeInertia,
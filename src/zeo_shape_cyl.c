@@ -111,7 +111,7 @@ double zCyl3DClosest(zCyl3D *cyl, zVec3D *p, zVec3D *cp)
     c = zCyl3DCenter(cyl,0);
 
   zVec3DCat( p, -d, &axis, cp );
-  if( r <= zCyl3DRadius(cyl) ) return -d;
+  if( r <= zCyl3DRadius(cyl) ) return fabs( d );
   zVec3DSub( cp, c, &cr );
   zVec3DCat( c, zCyl3DRadius(cyl)/r, &cr, cp );
   return sqrt( zSqr( r - zCyl3DRadius(cyl) ) + zSqr(d) );
@@ -128,7 +128,7 @@ double zCyl3DPointDist(zCyl3D *cyl, zVec3D *p)
     return r <= zCyl3DRadius(cyl) ? 0 : r - zCyl3DRadius(cyl);
   if( d > l ) d -= l;
   return r <= zCyl3DRadius(cyl) ?
-    -d : sqrt( zSqr( r - zCyl3DRadius(cyl) ) + zSqr(d) );
+    fabs( d ) : sqrt( zSqr( r - zCyl3DRadius(cyl) ) + zSqr(d) );
 }
 
 /* check if a point is inside of a cylinder. */
@@ -142,6 +142,75 @@ bool zCyl3DPointIsInside(zCyl3D *cyl, zVec3D *p, bool rim)
   return d >= ( rim ? -zTOL : 0 ) && d <= ( rim ? l+zTOL : l ) ? true : false;
 }
 
+/* support point of a cylinder with respect to a direction vector. */
+zVec3D *zCyl3DSupportMap(zCyl3D *cyl, zVec3D *v, zVec3D *sp)
+{
+  zVec3D axis, vr;
+  double d, l;
+
+  zCyl3DAxis( cyl, &axis );
+  zVec3DNormalizeDRC( &axis );
+  d = zVec3DInnerProd( v, &axis );
+  zVec3DCopy( zCyl3DCenter(cyl,d>=0?1:0), sp );
+  zVec3DCat( v, -d, &axis, &vr );
+  if( !zIsTiny( ( l = zVec3DNorm( &vr ) ) ) )
+    zVec3DCatDRC( sp, zCyl3DRadius(cyl)/l, &vr );
+  return sp;
+}
+
+/* intersection of a ray and a cylinder (the side surface clipped by the slab between the bases). */
+bool zCyl3DRayCast(zCyl3D *cyl, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm)
+{
+  zVec3D axis, o, d;
+  double h, os, ds, a, b, c, disc, t1, t2, tin = -HUGE_VAL, tout = HUGE_VAL;
+  int sidein = 0, sideout = 0; /* 0: side, -1: bottom, 1: top */
+
+  zCyl3DAxis( cyl, &axis );
+  if( zIsTiny( ( h = zVec3DNorm( &axis ) ) ) || zVec3DIsTiny( dir ) ) return false;
+  zVec3DDivDRC( &axis, h );
+  zVec3DSub( org, zCyl3DCenter(cyl,0), &o );
+  os = zVec3DInnerProd( &o, &axis );
+  ds = zVec3DInnerProd( dir, &axis );
+  zVec3DCatDRC( &o, -os, &axis );
+  zVec3DCat( dir, -ds, &axis, &d );
+  /* slab between the bases */
+  if( zIsTiny( ds ) ){
+    if( os < 0 || os > h ) return false;
+  } else
+  if( ds > 0 ){
+    tin = -os / ds; sidein = -1;
+    tout = ( h - os ) / ds; sideout = 1;
+  } else{
+    tin = ( h - os ) / ds; sidein = 1;
+    tout = -os / ds; sideout = -1;
+  }
+  /* side surface */
+  c = zVec3DSqrNorm( &o ) - zSqr( zCyl3DRadius(cyl) );
+  if( zIsTiny( ( a = zVec3DSqrNorm( &d ) ) ) ){
+    if( c > 0 ) return false;
+  } else{
+    b = zVec3DInnerProd( &o, &d );
+    if( ( disc = b*b - a*c ) < 0 ) return false;
+    disc = sqrt( disc );
+    if( ( t1 = ( -b - disc ) / a ) > tin ){ tin = t1; sidein = 0; }
+    if( ( t2 = ( -b + disc ) / a ) < tout ){ tout = t2; sideout = 0; }
+  }
+  if( tin > tout ) return false;
+  if( tin < 0 ){ /* from inside */
+    tin = tout; sidein = sideout;
+  }
+  if( tin < 0 || tin > tmax ) return false;
+  if( t ) *t = tin;
+  if( norm ){
+    if( sidein == 0 ){
+      zVec3DCat( &o, tin, &d, norm );
+      zVec3DNormalizeDRC( norm );
+    } else
+      zVec3DMul( &axis, sidein, norm );
+  }
+  return true;
+}
+
 /* height of a 3D cylinder. */
 double zCyl3DHeight(zCyl3D *cyl)
 {
@@ -283,6 +352,10 @@ static double _zShape3DCylPointDist(void *shape, zVec3D *p){
   return zCyl3DPointDist( shape, p ); }
 static bool _zShape3DCylPointIsInside(void *shape, zVec3D *p, bool rim){
   return zCyl3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DCylSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  return zCyl3DSupportMap( shape, v, sp ); }
+static bool _zShape3DCylRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return zCyl3DRayCast( shape, org, dir, tmax, t, norm ); }
 static double _zShape3DCylVolume(void *shape){
   return zCyl3DVolume( shape ); }
 static zVec3D *_zShape3DCylBarycenter(void *shape, zVec3D *c){
@@ -314,6 +387,8 @@ zShape3DCom zeo_shape3d_cyl_com = {
   _zShape3DCylClosest,
   _zShape3DCylPointDist,
   _zShape3DCylPointIsInside,
+  _zShape3DCylSupportMap,
+  _zShape3DCylRayCast,
   _zShape3DCylVolume,
   _zShape3DCylBarycenter,
   _zShape3DCylInertia,
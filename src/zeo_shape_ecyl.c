@@ -179,7 +179,91 @@ double zECyl3DPointDist(zECyl3D *cyl, zVec3D *p)
 /* check if a point is inside of an elliptic cylinder. */
 bool zECyl3DPointIsInside(zECyl3D *cyl, zVec3D *p, bool rim)
 {
-  return zECyl3DPointDist( cyl, p ) < ( rim ? zTOL : 0 ) ? true : false;
+  zVec3D axis, v;
+  double l, d, tol;
+
+  tol = rim ? zTOL : 0;
+  zECyl3DAxis( cyl, &axis );
+  l = zVec3DNormalizeDRC( &axis );
+  zVec3DSub( p, zECyl3DCenter(cyl,0), &v );
+  if( ( d = zVec3DInnerProd( &v, &axis ) ) < -tol || d > l + tol ) return false;
+  return zSqr( zVec3DInnerProd( &v, zECyl3DRadVec(cyl,0) ) / zECyl3DRadius(cyl,0) )
+       + zSqr( zVec3DInnerProd( &v, zECyl3DRadVec(cyl,1) ) / zECyl3DRadius(cyl,1) ) < 1 + tol ? true : false;
+}
+
+/* support point of an elliptic cylinder with respect to a direction vector. */
+zVec3D *zECyl3DSupportMap(zECyl3D *cyl, zVec3D *v, zVec3D *sp)
+{
+  zVec3D axis;
+  double d0, d1, l;
+
+  zECyl3DAxis( cyl, &axis );
+  zVec3DCopy( zECyl3DCenter(cyl,zVec3DInnerProd(v,&axis)>=0?1:0), sp );
+  d0 = zECyl3DRadius(cyl,0) * zVec3DInnerProd( v, zECyl3DRadVec(cyl,0) );
+  d1 = zECyl3DRadius(cyl,1) * zVec3DInnerProd( v, zECyl3DRadVec(cyl,1) );
+  if( !zIsTiny( ( l = sqrt( d0*d0 + d1*d1 ) ) ) ){
+    zVec3DCatDRC( sp, zECyl3DRadius(cyl,0)*d0/l, zECyl3DRadVec(cyl,0) );
+    zVec3DCatDRC( sp, zECyl3DRadius(cyl,1)*d1/l, zECyl3DRadVec(cyl,1) );
+  }
+  return sp;
+}
+
+/* intersection of a ray and an elliptic cylinder (a circular cylinder in the scaled radial coordinates). */
+bool zECyl3DRayCast(zECyl3D *cyl, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm)
+{
+  zVec3D axis, v;
+  double h, os, ds, o[2], d[2], a, b, c, disc, t1, t2, tin = -HUGE_VAL, tout = HUGE_VAL;
+  int sidein = 0, sideout = 0; /* 0: side, -1: bottom, 1: top */
+  register int i;
+
+  zECyl3DAxis( cyl, &axis );
+  if( zIsTiny( ( h = zVec3DNorm( &axis ) ) ) || zVec3DIsTiny( dir ) ) return false;
+  zVec3DDivDRC( &axis, h );
+  zVec3DSub( org, zECyl3DCenter(cyl,0), &v );
+  os = zVec3DInnerProd( &v, &axis );
+  ds = zVec3DInnerProd( dir, &axis );
+  for( i=0; i<2; i++ ){
+    o[i] = zVec3DInnerProd( &v, zECyl3DRadVec(cyl,i) ) / zECyl3DRadius(cyl,i);
+    d[i] = zVec3DInnerProd( dir, zECyl3DRadVec(cyl,i) ) / zECyl3DRadius(cyl,i);
+  }
+  /* slab between the bases */
+  if( zIsTiny( ds ) ){
+    if( os < 0 || os > h ) return false;
+  } else
+  if( ds > 0 ){
+    tin = -os / ds; sidein = -1;
+    tout = ( h - os ) / ds; sideout = 1;
+  } else{
+    tin = ( h - os ) / ds; sidein = 1;
+    tout = -os / ds; sideout = -1;
+  }
+  /* side surface */
+  c = o[0]*o[0] + o[1]*o[1] - 1;
+  if( zIsTiny( ( a = d[0]*d[0] + d[1]*d[1] ) ) ){
+    if( c > 0 ) return false;
+  } else{
+    b = o[0]*d[0] + o[1]*d[1];
+    if( ( disc = b*b - a*c ) < 0 ) return false;
+    disc = sqrt( disc );
+    if( ( t1 = ( -b - disc ) / a ) > tin ){ tin = t1; sidein = 0; }
+    if( ( t2 = ( -b + disc ) / a ) < tout ){ tout = t2; sideout = 0; }
+  }
+  if( tin > tout ) return false;
+  if( tin < 0 ){ /* from inside */
+    tin = tout; sidein = sideout;
+  }
+  if( tin < 0 || tin > tmax ) return false;
+  if( t ) *t = tin;
+  if( norm ){
+    if( sidein == 0 ){ /* gradient of the implicit function */
+      zVec3DZero( norm );
+      for( i=0; i<2; i++ )
+        zVec3DCatDRC( norm, ( o[i] + tin*d[i] ) / zECyl3DRadius(cyl,i), zECyl3DRadVec(cyl,i) );
+      zVec3DNormalizeDRC( norm );
+    } else
+      zVec3DMul( &axis, sidein, norm );
+  }
+  return true;
 }
 
 /* height of a 3D elliptic cylinder. */
@@ -327,6 +411,10 @@ static double _zShape3DECylPointDist(void *shape, zVec3D *p){
   return zECyl3DPointDist( shape, p ); }
 static bool _zShape3DECylPointIsInside(void *shape, zVec3D *p, bool rim){
   return zECyl3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DECylSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  return zECyl3DSupportMap( shape, v, sp ); }
+static bool _zShape3DECylRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return zECyl3DRayCast( shape, org, dir, tmax, t, norm ); }
 static double _zShape3DECylVolume(void *shape){
   return zECyl3DVolume( shape ); }
 static zVec3D *_zShape3DECylBarycenter(void *shape, zVec3D *c){
@@ -358,6 +446,8 @@ zShape3DCom zeo_shape3d_ecyl_com = {
   _zShape3DECylClosest,
   _zShape3DECylPointDist,
   _zShape3DECylPointIsInside,
+  _zShape3DECylSupportMap,
+  _zShape3DECylRayCast,
   _zShape3DECylVolume,
   _zShape3DECylBarycenter,
   _zShape3DECylInertia,
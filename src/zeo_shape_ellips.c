@@ -91,41 +91,38 @@ zEllips3D *zEllips3DXformInv(zEllips3D *src, zFrame3D *f, zEllips3D *dest)
   return dest;
 }
 
-/* the closest point from a 3D point to an aligned 3D ellipsoid. */
+/* the closest point from a 3D point outside of an aligned 3D ellipsoid.
+ * the Lagrange multiplier l of the closest point v_i/(1+l/r_i^2) is the root of
+ * G(l) = sum_i ( r_i v_i / (r_i^2 + l) )^2 - 1, which is convex and decreasing on
+ * l >= 0 with G(0) > 0, so that it is bracketed in [0, l1] and found by Newton's
+ * method safeguarded by bisection without any allocation. */
 static zVec3D *_zEllips3DClosest(double rx, double ry, double rz, zVec3D *v, zVec3D *cp)
 {
-  double a, b, c, p, q, r, p2, q2, r2, pqr, l;
-  zPex pex;
-  zCVec ans;
-  int i;
-
-  a = zSqr( v->e[zX] / rx );
-  b = zSqr( v->e[zY] / ry );
-  c = zSqr( v->e[zZ] / rz );
-  p = rx * rx; p2 = p * p;
-  q = ry * ry; q2 = q * q;
-  r = rz * rz; r2 = r * r; pqr = p * q * r;
-  pex = zPexAlloc( 6 );
-  ans = zCVecAlloc( 6 );
-  if( !pex || !ans ) return NULL;
-  zPexSetCoeff( pex, 6, 1 );
-  zPexSetCoeff( pex, 5, 2*(p+q+r) );
-  zPexSetCoeff( pex, 4, (1-a)*p2 + (1-c)*r2 + (1-b)*q2 + 4*(p*q+q*r+r*p) );
-  zPexSetCoeff( pex, 3, 2*(1-a)*(q+r)*p2 + 2*(1-b)*(r+p)*q2 + 2*(1-c)*(p+q)*r2 + 8*p*q*r );
-  zPexSetCoeff( pex, 2, (1-b-a)*p2*q2 + (1-a-c)*p2*r2 + (1-c-b)*q2*r2 + 4*pqr*( (1-a)*p + (1-b)*q + (1-c)*r ) );
-  zPexSetCoeff( pex, 1, 2*pqr*( (1-b-a)*p*q + (1-a-c)*r*p + (1-c-b)*q*r ) );
-  zPexSetCoeff( pex, 0, (1-a-b-c)*pqr*pqr );
-  zPexBH( pex, ans, zTOL, 0 );
-  zPexFree( pex );
-
-  for( i=0; i<6; i++ )
-    if( ( l = zCVecElemNC(ans,i)->re ) >= 0 ) break;
-  if( i == 6 || !zIsTiny( zCVecElemNC(ans,i)->im ) ){
-    ZRUNERROR( ZEO_ERR_FATAL );
-    return NULL;
+  double r[3], p[3], rv[3], lo, hi, l, g, dg, s, pmin;
+  register int i, k;
+
+  r[zX] = rx; r[zY] = ry; r[zZ] = rz;
+  for( s=0, pmin=HUGE_VAL, i=zX; i<=zZ; i++ ){
+    p[i] = r[i] * r[i];
+    rv[i] = r[i] * v->e[i];
+    s += rv[i] * rv[i];
+    if( p[i] < pmin ) pmin = p[i];
+  }
+  lo = 0;
+  hi = zMax( sqrt( s ) - pmin, 0 ); /* G(hi) <= 0 since r_i^2 + l >= pmin + l */
+  for( l=lo, k=0; k<ZEO_ELLIPS3D_CLOSEST_ITER_MAX; k++ ){
+    for( g=-1, dg=0, i=zX; i<=zZ; i++ ){
+      s = rv[i] / ( p[i] + l );
+      g += s * s;
+      dg -= 2 * s * s / ( p[i] + l );
+    }
+    if( g > 0 ) lo = l; else hi = l;
+    if( zIsTiny( g ) || hi - lo <= zTOL * ( 1 + hi ) ) break;
+    /* Newton's step, which does not overshoot for convex G, or bisection */
+    if( dg >= 0 || ( l -= g / dg ) <= lo || l >= hi ) l = 0.5 * ( lo + hi );
   }
-  zCVecFree( ans );
-  zVec3DCreate( cp, v->e[zX]/(1+l/p), v->e[zY]/(1+l/q), v->e[zZ]/(1+l/r) );
+  for( i=zX; i<=zZ; i++ )
+    cp->e[i] = p[i] * v->e[i] / ( p[i] + l );
   return cp;
 }
 
@@ -134,17 +131,30 @@ double zEllips3DClosest(zEllips3D *ellips, zVec3D *p, zVec3D *cp)
 {
   zVec3D pi;
 
-  if( zEllips3DPointIsInside( ellips, p, true ) ){
+  zXform3DInv( &ellips->f, p, &pi );
+  if( zSqr(pi.e[zX]/zEllips3DRadiusX(ellips))
+    + zSqr(pi.e[zY]/zEllips3DRadiusY(ellips))
+    + zSqr(pi.e[zZ]/zEllips3DRadiusZ(ellips)) - zTOL < 1.0 ){
     zVec3DCopy( p, cp );
     return 0;
   }
-  zXform3DInv( &ellips->f, p, &pi );
   _zEllips3DClosest( zEllips3DRadiusX(ellips), zEllips3DRadiusY(ellips), zEllips3DRadiusZ(ellips), &pi, cp );
   zXform3DDRC( &ellips->f, cp );
   /* distance */
   return zVec3DDist( p, cp );
 }
 
+/* the closest points from 3D points to a 3D ellipsoid. */
+void zEllips3DClosestBatch(zEllips3D *ellips, zVec3D p[], int n, zVec3D cp[], double d[])
+{
+  register int i;
+
+  for( i=0; i<n; i++ ){
+    if( d ) d[i] = zEllips3DClosest( ellips, &p[i], &cp[i] );
+    else zEllips3DClosest( ellips, &p[i], &cp[i] );
+  }
+}
+
 /* distance from a point to a 3D ellipsoid. */
 double zEllips3DPointDist(zEllips3D *ellips, zVec3D *p)
 {
@@ -162,10 +172,56 @@ bool zEllips3DPointIsInside(zEllips3D *ellips, zVec3D *p, bool rim)
   l = zSqr(_p.e[zX]/zEllips3DRadiusX(ellips))
     + zSqr(_p.e[zY]/zEllips3DRadiusY(ellips))
     + zSqr(_p.e[zZ]/zEllips3DRadiusZ(ellips));
-  if( rim ) l += zTOL;
+  if( rim ) l -= zTOL;
   return l < 1.0 ? true : false;
 }
 
+/* support point of an ellipsoid with respect to a direction vector. */
+zVec3D *zEllips3DSupportMap(zEllips3D *ellips, zVec3D *v, zVec3D *sp)
+{
+  zVec3D _v;
+  double l;
+  register zDir d;
+
+  zMulMat3DTVec3D( zFrame3DAtt(&ellips->f), v, &_v );
+  for( d=zX; d<=zZ; d++ ) _v.e[d] *= zEllips3DRadius(ellips,d);
+  if( zIsTiny( ( l = zVec3DNorm( &_v ) ) ) )
+    return zVec3DCopy( zEllips3DCenter(ellips), sp );
+  for( d=zX; d<=zZ; d++ ) _v.e[d] *= zEllips3DRadius(ellips,d) / l;
+  return zXform3D( &ellips->f, &_v, sp );
+}
+
+/* intersection of a ray and an ellipsoid (a unit sphere in the scaled frame of the ellipsoid). */
+bool zEllips3DRayCast(zEllips3D *ellips, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm)
+{
+  zVec3D o, d, n;
+  double a, b, c, disc, tt;
+  register zDir i;
+
+  zXform3DInv( &ellips->f, org, &o );
+  zMulMat3DTVec3D( zFrame3DAtt(&ellips->f), dir, &d );
+  for( i=zX; i<=zZ; i++ ){
+    o.e[i] /= zEllips3DRadius(ellips,i);
+    d.e[i] /= zEllips3DRadius(ellips,i);
+  }
+  if( zIsTiny( ( a = zVec3DSqrNorm( &d ) ) ) ) return false;
+  b = zVec3DInnerProd( &o, &d );
+  c = zVec3DSqrNorm( &o ) - 1;
+  if( ( disc = b*b - a*c ) < 0 ) return false;
+  disc = sqrt( disc );
+  if( ( tt = ( -b - disc ) / a ) < 0 ) tt = ( -b + disc ) / a; /* from inside */
+  if( tt < 0 || tt > tmax ) return false;
+  if( t ) *t = tt;
+  if( norm ){ /* gradient of the implicit function */
+    zVec3DCat( &o, tt, &d, &n );
+    for( i=zX; i<=zZ; i++ )
+      n.e[i] /= zEllips3DRadius(ellips,i);
+    zMulMat3DVec3D( zFrame3DAtt(&ellips->f), &n, norm );
+    zVec3DNormalizeDRC( norm );
+  }
+  return true;
+}
+
 /* volume of a 3D ellipsoid. */
 double zEllips3DVolume(zEllips3D *ellips)
 {
@@ -224,7 +280,7 @@ zPH3D* zEllips3DToPH(zEllips3D *ellips, zPH3D *ph)
   /* -- faces -- */
   /* arctic faces */
   for( n=0, i=1, j=zEllips3DDiv(ellips); i<=zEllips3DDiv(ellips); j=i++ )
-    zTri3DCreate( &face[n++], &vert[0], &vert[i], &vert[j] );
+    zTri3DCreate( &face[n++], &vert[0], &vert[j], &vert[i] );
   /* general */
   for( i=2; i<zEllips3DDiv(ellips); i++ )
     for( j=0, k=(i-1)*zEllips3DDiv(ellips)+1, l=i*zEllips3DDiv(ellips); j<zEllips3DDiv(ellips); j++, l=k++ ){
@@ -237,7 +293,7 @@ zPH3D* zEllips3DToPH(zEllips3D *ellips, zPH3D *ph)
   for( i=zPH3DVertNum(ph)-zEllips3DDiv(ellips)-1, j=zPH3DVertNum(ph)-2;
        n<zPH3DFaceNum(ph); j=i++ )
     zTri3DCreate( &face[n++],
-      &vert[i], &vert[zPH3DVertNum(ph)-1], &vert[j] );
+      &vert[j], &vert[zPH3DVertNum(ph)-1], &vert[i] );
 
   return ph;
 }
@@ -330,6 +386,10 @@ static double _zShape3DEllipsPointDist(void *shape, zVec3D *p){
   return zEllips3DPointDist( shape, p ); }
 static bool _zShape3DEllipsPointIsInside(void *shape, zVec3D *p, bool rim){
   return zEllips3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DEllipsSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  return zEllips3DSupportMap( shape, v, sp ); }
+static bool _zShape3DEllipsRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return zEllips3DRayCast( shape, org, dir, tmax, t, norm ); }
 static double _zShape3DEllipsVolume(void *shape){
   return zEllips3DVolume( shape ); }
 static zVec3D *_zShape3DEllipsBarycenter(void *shape, zVec3D *c){
@@ -361,6 +421,8 @@ zShape3DCom zeo_shape3d_ellips_com = {
   _zShape3DEllipsClosest,
   _zShape3DEllipsPointDist,
   _zShape3DEllipsPointIsInside,
+  _zShape3DEllipsSupportMap,
+  _zShape3DEllipsRayCast,
   _zShape3DEllipsVolume,
   _zShape3DEllipsBarycenter,
   _zShape3DEllipsInertia,
@@ -38,6 +38,22 @@ static double _zShape3DNURBSPointDist(void *shape, zVec3D *p){
 
 static bool _zShape3DNURBSPointIsInside(void *shape, zVec3D *p, bool rim){
   return false; }
+/* the convex hull of control points includes the surface. */
+static zVec3D *_zShape3DNURBSSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  zVec3D *cp = NULL;
+  double d, dmax = -HUGE_VAL;
+  register int i, j;
+
+  for( i=0; i<zNURBS3DCPNum((zNURBS3D*)shape,0); i++ )
+    for( j=0; j<zNURBS3DCPNum((zNURBS3D*)shape,1); j++ )
+      if( ( d = zVec3DInnerProd( zNURBS3DCP((zNURBS3D*)shape,i,j), v ) ) > dmax ){
+        dmax = d;
+        cp = zNURBS3DCP((zNURBS3D*)shape,i,j);
+      }
+  return cp ? zVec3DCopy( cp, sp ) : NULL;
+}
+static bool _zShape3DNURBSRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return false; }
 static double _zShape3DNURBSVolume(void *shape){
   return 0; }
 static zVec3D *_zShape3DNURBSBarycenter(void *shape, zVec3D *c){
@@ -67,6 +83,8 @@ zShape3DCom zeo_shape3d_nurbs_com = {
   _zShape3DNURBSClosest,
   _zShape3DNURBSPointDist,
   _zShape3DNURBSPointIsInside,
+  _zShape3DNURBSSupportMap,
+  _zShape3DNURBSRayCast,
   _zShape3DNURBSVolume,
   _zShape3DNURBSBarycenter,
   _zShape3DNURBSInertia,
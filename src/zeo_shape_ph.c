@@ -36,6 +36,15 @@ static double _zShape3DPHPointDist(void *shape, zVec3D *p){
   return zPH3DPointDist( shape, p ); }
 static bool _zShape3DPHPointIsInside(void *shape, zVec3D *p, bool rim){
   return zPH3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DPHSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  zVec3D *p;
+  if( !( p = zVec3DSupportMap( zPH3DVertBuf((zPH3D*)shape), zPH3DVertNum((zPH3D*)shape), v ) ) ) return NULL;
+  return zVec3DCopy( p, sp ); }
+static bool _zShape3DPHRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  int face;
+  if( ( face = zPH3DRayCast( shape, org, dir, tmax, t ) ) < 0 ) return false;
+  if( norm ) zVec3DCopy( zTri3DNorm(zPH3DFace((zPH3D*)shape,face)), norm );
+  return true; }
 static double _zShape3DPHVolume(void *shape){
   return zPH3DVolume( shape ); }
 static zVec3D *_zShape3DPHBarycenter(void *shape, zVec3D *c){
@@ -65,6 +74,8 @@ zShape3DCom zeo_shape3d_ph_com = {
   _zShape3DPHClosest,
   _zShape3DPHPointDist,
   _zShape3DPHPointIsInside,
+  _zShape3DPHSupportMap,
+  _zShape3DPHRayCast,
   _zShape3DPHVolume,
   _zShape3DPHBarycenter,
   _zShape3DPHInertia,
@@ -102,6 +102,38 @@ bool zSphere3DPointIsInside(zSphere3D *sphere, zVec3D *p, bool rim)
   return zSphere3DPointDist( sphere, p ) < ( rim ? zTOL : 0 ) ? true : false;
 }
 
+/* support point of a sphere with respect to a direction vector. */
+zVec3D *zSphere3DSupportMap(zSphere3D *sphere, zVec3D *v, zVec3D *sp)
+{
+  double l;
+
+  if( zIsTiny( ( l = zVec3DNorm( v ) ) ) )
+    return zVec3DCopy( zSphere3DCenter(sphere), sp );
+  return zVec3DCat( zSphere3DCenter(sphere), zSphere3DRadius(sphere)/l, v, sp );
+}
+
+/* intersection of a ray and a sphere. */
+bool zSphere3DRayCast(zSphere3D *sphere, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm)
+{
+  zVec3D v;
+  double a, b, c, d, tt;
+
+  if( zIsTiny( ( a = zVec3DSqrNorm( dir ) ) ) ) return false;
+  zVec3DSub( org, zSphere3DCenter(sphere), &v );
+  b = zVec3DInnerProd( &v, dir );
+  c = zVec3DSqrNorm( &v ) - zSqr( zSphere3DRadius(sphere) );
+  if( ( d = b*b - a*c ) < 0 ) return false;
+  d = sqrt( d );
+  if( ( tt = ( -b - d ) / a ) < 0 ) tt = ( -b + d ) / a; /* from inside */
+  if( tt < 0 || tt > tmax ) return false;
+  if( t ) *t = tt;
+  if( norm ){
+    zVec3DCat( &v, tt, dir, norm );
+    zVec3DNormalizeDRC( norm );
+  }
+  return true;
+}
+
 /* volume of a 3D sphere. */
 double zSphere3DVolume(zSphere3D *sphere)
 {
@@ -151,7 +183,7 @@ zPH3D *zSphere3DToPH(zSphere3D *sphere, zPH3D *ph)
 
   /* arctic faces */
   for( n=0, i=1, j=zSphere3DDiv(sphere); i<=zSphere3DDiv(sphere); j=i++ )
-    zTri3DCreate( &face[n++], &vert[0], &vert[i], &vert[j] );
+    zTri3DCreate( &face[n++], &vert[0], &vert[j], &vert[i] );
   /* general */
   for( i=2; i<zSphere3DDiv(sphere); i++ )
     for( j=0, k=(i-1)*zSphere3DDiv(sphere)+1, l=i*zSphere3DDiv(sphere); j<zSphere3DDiv(sphere); j++, l=k++ ){
@@ -164,7 +196,7 @@ zPH3D *zSphere3DToPH(zSphere3D *sphere, zPH3D *ph)
   for( i=zPH3DVertNum(ph)-zSphere3DDiv(sphere)-1, j=zPH3DVertNum(ph)-2;
        n<zPH3DFaceNum(ph); j=i++ )
     zTri3DCreate( &face[n++],
-      &vert[i], &vert[zPH3DVertNum(ph)-1], &vert[j] );
+      &vert[j], &vert[zPH3DVertNum(ph)-1], &vert[i] );
 
   return ph;
 }
@@ -262,6 +294,10 @@ static double _zShape3DSpherePointDist(void *shape, zVec3D *p){
   return zSphere3DPointDist( shape, p ); }
 static bool _zShape3DSpherePointIsInside(void *shape, zVec3D *p, bool rim){
   return zSphere3DPointIsInside( shape, p, rim ); }
+static zVec3D *_zShape3DSphereSupportMap(void *shape, zVec3D *v, zVec3D *sp){
+  return zSphere3DSupportMap( shape, v, sp ); }
+static bool _zShape3DSphereRayCast(void *shape, zVec3D *org, zVec3D *dir, double tmax, double *t, zVec3D *norm){
+  return zSphere3DRayCast( shape, org, dir, tmax, t, norm ); }
 static double _zShape3DSphereVolume(void *shape){
   return zSphere3DVolume( shape ); }
 static zVec3D *_zShape3DSphereBarycenter(void *shape, zVec3D *c){
@@ -293,6 +329,8 @@ zShape3DCom zeo_shape3d_sphere_com = {
   _zShape3DSphereClosest,
   _zShape3DSpherePointDist,
   _zShape3DSpherePointIsInside,
+  _zShape3DSphereSupportMap,
+  _zShape3DSphereRayCast,
   _zShape3DSphereVolume,
   _zShape3DSphereBarycenter,
   _zShape3DSphereInertia,
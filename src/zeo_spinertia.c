@@ -0,0 +1,216 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_spinertia - compact spatial inertia.
+ */
+
+#include <zeo/zeo_spinertia.h>
+
+/* ********************************************************** */
+/* CLASS: zSpInertia
+ * compact spatial inertia class
+ * ********************************************************** */
+
+/* index of the upper triangular components of a symmetric 3x3 matrix. */
+static const int _zSpInertiaIdx[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+
+/* add ( k1 |p|^2 + k2 p.q ) 1 - k1 p p^T - k2 ( p q^T + q p^T ) / 2 to a symmetric matrix. */
+static void _zSpInertiaShift(double i[], zVec3D *p, zVec3D *q, double k1, double k2)
+{
+  double d;
+  register int r, c;
+
+  d = k1*_zVec3DSqrNorm(p) + k2*_zVec3DInnerProd(p,q);
+  for( r=0; r<3; r++ ){
+    i[_zSpInertiaIdx[r][r]] += d;
+    for( c=r; c<3; c++ )
+      i[_zSpInertiaIdx[r][c]] -= k1*p->e[r]*p->e[c] + 0.5*k2*( p->e[r]*q->e[c] + q->e[r]*p->e[c] );
+  }
+}
+
+/* rotate a symmetric 3x3 matrix as R I R^T. */
+static void _zSpInertiaRot(zMat3D *r, double i[], double ri[])
+{
+  double t[3][3];
+  register int j, k, l;
+
+  for( j=0; j<3; j++ ) /* T = R I */
+    for( k=0; k<3; k++ )
+      t[j][k] = r->e[0][j]*i[_zSpInertiaIdx[0][k]] + r->e[1][j]*i[_zSpInertiaIdx[1][k]] + r->e[2][j]*i[_zSpInertiaIdx[2][k]];
+  for( j=0; j<3; j++ ) /* T R^T */
+    for( k=j; k<3; k++ )
+      for( ri[_zSpInertiaIdx[j][k]]=0, l=0; l<3; l++ )
+        ri[_zSpInertiaIdx[j][k]] += t[j][l]*r->e[l][k];
+}
+
+/* rotate a symmetric 3x3 matrix as R^T I R. */
+static void _zSpInertiaRotInv(zMat3D *r, double i[], double ri[])
+{
+  double t[3][3];
+  register int j, k, l;
+
+  for( j=0; j<3; j++ ) /* T = R^T I */
+    for( k=0; k<3; k++ )
+      t[j][k] = r->e[j][0]*i[_zSpInertiaIdx[0][k]] + r->e[j][1]*i[_zSpInertiaIdx[1][k]] + r->e[j][2]*i[_zSpInertiaIdx[2][k]];
+  for( j=0; j<3; j++ ) /* T R */
+    for( k=j; k<3; k++ )
+      for( ri[_zSpInertiaIdx[j][k]]=0, l=0; l<3; l++ )
+        ri[_zSpInertiaIdx[j][k]] += t[j][l]*r->e[k][l];
+}
+
+/* create a spatial inertia. */
+zSpInertia *zSpInertiaCreate(zSpInertia *si, double mass, zVec3D *com, zMat3D *inertia)
+{
+  register int r, c;
+
+  si->mass = mass;
+  zVec3DMul( com, mass, &si->h );
+  for( r=0; r<3; r++ )
+    for( c=r; c<3; c++ )
+      si->i[_zSpInertiaIdx[r][c]] = 0.5 * ( inertia->e[c][r] + inertia->e[r][c] );
+  _zSpInertiaShift( si->i, com, com, mass, 0 );
+  return si;
+}
+
+/* zero a spatial inertia. */
+zSpInertia *zSpInertiaZero(zSpInertia *si)
+{
+  register int j;
+
+  si->mass = 0;
+  zVec3DZero( &si->h );
+  for( j=0; j<6; j++ ) si->i[j] = 0;
+  return si;
+}
+
+/* center of mass of a spatial inertia. */
+zVec3D *zSpInertiaCOM(zSpInertia *si, zVec3D *com)
+{
+  if( zIsTiny( si->mass ) ){
+    ZRUNERROR( ZEO_ERR_ZERODIV );
+    return NULL;
+  }
+  return zVec3DDiv( &si->h, si->mass, com );
+}
+
+/* inertia tensor of a spatial inertia about the original point. */
+zMat3D *zSpInertiaInertia(zSpInertia *si, zMat3D *inertia)
+{
+  register int r, c;
+
+  for( r=0; r<3; r++ )
+    for( c=0; c<3; c++ )
+      inertia->e[c][r] = si->i[_zSpInertiaIdx[r][c]];
+  return inertia;
+}
+
+/* inertia tensor of a spatial inertia about the center of mass. */
+zMat3D *zSpInertiaBaryInertia(zSpInertia *si, zMat3D *inertia)
+{
+  double i[6];
+  zVec3D com;
+  register int r, c;
+
+  memcpy( i, si->i, sizeof(double)*6 );
+  if( !zIsTiny( si->mass ) ){
+    zVec3DDiv( &si->h, si->mass, &com );
+    _zSpInertiaShift( i, &com, &com, -si->mass, 0 );
+  }
+  for( r=0; r<3; r++ )
+    for( c=0; c<3; c++ )
+      inertia->e[c][r] = i[_zSpInertiaIdx[r][c]];
+  return inertia;
+}
+
+/* expand a spatial inertia to a 6x6 matrix. */
+zMat6D *zSpInertiaToMat6D(zSpInertia *si, zMat6D *m)
+{
+  _zMat3DCreate( &m->c.ll, si->mass, 0, 0, 0, si->mass, 0, 0, 0, si->mass );
+  zVec3DOuterProd2Mat3D( &si->h, &m->c.la );
+  zMat3DT( &m->c.la, &m->c.al );
+  zSpInertiaInertia( si, &m->c.aa );
+  return m;
+}
+
+/* add two spatial inertias. */
+zSpInertia *zSpInertiaAdd(zSpInertia *si1, zSpInertia *si2, zSpInertia *si)
+{
+  register int j;
+
+  si->mass = si1->mass + si2->mass;
+  _zVec3DAdd( &si1->h, &si2->h, &si->h );
+  for( j=0; j<6; j++ ) si->i[j] = si1->i[j] + si2->i[j];
+  return si;
+}
+
+/* multiply a 6D vector by a spatial inertia. */
+zVec6D *zMulSpInertiaVec6D(zSpInertia *si, zVec6D *v, zVec6D *f)
+{
+  _zMulSpInertiaVec6D( si, v, f );
+  return f;
+}
+
+/* multiply an array of 6D vectors by spatial inertias. */
+zVec6D *zMulSpInertiaVec6DArray(zSpInertia si[], zVec6D v[], int n, zVec6D f[])
+{
+  register int j;
+
+  for( j=0; j<n; j++ ) _zMulSpInertiaVec6D( &si[j], &v[j], &f[j] );
+  return f;
+}
+
+/* transform a spatial inertia. */
+zSpInertia *zSpInertiaXform(zSpInertia *si, zFrame3D *f, zSpInertia *sic)
+{
+  zVec3D hr;
+
+  _zMulMat3DVec3D( zFrame3DAtt(f), &si->h, &hr );
+  _zSpInertiaRot( zFrame3DAtt(f), si->i, sic->i );
+  _zSpInertiaShift( sic->i, zFrame3DPos(f), &hr, si->mass, 2 );
+  _zVec3DCat( &hr, si->mass, zFrame3DPos(f), &sic->h );
+  sic->mass = si->mass;
+  return sic;
+}
+
+/* inversely transform a spatial inertia. */
+zSpInertia *zSpInertiaXformInv(zSpInertia *si, zFrame3D *f, zSpInertia *sic)
+{
+  double i[6];
+  zVec3D h;
+
+  memcpy( i, si->i, sizeof(double)*6 );
+  _zSpInertiaShift( i, zFrame3DPos(f), &si->h, si->mass, -2 );
+  _zVec3DCat( &si->h, -si->mass, zFrame3DPos(f), &h );
+  _zMulMat3DTVec3D( zFrame3DAtt(f), &h, &sic->h );
+  _zSpInertiaRotInv( zFrame3DAtt(f), i, sic->i );
+  sic->mass = si->mass;
+  return sic;
+}
+
+/* transform an array of spatial inertias. */
+zSpInertia *zSpInertiaXformArray(zSpInertia si[], zFrame3D f[], int n, zSpInertia sic[])
+{
+  register int j;
+
+  for( j=0; j<n; j++ ) zSpInertiaXform( &si[j], &f[j], &sic[j] );
+  return sic;
+}
+
+/* inversely transform an array of spatial inertias. */
+zSpInertia *zSpInertiaXformInvArray(zSpInertia si[], zFrame3D f[], int n, zSpInertia sic[])
+{
+  register int j;
+
+  for( j=0; j<n; j++ ) zSpInertiaXformInv( &si[j], &f[j], &sic[j] );
+  return sic;
+}
+
+/* print a spatial inertia out to a file. */
+void zSpInertiaFPrint(FILE *fp, zSpInertia *si)
+{
+  fprintf( fp, "mass: %.10g\n", si->mass );
+  fprintf( fp, "h: " );
+  zVec3DFPrint( fp, &si->h );
+  fprintf( fp, "inertia: { %.10g, %.10g, %.10g, %.10g, %.10g, %.10g }\n",
+    si->i[0], si->i[1], si->i[2], si->i[3], si->i[4], si->i[5] );
+}
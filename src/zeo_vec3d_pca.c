@@ -38,7 +38,7 @@ zVec3D *zVec3DPCA_PL(zVec3DList *pl, zVec3D evec[])
   zMat3DZero( &vm );
   zListForEach( pl, pc )
     zMat3DAddDyad( &vm, pc->data, pc->data );
-  zMat3DSymEig( &vm, eval, evec );
+  zMat3DSymEigTrig( &vm, eval, evec );
   return evec;
 }
 
@@ -52,7 +52,7 @@ zVec3D *zVec3DPCA(zVec3D p[], int num, zVec3D evec[])
   zMat3DZero( &vm );
   for( i=0; i<num; i++ )
     zMat3DAddDyad( &vm, &p[i], &p[i] );
-  zMat3DSymEig( &vm, eval, evec );
+  zMat3DSymEigTrig( &vm, eval, evec );
   return evec;
 }
 
@@ -70,7 +70,7 @@ zVec3D *zVec3DBaryPCA_PL(zVec3DList *pl, zVec3D *c, zVec3D evec[])
     zVec3DSub( pc->data, c, &dp );
     zMat3DAddDyad( &vm, &dp, &dp );
   }
-  zMat3DSymEig( &vm, eval, evec );
+  zMat3DSymEigTrig( &vm, eval, evec );
   return c;
 }
 
@@ -88,6 +88,6 @@ zVec3D *zVec3DBaryPCA(zVec3D p[], int num, zVec3D *c, zVec3D evec[])
     zVec3DSub( &p[i], c, &dp );
     zMat3DAddDyad( &vm, &dp, &dp );
   }
-  zMat3DSymEig( &vm, eval, evec );
+  zMat3DSymEigTrig( &vm, eval, evec );
   return c;
 }
@@ -0,0 +1,260 @@
+#include <zeo/zeo.h>
+
+#define N 300
+#define MARGIN 0.01
+
+zAABox3D box[N];
+bool alive[N];
+int leaf[N];
+
+void box_rand(zAABox3D *b)
+{
+  double x, y, z, r;
+
+  x = zRandF(-1,1); y = zRandF(-1,1); z = zRandF(-1,1);
+  r = zRandF(0.01,0.1);
+  zAABox3DCreate( b, x-r, y-r, z-r, x+r, y+r, z+r );
+}
+
+bool box_contain(zAABox3D *b, zAABox3D *inner)
+{
+  return b->min.e[zX] <= inner->min.e[zX] && inner->max.e[zX] <= b->max.e[zX] &&
+         b->min.e[zY] <= inner->min.e[zY] && inner->max.e[zY] <= b->max.e[zY] &&
+         b->min.e[zZ] <= inner->min.e[zZ] && inner->max.e[zZ] <= b->max.e[zZ];
+}
+
+/* check parent-child links, heights, balance and enclosing boxes of a subtree; returns the number of leaves. */
+int check_subtree(zAABBTree *tree, int id, bool *result)
+{
+  zAABBTreeNode *node, *c0, *c1;
+
+  node = &tree->node[id];
+  if( zAABBTreeIsLeaf(tree,id) ){
+    if( node->height != 0 ) *result = false;
+    if( !box_contain( &node->box, &box[*(int*)node->data] ) ) *result = false;
+    return 1;
+  }
+  c0 = &tree->node[node->child[0]];
+  c1 = &tree->node[node->child[1]];
+  if( c0->parent != id || c1->parent != id ) *result = false;
+  if( node->height != 1 + zMax( c0->height, c1->height ) ) *result = false;
+  if( abs( c0->height - c1->height ) > 1 ) *result = false;
+  if( !box_contain( &node->box, &c0->box ) || !box_contain( &node->box, &c1->box ) ) *result = false;
+  return check_subtree( tree, node->child[0], result ) + check_subtree( tree, node->child[1], result );
+}
+
+bool check_tree(zAABBTree *tree, int n)
+{
+  bool result = true;
+
+  if( n == 0 ) return zAABBTreeRoot(tree) < 0;
+  if( tree->node[zAABBTreeRoot(tree)].parent != -1 ) return false;
+  if( check_subtree( tree, zAABBTreeRoot(tree), &result ) != n ) return false;
+  return result && tree->num == 2*n - 1;
+}
+
+typedef struct{
+  zAABBTree *tree;
+  bool hit[N];
+} query_t;
+
+bool query_mark(int id, void *priv)
+{
+  query_t *q = priv;
+
+  q->hit[*(int*)zAABBTreeData(q->tree,id)] = true;
+  return true;
+}
+
+/* ray-box intersection parameter of a tight box */
+double ray_box(zAABox3D *b, zVec3D *org, zVec3D *dir, double tmax)
+{
+  double tmin = 0, t1, t2;
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    t1 = ( b->min.e[i] - org->e[i] ) / dir->e[i];
+    t2 = ( b->max.e[i] - org->e[i] ) / dir->e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > tmin ) tmin = t1;
+    if( t2 < tmax ) tmax = t2;
+    if( tmin > tmax ) return HUGE_VAL;
+  }
+  return tmin;
+}
+
+typedef struct{
+  zAABBTree *tree;
+  int id;
+} ray_t;
+
+double ray_cb(int id, zVec3D *org, zVec3D *dir, double tmax, void *priv)
+{
+  ray_t *r = priv;
+  double t;
+  int i;
+
+  i = *(int*)zAABBTreeData(r->tree,id);
+  /* a tie is broken by the smaller index as the linear scan does */
+  if( ( t = ray_box( &box[i], org, dir, tmax ) ) > tmax ||
+      ( t == tmax && ( r->id < 0 || i > r->id ) ) ) return tmax;
+  r->id = i;
+  return t;
+}
+
+double closest_cb(int id, zVec3D *p, void *priv)
+{
+  zAABox3D *b;
+  double d = 0;
+  register int i;
+
+  b = &box[*(int*)zAABBTreeData((zAABBTree*)priv,id)];
+  for( i=zX; i<=zZ; i++ ){
+    if( p->e[i] < b->min.e[i] ) d += zSqr( b->min.e[i] - p->e[i] );
+    if( p->e[i] > b->max.e[i] ) d += zSqr( p->e[i] - b->max.e[i] );
+  }
+  return sqrt( d );
+}
+
+typedef struct{
+  zAABBTree *t1, *t2;
+  int count;
+  bool result;
+} pair_t;
+
+bool pair_cb(int id1, int id2, void *priv)
+{
+  pair_t *p = priv;
+
+  if( p->t1 == p->t2 && id1 >= id2 ) p->result = false;
+  if( !zColChkAABox3D( zAABBTreeBox(p->t1,id1), zAABBTreeBox(p->t2,id2) ) ) p->result = false;
+  p->count++;
+  return true;
+}
+
+void assert_aabbtree(void)
+{
+  zAABBTree tree;
+  query_t q;
+  ray_t r;
+  pair_t pr;
+  zAABox3D qb;
+  zVec3D org, dir, p, v;
+  int idx[N], n = 0, id, imin, count;
+  double t, tmin, d, dmin;
+  register int i, j, k;
+  bool result1 = true, result2 = true, result3 = true, result4 = true, result5 = true, result6 = true;
+
+  zAABBTreeInit( &tree, MARGIN );
+  for( i=0; i<N; i++ ){
+    idx[i] = i;
+    box_rand( &box[i] );
+    if( ( leaf[i] = zAABBTreeInsert( &tree, &box[i], &idx[i] ) ) < 0 ) result1 = false;
+    alive[i] = true;
+    n++;
+  }
+  if( !check_tree( &tree, n ) ) result1 = false;
+  /* removal, reinsertion and motion */
+  for( k=0; k<N; k++ ){
+    i = zRandI(0,N-1);
+    if( alive[i] ){
+      zAABBTreeRemove( &tree, leaf[i] );
+      alive[i] = false; n--;
+    } else{
+      box_rand( &box[i] );
+      leaf[i] = zAABBTreeInsert( &tree, &box[i], &idx[i] );
+      alive[i] = true; n++;
+    }
+    i = zRandI(0,N-1);
+    if( alive[i] ){
+      zVec3DCreate( &v, zRandF(-0.05,0.05), zRandF(-0.05,0.05), zRandF(-0.05,0.05) );
+      zVec3DAddDRC( &box[i].min, &v );
+      zVec3DAddDRC( &box[i].max, &v );
+      zAABBTreeMove( &tree, leaf[i], &box[i], &v );
+    }
+  }
+  if( !check_tree( &tree, n ) ) result2 = false;
+  /* box query */
+  for( k=0; k<N; k++ ){
+    box_rand( &qb );
+    q.tree = &tree;
+    for( i=0; i<N; i++ ) q.hit[i] = false;
+    zAABBTreeQuery( &tree, &qb, query_mark, &q );
+    for( i=0; i<N; i++ ){
+      if( !alive[i] ){
+        if( q.hit[i] ) result3 = false;
+      } else
+      if( zColChkAABox3D( &box[i], &qb ) && !q.hit[i] ) result3 = false;
+    }
+  }
+  /* ray cast */
+  for( k=0; k<N; k++ ){
+    zVec3DCreate( &org, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+    zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    r.tree = &tree; r.id = -1;
+    zAABBTreeRayCast( &tree, &org, &dir, 10, ray_cb, &r );
+    for( tmin=10, imin=-1, i=0; i<N; i++ )
+      if( alive[i] && ( t = ray_box( &box[i], &org, &dir, 10 ) ) < tmin ){
+        tmin = t; imin = i;
+      }
+    if( r.id != imin ) result4 = false;
+  }
+  /* closest */
+  for( k=0; k<N; k++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+    id = zAABBTreeClosest( &tree, &p, closest_cb, &tree, &d );
+    for( dmin=HUGE_VAL, i=0; i<N; i++ )
+      if( alive[i] && ( t = closest_cb( leaf[i], &p, &tree ) ) < dmin ) dmin = t;
+    if( id < 0 || !zIsTiny( d - dmin ) ) result5 = false;
+  }
+  /* self pairs */
+  pr.t1 = pr.t2 = &tree; pr.count = 0; pr.result = true;
+  zAABBTreeQueryTree( &tree, &tree, pair_cb, &pr );
+  for( count=0, i=0; i<N; i++ )
+    for( j=i+1; j<N; j++ )
+      if( alive[i] && alive[j] && zColChkAABox3D( zAABBTreeBox(&tree,leaf[i]), zAABBTreeBox(&tree,leaf[j]) ) ) count++;
+  if( !pr.result || pr.count != count ) result6 = false;
+  zAABBTreeDestroy( &tree );
+
+  zAssert( zAABBTreeInsert, result1 );
+  zAssert( zAABBTreeRemove + zAABBTreeMove, result2 );
+  zAssert( zAABBTreeQuery, result3 );
+  zAssert( zAABBTreeRayCast, result4 );
+  zAssert( zAABBTreeClosest, result5 );
+  zAssert( zAABBTreeQueryTree (self), result6 );
+}
+
+void assert_aabbtree_tree(void)
+{
+  zAABBTree tree1, tree2;
+  pair_t pr;
+  int idx[N], leaf2[N], count = 0;
+  zAABox3D box2[N];
+  register int i, j;
+
+  zAABBTreeInit( &tree1, MARGIN );
+  zAABBTreeInit( &tree2, MARGIN );
+  for( i=0; i<N; i++ ){
+    idx[i] = i;
+    box_rand( &box[i] );
+    box_rand( &box2[i] );
+    leaf[i] = zAABBTreeInsert( &tree1, &box[i], &idx[i] );
+    leaf2[i] = zAABBTreeInsert( &tree2, &box2[i], &idx[i] );
+  }
+  pr.t1 = &tree1; pr.t2 = &tree2; pr.count = 0; pr.result = true;
+  zAABBTreeQueryTree( &tree1, &tree2, pair_cb, &pr );
+  for( i=0; i<N; i++ )
+    for( j=0; j<N; j++ )
+      if( zColChkAABox3D( zAABBTreeBox(&tree1,leaf[i]), zAABBTreeBox(&tree2,leaf2[j]) ) ) count++;
+  zAABBTreeDestroy( &tree1 );
+  zAABBTreeDestroy( &tree2 );
+  zAssert( zAABBTreeQueryTree, pr.result && pr.count == count );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_aabbtree();
+  assert_aabbtree_tree();
+  return EXIT_SUCCESS;
+}
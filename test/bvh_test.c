@@ -0,0 +1,400 @@
+#include <zeo/zeo.h>
+
+#define N 100
+
+/* a torus with a circular cross-section of a given radius. */
+zPH3D *torus_create(zPH3D *ph, double r1, double r2, int n, int div, zVec3D *center)
+{
+  zVec3D loop[N], axis;
+  register int i;
+
+  for( i=0; i<n; i++ )
+    zVec3DCreate( &loop[i], center->e[zX]+r1+r2*cos(zPIx2*i/n), center->e[zY], center->e[zZ]+r2*sin(zPIx2*i/n) );
+  zVec3DCreate( &axis, zRandF(-0.1,0.1), zRandF(-0.1,0.1), 1 );
+  return zPH3DTorus( ph, loop, n, div, center, &axis );
+}
+
+bool box_contain(zAABox3D *b, zAABox3D *inner)
+{
+  return b->min.e[zX] <= inner->min.e[zX] && inner->max.e[zX] <= b->max.e[zX] &&
+         b->min.e[zY] <= inner->min.e[zY] && inner->max.e[zY] <= b->max.e[zY] &&
+         b->min.e[zZ] <= inner->min.e[zZ] && inner->max.e[zZ] <= b->max.e[zZ];
+}
+
+/* check structure of a subtree; returns the number of faces. */
+int check_subtree(zPH3DBVH *bvh, int id, int level, bool *mark, bool *result)
+{
+  zPH3DBVHNode *node;
+  zTri3D *t;
+  int f;
+  register int i, j;
+
+  node = zPH3DBVHNode(bvh,id);
+  if( level > zPH3DBVHDepth(bvh) ) *result = false;
+  if( zPH3DBVHIsLeaf(bvh,id) ){
+    if( node->num > ZEO_PH3D_BVH_LEAF_SIZE ) *result = false;
+    for( i=0; i<node->num; i++ ){
+      if( mark[( f = zPH3DBVHLeafFace(bvh,id,i) )] ) *result = false;
+      mark[f] = true;
+      t = zPH3DFace(bvh->ph,f);
+      for( j=0; j<3; j++ )
+        if( !zAABox3DPointIsInside( &node->box, zTri3DVert(t,j), false ) ) *result = false;
+    }
+    return node->num;
+  }
+  if( node->head <= id + 1 || node->head >= zPH3DBVHNodeNum(bvh) ) *result = false;
+  if( !box_contain( &node->box, &zPH3DBVHNode(bvh,id+1)->box ) ||
+      !box_contain( &node->box, &zPH3DBVHNode(bvh,node->head)->box ) ) *result = false;
+  return check_subtree( bvh, id+1, level+1, mark, result ) + check_subtree( bvh, node->head, level+1, mark, result );
+}
+
+bool check_bvh(zPH3DBVH *bvh)
+{
+  bool *mark, result = true;
+
+  mark = zAlloc( bool, zPH3DFaceNum(bvh->ph) );
+  if( check_subtree( bvh, 0, 0, mark, &result ) != zPH3DFaceNum(bvh->ph) ) result = false;
+  zFree( mark );
+  return result && zPH3DBVHDepth(bvh) < ZEO_PH3D_BVH_DEPTH_MAX;
+}
+
+/* Moller-Trumbore ray-triangle intersection */
+bool ray_tri(zTri3D *tri, zVec3D *org, zVec3D *dir, double *t)
+{
+  zVec3D e1, e2, s, pv, qv;
+  double det, u, v;
+
+  zVec3DSub( zTri3DVert(tri,1), zTri3DVert(tri,0), &e1 );
+  zVec3DSub( zTri3DVert(tri,2), zTri3DVert(tri,0), &e2 );
+  zVec3DOuterProd( dir, &e2, &pv );
+  if( zIsTiny( ( det = zVec3DInnerProd( &e1, &pv ) ) ) ) return false;
+  zVec3DSub( org, zTri3DVert(tri,0), &s );
+  if( ( u = zVec3DInnerProd( &s, &pv ) / det ) < 0 || u > 1 ) return false;
+  zVec3DOuterProd( &s, &e1, &qv );
+  if( ( v = zVec3DInnerProd( dir, &qv ) / det ) < 0 || u + v > 1 ) return false;
+  return ( *t = zVec3DInnerProd( &e2, &qv ) / det ) >= 0;
+}
+
+typedef struct{
+  bool *hit;
+  int count;
+} query_t;
+
+bool query_mark(int f, void *priv)
+{
+  query_t *q = priv;
+
+  q->hit[f] = true;
+  q->count++;
+  return true;
+}
+
+bool pair_count(int f1, int f2, void *priv)
+{
+  (*(int *)priv)++;
+  return true;
+}
+
+void assert_bvh(void)
+{
+  zPH3D ph;
+  zPH3DBVH bvh;
+  zVec3D c, p, cp1, cp2, dir, *v1, *v2;
+  zAABox3D box;
+  query_t q;
+  double d1, d2, t, tmin;
+  int face, fmin, count;
+  register int i, k;
+  bool result1 = true, result2 = true, result3 = true, result4 = true;
+
+  zVec3DZero( &c );
+  torus_create( &ph, 1.0, 0.3, 24, 48, &c );
+  zPH3DBVHCreate( &bvh, &ph, 1 );
+  if( !check_bvh( &bvh ) ) result1 = false;
+  for( k=0; k<N; k++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(-1,1) );
+    /* closest point and contiguous vertex */
+    d1 = zPH3DBVHClosest( &bvh, &p, &cp1, &face );
+    d2 = zPH3DClosest( &ph, &p, &cp2 );
+    if( !zIsTiny( d1 - d2 ) || !zIsTiny( zTri3DClosest( zPH3DFace(&ph,face), &p, &c ) - d1 ) ) result2 = false;
+    v1 = zPH3DBVHContigVert( &bvh, &p, &d1 );
+    v2 = zPH3DContigVert( &ph, &p, &d2 );
+    if( !zIsTiny( d1 - d2 ) || !zIsTiny( zVec3DDist( v1, &p ) - zVec3DDist( v2, &p ) ) ) result2 = false;
+    /* ray casting */
+    zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec3DMulDRC( &dir, 2.0 );
+    face = zPH3DBVHRayCast( &bvh, &p, &dir, 1.0, &t );
+    for( tmin=1.0, fmin=-1, i=0; i<zPH3DFaceNum(&ph); i++ )
+      if( ray_tri( zPH3DFace(&ph,i), &p, &dir, &d1 ) && d1 <= tmin ){
+        tmin = d1; fmin = i;
+      }
+    if( ( face < 0 ) != ( fmin < 0 ) || ( face >= 0 && !zIsTiny( t - tmin ) ) ) result3 = false;
+    /* box query */
+    zAABox3DCreate( &box, p.e[zX]-0.2, p.e[zY]-0.2, p.e[zZ]-0.2, p.e[zX]+0.2, p.e[zY]+0.2, p.e[zZ]+0.2 );
+    q.hit = zAlloc( bool, zPH3DFaceNum(&ph) );
+    q.count = 0;
+    zPH3DBVHQueryAABox3D( &bvh, &box, query_mark, &q );
+    for( count=0, i=0; i<zPH3DFaceNum(&ph); i++ )
+      if( zColChkTriAABox3D( zPH3DFace(&ph,i), &box ) ){
+        if( !q.hit[i] ) result4 = false;
+        count++;
+      }
+    if( count != q.count ) result4 = false;
+    zFree( q.hit );
+  }
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &ph );
+
+  zAssert( zPH3DBVHCreate, result1 );
+  zAssert( zPH3DBVHClosest + zPH3DBVHContigVert, result2 );
+  zAssert( zPH3DBVHRayCast, result3 );
+  zAssert( zPH3DBVHQueryAABox3D, result4 );
+}
+
+void assert_bvh_parallel(void)
+{
+  zPH3D ph;
+  zPH3DBVH bvh, bvh_p;
+  zVec3D c;
+  bool result;
+
+  zVec3DZero( &c );
+  torus_create( &ph, 1.0, 0.3, 96, 96, &c );
+  zPH3DBVHCreate( &bvh, &ph, 1 );
+  zPH3DBVHCreate( &bvh_p, &ph, 4 );
+  /* parallel build results in the same hierarchy */
+  result = check_bvh( &bvh_p ) && zPH3DBVHNodeNum(&bvh) == zPH3DBVHNodeNum(&bvh_p) &&
+    memcmp( bvh.node, bvh_p.node, sizeof(zPH3DBVHNode)*zPH3DBVHNodeNum(&bvh) ) == 0 &&
+    memcmp( bvh.face, bvh_p.face, sizeof(int)*zPH3DFaceNum(&ph) ) == 0;
+  zPH3DBVHDestroy( &bvh );
+  zPH3DBVHDestroy( &bvh_p );
+  zPH3DDestroy( &ph );
+  zAssert( zPH3DBVHCreate (parallel), result );
+}
+
+void assert_bvh_refit(void)
+{
+  zPH3D ph, src;
+  zPH3DBVH bvh;
+  zFrame3D f;
+  zVec3D c, p, cp;
+  double d1, d2;
+  register int i, k;
+  bool result1, result2 = true, result3 = true;
+
+  zVec3DZero( &c );
+  torus_create( &src, 1.0, 0.3, 24, 48, &c );
+  zPH3DClone( &src, &ph );
+  zPH3DBVHCreate( &bvh, &ph, 1 );
+  result1 = zIsTiny( zPH3DBVHCostRatio(&bvh) - 1 );
+  /* rigid transformation */
+  zFrame3DFromZYX( &f, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-zPI,zPI), zRandF(-zPI_2,zPI_2), zRandF(-zPI,zPI) );
+  zPH3DBVHXform( &bvh, &src, &f );
+  if( !check_bvh( &bvh ) ) result2 = false;
+  for( k=0; k<N; k++ ){
+    zVec3DCreate( &p, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+    d1 = zPH3DBVHClosest( &bvh, &p, &cp, NULL );
+    d2 = zPH3DClosest( &ph, &p, &cp );
+    if( !zIsTiny( d1 - d2 ) ) result2 = false;
+  }
+  /* non-rigid deformation in place */
+  for( i=0; i<zPH3DVertNum(&ph); i++ ){
+    zVec3DCreate( &p, zRandF(-0.05,0.05), zRandF(-0.05,0.05), zRandF(-0.05,0.05) );
+    zVec3DAddDRC( zPH3DVert(&ph,i), &p );
+    zPH3DVert(&ph,i)->e[zZ] *= 2;
+  }
+  for( i=0; i<zPH3DFaceNum(&ph); i++ )
+    zTri3DCalcNorm( zPH3DFace(&ph,i) );
+  zPH3DBVHRefit( &bvh );
+  if( !check_bvh( &bvh ) ) result3 = false;
+  for( k=0; k<N; k++ ){
+    zVec3DCreate( &p, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+    d1 = zPH3DBVHClosest( &bvh, &p, &cp, NULL );
+    d2 = zPH3DClosest( &ph, &p, &cp );
+    if( !zIsTiny( d1 - d2 ) ) result3 = false;
+  }
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &ph );
+  zPH3DDestroy( &src );
+  zAssert( zPH3DBVHCostRatio, result1 );
+  zAssert( zPH3DBVHXform, result2 );
+  zAssert( zPH3DBVHRefit, result3 );
+}
+
+void assert_bvh_pair(void)
+{
+  zPH3D ph1, ph2;
+  zPH3DBVH bvh1, bvh2;
+  zVec3D c;
+  int count, count_bf, f1, f2;
+  register int i, j, k;
+  bool result = true;
+
+  for( k=0; k<10; k++ ){
+    zVec3DZero( &c );
+    torus_create( &ph1, 1.0, 0.3, 12, 24, &c );
+    zVec3DCreate( &c, zRandF(-1,1), zRandF(-1,1), zRandF(-0.5,0.5) );
+    torus_create( &ph2, 0.8, 0.2, 12, 24, &c );
+    zPH3DBVHCreate( &bvh1, &ph1, 1 );
+    zPH3DBVHCreate( &bvh2, &ph2, 1 );
+    count = 0;
+    zPH3DBVHQueryPair( &bvh1, &bvh2, pair_count, &count );
+    for( count_bf=0, i=0; i<zPH3DFaceNum(&ph1); i++ )
+      for( j=0; j<zPH3DFaceNum(&ph2); j++ )
+        if( zColChkTri3D( zPH3DFace(&ph1,i), zPH3DFace(&ph2,j) ) ) count_bf++;
+    if( count != count_bf ) result = false;
+    if( zPH3DBVHColChk( &bvh1, &bvh2, &f1, &f2 ) != ( count_bf > 0 ) ) result = false;
+    if( count_bf > 0 && !zColChkTri3D( zPH3DFace(&ph1,f1), zPH3DFace(&ph2,f2) ) ) result = false;
+    zPH3DBVHDestroy( &bvh1 );
+    zPH3DBVHDestroy( &bvh2 );
+    zPH3DDestroy( &ph1 );
+    zPH3DDestroy( &ph2 );
+  }
+  zAssert( zPH3DBVHQueryPair + zPH3DBVHColChk, result );
+}
+
+void assert_bvh_inside(void)
+{
+  zPH3D torus, box;
+  zPH3DBVH bvh;
+  zShape3D shape;
+  zVec3D loop[N], center, axis, p[N*10];
+  bool inside[N*10];
+  double r1 = 1.0, r2 = 0.3, e;
+  int count;
+  register int i;
+  bool result1 = true, result2 = true, result3 = true;
+
+  /* non-convex torus about the z-axis */
+  for( i=0; i<24; i++ )
+    zVec3DCreate( &loop[i], r1+r2*cos(zPIx2*i/24), 0, r2*sin(zPIx2*i/24) );
+  zVec3DZero( &center );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( &torus, loop, 24, 48, &center, &axis );
+  zPH3DBVHCreate( &bvh, &torus, 1 );
+  for( i=0; i<N*10; i++ ){
+    zVec3DCreate( &p[i], zRandF(-1.5,1.5), zRandF(-1.5,1.5), zRandF(-0.5,0.5) );
+    e = sqrt( zSqr( sqrt( zSqr(p[i].c.x) + zSqr(p[i].c.y) ) - r1 ) + zSqr(p[i].c.z) ) - r2;
+    if( fabs( e ) > 0.02 && zPH3DBVHPointIsInside( &bvh, &p[i], true ) != ( e < 0 ) ) result1 = false;
+  }
+  /* the hole and the center of the tube */
+  zVec3DZero( &p[0] );
+  if( zPH3DBVHPointIsInside( &bvh, &p[0], true ) ) result1 = false;
+  zVec3DCreate( &p[0], r1, 0, 0 );
+  if( !zPH3DBVHPointIsInside( &bvh, &p[0], true ) ) result1 = false;
+  /* batch */
+  count = zPH3DBVHPointIsInsideBatch( &bvh, p, N*10, true, inside, 3 );
+  for( i=0; i<N*10; i++ ){
+    if( inside[i] != zPH3DBVHPointIsInside( &bvh, &p[i], true ) ) result2 = false;
+    if( inside[i] ) count--;
+  }
+  if( count != 0 ) result2 = false;
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &torus );
+
+  /* convex box against the convex test, with points aligned to edges and vertices */
+  zVec3DZero( &center );
+  zShape3DBoxCreateAlign( &shape, &center, 1, 1, 1 );
+  zShape3DToPH( &shape );
+  zPH3DClone( zShape3DPH(&shape), &box );
+  zPH3DBVHCreate( &bvh, &box, 1 );
+  for( i=0; i<N*10; i++ ){
+    if( i % 2 == 0 )
+      zVec3DCreate( &p[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    else
+      zVec3DCreate( &p[i], 0.25*zRandI(-4,4), 0.25*zRandI(-4,4), 0.25*zRandI(-4,4) );
+    if( zPH3DBVHPointIsInside( &bvh, &p[i], true ) != zPH3DPointIsInside( &box, &p[i], true ) ||
+        zPH3DBVHPointIsInside( &bvh, &p[i], false ) != zPH3DPointIsInside( &box, &p[i], false ) ) result3 = false;
+  }
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &box );
+  zShape3DDestroy( &shape );
+  zAssert( zPH3DBVHPointIsInside (non-convex), result1 );
+  zAssert( zPH3DBVHPointIsInsideBatch, result2 );
+  zAssert( zPH3DBVHPointIsInside (degenerate), result3 );
+}
+
+void mshape_create(zMShape3D *ms, int n)
+{
+  zVec3D c1, c2;
+  register int i;
+
+  zMShape3DInit( ms );
+  zArrayAlloc( &ms->shape, zShape3D, n );
+  for( i=0; i<n; i++ ){
+    zVec3DCreate( &c1, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+    zVec3DCreate( &c2, zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-0.5,0.5) );
+    zVec3DAddDRC( &c2, &c1 );
+    switch( i % 3 ){
+    case 0:
+      zShape3DCylCreate( zMShape3DShape(ms,i), &c1, &c2, zRandF(0.1,0.3), 16 );
+      zShape3DToPH( zMShape3DShape(ms,i) );
+      break;
+    case 1:
+      zShape3DBoxCreateAlign( zMShape3DShape(ms,i), &c1, zRandF(0.1,0.5), zRandF(0.1,0.5), zRandF(0.1,0.5) );
+      break;
+    default:
+      zShape3DSphereCreate( zMShape3DShape(ms,i), &c1, zRandF(0.1,0.3), 16 );
+      zShape3DToPH( zMShape3DShape(ms,i) );
+    }
+  }
+}
+
+void assert_mshape_bvh(void)
+{
+  zMShape3D ms;
+  zMShape3DBVH mb;
+  zVec3D p, cp, cp_bf, disp;
+  double d, d_bf;
+  int id;
+  register int i, j, k;
+  bool result1 = true, result2 = true, result3 = true;
+
+  mshape_create( &ms, 30 );
+  zMShape3DBVHInit( &mb, &ms );
+  if( zMShape3DBVHIsBuilt(&mb) ) result1 = false;
+  for( k=0; k<2; k++ ){
+    for( i=0; i<N; i++ ){
+      zVec3DCreate( &p, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+      d = zMShape3DBVHClosest( &mb, &p, &cp, &id );
+      d_bf = zMShape3DClosest( &ms, &p, &cp_bf );
+      if( !zIsTiny( d - d_bf ) || !zIsTiny( zVec3DDist( &p, &cp ) - d ) ) result1 = false;
+      if( !zIsTiny( zShape3DClosest( zMShape3DShape(&ms,id), &p, &cp_bf ) - d ) ) result1 = false;
+      if( zMShape3DBVHPointIsInside( &mb, &p, true ) != zMShape3DPointIsInside( &ms, &p, true ) ) result2 = false;
+    }
+    /* move the shapes and rebuild the hierarchy */
+    zVec3DCreate( &disp, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    for( i=0; i<zMShape3DShapeNum(&ms); i++ ){
+      if( zMShape3DShape(&ms,i)->com == &zeo_shape3d_ph_com ){
+        for( j=0; j<zPH3DVertNum(zShape3DPH(zMShape3DShape(&ms,i))); j++ )
+          zVec3DAddDRC( zPH3DVert(zShape3DPH(zMShape3DShape(&ms,i)),j), &disp );
+      } else
+        zVec3DAddDRC( zBox3DCenter(zShape3DBox(zMShape3DShape(&ms,i))), &disp );
+    }
+    zMShape3DBVHReset( &mb );
+    if( zMShape3DBVHIsBuilt(&mb) ) result3 = false;
+  }
+  zMShape3DBVHDestroy( &mb );
+  zMShape3DDestroy( &ms );
+  /* empty shapes */
+  zMShape3DInit( &ms );
+  zMShape3DBVHInit( &mb, &ms );
+  if( zMShape3DBVHClosest( &mb, &p, &cp, &id ) != HUGE_VAL || id != -1 ) result3 = false;
+  if( zMShape3DBVHPointIsInside( &mb, &p, true ) ) result3 = false;
+  zMShape3DBVHDestroy( &mb );
+  zAssert( zMShape3DBVHClosest, result1 );
+  zAssert( zMShape3DBVHPointIsInside, result2 );
+  zAssert( zMShape3DBVHReset, result3 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_bvh();
+  assert_bvh_parallel();
+  assert_bvh_refit();
+  assert_bvh_pair();
+  assert_bvh_inside();
+  assert_mshape_bvh();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+
+/* check if a polyhedron is a closed convex hull which contains all points. */
+bool check_hull(zPH3D *ch, zVec3D p[], int n)
+{
+  zVec3D e;
+  register int i, j, k, l;
+  int count;
+
+  if( zPH3DFaceNum(ch) != 2 * zPH3DVertNum(ch) - 4 ) return false; /* Euler's formula */
+  for( i=0; i<zPH3DFaceNum(ch); i++ ){
+    /* contains all points */
+    for( j=0; j<n; j++ ){
+      zVec3DSub( &p[j], zPH3DFaceVert(ch,i,0), &e );
+      if( zVec3DInnerProd( zPH3DFaceNorm(ch,i), &e ) > zTOL ) return false;
+    }
+    /* each edge is shared with exactly one face in the opposite direction */
+    for( k=0; k<3; k++ ){
+      for( count=0, j=0; j<zPH3DFaceNum(ch); j++ )
+        for( l=0; l<3; l++ )
+          if( zPH3DFaceVert(ch,j,l) == zTri3DVertNext(zPH3DFace(ch,i),k) &&
+              zTri3DVertNext(zPH3DFace(ch,j),l) == zPH3DFaceVert(ch,i,k) ) count++;
+      if( count != 1 ) return false;
+    }
+  }
+  /* vertices are extreme points */
+  for( i=0; i<zPH3DVertNum(ch); i++ ){
+    for( j=0; j<n; j++ )
+      if( zVec3DEqual( zPH3DVert(ch,i), &p[j] ) ) break;
+    if( j == n ) return false;
+  }
+  return true;
+}
+
+void assert_ch3d(void)
+{
+  zVec3D p[N];
+  zPH3D ch;
+  zVec3DList pl;
+  register int i;
+  bool result;
+
+  /* random points in a ball */
+  for( i=0; i<N; i++ )
+    zVec3DCreatePolar( &p[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  result = zCH3D( &ch, p, N ) && check_hull( &ch, p, N );
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (ball), result );
+
+  /* random points on a sphere (all are extreme points) */
+  for( i=0; i<N; i++ )
+    zVec3DCreatePolar( &p[i], 1, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  result = zCH3D( &ch, p, N ) && check_hull( &ch, p, N ) && zPH3DVertNum(&ch) == N;
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (sphere), result );
+
+  /* points in a cube including coplanar points on the surface */
+  for( i=0; i<8; i++ )
+    zVec3DCreate( &p[i], i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1 );
+  for( ; i<N; i++ )
+    zVec3DCreate( &p[i], zRandI(-2,2)*0.5, zRandI(-2,2)*0.5, zRandI(-2,2)*0.5 );
+  result = zCH3D( &ch, p, N ) && check_hull( &ch, p, N ) && zIsTiny( zPH3DVolume(&ch) - 8 ) &&
+    zPH3DVertNum(&ch) == 8;
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (cube), result );
+
+  /* vector list */
+  for( i=0; i<N; i++ )
+    zVec3DCreate( &p[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zVec3DListFromArray( &pl, p, N );
+  result = zCH3DPL( &ch, &pl ) && check_hull( &ch, p, N );
+  zPH3DDestroy( &ch );
+  zVec3DListDestroy( &pl );
+  zAssert( zCH3DPL, result );
+}
+
+#define NP 50000
+
+void assert_ch3d_parallel(void)
+{
+  zVec3D *p;
+  zPH3D ch1, ch2;
+  register int i;
+  bool result;
+
+  if( !( p = zAlloc( zVec3D, NP ) ) ) return;
+  for( i=0; i<NP; i++ )
+    zVec3DCreatePolar( &p[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  result = zCH3D( &ch1, p, NP ) && zCH3DParallel( &ch2, p, NP, 4 ) &&
+    zPH3DVertNum(&ch1) == zPH3DVertNum(&ch2) && zPH3DFaceNum(&ch1) == zPH3DFaceNum(&ch2) &&
+    zIsTiny( zPH3DVolume(&ch1) - zPH3DVolume(&ch2) ) && check_hull( &ch2, p, NP );
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zFree( p );
+  zAssert( zCH3DParallel, result );
+}
+
+void assert_ch3d_inc(void)
+{
+  zVec3D p[N];
+  zCH3DInc chi;
+  zPH3D ch1, ch2;
+  register int i;
+  bool result = true;
+
+  zCH3DIncInit( &chi );
+  /* coplanar points */
+  for( i=0; i<4; i++ ){
+    zVec3DCreate( &p[i], zRandF(-1,1), zRandF(-1,1), 0 );
+    zCH3DIncAddPoint( &chi, &p[i] );
+  }
+  if( !zCH3DInc2PH3D( &chi, &ch2 ) || zPH3DVolume(&ch2) != 0 ) result = false;
+  zPH3DDestroy( &ch2 );
+  /* add points one by one and in groups */
+  for( ; i<N/2; i++ ){
+    zVec3DCreatePolar( &p[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    if( !zCH3DIncAddPoint( &chi, &p[i] ) ) result = false;
+  }
+  for( ; i<N; i++ )
+    zVec3DCreatePolar( &p[i], zRandF(0,1.2), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  for( i=N/2; i<N; i+=N/10 )
+    if( !zCH3DIncAdd( &chi, &p[i], zMin( N/10, N-i ) ) ) result = false;
+  if( !zCH3D( &ch1, p, N ) || !zCH3DInc2PH3D( &chi, &ch2 ) ||
+      zPH3DVertNum(&ch1) != zPH3DVertNum(&ch2) || !zIsTiny( zPH3DVolume(&ch1) - zPH3DVolume(&ch2) ) ||
+      !check_hull( &ch2, p, N ) ) result = false;
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zCH3DIncDestroy( &chi );
+  zAssert( zCH3DIncAdd, result );
+}
+
+bool check_adj(zPH3DAdj *adj1, zPH3DAdj *adj2)
+{
+  register int i, j, k;
+
+  if( adj1->num != adj2->num ) return false;
+  for( i=0; i<adj1->num; i++ ){
+    if( zPH3DAdjNeighborNum(adj1,i) != zPH3DAdjNeighborNum(adj2,i) ) return false;
+    for( j=0; j<zPH3DAdjNeighborNum(adj1,i); j++ ){
+      for( k=0; k<zPH3DAdjNeighborNum(adj2,i); k++ )
+        if( zPH3DAdjNeighbor(adj1,i,j) == zPH3DAdjNeighbor(adj2,i,k) ) break;
+      if( k == zPH3DAdjNeighborNum(adj2,i) ) return false;
+    }
+  }
+  return true;
+}
+
+void assert_ch3d_adj(void)
+{
+  zVec3D p[N];
+  zPH3D ch;
+  zPH3DAdj adj1, adj2;
+  register int i;
+  bool result;
+
+  for( i=0; i<N; i++ )
+    zVec3DCreatePolar( &p[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  result = zCH3DAdj( &ch, &adj1, p, N ) && zPH3DAdjCreate( &adj2, &ch ) && check_adj( &adj1, &adj2 ) &&
+    adj1.head[adj1.num] == 6 * zPH3DVertNum(&ch) - 12; /* twice the number of edges */
+  zPH3DDestroy( &ch );
+  zPH3DAdjDestroy( &adj1 );
+  zPH3DAdjDestroy( &adj2 );
+  zAssert( zCH3DAdj, result );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_ch3d();
+  assert_ch3d_parallel();
+  assert_ch3d_inc();
+  assert_ch3d_adj();
+  return EXIT_SUCCESS;
+}
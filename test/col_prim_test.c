@@ -0,0 +1,152 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+
+void vec_rand(zVec3D *v, double r)
+{
+  zVec3DCreate( v, zRandF(-r,r), zRandF(-r,r), zRandF(-r,r) );
+}
+
+void assert_edge(void)
+{
+  zVec3D v[4], c1, c2, p1, p2;
+  zEdge3D e1, e2;
+  double d, dmin;
+  register int i, j, k;
+  bool result1 = true, result2 = true;
+
+  for( i=0; i<N/10; i++ ){
+    for( j=0; j<4; j++ ) vec_rand( &v[j], 1 );
+    if( i % 4 == 1 ) zVec3DAdd( &v[2], zVec3DSub( &v[1], &v[0], &p1 ), &v[3] ); /* parallel */
+    if( i % 4 == 2 ) zVec3DCopy( &v[0], &v[1] ); /* degenerated */
+    zEdge3DCreate( &e1, &v[0], &v[1] );
+    zEdge3DCreate( &e2, &v[2], &v[3] );
+    d = zEdge3DClosestPair( &e1, &e2, &c1, &c2 );
+    if( !zIsTiny( zVec3DDist( &c1, &c2 ) - d ) || !zIsTiny( zEdge3DPointDist( &e2, &c2 ) ) ||
+        ( i % 4 == 2 ? !zVec3DEqual( &c1, &v[0] ) : !zIsTiny( zEdge3DPointDist( &e1, &c1 ) ) ) ) result1 = false;
+    for( dmin=HUGE_VAL, j=0; j<=100; j++ )
+      for( k=0; k<=100; k++ ){
+        zVec3DInterDiv( &v[0], &v[1], 0.01*j, &p1 );
+        zVec3DInterDiv( &v[2], &v[3], 0.01*k, &p2 );
+        dmin = zMin( dmin, zVec3DDist( &p1, &p2 ) );
+      }
+    if( d > dmin + zTOL ) result2 = false;
+  }
+  zAssert( zEdge3DClosestPair, result1 );
+  zAssert( zEdge3DClosestPair (global), result2 );
+}
+
+void assert_capsule(void)
+{
+  zVec3D v[4], c1, c2, p1, p2;
+  zEdge3D e1, e2;
+  double d, r1, r2;
+  register int i, j;
+  bool result = true;
+
+  for( i=0; i<N; i++ ){
+    for( j=0; j<4; j++ ) vec_rand( &v[j], 1 );
+    zEdge3DCreate( &e1, &v[0], &v[1] );
+    zEdge3DCreate( &e2, &v[2], &v[3] );
+    r1 = zRandF(0.01,0.5);
+    r2 = zRandF(0.01,0.5);
+    d = zEdge3DClosestPair( &e1, &e2, &p1, &p2 );
+    if( zCapsule3DClosestPair( &e1, r1, &e2, r2, &c1, &c2 ) ){
+      if( d > r1 + r2 || !zVec3DEqual( &c1, &c2 ) ||
+          zEdge3DPointDist( &e1, &c1 ) > r1 + zTOL || zEdge3DPointDist( &e2, &c2 ) > r2 + zTOL ) result = false;
+    } else{
+      if( d <= r1 + r2 || !zIsTiny( zVec3DDist( &c1, &c2 ) - ( d - r1 - r2 ) ) ) result = false;
+    }
+  }
+  zAssert( zCapsule3DClosestPair, result );
+}
+
+void shape_rand(zShape3D *s, int type)
+{
+  zVec3D c, c2, ax, ay, az;
+  zMat3D att;
+
+  vec_rand( &c, 1.5 );
+  vec_rand( &ax, 1 );
+  zMat3DFromAA( &att, &ax );
+  zMat3DCol( &att, zX, &ax );
+  zMat3DCol( &att, zY, &ay );
+  zMat3DCol( &att, zZ, &az );
+  switch( type ){
+  case 0: zShape3DSphereCreate( s, &c, zRandF(0.1,0.8), 0 ); break;
+  case 1: zShape3DBoxCreate( s, &c, &ax, &ay, &az, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1) ); break;
+  case 2: vec_rand( &c2, 0.8 ); zVec3DAddDRC( &c2, &c );
+          zShape3DCylCreate( s, &c, &c2, zRandF(0.1,0.5), 0 ); break;
+  default: zShape3DEllipsCreate( s, &c, &ax, &ay, &az, zRandF(0.1,0.8), zRandF(0.1,0.8), zRandF(0.1,0.8), 0 );
+  }
+}
+
+bool check_pair(int type1, int type2)
+{
+  zShape3D s1, s2;
+  zVec3D c1, c2, d1, d2, u, q;
+  double d;
+  register int i, j;
+  bool ret, result = true;
+
+  for( i=0; i<N; i++ ){
+    shape_rand( &s1, type1 );
+    shape_rand( &s2, type2 );
+    ret = zShape3DClosestPair( &s1, &s2, &c1, &c2 );
+    d = zShape3DDist( &s1, &s2 );
+    if( ret != zColChkShape3D( &s1, &s2 ) || ret != zIsTiny( d ) ) result = false;
+    /* GJK agrees except for shapes touching within round-off */
+    if( zGJKShape( &s1, NULL, &s2, NULL, &d1, &d2 ) ?
+        !ret && d > 1.0e-8 :
+        ( ret && zVec3DDist( &d1, &d2 ) > 1.0e-8 ) || !zIsTol( d - zVec3DDist( &d1, &d2 ), 1.0e-4 ) ) result = false;
+    if( ret ){ /* a common point */
+      if( !zVec3DEqual( &c1, &c2 ) ||
+          !zShape3DPointIsInside( &s1, &c1, true ) || !zShape3DPointIsInside( &s2, &c2, true ) ) result = false;
+    } else{
+      if( !zIsTiny( zVec3DDist( &c1, &c2 ) - d ) ||
+          zShape3DPointDist( &s1, &c1 ) > zTOL || zShape3DPointDist( &s2, &c2 ) > zTOL ) result = false;
+      for( j=0; j<10; j++ ){ /* no point on the surface of s1 is closer to s2 */
+        vec_rand( &u, 1 );
+        if( zShape3DPointDist( &s2, zShape3DSupportMap( &s1, &u, &q ) ) < d - zTOL ) result = false;
+      }
+    }
+    /* the reversed pair */
+    if( zShape3DClosestPair( &s2, &s1, &d2, &d1 ) != ret || !zIsTiny( zVec3DDist( &d1, &d2 ) - zVec3DDist( &c1, &c2 ) ) ) result = false;
+    zShape3DDestroy( &s1 );
+    zShape3DDestroy( &s2 );
+  }
+  return result;
+}
+
+bool check_fallback(void)
+{
+  zShape3D s1, s2;
+  zVec3D c1, c2, d1, d2;
+  register int i;
+  bool result = true;
+
+  for( i=0; i<N; i++ ){
+    shape_rand( &s1, 2 );
+    shape_rand( &s2, 3 );
+    if( zShape3DClosestPair( &s1, &s2, &c1, &c2 ) != zGJKShape( &s1, NULL, &s2, NULL, &d1, &d2 ) ||
+        !zVec3DEqual( &c1, &d1 ) || !zVec3DEqual( &c2, &d2 ) ) result = false;
+    zShape3DDestroy( &s1 );
+    zShape3DDestroy( &s2 );
+  }
+  return result;
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_edge();
+  assert_capsule();
+  zAssert( zShape3DClosestPair (sphere-sphere), check_pair( 0, 0 ) );
+  zAssert( zShape3DClosestPair (sphere-box), check_pair( 0, 1 ) );
+  zAssert( zShape3DClosestPair (box-sphere), check_pair( 1, 0 ) );
+  zAssert( zShape3DClosestPair (sphere-cylinder), check_pair( 0, 2 ) );
+  zAssert( zShape3DClosestPair (sphere-ellipsoid), check_pair( 0, 3 ) );
+  zAssert( zShape3DClosestPair (box-box), check_pair( 1, 1 ) );
+  zAssert( zShape3DClosestPair (fallback), check_fallback() );
+  return EXIT_SUCCESS;
+}
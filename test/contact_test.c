@@ -0,0 +1,145 @@
+#include <zeo/zeo.h>
+
+#define N 100
+#define DEPTH 0.01
+
+/* a box on the top face of a 2x2x1 box rotated about the vertical axis. */
+void box_on_box(zBox3D *b1, zBox3D *b2, double theta, double x, double y, double depth)
+{
+  zVec3D c, ax, ay;
+
+  zBox3DCreateAlign( b1, ZVEC3DZERO, 2, 2, 1 );
+  zVec3DCreate( &c, x, y, 1 - depth );
+  zVec3DCreate( &ax, cos(theta), sin(theta), 0 );
+  zVec3DCreate( &ay,-sin(theta), cos(theta), 0 );
+  zBox3DCreate( b2, &c, &ax, &ay, ZVEC3DZ, 1, 1, 1 );
+}
+
+/* check if a contact manifold is consistent with a box on a box. */
+bool check_manifold(zContactManifold3D *m, int num, double depth)
+{
+  zVec3D d;
+  register int i;
+
+  if( zContactManifold3DNum(m) != num ) return false;
+  if( !zVec3DEqual( zContactManifold3DNorm(m), ZVEC3DZ ) ) return false;
+  for( i=0; i<zContactManifold3DNum(m); i++ ){
+    if( !zIsTol( zContactManifold3DCP(m,i)->depth - depth, zTOL*10 ) ) return false;
+    zVec3DSub( &zContactManifold3DCP(m,i)->p1, &zContactManifold3DCP(m,i)->p2, &d );
+    zVec3DCatDRC( &d, -zContactManifold3DCP(m,i)->depth, zContactManifold3DNorm(m) );
+    if( !zVec3DIsTol( &d, zTOL*10 ) ) return false;
+    if( !zIsTol( zContactManifold3DCP(m,i)->p1.c.z - 0.5, zTOL*10 ) ) return false;
+  }
+  return true;
+}
+
+void assert_contact_box(void)
+{
+  zBox3D b1, b2;
+  zContactManifold3D m;
+  register int i;
+  bool result1 = true, result2 = true;
+
+  for( i=0; i<N; i++ ){
+    box_on_box( &b1, &b2, zRandF(-zPI,zPI), zRandF(-0.2,0.2), zRandF(-0.2,0.2), DEPTH );
+    zContactManifold3DInit( &m );
+    if( !zContactManifold3DBox3D( &m, &b1, &b2 ) || !check_manifold( &m, 4, DEPTH ) ) result1 = false;
+    box_on_box( &b1, &b2, zRandF(-zPI,zPI), zRandF(-0.2,0.2), zRandF(-0.2,0.2), -DEPTH );
+    zContactManifold3DInit( &m );
+    if( zContactManifold3DBox3D( &m, &b1, &b2 ) != 0 ) result2 = false;
+  }
+  zAssert( zContactManifold3DBox3D, result1 );
+  zAssert( zContactManifold3DBox3D (separated), result2 );
+}
+
+void assert_contact_ph(void)
+{
+  zBox3D b1, b2;
+  zPH3D ph1, ph2, oct;
+  zFrame3D f1, f2;
+  zVec3D v[16];
+  zContactManifold3D m;
+  register int i;
+  bool result1 = true, result2 = true, result3 = true;
+
+  for( i=0; i<N; i++ ){
+    box_on_box( &b1, &b2, zRandF(-zPI,zPI), zRandF(-0.2,0.2), zRandF(-0.2,0.2), DEPTH );
+    /* polyhedra in their local frames */
+    zFrame3DCopy( &b1.f, &f1 );
+    zFrame3DCopy( &b2.f, &f2 );
+    zFrame3DIdent( &b1.f );
+    zFrame3DIdent( &b2.f );
+    zBox3DToPH( &b1, &ph1 );
+    zBox3DToPH( &b2, &ph2 );
+    zContactManifold3DInit( &m );
+    if( !zContactManifold3DPH3D( &m, &ph1, &f1, &ph2, &f2 ) || !check_manifold( &m, 4, DEPTH ) ) result1 = false;
+    zPH3DDestroy( &ph1 );
+    zPH3DDestroy( &ph2 );
+  }
+  zAssert( zContactManifold3DPH3D, result1 );
+
+  /* a vertex of an octahedron on a face of a box */
+  zBox3DCreateAlign( &b1, ZVEC3DZERO, 2, 2, 1 );
+  zBox3DToPH( &b1, &ph1 );
+  zVec3DCreate( &v[0], 1, 0, 0 ); zVec3DCreate( &v[1],-1, 0, 0 );
+  zVec3DCreate( &v[2], 0, 1, 0 ); zVec3DCreate( &v[3], 0,-1, 0 );
+  zVec3DCreate( &v[4], 0, 0, 1 ); zVec3DCreate( &v[5], 0, 0,-1 );
+  zCH3D( &oct, v, 6 );
+  zFrame3DIdent( &f2 );
+  zVec3DCreate( zFrame3DPos(&f2), zRandF(-0.5,0.5), zRandF(-0.5,0.5), 1.5 - DEPTH );
+  zContactManifold3DInit( &m );
+  if( zContactManifold3DPH3D( &m, &ph1, NULL, &oct, &f2 ) != 1 || !check_manifold( &m, 1, DEPTH ) ||
+      !zIsTiny( zContactManifold3DCP(&m,0)->p2.c.x - zFrame3DPos(&f2)->c.x ) ||
+      !zIsTiny( zContactManifold3DCP(&m,0)->p2.c.y - zFrame3DPos(&f2)->c.y ) ) result2 = false;
+  zPH3DDestroy( &oct );
+  zAssert( zContactManifold3DPH3D (vertex-face), result2 );
+
+  /* an octagonal prism on a face of a box */
+  for( i=0; i<8; i++ ){
+    zVec3DCreate( &v[i],   0.5*cos(zPI*i/4), 0.5*sin(zPI*i/4), 0.5 );
+    zVec3DCreate( &v[i+8], 0.5*cos(zPI*i/4), 0.5*sin(zPI*i/4),-0.5 );
+  }
+  zCH3D( &oct, v, 16 );
+  zFrame3DIdent( &f2 );
+  zVec3DCreate( zFrame3DPos(&f2), zRandF(-0.5,0.5), zRandF(-0.5,0.5), 1 - DEPTH );
+  zContactManifold3DInit( &m );
+  if( !zContactManifold3DPH3D( &m, &ph1, NULL, &oct, &f2 ) || !check_manifold( &m, 4, DEPTH ) ) result3 = false;
+  zPH3DDestroy( &ph1 );
+  zPH3DDestroy( &oct );
+  zAssert( zContactManifold3DPH3D (reduction), result3 );
+}
+
+void assert_contact_persist(void)
+{
+  zBox3D b1, b2;
+  zContactManifold3D m;
+  register int i;
+  bool result1 = true, result2 = true;
+
+  box_on_box( &b1, &b2, zRandF(-zPI,zPI), 0, 0, DEPTH );
+  zContactManifold3DInit( &m );
+  zContactManifold3DBox3D( &m, &b1, &b2 );
+  for( i=0; i<zContactManifold3DNum(&m); i++ )
+    zContactManifold3DCP(&m,i)->impulse = i + 1;
+  /* slight motion keeps contact points */
+  zBox3DCenter(&b2)->c.x += 0.1 * zContactManifold3DTol(&m);
+  if( zContactManifold3DBox3D( &m, &b1, &b2 ) != 4 ) result1 = false;
+  for( i=0; i<zContactManifold3DNum(&m); i++ )
+    if( zContactManifold3DCP(&m,i)->life != 1 || zContactManifold3DCP(&m,i)->impulse == 0 ) result1 = false;
+  /* sliding breaks contact points */
+  zBox3DCenter(&b2)->c.x += 0.1;
+  if( zContactManifold3DBox3D( &m, &b1, &b2 ) != 4 ) result2 = false;
+  for( i=0; i<zContactManifold3DNum(&m); i++ )
+    if( zContactManifold3DCP(&m,i)->life != 0 || zContactManifold3DCP(&m,i)->impulse != 0 ) result2 = false;
+  zAssert( zContactManifold3DBox3D (persistent), result1 );
+  zAssert( zContactManifold3DBox3D (break), result2 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_contact_box();
+  assert_contact_ph();
+  assert_contact_persist();
+  return EXIT_SUCCESS;
+}
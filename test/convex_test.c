@@ -0,0 +1,371 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+#define T 100
+
+void vec_create_ball(zVec3D p[], int n, double r, zVec3D *c)
+{
+  register int i;
+
+  for( i=0; i<n; i++ ){
+    zVec3DCreatePolar( &p[i], zRandF(0,r), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    if( c ) zVec3DAddDRC( &p[i], c );
+  }
+}
+
+void frame_rand(zFrame3D *f, double r)
+{
+  zVec3D aa;
+
+  zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DFromAA( zFrame3DAtt(f), &aa );
+  zVec3DCreate( zFrame3DPos(f), zRandF(-r,r), zRandF(-r,r), zRandF(-r,r) );
+}
+
+void assert_support_map(void)
+{
+  zVec3D p[N], v;
+  zPH3D ch;
+  zPH3DAdj adj;
+  int hint = -1;
+  register int i;
+  bool result = true;
+
+  vec_create_ball( p, N, 1, NULL );
+  zCH3DAdj( &ch, &adj, p, N );
+  for( i=0; i<T; i++ ){
+    zVec3DCreate( &v, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    if( zPH3DAdjSupportMap( &adj, zPH3DVertBuf(&ch), &v, &hint ) != zVec3DSupportMap( zPH3DVertBuf(&ch), zPH3DVertNum(&ch), &v ) )
+      result = false;
+  }
+  zPH3DDestroy( &ch );
+  zPH3DAdjDestroy( &adj );
+  zAssert( zPH3DAdjSupportMap, result );
+}
+
+/* a cube whose faces are divided into fans around non-extreme vertices at their centers */
+zPH3D *cube_create_fan(zPH3D *ph)
+{
+  int a, b, c, k, s, corner[4];
+  register int i;
+
+  zPH3DAlloc( ph, 14, 24 );
+  for( i=0; i<8; i++ )
+    zVec3DCreate( zPH3DVert(ph,i), i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1 );
+  for( i=0, a=0; a<3; a++ ){
+    b = ( a + 1 ) % 3;
+    c = ( a + 2 ) % 3;
+    for( s=0; s<2; s++ ){
+      zVec3DZero( zPH3DVert(ph,8+2*a+s) );
+      zPH3DVert(ph,8+2*a+s)->e[a] = s ? 1 : -1;
+      corner[0] = s << a;
+      corner[1] = corner[0] | 1 << b;
+      corner[2] = corner[1] | 1 << c;
+      corner[3] = corner[0] | 1 << c;
+      for( k=0; k<4; k++ )
+        zTri3DCreate( zPH3DFace(ph,i++), zPH3DVert(ph,8+2*a+s), zPH3DVert(ph,corner[k]), zPH3DVert(ph,corner[(k+1)%4]) );
+    }
+  }
+  return ph;
+}
+
+void assert_support_map_plateau(void)
+{
+  zPH3D ph;
+  zPH3DAdj adj;
+  zVec3D v;
+  int hint;
+  register int i, j;
+  bool result = true;
+
+  cube_create_fan( &ph );
+  zPH3DAdjCreate( &adj, &ph );
+  for( i=8; i<14; i++ ) /* start from the center of each face */
+    for( j=0; j<6+T; j++ ){
+      if( j < 6 ){ /* normal vectors of faces, for which the climb hits plateaus */
+        zVec3DZero( &v );
+        v.e[j/2] = j % 2 ? 1 : -1;
+      } else
+        zVec3DCreate( &v, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      hint = i;
+      if( !zIsTiny( zVec3DInnerProd( zPH3DAdjSupportMap( &adj, zPH3DVertBuf(&ph), &v, &hint ), &v ) -
+                    zVec3DInnerProd( zVec3DSupportMap( zPH3DVertBuf(&ph), zPH3DVertNum(&ph), &v ), &v ) ) )
+        result = false;
+    }
+  zPH3DDestroy( &ph );
+  zPH3DAdjDestroy( &adj );
+  zAssert( zPH3DAdjSupportMap (plateau), result );
+}
+
+void assert_gjk_mpr(void)
+{
+  zVec3D p1[N], p2[N], q1[N], q2[N], c1, c2, d1, d2;
+  zPH3D ch1, ch2;
+  zPH3DAdj adj1, adj2;
+  zConvex3D cv1, cv2;
+  zFrame3D f1, f2;
+  register int i, j;
+  bool result1 = true, result2 = true, r1, r2;
+
+  vec_create_ball( p1, N, 1, NULL );
+  vec_create_ball( p2, N, 1, NULL );
+  zCH3DAdj( &ch1, &adj1, p1, N );
+  zCH3DAdj( &ch2, &adj2, p2, N );
+  zConvex3DPH3D( &cv1, &ch1, &adj1 );
+  zConvex3DPH3D( &cv2, &ch2, &adj2 );
+  zConvex3DSetFrame( &cv1, &f1 );
+  zConvex3DSetFrame( &cv2, &f2 );
+  for( i=0; i<T; i++ ){
+    frame_rand( &f1, 2 );
+    frame_rand( &f2, 2 );
+    for( j=0; j<zPH3DVertNum(&ch1); j++ ) zXform3D( &f1, zPH3DVert(&ch1,j), &q1[j] );
+    for( j=0; j<zPH3DVertNum(&ch2); j++ ) zXform3D( &f2, zPH3DVert(&ch2,j), &q2[j] );
+    r1 = zGJK( q1, zPH3DVertNum(&ch1), q2, zPH3DVertNum(&ch2), &c1, &c2 );
+    r2 = zGJKConvex( &cv1, &cv2, &d1, &d2 );
+    if( r1 != r2 || ( !r1 && !zIsTol( zVec3DDist(&c1,&c2) - zVec3DDist(&d1,&d2), zTOL*10 ) ) ) result1 = false;
+    if( zMPR( q1, zPH3DVertNum(&ch1), q2, zPH3DVertNum(&ch2) ) != zMPRConvex( &cv1, &cv2 ) ) result2 = false;
+  }
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zPH3DAdjDestroy( &adj1 );
+  zPH3DAdjDestroy( &adj2 );
+  zAssert( zGJKConvex, result1 );
+  zAssert( zMPRConvex, result2 );
+}
+
+void shape_create_rand(zShape3D shape[])
+{
+  zVec3D c1, c2, ax, ay, az;
+  zMat3D att;
+
+  zVec3DCreate( &c1, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zVec3DCreate( &c2, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zVec3DCreate( &ax, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DFromAA( &att, &ax );
+  zMat3DCol( &att, zX, &ax );
+  zMat3DCol( &att, zY, &ay );
+  zMat3DCol( &att, zZ, &az );
+  zShape3DBoxCreate( &shape[0], &c1, &ax, &ay, &az, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1) );
+  zShape3DSphereCreate( &shape[1], &c1, zRandF(0.1,1), 0 );
+  zShape3DEllipsCreate( &shape[2], &c1, &ax, &ay, &az, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1), 0 );
+  zShape3DCylCreate( &shape[3], &c1, &c2, zRandF(0.1,1), 0 );
+  zShape3DECylCreate( &shape[4], &c1, &c2, zRandF(0.1,1), zRandF(0.1,1), &ax, 0 );
+  zShape3DConeCreate( &shape[5], &c1, &c2, zRandF(0.1,1), 0 );
+}
+
+#define NS 6
+#define DIV 256
+
+void assert_shape_support_map(void)
+{
+  zShape3D shape[NS];
+  zPH3D ph;
+  zVec3D v, sp;
+  double d;
+  register int i, j;
+  bool result;
+
+  shape_create_rand( shape );
+  for( i=0; i<NS; i++ ){
+    shape[i].com->_toph( shape[i].body, &ph ); /* with the default division */
+    for( result=true, j=0; j<T; j++ ){
+      zVec3DCreate( &v, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      zShape3DSupportMap( &shape[i], &v, &sp );
+      d = zVec3DInnerProd( &sp, &v ) - zVec3DInnerProd( zVec3DSupportMap( zPH3DVertBuf(&ph), zPH3DVertNum(&ph), &v ), &v );
+      /* the support point is on the shape and is not behind vertices of the tessellation */
+      if( d < -zTOL || d > 0.1 * zVec3DNorm(&v) ) result = false;
+      if( !zShape3DPointIsInside( &shape[i], &sp, true ) && zShape3DPointDist( &shape[i], &sp ) > zTOL ) result = false;
+    }
+    zPH3DDestroy( &ph );
+    zAssert( zShape3DSupportMap, result );
+    zShape3DDestroy( &shape[i] );
+  }
+}
+
+void assert_gjk_shape(void)
+{
+  zShape3D s1, s2;
+  zVec3D c, c1, c2, p1[8], p2[8], q1[8], q2[8], d1, d2;
+  zFrame3D f1, f2;
+  double r1, r2;
+  register int i, j;
+  bool result1 = true, result2 = true, result3 = true, result4 = true;
+
+  for( i=0; i<T; i++ ){
+    /* spheres */
+    zVec3DCreate( &c, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zShape3DSphereCreate( &s1, &c, ( r1 = zRandF(0.1,1) ), 0 );
+    zShape3DSphereCreate( &s2, &c, ( r2 = zRandF(0.1,1) ), 0 );
+    frame_rand( &f1, 2 );
+    frame_rand( &f2, 2 );
+    zXform3D( &f1, &c, &c1 );
+    zXform3D( &f2, &c, &c2 );
+    if( zGJKShape( &s1, &f1, &s2, &f2, &d1, &d2 ) != ( zVec3DDist( &c1, &c2 ) < r1 + r2 ) ||
+        ( zVec3DDist( &c1, &c2 ) > r1 + r2 && !zIsTol( zVec3DDist( &d1, &d2 ) - ( zVec3DDist( &c1, &c2 ) - r1 - r2 ), zTOL*10 ) ) )
+      result1 = false;
+    if( zMPRShape( &s1, &f1, &s2, &f2 ) != ( zVec3DDist( &c1, &c2 ) < r1 + r2 ) ) result2 = false;
+    zShape3DDestroy( &s1 );
+    zShape3DDestroy( &s2 );
+    /* boxes against vertices */
+    zShape3DBoxCreate( &s1, &c, ZVEC3DX, ZVEC3DY, ZVEC3DZ, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1) );
+    zShape3DBoxCreate( &s2, &c, ZVEC3DX, ZVEC3DY, ZVEC3DZ, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1) );
+    for( j=0; j<8; j++ ){
+      zXform3D( &f1, zBox3DVert( zShape3DBox(&s1), j, &p1[j] ), &q1[j] );
+      zXform3D( &f2, zBox3DVert( zShape3DBox(&s2), j, &p2[j] ), &q2[j] );
+    }
+    if( zGJKShape( &s1, &f1, &s2, &f2, &d1, &d2 ) != zGJK( q1, 8, q2, 8, &c1, &c2 ) ||
+        !zIsTol( zVec3DDist( &c1, &c2 ) - zVec3DDist( &d1, &d2 ), zTOL*10 ) ) result3 = false;
+    if( zMPRShape( &s1, &f1, &s2, &f2 ) != zMPR( q1, 8, q2, 8 ) ) result4 = false;
+    zShape3DDestroy( &s1 );
+    zShape3DDestroy( &s2 );
+  }
+  zAssert( zGJKShape (sphere), result1 );
+  zAssert( zMPRShape (sphere), result2 );
+  zAssert( zGJKShape (box), result3 );
+  zAssert( zMPRShape (box), result4 );
+}
+
+void assert_gjk_shape_curved(void)
+{
+  zShape3D s1, s2;
+  zVec3D c1, c2, ax, ay, az, d1, d2;
+  zMat3D att;
+  double r, d;
+  register int i, type;
+  bool result = true;
+
+  for( type=0; type<3; type++ )
+    for( i=0; i<N; i++ ){
+      zVec3DCreate( &c1, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+      zVec3DCreate( &c2, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      zVec3DCreate( &ax, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      zMat3DFromAA( &att, &ax );
+      zMat3DCol( &att, zX, &ax );
+      zMat3DCol( &att, zY, &ay );
+      zMat3DCol( &att, zZ, &az );
+      zShape3DSphereCreate( &s1, &c1, ( r = zRandF(0.1,1) ), 0 );
+      switch( type ){
+      case 0: zShape3DSphereCreate( &s2, &c2, zRandF(0.1,1), 0 ); break;
+      case 1: zShape3DCylCreate( &s2, &c2, zVec3DAddDRC( &ax, &c2 ), zRandF(0.1,1), 0 ); break;
+      default: zShape3DEllipsCreate( &s2, &c2, &ax, &ay, &az, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1), 0 );
+      }
+      /* separated pairs, where the distance is measured from the center of the sphere */
+      if( ( d = zShape3DPointDist( &s2, &c1 ) - r ) > 1.0e-3 &&
+          ( zGJKShape( &s1, NULL, &s2, NULL, &d1, &d2 ) || !zIsTol( zVec3DDist( &d1, &d2 ) - d, 1.0e-4 ) ) )
+        result = false;
+      zShape3DDestroy( &s1 );
+      zShape3DDestroy( &s2 );
+    }
+  zAssert( zGJKShape (separated curved shapes), result );
+}
+
+void assert_gjk_cache(void)
+{
+  zVec3D p1[N], p2[N], c1, c2, d1, d2, dp, aa;
+  zPH3D ch1, ch2;
+  zPH3DAdj adj1, adj2;
+  zConvex3D cv1, cv2;
+  zGJKCache cache;
+  zFrame3D f1, f2;
+  zMat3D att;
+  register int i;
+  bool result = true, r1, r2;
+
+  vec_create_ball( p1, N, 1, NULL );
+  vec_create_ball( p2, N, 1, NULL );
+  zCH3DAdj( &ch1, &adj1, p1, N );
+  zCH3DAdj( &ch2, &adj2, p2, N );
+  zConvex3DPH3D( &cv1, &ch1, &adj1 );
+  zConvex3DPH3D( &cv2, &ch2, &adj2 );
+  zConvex3DSetFrame( &cv1, &f1 );
+  zConvex3DSetFrame( &cv2, &f2 );
+  frame_rand( &f1, 2 );
+  frame_rand( &f2, 2 );
+  zGJKCacheCreate( &cache, &cv1, &cv2 );
+  for( i=0; i<T; i++ ){ /* small motion */
+    zVec3DCreate( &dp, zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.1,0.1) );
+    zVec3DAddDRC( zFrame3DPos(&f2), &dp );
+    zVec3DCreate( &aa, zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.1,0.1) );
+    zMat3DRot( zFrame3DAtt(&f2), &aa, &att );
+    zMat3DCopy( &att, zFrame3DAtt(&f2) );
+    r1 = zGJKConvex( &cv1, &cv2, &c1, &c2 );
+    r2 = zGJKCacheCheck( &cache, &d1, &d2 );
+    if( r1 != r2 || ( !r1 && !zIsTol( zVec3DDist(&c1,&c2) - zVec3DDist(&d1,&d2), zTOL*10 ) ) ) result = false;
+  }
+  zGJKCacheDestroy( &cache );
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zPH3DAdjDestroy( &adj1 );
+  zPH3DAdjDestroy( &adj2 );
+  zAssert( zGJKCacheCheck, result );
+}
+
+void box_vert(zVec3D p[], zVec3D *c, zVec3D *d)
+{
+  register int i;
+
+  for( i=0; i<8; i++ )
+    zVec3DCreate( &p[i], c->e[zX] + ( i & 1 ? d->e[zX] : -d->e[zX] ),
+                         c->e[zY] + ( i & 2 ? d->e[zY] : -d->e[zY] ),
+                         c->e[zZ] + ( i & 4 ? d->e[zZ] : -d->e[zZ] ) );
+}
+
+void assert_epa(void)
+{
+  zShape3D s1, s2;
+  zVec3D p1[8], p2[8], o1, o2, d1, d2, mtv, c1, c2, dir;
+  zFrame3D f1, f2;
+  double r1, r2, depth, overlap;
+  register int i, k;
+  bool result1 = true, result2 = true, result3 = true;
+
+  for( i=0; i<T; i++ ){
+    /* axis-aligned boxes */
+    zVec3DCreate( &o1, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec3DCreate( &o2, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec3DCreate( &d1, zRandF(0.5,1), zRandF(0.5,1), zRandF(0.5,1) );
+    zVec3DCreate( &d2, zRandF(0.5,1), zRandF(0.5,1), zRandF(0.5,1) );
+    box_vert( p1, &o1, &d1 );
+    box_vert( p2, &o2, &d2 );
+    for( depth=HUGE_VAL, k=zX; k<=zZ; k++ )
+      if( ( overlap = d1.e[k] + d2.e[k] - fabs( o1.e[k] - o2.e[k] ) ) < depth ) depth = overlap;
+    if( zEPA( p1, 8, p2, 8, 0, 0, &mtv, &c1, &c2 ) != ( depth > 0 ) ) result1 = false;
+    if( depth > 0 ){
+      zVec3DSub( &c1, &c2, &dir );
+      if( !zIsTol( zVec3DNorm(&mtv) - depth, zTOL*10 ) || !zVec3DEqual( &dir, &mtv ) ) result1 = false;
+      /* separated by translating the second box by mtv */
+      zVec3DAddDRC( &o2, zVec3DMulDRC( &mtv, 1+1.0e-6 ) );
+      box_vert( p2, &o2, &d2 );
+      if( zGJK( p1, 8, p2, 8, &c1, &c2 ) ) result2 = false;
+    }
+    /* spheres */
+    zVec3DZero( &o1 );
+    zShape3DSphereCreate( &s1, &o1, ( r1 = zRandF(0.5,1) ), 0 );
+    zShape3DSphereCreate( &s2, &o1, ( r2 = zRandF(0.5,1) ), 0 );
+    frame_rand( &f1, 1 );
+    frame_rand( &f2, 1 );
+    if( ( depth = r1 + r2 - zVec3DDist( zFrame3DPos(&f1), zFrame3DPos(&f2) ) ) > 0 ){
+      if( !zEPAShape( &s1, &f1, &s2, &f2, 1.0e-8, 0, &mtv, &c1, &c2 ) ||
+          !zIsTol( zVec3DNorm(&mtv) - depth, 1.0e-6 ) ) result3 = false;
+    }
+    zShape3DDestroy( &s1 );
+    zShape3DDestroy( &s2 );
+  }
+  zAssert( zEPA, result1 );
+  zAssert( zEPA (separation), result2 );
+  zAssert( zEPAShape, result3 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_support_map();
+  assert_support_map_plateau();
+  assert_gjk_mpr();
+  assert_shape_support_map();
+  assert_gjk_shape();
+  assert_gjk_shape_curved();
+  assert_gjk_cache();
+  assert_epa();
+  return EXIT_SUCCESS;
+}
@@ -88,10 +88,28 @@ void assert_inside(void)
   zAssert( zCyl3DPointIsInside, nitest == ni && notest == no );
 }
 
+void assert_closest(void)
+{
+  zCyl3D cyl;
+  zVec3D p, cp;
+  double d;
+  register int i;
+  bool result = true;
+
+  generate_cyl_rand( &cyl );
+  for( i=0; i<1000; i++ ){
+    zVec3DCreate( &p, zRandF(-5,5), zRandF(-5,5), zRandF(-5,5) );
+    d = zCyl3DClosest( &cyl, &p, &cp );
+    if( d < 0 || !zIsTiny( zVec3DDist( &p, &cp ) - d ) || !zIsTiny( zCyl3DPointDist( &cyl, &p ) - d ) ) result = false;
+  }
+  zAssert( zCyl3DClosest + zCyl3DPointDist, result );
+}
+
 int main(void)
 {
   zRandInit();
   assert_volume_inertia();
   assert_inside();
+  assert_closest();
   return EXIT_SUCCESS;
 }
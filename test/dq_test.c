@@ -0,0 +1,170 @@
+#include <zeo/zeo.h>
+
+void frame_rand(zFrame3D *f)
+{
+  zVec3D aa;
+
+  zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DFromAA( zFrame3DAtt(f), &aa );
+  zVec3DCreate( zFrame3DPos(f), zRandF(-10,10), zRandF(-10,10), zRandF(-10,10) );
+}
+
+bool frame_equal(zFrame3D *f1, zFrame3D *f2)
+{
+  return zVec3DEqual( zFrame3DPos(f1), zFrame3DPos(f2) ) && zMat3DEqual( zFrame3DAtt(f1), zFrame3DAtt(f2) );
+}
+
+void assert_frame(void)
+{
+  zFrame3D f1, f2;
+  zDQ dq;
+  zVec3D aa, pos;
+  zEP ep;
+
+  frame_rand( &f1 );
+  zDQFromFrame3D( &dq, &f1 );
+  zDQToFrame3D( &dq, &f2 );
+  zAssert( zDQFromFrame3D + zDQToFrame3D, frame_equal( &f1, &f2 ) );
+
+  zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zAA2EP( &aa, &ep );
+  zVec3DCreate( &pos, zRandF(-10,10), zRandF(-10,10), zRandF(-10,10) );
+  zDQCreate( &dq, &ep, &pos );
+  zMat3DFromAA( zFrame3DAtt(&f1), &aa );
+  zFrame3DSetPos( &f1, &pos );
+  zDQToFrame3D( &dq, &f2 );
+  zAssert( zDQCreate, frame_equal( &f1, &f2 ) );
+}
+
+void assert_xform(void)
+{
+  zFrame3D f;
+  zDQ dq;
+  zVec3D v, tv1, tv2;
+
+  frame_rand( &f );
+  zDQFromFrame3D( &dq, &f );
+  zVec3DCreate( &v, zRandF(-10,10), zRandF(-10,10), zRandF(-10,10) );
+  zXform3D( &f, &v, &tv1 );
+  zXform3DDQ( &dq, &v, &tv2 );
+  zAssert( zXform3DDQ, zVec3DEqual( &tv1, &tv2 ) );
+  zXform3DInv( &f, &v, &tv1 );
+  zXform3DInvDQ( &dq, &v, &tv2 );
+  zAssert( zXform3DInvDQ, zVec3DEqual( &tv1, &tv2 ) );
+}
+
+void assert_cascade(void)
+{
+  zFrame3D f1, f2, f, fdq;
+  zDQ dq1, dq2, dq;
+
+  frame_rand( &f1 );
+  frame_rand( &f2 );
+  zDQFromFrame3D( &dq1, &f1 );
+  zDQFromFrame3D( &dq2, &f2 );
+
+  zFrame3DCascade( &f1, &f2, &f );
+  zDQCascade( &dq1, &dq2, &dq );
+  zAssert( zDQCascade, frame_equal( &f, zDQToFrame3D( &dq, &fdq ) ) );
+
+  zFrame3DXform( &f1, &f2, &f );
+  zDQXform( &dq1, &dq2, &dq );
+  zAssert( zDQXform, frame_equal( &f, zDQToFrame3D( &dq, &fdq ) ) );
+
+  zFrame3DInv( &f1, &f );
+  zDQInv( &dq1, &dq );
+  zAssert( zDQInv, frame_equal( &f, zDQToFrame3D( &dq, &fdq ) ) );
+}
+
+void assert_normalize(void)
+{
+  zFrame3D f, fdq;
+  zDQ dq;
+  register int i;
+
+  frame_rand( &f );
+  zDQFromFrame3D( &dq, &f );
+  for( i=0; i<8; i++ ) dq.e[i] *= 1.5;
+  dq.q.d.ex.w += 1.0e-3 * dq.q.r.ex.w;
+  zDQNormalize( &dq );
+  zAssert( zDQNormalize,
+    zIsTiny( zEPNorm( &dq.q.r ) - 1 ) && zIsTiny( zEPInnerProd( &dq.q.r, &dq.q.d ) ) &&
+    zMat3DEqual( zFrame3DAtt(&f), zFrame3DAtt(zDQToFrame3D(&dq,&fdq)) ) );
+}
+
+void assert_interdiv(void)
+{
+  zFrame3D f1, f2, fdq;
+  zDQ dq1, dq2, dq, dqh1, dqh2;
+  zEP ep;
+  zVec3D aa, axis, p1, p2, p, dp;
+  double t;
+
+  frame_rand( &f1 );
+  frame_rand( &f2 );
+  zDQFromFrame3D( &dq1, &f1 );
+  zDQFromFrame3D( &dq2, &f2 );
+  zDQInterDiv( &dq1, &dq2, 0, &dq );
+  zAssert( zDQInterDiv (t=0), frame_equal( &f1, zDQToFrame3D( &dq, &fdq ) ) );
+  zDQInterDiv( &dq1, &dq2, 1, &dq );
+  zAssert( zDQInterDiv (t=1), frame_equal( &f2, zDQToFrame3D( &dq, &fdq ) ) );
+
+  /* consistency with SLERP */
+  t = zRandF(0,1);
+  zEPInterDiv( &dq1.q.r, &dq2.q.r, t, &ep );
+  zDQInterDiv( &dq1, &dq2, t, &dq );
+  zAssert( zDQInterDiv (rotation), zIsTiny( fabs( zEPInnerProd( &ep, &dq.q.r ) ) - 1 ) );
+
+  /* constant velocity: two half steps equal the whole */
+  zDQInterDiv( &dq1, &dq2, 0.5, &dqh1 );
+  zDQXform( &dq1, &dqh1, &dqh2 );
+  zDQCascade( &dqh1, &dqh2, &dq );
+  zAssert( zDQInterDiv (screw), frame_equal( &f2, zDQToFrame3D( &dq, &fdq ) ) );
+
+  /* pure translation */
+  zDQCreate( &dq1, &dq1.q.r, zVec3DCreate( &p1, 1, 2, 3 ) );
+  zDQCreate( &dq2, &dq1.q.r, zVec3DCreate( &p2, -3, 0, 5 ) );
+  zDQInterDiv( &dq1, &dq2, t, &dq );
+  zVec3DInterDiv( &p1, &p2, t, &p );
+  zAssert( zDQInterDiv (translation), zVec3DEqual( &p, zDQPos( &dq, &dp ) ) );
+
+  /* rotation about a fixed axis keeps points on the axis */
+  zVec3DCreate( &axis, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zVec3DNormalizeDRC( &axis );
+  zVec3DMul( &axis, zPI*0.8, &aa );
+  zAA2EP( &aa, &ep );
+  zVec3DCreate( &p, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zEPRotVec3D( &ep, &p, &dp );
+  zVec3DSub( &p, &dp, &p2 );
+  zDQIdent( &dq1 );
+  zDQCreate( &dq2, &ep, &p2 ); /* rotation about the axis through p */
+  zDQInterDiv( &dq1, &dq2, t, &dq );
+  zXform3DDQ( &dq, &p, &dp );
+  zAssert( zDQInterDiv (fixed axis), zVec3DEqual( &p, &dp ) );
+}
+
+void assert_blend(void)
+{
+  zFrame3D f, fdq;
+  zDQ dq[3], dqb;
+  double w[] = { 0.2, 0.3, 0.5 };
+  register int i;
+
+  frame_rand( &f );
+  for( i=0; i<3; i++ ) zDQFromFrame3D( &dq[i], &f );
+  for( i=0; i<8; i++ ) dq[2].e[i] = -dq[2].e[i]; /* antipodal */
+  zDQBlend( dq, w, 3, &dqb );
+  zAssert( zDQBlend, frame_equal( &f, zDQToFrame3D( &dqb, &fdq ) ) );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_frame();
+  assert_xform();
+  assert_cascade();
+  assert_normalize();
+  assert_interdiv();
+  assert_blend();
+  return EXIT_SUCCESS;
+}
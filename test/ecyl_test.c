@@ -77,17 +77,19 @@ void assert_inside(void)
   zVec3D p;
   double x, y, z;
   register int i;
-  int n = 1000, ni, no, nitest, notest;
+  int n = 1000, ni, no, nitest, notest, nitest_strict;
 
   generate_ecyl_rand( &ecyl );
-  for( ni=no=nitest=notest=0, i=0; i<n; i++ ){
+  for( ni=no=nitest=notest=nitest_strict=0, i=0; i<n; i++ ){
     x = zRandF(-2,2);
     y = zRandF(-2,2);
     z = zRandF(-1,2);
     ecyl_cat( &ecyl, x, y, z, &p ) ? ni++ : no++;
     zECyl3DPointIsInside( &ecyl, &p, true ) ? nitest++ : notest++;
+    if( zECyl3DPointIsInside( &ecyl, &p, false ) ) nitest_strict++;
   }
   zAssert( zECyl3DPointIsInside, nitest == ni && notest == no );
+  zAssert( zECyl3DPointIsInside (without rim), nitest_strict == ni );
 }
 
 int main(void)
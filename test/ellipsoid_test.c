@@ -91,10 +91,87 @@ void assert_inside(void)
   zAssert( zEllips3DPointIsInside, nitest == ni && notest == no );
 }
 
+void assert_toph(void)
+{
+  zEllips3D ellips;
+  zPH3D ph;
+  zVec3D c;
+  register int i;
+  bool result = true;
+
+  generate_ellips_rand( &ellips );
+  zEllips3DSetDiv( &ellips, 16 );
+  zEllips3DToPH( &ellips, &ph );
+  for( i=0; i<zPH3DFaceNum(&ph); i++ ){
+    zTri3DBarycenter( zPH3DFace(&ph,i), &c );
+    zVec3DSubDRC( &c, zEllips3DCenter(&ellips) );
+    if( zVec3DInnerProd( &c, zTri3DNorm(zPH3DFace(&ph,i)) ) <= 0 ) result = false;
+  }
+  zPH3DDestroy( &ph );
+  zAssert( zEllips3DToPH (outward normals), result );
+}
+
+bool check_closest(zEllips3D *ellips, zVec3D *p, zVec3D *cp, double d)
+{
+  zVec3D pi, ci, n, e;
+  double s;
+  register int i;
+
+  if( !zIsTiny( zVec3DDist( p, cp ) - d ) ) return false;
+  if( zEllips3DPointIsInside( ellips, p, true ) ) return zIsTiny( d );
+  zXform3DInv( &ellips->f, p, &pi );
+  zXform3DInv( &ellips->f, cp, &ci );
+  for( s=0, i=zX; i<=zZ; i++ ){
+    s += zSqr( ci.e[i] / zEllips3DRadius(ellips,i) );
+    n.e[i] = ci.e[i] / zSqr( zEllips3DRadius(ellips,i) );
+  }
+  /* on the surface, and the error vector along the normal vector */
+  zVec3DSub( &pi, &ci, &e );
+  zVec3DOuterProd( &e, &n, &pi );
+  return zIsTol( s - 1, 1.0e-9 ) && zVec3DNorm(&pi) < 1.0e-8 * zVec3DNorm(&e) * zVec3DNorm(&n) && zVec3DInnerProd( &e, &n ) > 0;
+}
+
+void assert_closest(void)
+{
+  zEllips3D ellips;
+  zVec3D p[100], cp[100], q;
+  double d[100], dmin;
+  register int i, j, k;
+  bool result1 = true, result2 = true, result3 = true;
+
+  for( k=0; k<10; k++ ){
+    generate_ellips_rand( &ellips );
+    for( i=0; i<100; i++ ){
+      if( i % 4 == 0 ) /* on the principal axes */
+        zVec3DCat( zEllips3DCenter(&ellips), zRandF(-10,10), zEllips3DAxis(&ellips,i/4%3), &p[i] );
+      else
+        zVec3DCreate( &p[i], zRandF(-10,10), zRandF(-10,10), zRandF(-10,10) );
+      d[i] = zEllips3DClosest( &ellips, &p[i], &cp[i] );
+      if( !check_closest( &ellips, &p[i], &cp[i], d[i] ) ) result1 = false;
+      /* not farther than sampled points on the surface */
+      for( dmin=HUGE_VAL, j=0; j<1000; j++ ){
+        zVec3DCreatePolar( &q, 1, zRandF(0,zPI), zRandF(-zPI,zPI) );
+        zVec3DCreate( &q, q.c.x*zEllips3DRadiusX(&ellips), q.c.y*zEllips3DRadiusY(&ellips), q.c.z*zEllips3DRadiusZ(&ellips) );
+        zXform3DDRC( &ellips.f, &q );
+        dmin = zMin( dmin, zVec3DDist( &p[i], &q ) );
+      }
+      if( d[i] > dmin + zTOL ) result2 = false;
+    }
+    zEllips3DClosestBatch( &ellips, p, 100, cp, d );
+    for( i=0; i<100; i++ )
+      if( !zIsTiny( zEllips3DPointDist( &ellips, &p[i] ) - d[i] ) || !check_closest( &ellips, &p[i], &cp[i], d[i] ) ) result3 = false;
+  }
+  zAssert( zEllips3DClosest, result1 );
+  zAssert( zEllips3DClosest (global), result2 );
+  zAssert( zEllips3DClosestBatch, result3 );
+}
+
 int main(void)
 {
   zRandInit();
   assert_volume_inertia();
   assert_inside();
+  assert_toph();
+  assert_closest();
   return EXIT_SUCCESS;
 }
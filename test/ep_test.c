@@ -83,6 +83,87 @@ void assert_cascade(void)
   zAssert( zEPCascade, zMat3DEqual( &m3, &test_m ) );
 }
 
+#define N 200
+
+/* create a unit Euler parameter; some of them are close to the rotations by pi. */
+void ep_rand(zEP *ep, int i)
+{
+  zVec3D aa;
+
+  zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zVec3DNormalizeDRC( &aa );
+  zVec3DMulDRC( &aa, i % 4 == 0 ? zRandF(zPI-0.01,zPI) : zRandF(0,zPI) );
+  zAA2EP( &aa, ep );
+}
+
+void assert_array(void)
+{
+  zEP ep1[N], ep2[N], ep[N], epvel[N], test_ep;
+  zMat3D m[N], m1, m2, test_m;
+  zVec3D av[N], test_av[N], aa, v, rv, test_v;
+  double t[N], c;
+  register int i;
+  bool result_slerp = true, result_nlerp = true, result_from = true, result_to = true, result_vel = true;
+
+  for( i=0; i<N; i++ ){
+    ep_rand( &ep1[i], i );
+    ep_rand( &ep2[i], i+1 );
+    t[i] = zRandF(0,1);
+  }
+  /* SLERP: rotation of the first attitude by t times the relative angle-axis vector */
+  zEPInterDivArray( ep1, ep2, t, N, ep );
+  for( i=0; i<N; i++ ){
+    zMat3DFromEP( &m1, &ep1[i] );
+    zMat3DFromEP( &m2, &ep2[i] );
+    zMulMat3DTMat3D( &m1, &m2, &test_m );
+    zMat3DToAA( &test_m, &aa );
+    zVec3DMulDRC( &aa, t[i] );
+    zMat3DFromAA( &m2, &aa );
+    zMulMat3DMat3D( &m1, &m2, &test_m );
+    zMat3DFromEP( &m2, &ep[i] );
+    if( !zMat3DEqual( &m2, &test_m ) || !zIsTiny( zEPNorm( &ep[i] ) - 1 ) ) result_slerp = false;
+  }
+  /* NLERP: normalized linear interpolation along the shorter path */
+  zEPInterDivNLArray( ep1, ep2, t, N, ep );
+  for( i=0; i<N; i++ ){
+    c = zEPInnerProd( &ep1[i], &ep2[i] ) < 0 ? -t[i] : t[i];
+    zEPMul( &ep1[i], 1-t[i], &test_ep );
+    zEPCatDRC( &test_ep, c, &ep2[i] );
+    zEPNormalize( &test_ep );
+    zEPSubDRC( &test_ep, &ep[i] );
+    if( !zIsTiny( zEPNorm( &test_ep ) ) || !zIsTiny( zEPNorm( &ep[i] ) - 1 ) ) result_nlerp = false;
+  }
+  /* conversion to matrices: the same rotation of a vector */
+  zMat3DFromEPArray( m, ep1, N );
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &v, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zMulMat3DVec3D( &m[i], &v, &rv );
+    zEPRotVec3D( &ep1[i], &v, &test_v );
+    if( !zVec3DEqual( &rv, &test_v ) ) result_from = false;
+  }
+  /* conversion from matrices: the original parameters up to the sign */
+  if( !zMat3DToEPArray( m, ep, N ) ) result_to = false;
+  for( i=0; i<N; i++ ){
+    c = zEPInnerProd( &ep[i], &ep1[i] ) < 0 ? -1 : 1;
+    zEPMul( &ep1[i], c, &test_ep );
+    zEPSubDRC( &test_ep, &ep[i] );
+    if( !zIsTiny( zEPNorm( &test_ep ) ) ) result_to = false;
+  }
+  /* angular velocity: the inverse of zAngVel2EPVel() */
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &av[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zAngVel2EPVel( &av[i], &ep1[i], &epvel[i] );
+  }
+  zEPVel2AngVelArray( epvel, ep1, test_av, N );
+  for( i=0; i<N; i++ )
+    if( !zVec3DEqual( &av[i], &test_av[i] ) ) result_vel = false;
+  zAssert( zEPInterDivArray, result_slerp );
+  zAssert( zEPInterDivNLArray, result_nlerp );
+  zAssert( zMat3DFromEPArray, result_from );
+  zAssert( zMat3DToEPArray, result_to );
+  zAssert( zEPVel2AngVelArray, result_vel );
+}
+
 int main(void)
 {
   zRandInit();
@@ -91,5 +172,6 @@ int main(void)
   assert_rotate();
   assert_vel();
   assert_cascade();
+  assert_array();
   return EXIT_SUCCESS;
 }
@@ -429,6 +429,63 @@ void assert_sym_eig(void)
   zAssert( zMat3DSymEig, result );
 }
 
+bool check_sym_eig(zMat3D *m, double eval[], zVec3D evec[], double tol)
+{
+  zVec3D v;
+  register int i;
+
+  if( eval[0] < eval[1] || eval[1] < eval[2] ) return false;
+  if( !zIsTol( zVec3DGrassmannProd( &evec[0], &evec[1], &evec[2] ) - 1, tol ) ) return false;
+  for( i=0; i<3; i++ ){
+    zMulMat3DVec3D( m, &evec[i], &v );
+    zVec3DCatDRC( &v, -eval[i], &evec[i] );
+    if( !zVec3DIsTol( &v, tol ) ) return false;
+  }
+  return true;
+}
+
+#define N 100
+
+void assert_sym_eig_trig(void)
+{
+  zMat3D m[N], r;
+  double eval[3*N];
+  zVec3D evec[3*N], aa;
+  double xx, yy, zz, xy, yz, zx;
+  bool result_trig = true, result_deg = true, result_array = true;
+  double test_tol = 1.0e-6;
+  register int i;
+
+  for( i=0; i<N; i++ ){
+    xx = zRandF(-10,10);
+    yy = zRandF(-10,10);
+    zz = zRandF(-10,10);
+    xy = zRandF(-10,10);
+    yz = zRandF(-10,10);
+    zx = zRandF(-10,10);
+    zMat3DCreate( &m[i], xx, xy, zx, xy, yy, yz, zx, yz, zz );
+    zMat3DSymEigTrig( &m[i], eval, evec );
+    if( !check_sym_eig( &m[i], eval, evec, test_tol ) ) result_trig = false;
+  }
+  zMat3DSymEigTrigArray( m, N, eval, evec );
+  for( i=0; i<N; i++ )
+    if( !check_sym_eig( &m[i], &eval[3*i], &evec[3*i], test_tol ) ) result_array = false;
+  /* degenerated spectra */
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zMat3DFromAA( &r, &aa );
+    xx = zRandF(-10,10);
+    yy = i % 3 == 0 ? xx : zRandF(-10,10);
+    zMat3DCreate( &m[i], xx, 0, 0, 0, yy, 0, 0, 0, i % 3 == 2 ? xx : yy );
+    zRotMat3DDRC( &r, &m[i] );
+    zMat3DSymEigTrig( &m[i], eval, evec );
+    if( !check_sym_eig( &m[i], eval, evec, test_tol ) ) result_deg = false;
+  }
+  zAssert( zMat3DSymEigTrig, result_trig );
+  zAssert( zMat3DSymEigTrig (degenerated case), result_deg );
+  zAssert( zMat3DSymEigTrigArray, result_array );
+}
+
 int main(void)
 {
   zRandInit();
@@ -440,5 +497,6 @@ int main(void)
   assert_mat_inv();
   assert_rot();
   assert_sym_eig();
+  assert_sym_eig_trig();
   return EXIT_SUCCESS;
 }
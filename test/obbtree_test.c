@@ -0,0 +1,107 @@
+#include <zeo/zeo.h>
+
+#define N 30
+
+/* check structure of a subtree; returns the number of faces, the first of which is stored in head. */
+int check_subtree(zPH3DOBBTree *tree, int id, int level, bool *mark, int *head, bool *result)
+{
+  zPH3DOBBTreeNode *node;
+  zTri3D *t;
+  int num, head2;
+  register int i, j;
+
+  node = zPH3DOBBTreeNode(tree,id);
+  if( level > zPH3DOBBTreeDepth(tree) ) *result = false;
+  if( zPH3DOBBTreeIsLeaf(tree,id) ){
+    if( node->num != 1 || mark[zPH3DOBBTreeLeafFace(tree,id,0)] ) *result = false;
+    mark[zPH3DOBBTreeLeafFace(tree,id,0)] = true;
+    *head = node->head;
+    num = 1;
+  } else{
+    if( node->head <= id + 1 || node->head >= zPH3DOBBTreeNodeNum(tree) ) *result = false;
+    num = check_subtree( tree, id+1, level+1, mark, head, result );
+    j = check_subtree( tree, node->head, level+1, mark, &head2, result );
+    if( head2 != *head + num ) *result = false;
+    num += j;
+  }
+  /* a box contains all vertices of faces below it */
+  for( i=*head; i<*head+num; i++ ){
+    t = zPH3DFace(tree->ph,tree->face[i]);
+    for( j=0; j<3; j++ )
+      if( !zBox3DPointIsInside( &node->obb, zTri3DVert(t,j), true ) ) *result = false;
+  }
+  return num;
+}
+
+bool check_obbtree(zPH3DOBBTree *tree)
+{
+  bool *mark, result = true;
+  int head;
+
+  mark = zAlloc( bool, zPH3DFaceNum(tree->ph) );
+  if( check_subtree( tree, 0, 0, mark, &head, &result ) != zPH3DFaceNum(tree->ph) || head != 0 ) result = false;
+  zFree( mark );
+  return result && zPH3DOBBTreeNodeNum(tree) == 2*zPH3DFaceNum(tree->ph)-1 && zPH3DOBBTreeDepth(tree) < ZEO_PH3D_OBBTREE_DEPTH_MAX;
+}
+
+bool pair_mark(int f1, int f2, void *priv)
+{
+  int *count = priv;
+
+  count[0]++;
+  count[1] += f1 * 7919 + f2; /* checksum of found pairs */
+  return true;
+}
+
+void assert_obbtree(void)
+{
+  zEllips3D e1, e2;
+  zPH3D ph1, ph2, ph1x, ph2x;
+  zPH3DOBBTree tree1, tree2;
+  zFrame3D f1, f2;
+  int count[2], count_bf[2], face1, face2;
+  register int i, j, k;
+  bool result1, result2 = true, result3 = true, hit;
+
+  zEllips3DCreateAlign( &e1, ZVEC3DZERO, 1.0, 0.6, 0.3, 16 );
+  zEllips3DCreateAlign( &e2, ZVEC3DZERO, 1.2, 0.1, 0.05, 16 ); /* thin */
+  zEllips3DToPH( &e1, &ph1 );
+  zEllips3DToPH( &e2, &ph2 );
+  zPH3DOBBTreeCreate( &tree1, &ph1 );
+  zPH3DOBBTreeCreate( &tree2, &ph2 );
+  result1 = check_obbtree( &tree1 ) && check_obbtree( &tree2 );
+  for( k=0; k<N; k++ ){
+    zFrame3DFromZYX( &f1, zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-zPI,zPI), zRandF(-zPI_2,zPI_2), zRandF(-zPI,zPI) );
+    zFrame3DFromZYX( &f2, zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-zPI,zPI), zRandF(-zPI_2,zPI_2), zRandF(-zPI,zPI) );
+    count[0] = count[1] = 0;
+    zPH3DOBBTreeQueryPair( &tree1, &f1, &tree2, &f2, pair_mark, count );
+    /* brute force on transformed polyhedra */
+    zPH3DClone( &ph1, &ph1x ); zPH3DXform( &ph1, &f1, &ph1x );
+    zPH3DClone( &ph2, &ph2x ); zPH3DXform( &ph2, &f2, &ph2x );
+    count_bf[0] = count_bf[1] = 0;
+    for( i=0; i<zPH3DFaceNum(&ph1x); i++ )
+      for( j=0; j<zPH3DFaceNum(&ph2x); j++ )
+        if( zColChkTri3D( zPH3DFace(&ph1x,i), zPH3DFace(&ph2x,j) ) ) pair_mark( i, j, count_bf );
+    if( count[0] != count_bf[0] || count[1] != count_bf[1] ) result2 = false;
+    hit = zPH3DOBBTreeColChk( &tree1, &f1, &tree2, &f2, &face1, &face2 );
+    if( hit != ( count_bf[0] > 0 ) ||
+        ( hit && !zColChkTri3D( zPH3DFace(&ph1x,face1), zPH3DFace(&ph2x,face2) ) ) ) result3 = false;
+    zPH3DDestroy( &ph1x );
+    zPH3DDestroy( &ph2x );
+  }
+  zPH3DOBBTreeDestroy( &tree1 );
+  zPH3DOBBTreeDestroy( &tree2 );
+  zPH3DDestroy( &ph1 );
+  zPH3DDestroy( &ph2 );
+
+  zAssert( zPH3DOBBTreeCreate, result1 );
+  zAssert( zPH3DOBBTreeQueryPair, result2 );
+  zAssert( zPH3DOBBTreeColChk, result3 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_obbtree();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+#include <zeo/zeo.h>
+
+#define NS 24
+#define W  40
+#define H  30
+
+/* a scene of primitives scattered around the origin; every fourth one is a polyhedron. */
+zMShape3D *scene_create(zMShape3D *ms)
+{
+  zVec3D c1, c2;
+  register int i;
+
+  zMShape3DInit( ms );
+  zArrayAlloc( &ms->shape, zShape3D, NS );
+  for( i=0; i<NS; i++ ){
+    zVec3DCreate( &c1, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+    zVec3DCreate( &c2, zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-0.5,0.5) );
+    zVec3DAddDRC( &c2, &c1 );
+    switch( i % 4 ){
+    case 0: zShape3DSphereCreate( zMShape3DShape(ms,i), &c1, zRandF(0.1,0.5), 0 ); break;
+    case 1: zShape3DCylCreate( zMShape3DShape(ms,i), &c1, &c2, zRandF(0.1,0.5), 0 ); break;
+    case 2: zShape3DEllipsCreateAlign( zMShape3DShape(ms,i), &c1, zRandF(0.1,0.5), zRandF(0.1,0.5), zRandF(0.1,0.5), 0 ); break;
+    default:
+      zShape3DBoxCreateAlign( zMShape3DShape(ms,i), &c1, zRandF(0.1,1), zRandF(0.1,1), zRandF(0.1,1) );
+      zShape3DToPH( zMShape3DShape(ms,i) );
+    }
+  }
+  return ms;
+}
+
+/* a pose looking at the origin from a random point. */
+zFrame3D *pose_create_rand(zFrame3D *pose)
+{
+  zVec3D ax, ay, az, up;
+
+  zVec3DCreate( zFrame3DPos(pose), zRandF(-4,4), zRandF(-4,4), zRandF(-4,4) );
+  zVec3DRev( zFrame3DPos(pose), &az );
+  zVec3DNormalizeDRC( &az );
+  zVec3DCreate( &up, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zVec3DOuterProd( &up, &az, &ax );
+  zVec3DNormalizeDRC( &ax );
+  zVec3DOuterProd( &az, &ax, &ay );
+  zMat3DCreate( zFrame3DAtt(pose),
+    ax.c.x, ay.c.x, az.c.x, ax.c.y, ay.c.y, az.c.y, ax.c.z, ay.c.z, az.c.z );
+  return pose;
+}
+
+/* check a scan against rays cast to multiple shapes one by one. */
+bool check_scan(zRangeSensor *sensor, zMShape3D *ms, zFrame3D *pose, int count)
+{
+  zVec3D dir, *p;
+  double t;
+  int n = 0;
+  register int i, j;
+
+  for( i=0; i<zRangeSensorHeight(sensor); i++ )
+    for( j=0; j<zRangeSensorWidth(sensor); j++ ){
+      p = zRangeSensorPoint(sensor,i,j);
+      zMulMat3DVec3D( zFrame3DAtt(pose), zRangeSensorDir(sensor,i,j), &dir );
+      if( zMShape3DRayCast( ms, zFrame3DPos(pose), &dir, sensor->rmax, &t, NULL, NULL ) >= 0 && t >= sensor->rmin ){
+        if( zVec3DIsNan( p ) ) return false;
+        zVec3DMul( zRangeSensorDir(sensor,i,j), t, &dir );
+        if( !zVec3DEqual( p, &dir ) ) return false;
+        n++;
+      } else
+        if( !zVec3DIsNan( p ) ) return false;
+    }
+  return n == count;
+}
+
+/* check if measured points are read back from a PCD file in the world frame. */
+bool check_pcd(zRangeSensor *sensor, zFrame3D *pose, int count)
+{
+  FILE *fp;
+  zVec3DList pc;
+  zVec3DListCell *cp;
+  zVec3D p;
+  register int i;
+  bool result = true;
+
+  if( !( fp = tmpfile() ) ) return false;
+  if( !zRangeSensorPCDFWrite( fp, sensor, pose ) ) result = false;
+  rewind( fp );
+  if( !zVec3DListPCDFRead( fp, &pc ) ) result = false;
+  fclose( fp );
+  if( zListSize(&pc) != count ) result = false;
+  /* points are read in the same order */
+  cp = zListTail(&pc);
+  for( i=0; i<zRangeSensorRayNum(sensor) && cp!=zListRoot(&pc); i++ ){
+    if( zVec3DIsNan( zArrayElemNC(zRangeSensorPointCloud(sensor),i) ) ) continue;
+    zXform3D( pose, zArrayElemNC(zRangeSensorPointCloud(sensor),i), &p );
+    if( !zVec3DIsTol( zVec3DSubDRC( &p, cp->data ), 1.0e-5 ) ) result = false;
+    cp = zListCellNext(cp);
+  }
+  zVec3DListDestroy( &pc );
+  return result;
+}
+
+void assert_scene(void)
+{
+  zMShape3D ms;
+  zRangeScene scene;
+  zVec3D org, dir;
+  double t1, t2;
+  int i1, i2;
+  register int i;
+  bool result = true;
+
+  scene_create( &ms );
+  zRangeSceneCreate( &scene, &ms, 2 );
+  for( i=0; i<1000; i++ ){
+    zVec3DCreate( &org, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+    zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec3DSubDRC( &dir, &org );
+    i1 = zMShape3DRayCast( &ms, &org, &dir, 1, &t1, NULL, NULL );
+    i2 = zRangeSceneRayCast( &scene, &org, &dir, 1, &t2 );
+    if( i1 != i2 || ( i1 >= 0 && !zIsTiny( t1 - t2 ) ) ) result = false;
+  }
+  zRangeSceneDestroy( &scene );
+  zMShape3DDestroy( &ms );
+  zAssert( zRangeSceneRayCast, result );
+}
+
+void assert_scan(void)
+{
+  zMShape3D ms;
+  zRangeScene scene;
+  zRangeSensor camera, lidar;
+  zFrame3D pose;
+  zVec3DArray pc;
+  int count;
+  register int i, k;
+  bool result1 = true, result2 = true, result3 = true;
+
+  scene_create( &ms );
+  zRangeSceneCreate( &scene, &ms, 1 );
+  zRangeSensorCreateCamera( &camera, W, H, W, W, 0.5*(W-1), 0.5*(H-1), 0.5, 8 );
+  zRangeSensorCreateLiDAR( &lidar, 16, zDeg2Rad(-15), zDeg2Rad(15), 90, 0.5, 8 );
+  zArrayAlloc( &pc, zVec3D, W*H );
+  for( k=0; k<10; k++ ){
+    pose_create_rand( &pose );
+    count = zRangeSensorScan( &camera, &scene, &pose, 1 );
+    if( !check_scan( &camera, &ms, &pose, count ) ) result1 = false;
+    memcpy( zArrayBuf(&pc), zArrayBuf(zRangeSensorPointCloud(&camera)), sizeof(zVec3D)*W*H );
+    if( zRangeSensorScan( &camera, &scene, &pose, 4 ) != count ) result2 = false;
+    for( i=0; i<W*H; i++ )
+      if( zVec3DIsNan( zArrayElemNC(&pc,i) ) ?
+          !zVec3DIsNan( zArrayElemNC(zRangeSensorPointCloud(&camera),i) ) :
+          !zVec3DMatch( zArrayElemNC(&pc,i), zArrayElemNC(zRangeSensorPointCloud(&camera),i) ) ) result2 = false;
+    count = zRangeSensorScan( &lidar, &scene, &pose, 3 );
+    if( !check_scan( &lidar, &ms, &pose, count ) ) result3 = false;
+    for( i=0; i<zRangeSensorRayNum(&lidar); i++ )
+      if( !zVec3DIsNan( zArrayElemNC(zRangeSensorPointCloud(&lidar),i) ) &&
+          zVec3DNorm( zArrayElemNC(zRangeSensorPointCloud(&lidar),i) ) > 8 + zTOL ) result3 = false;
+  }
+  zArrayFree( &pc );
+  zAssert( zRangeSensorCreateCamera + zRangeSensorScan, result1 );
+  zAssert( zRangeSensorScan (multi-threaded), result2 );
+  zAssert( zRangeSensorCreateLiDAR + zRangeSensorScan, result3 );
+  zAssert( zVec3DArrayPCDFWrite, check_pcd( &lidar, &pose, count ) );
+  zRangeSensorDestroy( &camera );
+  zRangeSensorDestroy( &lidar );
+  zRangeSceneDestroy( &scene );
+  zMShape3DDestroy( &ms );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_scene();
+  assert_scan();
+  return EXIT_SUCCESS;
+}
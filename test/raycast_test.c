@@ -0,0 +1,158 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+#define M 20
+#define NS 6
+
+/* primitive shapes of every type with the analytic ray casting, tilted from the axes. */
+void shape_create(zShape3D shape[])
+{
+  zVec3D c1, c2, ax, ay, az;
+  zMat3D att;
+
+  zVec3DCreate( &c1, 0.2,-0.1, 0.3 );
+  zVec3DCreate( &c2,-0.4, 0.5,-0.2 );
+  zMat3DFromZYX( &att, 0.3, -0.4, 0.5 );
+  zMat3DCol( &att, zX, &ax );
+  zMat3DCol( &att, zY, &ay );
+  zMat3DCol( &att, zZ, &az );
+  zShape3DBoxCreate( &shape[0], &c1, &ax, &ay, &az, 0.8, 0.5, 0.3 );
+  zShape3DSphereCreate( &shape[1], &c1, 0.6, 0 );
+  zShape3DEllipsCreate( &shape[2], &c1, &ax, &ay, &az, 0.9, 0.5, 0.3, 0 );
+  zShape3DCylCreate( &shape[3], &c1, &c2, 0.4, 0 );
+  zShape3DECylCreate( &shape[4], &c1, &c2, 0.6, 0.3, &ax, 0 );
+  zShape3DConeCreate( &shape[5], &c1, &c2, 0.5, 0 );
+}
+
+/* check if a ray hits a convex shape at the first crossing of its surface. */
+bool check_ray(zShape3D *shape, zVec3D *org, zVec3D *dir, double tmax, int *hitcount)
+{
+  zVec3D hit, norm, p;
+  double t;
+  bool inside;
+  register int k;
+
+  inside = zShape3DPointIsInside( shape, org, false );
+  if( !zShape3DRayCast( shape, org, dir, tmax, &t, &hit, &norm ) ){
+    if( inside && tmax == HUGE_VAL ) return false; /* a ray from inside always exits */
+    for( k=1; k<=M; k++ )
+      if( zShape3DPointIsInside( shape, zVec3DCat( org, tmax*k/M, dir, &p ), false ) != inside ) return false;
+    return !zShape3DRayAnyHit( shape, org, dir, tmax );
+  }
+  (*hitcount)++;
+  if( t < 0 || t > tmax || !zIsTiny( zVec3DNorm(&norm) - 1 ) ) return false;
+  /* the ray does not cross the surface before the hit point */
+  for( k=1; k<M; k++ )
+    if( zShape3DPointIsInside( shape, zVec3DCat( org, t*k/M, dir, &p ), false ) != inside ) return false;
+  /* the hit point is on the surface, and the normal vector points outward */
+  if( zShape3DPointIsInside( shape, zVec3DCat( &hit, 1.0e-6, &norm, &p ), false ) ) return false;
+  if( !zShape3DPointIsInside( shape, zVec3DCat( &hit, -1.0e-6, &norm, &p ), false ) &&
+      !zIsTol( zShape3DPointDist( shape, &p ), 1.0e-6 ) ) return false;
+  return zShape3DRayAnyHit( shape, org, dir, tmax );
+}
+
+void assert_shape_raycast(void)
+{
+  zShape3D shape[NS];
+  zVec3D org, dir, c, sp;
+  int hitcount;
+  register int i, j;
+  bool result;
+
+  shape_create( shape );
+  for( i=0; i<NS; i++ ){
+    for( hitcount=0, result=true, j=0; j<N; j++ ){
+      zVec3DCreate( &org, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+      /* aim at around the shape */
+      zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      zShape3DSupportMap( &shape[i], &dir, &c );
+      zVec3DRevDRC( &dir );
+      zShape3DSupportMap( &shape[i], &dir, &sp );
+      zVec3DInterDiv( &c, &sp, zRandF(-0.2,1.2), &c );
+      zVec3DSub( &c, &org, &dir );
+      if( !check_ray( &shape[i], &org, &dir, zRandF(0.5,2), &hitcount ) ) result = false;
+      /* from inside */
+      zVec3DCreate( &org, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      if( zShape3DPointIsInside( &shape[i], &org, false ) ){
+        zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+        if( !check_ray( &shape[i], &org, &dir, HUGE_VAL, &hitcount ) ) result = false;
+      }
+    }
+    if( hitcount < N/4 ) result = false;
+    zAssert( zShape3DRayCast, result );
+    zShape3DDestroy( &shape[i] );
+  }
+}
+
+void assert_ph_raycast(void)
+{
+  zEllips3D ellips;
+  zPH3D ph;
+  zPH3DBVH bvh;
+  zVec3D org, dir, c;
+  double t1, t2, t;
+  int f1, f2, f;
+  register int i;
+  bool result1 = true, result2 = true;
+
+  zEllips3DCreateAlign( &ellips, ZVEC3DZERO, 1.2, 0.8, 0.3, 32 );
+  zEllips3DToPH( &ellips, &ph );
+  zPH3DBVHCreate( &bvh, &ph, 1 );
+  /* coherent rays from a point */
+  zVec3DCreate( &c, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+  for( i=0; i<N; i++ ){
+    zVec3DCopy( &c, &org );
+    zVec3DCreate( &dir, zRandF(-1.3,1.3), zRandF(-1.3,1.3), zRandF(-0.3,0.3) );
+    zVec3DSubDRC( &dir, &c );
+    f1 = zPH3DRayCast( &ph, &org, &dir, 2, &t1 );
+    f2 = zPH3DBVHRayCast( &bvh, &org, &dir, 2, &t2 );
+    if( ( f1 < 0 ) != ( f2 < 0 ) || ( f1 >= 0 && !zIsTiny( t1 - t2 ) ) ) result1 = false;
+    f = zPH3DBVHRayAnyHit( &bvh, &org, &dir, 2 );
+    if( ( f < 0 ) != ( f1 < 0 ) || ( f >= 0 && !zTri3DRayHit( zPH3DFace(&ph,f), &org, &dir, 2, &t ) ) ) result2 = false;
+  }
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &ph );
+  zAssert( zPH3DRayCast + zPH3DBVHRayCast, result1 );
+  zAssert( zPH3DBVHRayAnyHit, result2 );
+}
+
+void assert_mshape_raycast(void)
+{
+  zMShape3D ms;
+  zVec3D org, dir, hit, n, n1;
+  double t1, tmin;
+  int i1, imin;
+  register int i, j;
+  bool result1 = true, result2 = true;
+
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, NS );
+  shape_create( zMShape3DShapeBuf(&ms) );
+  zShape3DToPH( zMShape3DShape(&ms,0) ); /* a polyhedral box */
+  for( j=0; j<N; j++ ){
+    zVec3DCreate( &org, zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+    zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zVec3DSubDRC( &dir, &org );
+    i1 = zMShape3DRayCast( &ms, &org, &dir, 1, &t1, &hit, &n1 );
+    for( imin=-1, tmin=1, i=0; i<NS; i++ )
+      if( zShape3DRayCast( zMShape3DShape(&ms,i), &org, &dir, tmin, &t1, NULL, &n ) ){
+        tmin = t1; imin = i;
+      }
+    if( i1 != imin ) result1 = false;
+    if( i1 >= 0 && !zVec3DEqual( &n, &n1 ) ) result1 = false;
+    i1 = zMShape3DRayAnyHit( &ms, &org, &dir, 1 );
+    if( ( i1 < 0 ) != ( imin < 0 ) || ( i1 >= 0 && !zShape3DRayAnyHit( zMShape3DShape(&ms,i1), &org, &dir, 1 ) ) ) result2 = false;
+  }
+  zMShape3DDestroy( &ms );
+  zAssert( zMShape3DRayCast, result1 );
+  zAssert( zMShape3DRayAnyHit, result2 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_shape_raycast();
+  assert_ph_raycast();
+  assert_mshape_raycast();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+#include <zeo/zeo.h>
+
+#define N 200
+#define T 20
+
+void box_rand(zAABox3D *box, double x, double y, double z)
+{
+  double r;
+
+  r = zRandF(0.01,0.1);
+  zAABox3DCreate( box, x-r, y-r, z-r, x+r, y+r, z+r );
+}
+
+void box_move(zAABox3D *box, double d)
+{
+  zVec3D v;
+
+  zVec3DCreate( &v, zRandF(-d,d), zRandF(-d,d), zRandF(-d,d) );
+  zVec3DAddDRC( &box->min, &v );
+  zVec3DAddDRC( &box->max, &v );
+}
+
+/* brute-force overlap matrix. */
+void overlap_bruteforce(zAABox3D box[], bool alive[], int n, bool ov[][N])
+{
+  register int i, j;
+
+  for( i=0; i<n; i++ )
+    for( j=0; j<n; j++ )
+      ov[i][j] = i < j && alive[i] && alive[j] && zColChkAABox3D( &box[i], &box[j] );
+}
+
+/* check if overlapping and changed pairs coincide with the brute-force result. */
+bool check_sap(zSAP *sap, bool ov0[][N], bool ov[][N], int n)
+{
+  static bool mark[N][N];
+  zSAPPair *p;
+  register int i, j, k;
+  int count = 0;
+
+  for( i=0; i<n; i++ )
+    for( j=0; j<n; j++ ){
+      mark[i][j] = false;
+      if( ov[i][j] ) count++;
+    }
+  if( zSAPPairNum(sap) != count ) return false;
+  for( k=0; k<zSAPPairNum(sap); k++ ){
+    p = zSAPPair(sap,k);
+    if( p->i >= p->j || !ov[p->i][p->j] || mark[p->i][p->j] ) return false;
+    mark[p->i][p->j] = true;
+  }
+  for( count=0, i=0; i<n; i++ )
+    for( j=0; j<n; j++ )
+      if( ov[i][j] != ov0[i][j] ) count++;
+  if( zSAPAddedNum(sap) + zSAPRemovedNum(sap) != count ) return false;
+  for( k=0; k<zSAPAddedNum(sap); k++ ){
+    p = zSAPAdded(sap,k);
+    if( ov0[p->i][p->j] || !ov[p->i][p->j] ) return false;
+  }
+  for( k=0; k<zSAPRemovedNum(sap); k++ ){
+    p = zSAPRemoved(sap,k);
+    if( !ov0[p->i][p->j] || ov[p->i][p->j] ) return false;
+  }
+  return true;
+}
+
+void assert_sap(void)
+{
+  static bool ov0[N][N], ov[N][N];
+  zAABox3D box[N], b;
+  bool alive[N];
+  zSAP sap;
+  register int i, t;
+  int id;
+  bool result1 = true, result2 = true, result3 = true;
+
+  zSAPInit( &sap );
+  for( i=0; i<N; i++ ){
+    box_rand( &box[i], zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    alive[i] = true;
+    if( zSAPAdd( &sap, &box[i] ) != i ) result1 = false;
+  }
+  overlap_bruteforce( box, alive, N, ov0 );
+  overlap_bruteforce( box, alive, N, ov );
+  memset( ov0, 0, sizeof(ov0) );
+  if( !zSAPUpdate( &sap ) || !check_sap( &sap, ov0, ov, N ) ) result1 = false;
+  /* incremental update */
+  for( t=0; t<T; t++ ){
+    memcpy( ov0, ov, sizeof(ov) );
+    for( i=0; i<N; i++ ){
+      box_move( &box[i], 0.02 );
+      zSAPMove( &sap, i, &box[i] );
+    }
+    overlap_bruteforce( box, alive, N, ov );
+    if( !zSAPUpdate( &sap ) || !check_sap( &sap, ov0, ov, N ) ) result2 = false;
+  }
+  /* removal and addition */
+  for( t=0; t<T; t++ ){
+    memcpy( ov0, ov, sizeof(ov) );
+    id = zRandI(0,N-1);
+    if( alive[id] ){
+      zSAPRemove( &sap, id );
+      alive[id] = false;
+    }
+    if( zRandI(0,1) ){
+      box_rand( &b, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+      if( ( id = zSAPAdd( &sap, &b ) ) < 0 || id >= N || alive[id] ) result3 = false;
+      zAABox3DCopy( &b, &box[id] );
+      alive[id] = true;
+    }
+    overlap_bruteforce( box, alive, N, ov );
+    if( !zSAPUpdate( &sap ) || !check_sap( &sap, ov0, ov, N ) ) result3 = false;
+  }
+  zSAPDestroy( &sap );
+  zAssert( zSAPUpdate (initial), result1 );
+  zAssert( zSAPUpdate (incremental), result2 );
+  zAssert( zSAPAdd + zSAPRemove, result3 );
+}
+
+void assert_sap_mshape(void)
+{
+  zMShape3D ms;
+  zSAP sap;
+  zVec3D c;
+  zAABox3D box;
+  register int i, j, k;
+  bool result = true, ov;
+
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, N/4 );
+  for( i=0; i<zMShape3DShapeNum(&ms); i++ ){
+    zVec3DCreate( &c, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    zShape3DSphereCreate( zMShape3DShape(&ms,i), &c, zRandF(0.05,0.2), 0 );
+  }
+  zSAPCreateMShape3D( &sap, &ms );
+  for( k=0, i=0; i<zMShape3DShapeNum(&ms); i++ ){
+    zShape3DToAABox3D( zMShape3DShape(&ms,i), &box );
+    if( !zVec3DEqual( &box.min, &zSAPBox(&sap,i)->min ) || !zVec3DEqual( &box.max, &zSAPBox(&sap,i)->max ) ) result = false;
+    for( j=i+1; j<zMShape3DShapeNum(&ms); j++ ){
+      ov = zColChkAABox3D( zSAPBox(&sap,i), zSAPBox(&sap,j) );
+      if( ov ) k++;
+    }
+  }
+  if( k != zSAPPairNum(&sap) ) result = false;
+  zSAPDestroy( &sap );
+  zMShape3DDestroy( &ms );
+  zAssert( zSAPCreateMShape3D, result );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_sap();
+  assert_sap_mshape();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+#include <zeo/zeo.h>
+
+#define N     1000
+#define PITCH 0.05
+
+/* exact signed distance of a box. */
+double box_sdf(zBox3D *box, zVec3D *p)
+{
+  zVec3D q;
+  double d, dmax = -HUGE_VAL, out = 0;
+  register int i;
+
+  zXform3DInv( &box->f, p, &q );
+  for( i=zX; i<=zZ; i++ ){
+    d = fabs( q.e[i] ) - 0.5 * zBox3DDia(box,i);
+    if( d > dmax ) dmax = d;
+    if( d > 0 ) out += d*d;
+  }
+  return dmax > 0 ? sqrt( out ) : dmax;
+}
+
+/* exact signed distance of a torus about the z-axis. */
+double torus_sdf(double r1, double r2, zVec3D *p)
+{
+  return sqrt( zSqr( sqrt( zSqr(p->c.x) + zSqr(p->c.y) ) - r1 ) + zSqr(p->c.z) ) - r2;
+}
+
+/* check if a point is on the grid of a signed distance field. */
+bool on_grid(zSDF3D *sdf, zVec3D *p)
+{
+  register int i;
+
+  for( i=zX; i<=zZ; i++ )
+    if( p->e[i] < sdf->org.e[i] || p->e[i] > sdf->org.e[i] + zSDF3DPitch(sdf)*( zSDF3DSize(sdf,i) - 1 ) ) return false;
+  return true;
+}
+
+void box_create_rand(zShape3D *shape)
+{
+  zVec3D c, ax, ay, az;
+  zMat3D att;
+
+  zVec3DCreate( &c, zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-0.5,0.5) );
+  zVec3DCreate( &ax, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DFromAA( &att, &ax );
+  zMat3DCol( &att, zX, &ax );
+  zMat3DCol( &att, zY, &ay );
+  zMat3DCol( &att, zZ, &az );
+  zShape3DBoxCreate( shape, &c, &ax, &ay, &az, zRandF(0.3,1), zRandF(0.3,1), zRandF(0.3,1) );
+}
+
+void assert_box(void)
+{
+  zShape3D box;
+  zSDF3D dense, sparse;
+  zVec3D p, g, dp;
+  double d, e, band = 0.2;
+  register int i, j;
+  bool result1 = true, result2 = true, result3 = true;
+
+  box_create_rand( &box );
+  zSDF3DCreateShape( &dense, &box, PITCH, 0.5, ZEO_SDF3D_DENSE, 4 );
+  zSDF3DCreateShape( &sparse, &box, PITCH, 0.5, band, 4 );
+  if( zSDF3DBlockNum(&sparse) >= zSDF3DBlockNum(&dense) ) result2 = false;
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    e = box_sdf( zShape3DBox(&box), &p );
+    /* dense grid: exact around the surface and propagated far from it */
+    d = zSDF3DDist( &dense, &p );
+    if( on_grid( &dense, &p ) ? !zIsTol( d - e, PITCH ) : d < e - PITCH ) result1 = false;
+    /* sparse grid: exact within the band and truncated outside of it */
+    d = zSDF3DDist( &sparse, &p );
+    if( fabs( e ) < band - 2*PITCH ){
+      if( !zIsTol( d - e, PITCH ) ) result2 = false;
+    } else
+    if( fabs( e ) > band + 2*PITCH && ( e > 0 ? d < band - zTOL : !zIsTiny( d + band ) ) ) result2 = false;
+    if( fabs( e ) > PITCH && d * e < 0 ) result2 = false;
+    /* gradient against numerical differentiation */
+    d = zSDF3DGrad( &dense, &p, &g );
+    for( j=zX; j<=zZ; j++ ){
+      zVec3DCopy( &p, &dp );
+      dp.e[j] += 1.0e-7;
+      if( !zIsTol( ( zSDF3DDist( &dense, &dp ) - d ) / 1.0e-7 - g.e[j], 1.0e-4 ) &&
+          floor( ( dp.e[j] - dense.org.e[j] ) / PITCH ) == floor( ( p.e[j] - dense.org.e[j] ) / PITCH ) ) result3 = false;
+    }
+  }
+  zSDF3DDestroy( &dense );
+  zSDF3DDestroy( &sparse );
+  zShape3DDestroy( &box );
+  zAssert( zSDF3DCreateShape (dense), result1 );
+  zAssert( zSDF3DCreateShape (sparse), result2 );
+  zAssert( zSDF3DGrad, result3 );
+}
+
+void assert_torus(void)
+{
+  zPH3D torus;
+  zSDF3D sdf;
+  zVec3D loop[32], center, axis, p;
+  double d, e, r1 = 1.0, r2 = 0.3;
+  register int i;
+  bool result = true;
+
+  for( i=0; i<32; i++ )
+    zVec3DCreate( &loop[i], r1+r2*cos(zPIx2*i/32), 0, r2*sin(zPIx2*i/32) );
+  zVec3DZero( &center );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( &torus, loop, 32, 64, &center, &axis );
+  zSDF3DCreatePH( &sdf, &torus, PITCH, 0.2, 0.3, 3 );
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-1.5,1.5), zRandF(-1.5,1.5), zRandF(-0.5,0.5) );
+    e = torus_sdf( r1, r2, &p );
+    d = zSDF3DDist( &sdf, &p );
+    if( fabs( e ) < 0.3 - 2*PITCH && !zIsTol( d - e, PITCH ) ) result = false;
+    if( fabs( e ) > PITCH && d * e < 0 ) result = false; /* the hole is outside */
+  }
+  zSDF3DDestroy( &sdf );
+  zPH3DDestroy( &torus );
+  zAssert( zSDF3DCreatePH (non-convex), result );
+}
+
+void assert_mshape(void)
+{
+  zMShape3D ms;
+  zSDF3D sdf;
+  zVec3D c1, c2, p;
+  double d, e, r1, r2;
+  register int i;
+  bool result = true;
+
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, 2 );
+  zVec3DCreate( &c1, -0.3, 0, 0 );
+  zVec3DCreate( &c2, 0.4, 0.1, 0 );
+  zShape3DSphereCreate( zMShape3DShape(&ms,0), &c1, ( r1 = 0.5 ), 32 );
+  zShape3DSphereCreate( zMShape3DShape(&ms,1), &c2, ( r2 = 0.4 ), 32 );
+  zSDF3DCreateMShape( &sdf, &ms, PITCH, 0.3, ZEO_SDF3D_DENSE, 2 );
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    e = zMin( zVec3DDist( &p, &c1 ) - r1, zVec3DDist( &p, &c2 ) - r2 );
+    d = zSDF3DDist( &sdf, &p );
+    if( e > 0 && !zIsTol( d - e, 2*PITCH ) ) result = false;
+    if( fabs( e ) > 2*PITCH && d * e < 0 ) result = false;
+  }
+  zSDF3DDestroy( &sdf );
+  zMShape3DDestroy( &ms );
+  zAssert( zSDF3DCreateMShape, result );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_box();
+  assert_torus();
+  assert_mshape();
+  return EXIT_SUCCESS;
+}
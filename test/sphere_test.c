@@ -84,10 +84,31 @@ void assert_inside(void)
   zAssert( zSphere3DPointIsInside, nitest == ni && notest == no );
 }
 
+void assert_toph(void)
+{
+  zSphere3D sphere;
+  zPH3D ph;
+  zVec3D c;
+  register int i;
+  bool result = true;
+
+  generate_sphere_rand( &sphere );
+  zSphere3DSetDiv( &sphere, 16 );
+  zSphere3DToPH( &sphere, &ph );
+  for( i=0; i<zPH3DFaceNum(&ph); i++ ){
+    zTri3DBarycenter( zPH3DFace(&ph,i), &c );
+    zVec3DSubDRC( &c, zSphere3DCenter(&sphere) );
+    if( zVec3DInnerProd( &c, zTri3DNorm(zPH3DFace(&ph,i)) ) <= 0 ) result = false;
+  }
+  zPH3DDestroy( &ph );
+  zAssert( zSphere3DToPH (outward normals), result );
+}
+
 int main(void)
 {
   zRandInit();
   assert_volume_inertia();
   assert_inside();
+  assert_toph();
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,173 @@
+#include <zeo/zeo.h>
+
+#define N 10
+
+void frame_rand(zFrame3D *f)
+{
+  zVec3D aa;
+
+  zVec3DCreate( &aa, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DFromAA( zFrame3DAtt(f), &aa );
+  zVec3DCreate( zFrame3DPos(f), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+}
+
+void vec6d_rand(zVec6D *v)
+{
+  zVec6DCreate( v, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+}
+
+void spinertia_rand(zSpInertia *si)
+{
+  zVec3D com;
+  zMat3D inertia;
+  double ixx, iyy, izz;
+
+  zVec3DCreate( &com, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  ixx = zRandF(0.1,1); iyy = zRandF(0.1,1); izz = zRandF(0.1,1);
+  zMat3DCreate( &inertia, ixx, 0.1*zRandF(-0.1,0.1), 0.1*zRandF(-0.1,0.1), 0, iyy, 0.1*zRandF(-0.1,0.1), 0, 0, izz );
+  inertia.c.xy = inertia.c.yx;
+  inertia.c.xz = inertia.c.zx;
+  inertia.c.yz = inertia.c.zy;
+  zSpInertiaCreate( si, zRandF(0.1,10), &com, &inertia );
+}
+
+/* spatial transformation matrix equivalent to zXform6DLin() */
+zMat6D *frame2mat6d(zFrame3D *f, zMat6D *m)
+{
+  zMat3D op;
+
+  zMat3DT( zFrame3DAtt(f), &m->c.ll );
+  zMat3DZero( &m->c.la );
+  zVec3DOuterProd2Mat3D( zFrame3DPos(f), &op );
+  zMulMat3DTMat3D( zFrame3DAtt(f), &op, &m->c.al );
+  zMat3DRevDRC( &m->c.al );
+  zMat3DT( zFrame3DAtt(f), &m->c.aa );
+  return m;
+}
+
+void assert_xform6d(void)
+{
+  zFrame3D f[N];
+  zVec6D v[N], vc[N], vi[N], vm;
+  zMat6D m;
+  register int i;
+  bool ret1 = true, ret2 = true, ret3 = true, ret4 = true;
+
+  for( i=0; i<N; i++ ){
+    frame_rand( &f[i] );
+    vec6d_rand( &v[i] );
+  }
+  zXform6DLinArray( f, v, N, vc );
+  for( i=0; i<N; i++ ){
+    zMulMat6DVec6D( frame2mat6d( &f[i], &m ), &v[i], &vm );
+    if( !zVec6DEqual( &vc[i], &vm ) ) ret1 = false;
+  }
+  zXform6DLinInvArray( f, vc, N, vi );
+  for( i=0; i<N; i++ )
+    if( !zVec6DEqual( &v[i], &vi[i] ) ) ret2 = false;
+  zXform6DAngArray( f, v, N, vc );
+  for( i=0; i<N; i++ ){
+    zMulMat6DTVec6D( frame2mat6d( &f[i], &m ), &v[i], &vm );
+    if( !zVec6DEqual( &vc[i], &vm ) ) ret3 = false;
+  }
+  zXform6DAngInvArray( f, vc, N, vi );
+  for( i=0; i<N; i++ )
+    if( !zVec6DEqual( &v[i], &vi[i] ) ) ret4 = false;
+  zAssert( zXform6DLinArray, ret1 );
+  zAssert( zXform6DLinInvArray, ret2 );
+  zAssert( zXform6DAngArray (transpose), ret3 );
+  zAssert( zXform6DAngInvArray, ret4 );
+  /* in-place transformation */
+  zVec6DCopy( &v[0], &vm );
+  zXform6DLin( &f[0], &vm, &vm );
+  zXform6DLinInv( &f[0], &vm, &vm );
+  zAssert( zXform6DLin (in-place), zVec6DEqual( &v[0], &vm ) );
+}
+
+void assert_create(void)
+{
+  zSpInertia si;
+  zVec3D com, com_test;
+  zMat3D inertia, inertia_test;
+  double mass;
+
+  mass = zRandF(0.1,10);
+  zVec3DCreate( &com, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  zMat3DCreate( &inertia, 1, 0.1, 0.2, 0.1, 2, 0.3, 0.2, 0.3, 3 );
+  zSpInertiaCreate( &si, mass, &com, &inertia );
+  zSpInertiaCOM( &si, &com_test );
+  zSpInertiaBaryInertia( &si, &inertia_test );
+  zAssert( zSpInertiaCreate, zIsTiny( si.mass - mass ) && zVec3DEqual( &com, &com_test ) && zMat3DEqual( &inertia, &inertia_test ) );
+}
+
+void assert_mul(void)
+{
+  zSpInertia si[N];
+  zVec6D v[N], f[N], fm;
+  zMat6D m;
+  register int i;
+  bool result = true;
+
+  for( i=0; i<N; i++ ){
+    spinertia_rand( &si[i] );
+    vec6d_rand( &v[i] );
+  }
+  zMulSpInertiaVec6DArray( si, v, N, f );
+  for( i=0; i<N; i++ ){
+    zMulMat6DVec6D( zSpInertiaToMat6D( &si[i], &m ), &v[i], &fm );
+    if( !zVec6DEqual( &f[i], &fm ) ) result = false;
+  }
+  zAssert( zMulSpInertiaVec6DArray, result );
+  zMulSpInertiaVec6D( &si[0], &v[0], &v[0] );
+  zAssert( zMulSpInertiaVec6D (in-place), zVec6DEqual( &f[0], &v[0] ) );
+}
+
+void assert_xform(void)
+{
+  zSpInertia si[N], sic[N], sii[N];
+  zFrame3D f[N];
+  zVec6D v0, v1, f1, f0, fc;
+  register int i;
+  bool result1 = true, result2 = true, result3 = true;
+
+  for( i=0; i<N; i++ ){
+    spinertia_rand( &si[i] );
+    frame_rand( &f[i] );
+  }
+  zSpInertiaXformArray( si, f, N, sic );
+  for( i=0; i<N; i++ ){ /* X^T I X v = I' v */
+    vec6d_rand( &v0 );
+    zXform6DLin( &f[i], &v0, &v1 );
+    zMulSpInertiaVec6D( &si[i], &v1, &f1 );
+    zXform6DAng( &f[i], &f1, &f0 );
+    zMulSpInertiaVec6D( &sic[i], &v0, &fc );
+    if( !zVec6DEqual( &f0, &fc ) ) result1 = false;
+  }
+  zSpInertiaXformInvArray( sic, f, N, sii );
+  for( i=0; i<N; i++ ){
+    if( !zIsTiny( sii[i].mass - si[i].mass ) || !zVec3DEqual( &sii[i].h, &si[i].h ) ) result2 = false;
+    if( !zIsTiny( sii[i].i[0] - si[i].i[0] ) || !zIsTiny( sii[i].i[1] - si[i].i[1] ) || !zIsTiny( sii[i].i[2] - si[i].i[2] ) ||
+        !zIsTiny( sii[i].i[3] - si[i].i[3] ) || !zIsTiny( sii[i].i[4] - si[i].i[4] ) || !zIsTiny( sii[i].i[5] - si[i].i[5] ) ) result2 = false;
+  }
+  /* composite inertia */
+  zSpInertiaAdd( &sic[0], &sic[1], &sii[0] );
+  vec6d_rand( &v0 );
+  zMulSpInertiaVec6D( &sic[0], &v0, &f0 );
+  zMulSpInertiaVec6D( &sic[1], &v0, &f1 );
+  zVec6DAddDRC( &f0, &f1 );
+  zMulSpInertiaVec6D( &sii[0], &v0, &fc );
+  if( !zVec6DEqual( &f0, &fc ) ) result3 = false;
+  zAssert( zSpInertiaXformArray, result1 );
+  zAssert( zSpInertiaXformInvArray, result2 );
+  zAssert( zSpInertiaAdd, result3 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_xform6d();
+  assert_create();
+  assert_mul();
+  assert_xform();
+  return EXIT_SUCCESS;
+}